@@ -0,0 +1,171 @@
+// BENCHMARK:
+// This program compares the `Link::IRQ` hub against the chained approach
+// (an interrupt library that calls `LINK_UNIVERSAL_ISR_*`, which forwards to
+// `LinkUniversal`, which forwards to the active driver).
+// - chained: A libtonc-like switchboard (a list of flag/function pairs,
+//   searched on every interrupt) calling the `LINK_*_ISR_*` functions.
+// - hub: `Link::IRQ::_onIRQ()`, with the handlers registered by `activate()`.
+// - empty: The driver does nothing, so only the dispatch is measured.
+// - LinkCable: `LinkUniversal` in cable mode, with real `_onSerial()` and
+//   `_onTimer()` work (the difference is the dispatch cost).
+// Output:
+// - Host cycles per interrupt (best of multiple runs).
+// - On the GBA, the hub also runs in ARM mode from IWRAM, while the chained
+//   approach usually runs a master ISR in IWRAM and then Thumb code from ROM,
+//   so the difference is larger there.
+// Usage:
+//   ./IRQ_bench [-n iterations]
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkUniversal.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+
+static constexpr u32 RUNS = 10;
+
+LinkUniversal* linkUniversal = nullptr;
+
+// Chained approach
+
+struct Switchboard {
+  struct Entry {
+    u16 flag;
+    void (*isr)();
+  };
+
+  Entry entries[14];
+  u32 count = 0;
+
+  void add(u16 flag, void (*isr)()) { entries[count++] = Entry{flag, isr}; }
+
+  LINK_NOINLINE void onIRQ() {
+    u16 pending = Link::_REG_IE & Link::_REG_IF;
+    for (u32 i = 0; i < count; i++) {
+      if (pending & entries[i].flag) {
+        entries[i].isr();
+        return;
+      }
+    }
+  }
+};
+
+// Empty drivers
+
+volatile u32 sink = 0;
+
+struct EmptyDriver {
+  LINK_NOINLINE void _onSerial() { sink = sink + 1; }
+  LINK_NOINLINE void _onTimer() { sink = sink + 1; }
+};
+
+struct EmptyWrapper {
+  volatile bool isEnabled = true;
+  volatile bool isFirstMode = true;
+  EmptyDriver first, second;
+
+  void _onSerial() {
+    if (!isEnabled)
+      return;
+    if (isFirstMode)
+      first._onSerial();
+    else
+      second._onSerial();
+  }
+
+  void _onTimer() {
+    if (!isEnabled)
+      return;
+    if (isFirstMode)
+      first._onTimer();
+    else
+      second._onTimer();
+  }
+};
+
+EmptyWrapper* emptyWrapper = nullptr;
+
+inline void EMPTY_ISR_SERIAL() {
+  emptyWrapper->_onSerial();
+}
+
+inline void EMPTY_ISR_TIMER() {
+  emptyWrapper->_onTimer();
+}
+
+// Measurement
+
+template <typename Dispatch>
+double measure(u32 iterations, u16 irq, Dispatch dispatch) {
+  u64 best = ~0ull;
+
+  for (u32 run = 0; run < RUNS; run++) {
+    u64 start = Link::Host::hostCycles();
+    for (u32 i = 0; i < iterations; i++) {
+      Link::_REG_IF = irq;
+      dispatch();
+    }
+    u64 elapsed = Link::Host::hostCycles() - start;
+    best = std::min(best, elapsed);
+  }
+
+  Link::_REG_IF = 0;
+  return (double)best / iterations;
+}
+
+void compare(const char* name,
+             u32 iterations,
+             u16 irq,
+             Switchboard& switchboard) {
+  double chained =
+      measure(iterations, irq, [&switchboard]() { switchboard.onIRQ(); });
+  double hub = measure(iterations, irq, []() { Link::IRQ::_onIRQ(); });
+
+  printf("%-22s %10.2f %10.2f %9.2fx\n", name, chained, hub, chained / hub);
+}
+
+int main(int argc, char* argv[]) {
+  u32 iterations = atoi(Bench::option(argc, argv, "-n", "1000000"));
+
+  printf("IRQ_bench (%u iterations, host cycles per interrupt)\n\n",
+         iterations);
+  printf("%-22s %10s %10s %10s\n", "driver", "chained", "hub", "speedup");
+
+  // (the switchboard has the usual VBLANK entry before the link ones)
+  Switchboard emptySwitchboard;
+  emptySwitchboard.add(Link::_IRQ_VBLANK, []() {});
+  emptySwitchboard.add(Link::_IRQ_SERIAL, EMPTY_ISR_SERIAL);
+  emptySwitchboard.add(Link::_IRQ_TIMER3, EMPTY_ISR_TIMER);
+
+  emptyWrapper = new EmptyWrapper();
+  Link::IRQ::set(Link::_IRQ_SERIAL, &emptyWrapper->first, [](void* driver) {
+    static_cast<EmptyDriver*>(driver)->_onSerial();
+  });
+  Link::IRQ::set(Link::_IRQ_TIMER3, &emptyWrapper->first, [](void* driver) {
+    static_cast<EmptyDriver*>(driver)->_onTimer();
+  });
+  Link::_REG_IE = Link::_IRQ_VBLANK | Link::_IRQ_SERIAL | Link::_IRQ_TIMER3;
+
+  compare("empty (SERIAL)", iterations, Link::_IRQ_SERIAL, emptySwitchboard);
+  compare("empty (TIMER)", iterations, Link::_IRQ_TIMER3, emptySwitchboard);
+  Link::IRQ::unsetAll(&emptyWrapper->first);
+
+  Switchboard cableSwitchboard;
+  cableSwitchboard.add(Link::_IRQ_VBLANK, LINK_UNIVERSAL_ISR_VBLANK);
+  cableSwitchboard.add(Link::_IRQ_SERIAL, LINK_UNIVERSAL_ISR_SERIAL);
+  cableSwitchboard.add(Link::_IRQ_TIMER3, LINK_UNIVERSAL_ISR_TIMER);
+
+  linkUniversal = new LinkUniversal(LinkUniversal::Protocol::CABLE);
+  linkUniversal->activate();
+  Link::_REG_IE = Link::_IRQ_VBLANK | Link::_IRQ_SERIAL | Link::_IRQ_TIMER3;
+
+  compare("LinkCable (SERIAL)", iterations, Link::_IRQ_SERIAL,
+          cableSwitchboard);
+  compare("LinkCable (TIMER)", iterations, Link::_IRQ_TIMER3,
+          cableSwitchboard);
+
+  linkUniversal->deactivate();
+  return 0;
+}
@@ -0,0 +1,313 @@
+// BENCHMARK:
+// This program compares `LinkCable2P` (Normal Mode, 32 bits) against
+// `LinkCable` (Multi-Play, 16 bits) on 2 simulated GBAs.
+// - LinkCable: 2 machines connected with a `MultiPlayBus`.
+// - LinkCable2P: 2 machines connected with a `NormalBus` (GBC Link Cable).
+//   The second GBA is turned on a few scanlines later, and both of them
+//   negotiate their roles.
+// A) Packet loss test:
+//   - Both nodes keep their send queue full of consecutive values.
+//   - When a node receives something not equal to previousValue + 1, it's an
+//     error.
+// L) Measure ping latency:
+//   - Measures how much time it takes to receive a packet from the other node.
+// Output:
+// - msgs/s: Received messages per second (both nodes).
+// - p50: Message latency, in scanlines.
+// - cyc/frm: Total *host* cycles spent in interrupt handlers per frame (per
+//   node).
+// - connect: Frames until both nodes are connected.
+// Usage:
+//   ./LinkCable2P_bench [-t AL] [-n messages] [-i intervals] [-f maxFrames]
+//   (e.g. ./LinkCable2P_bench -t A -i 3,10,25)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkCable.hpp"
+#include "../../../lib/LinkCable2P.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+using Link::Host::NormalBus;
+
+static constexpr u32 PLAYERS = 2;
+static constexpr u32 BOOT_OFFSET = 100 * Link::Host::CYCLES_PER_SCANLINE;
+static constexpr u16 WAKE_IRQS =
+    Link::_IRQ_VBLANK | Link::_IRQ_SERIAL |
+    Link::_TIMER_IRQ_IDS[LINK_CABLE_DEFAULT_SEND_TIMER_ID];
+
+enum class Test { PACKET_LOSS, PING };
+
+struct Options {
+  u32 messages;
+  u32 maxFrames;
+};
+
+struct Node {
+  Machine machine;
+  u16 localCounter = 0;
+  u16 expectedCounter = 0;
+  u32 received = 0;
+  bool isWaiting = false;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u32 received = 0;
+  u64 elapsedCycles = 0;
+  u64 connectCycles = 0;
+  Bench::Samples latencies;
+  double cyclesPerFrame = 0;
+};
+
+Node nodes[PLAYERS];
+u64 sentTimes[PLAYERS][0x10000];
+
+// Tests
+
+template <typename L, typename B>
+void testPacketLoss(L* link,
+                    B& bus,
+                    Node& node,
+                    u32 playerId,
+                    Result& result,
+                    Options& opts) {
+  while (node.localCounter < opts.messages && link->canSend()) {
+    node.localCounter++;
+    link->send(node.localCounter);
+    sentTimes[playerId][node.localCounter] = bus.cycles();
+  }
+
+  u32 remotePlayerId = !playerId;
+  while (link->canRead(remotePlayerId)) {
+    u16 message = link->read(remotePlayerId);
+    result.latencies.add(bus.cycles() - sentTimes[remotePlayerId][message]);
+    result.received++;
+    node.received++;
+
+    node.expectedCounter++;
+    if (message != node.expectedCounter) {
+      result.errors++;
+      node.expectedCounter = message;
+    }
+  }
+}
+
+template <typename L, typename B>
+void testPing(L* link,
+              B& bus,
+              Node& node,
+              u32 playerId,
+              Result& result,
+              Options& opts) {
+  if (!node.isWaiting) {
+    if (node.localCounter >= opts.messages)
+      return;
+    node.localCounter++;
+    link->send(node.localCounter);
+    sentTimes[playerId][node.localCounter] = bus.cycles();
+    node.isWaiting = true;
+  }
+
+  u32 remotePlayerId = !playerId;
+  if (!link->canRead(remotePlayerId))
+    return;
+
+  u16 message = link->read(remotePlayerId);
+  result.latencies.add(bus.cycles() - sentTimes[remotePlayerId][message]);
+  result.received++;
+  node.received++;
+  node.isWaiting = false;
+}
+
+bool isDone(Test test, Options& opts) {
+  for (u32 i = 0; i < PLAYERS; i++) {
+    auto& node = nodes[i];
+    if (node.received < opts.messages ||
+        (test == Test::PING && node.isWaiting))
+      return false;
+  }
+  return true;
+}
+
+// Runner
+
+template <typename L, typename B, typename F>
+Result run(Test test, F create, Options& opts) {
+  Result result;
+  L* links[PLAYERS];
+  B bus;
+
+  for (u32 i = 0; i < PLAYERS; i++) {
+    auto& node = nodes[i];
+    node.localCounter = 0;
+    node.expectedCounter = 0;
+    node.received = 0;
+    node.isWaiting = false;
+    node.machine.activate();
+    node.machine.reset();
+    links[i] = create();
+    links[i]->activate();
+    Link::IRQ::install();
+
+    // (the second GBA is turned on later)
+    if (i == 0)
+      node.machine.step(BOOT_OFFSET);
+  }
+
+  for (u32 i = 0; i < PLAYERS; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = 0;
+  bool hasStarted = false;
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    for (u32 i = 0; i < PLAYERS; i++) {
+      auto& node = nodes[i];
+      if (!(node.machine._takeDispatchedIRQs() & WAKE_IRQS))
+        continue;
+
+      node.machine.activate();
+      L* link = links[i];
+      link->sync();
+
+      if (!hasStarted && links[0]->isConnected() && links[1]->isConnected()) {
+        startCycles = bus.cycles();
+        result.connectCycles = startCycles;
+        hasStarted = true;
+        for (u32 j = 0; j < PLAYERS; j++)
+          nodes[j].machine.resetStats();
+      }
+      if (!hasStarted)
+        continue;
+
+      u32 playerId = link->currentPlayerId();
+      if (test == Test::PACKET_LOSS)
+        testPacketLoss(link, bus, node, playerId, result, opts);
+      else
+        testPing(link, bus, node, playerId, result, opts);
+    }
+
+    if (hasStarted && isDone(test, opts)) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  double frames = (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME;
+  for (u32 i = 0; i < PLAYERS; i++) {
+    auto& machine = nodes[i].machine;
+    u64 total = machine.isrStats(Link::_IRQ_VBLANK).totalCycles +
+                machine.isrStats(Link::_IRQ_SERIAL).totalCycles +
+                machine
+                    .isrStats(Link::_TIMER_IRQ_IDS
+                                  [LINK_CABLE_DEFAULT_SEND_TIMER_ID])
+                    .totalCycles;
+    if (frames > 0)
+      result.cyclesPerFrame += total / frames / PLAYERS;
+
+    machine.activate();
+    links[i]->deactivate();
+    delete links[i];
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+void printHeader(const char* name) {
+  printf("\n%s\n", name);
+  printf("%-12s %-8s %8s %8s %10s %8s %7s %8s %8s\n", "library", "speed",
+         "interval", "status", "msgs/s", "p50", "errors", "cyc/frm",
+         "connect");
+}
+
+void printResult(const char* library,
+                 const char* speed,
+                 u16 interval,
+                 Result& result) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  printf("%-12s %-8s %8u %8s %10.1f %8.1f %7u %8.0f %8.1f\n", library, speed,
+         interval, result.completed ? "OK" : "TIMEOUT",
+         seconds > 0 ? result.received / seconds : 0,
+         Bench::toScanlines(result.latencies.percentile(50)), result.errors,
+         result.cyclesPerFrame,
+         (double)result.connectCycles / Link::Host::CYCLES_PER_FRAME);
+}
+
+int main(int argc, char* argv[]) {
+  std::string tests = Bench::option(argc, argv, "-t", "AL");
+  Options opts;
+  opts.messages = atoi(Bench::option(argc, argv, "-n", "2000"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "36000"));
+  auto intervals =
+      Bench::parseList(Bench::option(argc, argv, "-i", "3,10,25,50"));
+
+  if (opts.messages < 1 || opts.messages > 65534) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  printf("LinkCable2P_bench (2 players, %u messages)\n", opts.messages);
+  printf("(latencies in scanlines, ISR costs in host cycles)\n");
+
+  for (char c : tests) {
+    Test test;
+    const char* name;
+    switch (c) {
+      case 'A': {
+        test = Test::PACKET_LOSS;
+        name = "A) Packet loss";
+        break;
+      }
+      case 'L': {
+        test = Test::PING;
+        name = "L) Ping latency";
+        break;
+      }
+      default:
+        continue;
+    }
+
+    printHeader(name);
+    for (u32 interval : intervals) {
+      auto cable = run<LinkCable, MultiPlayBus>(
+          test,
+          [interval]() {
+            return new LinkCable(LinkCable::BaudRate::BAUD_RATE_3,
+                                 LINK_CABLE_DEFAULT_TIMEOUT, interval);
+          },
+          opts);
+      printResult("LinkCable", "115200", interval, cable);
+
+      auto cable2P = run<LinkCable2P, NormalBus>(
+          test,
+          [interval]() {
+            return new LinkCable2P(LinkCable2P::Speed::SPEED_256KBPS,
+                                   LINK_CABLE_2P_DEFAULT_TIMEOUT, interval);
+          },
+          opts);
+      printResult("LinkCable2P", "256K", interval, cable2P);
+
+      auto cable2PFast = run<LinkCable2P, NormalBus>(
+          test,
+          [interval]() {
+            return new LinkCable2P(LinkCable2P::Speed::SPEED_2MBPS,
+                                   LINK_CABLE_2P_DEFAULT_TIMEOUT, interval);
+          },
+          opts);
+      printResult("LinkCable2P", "2M", interval, cable2PFast);
+    }
+  }
+
+  return 0;
+}
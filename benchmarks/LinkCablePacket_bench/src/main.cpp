@@ -0,0 +1,419 @@
+// BENCHMARK:
+// This program compares `LinkCable::sendPacket(...)` / `receivePacket(...)`
+// against the framing that games usually write on top of `send(...)`, on 2
+// simulated GBAs connected with a Multi-Play bus.
+// - packet: The built-in framing (a length header, then 2 bytes per word).
+// - hand-rolled: A length header, then 1 byte per word (`0x100 | byte`, so the
+//   reserved values are never sent).
+// - Both nodes send packets of a fixed size as fast as the send queue allows,
+//   and validate every received byte.
+// Data patterns:
+// - random: Pseudo-random bytes.
+// - zeros: All bytes are `0` (a common case in game structs).
+// - worst: Every word needs escaping (`0x00, 0x80` pairs).
+// - The send queue is big enough for worst-case packets of the maximum size.
+// - `-u 1` also sends one `sendUrgent(...)` message per frame, which can land
+//   in the middle of a packet. Packets must still arrive intact, and urgent
+//   messages must arrive in order through `readUrgent(...)`.
+// Output:
+// - B/s: Effective payload bytes per second (received, per node).
+// - words/pkt: Average 16-bit transfers per packet.
+// Usage:
+//   ./LinkCablePacket_bench [-s sizes] [-i interval] [-n packets]
+//                           [-f maxFrames] [-u urgent]
+//   (e.g. ./LinkCablePacket_bench -s 2,8,24 -i 10)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkCable.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+
+using BenchCable = LinkCableT<LINK_CABLE_PACKET_SIZE + 1>;
+
+static constexpr u32 PLAYERS = 2;
+static constexpr u16 WAKE_IRQS =
+    Link::_IRQ_VBLANK | Link::_IRQ_SERIAL |
+    Link::_TIMER_IRQ_IDS[LINK_CABLE_DEFAULT_SEND_TIMER_ID];
+
+enum class Framing { PACKET, HAND_ROLLED };
+enum class Pattern { RANDOM, ZEROS, WORST };
+
+struct Options {
+  u32 packets;
+  u16 interval;
+  u32 maxFrames;
+  bool urgent;
+};
+
+struct HandRolledSender {
+  u8 packet[LINK_CABLE_PACKET_SIZE];
+  u32 position = 0;  // (0 = header)
+  bool isPending = false;
+};
+
+struct HandRolledReceiver {
+  u8 packet[LINK_CABLE_PACKET_SIZE];
+  u32 length = 0;
+  u32 position = 0;
+};
+
+struct Node {
+  Machine machine;
+  BenchCable* linkCable = nullptr;
+  u32 sentPackets = 0;
+  u32 receivedPackets = 0;
+  u16 sentUrgent = 0;
+  u16 receivedUrgent = 0;
+  u64 lastUrgentAt = 0;
+  HandRolledSender sender;
+  HandRolledReceiver receiver;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u64 receivedBytes = 0;
+  u64 sentWords = 0;
+  u32 sentPackets = 0;
+  u64 elapsedCycles = 0;
+};
+
+Node nodes[PLAYERS];
+MultiPlayBus bus;
+
+// Packets
+
+u8 byteAt(Pattern pattern, u32 playerId, u32 packetId, u32 index) {
+  switch (pattern) {
+    case Pattern::RANDOM: {
+      u32 x = (playerId + 1) * 0x9E3779B9 ^ packetId * 0x85EBCA6B ^
+              index * 0xC2B2AE35;
+      x ^= x >> 15;
+      x *= 0x2C1B3C6D;
+      x ^= x >> 12;
+      return x & 0xFF;
+    }
+    case Pattern::ZEROS:
+      return 0;
+    case Pattern::WORST:
+    default:
+      return index % 2 == 0 ? 0x00 : 0x80;
+  }
+}
+
+void fillPacket(u8* packet,
+                u32 size,
+                Pattern pattern,
+                u32 playerId,
+                u32 packetId) {
+  for (u32 i = 0; i < size; i++)
+    packet[i] = byteAt(pattern, playerId, packetId, i);
+}
+
+u32 checkPacket(const u8* packet,
+                u32 size,
+                Pattern pattern,
+                u32 playerId,
+                u32 packetId) {
+  u32 errors = 0;
+  for (u32 i = 0; i < size; i++) {
+    if (packet[i] != byteAt(pattern, playerId, packetId, i))
+      errors++;
+  }
+  return errors;
+}
+
+// Built-in framing
+
+u32 packetWords(const u8* packet, u32 size) {
+  // (header + 1 word per byte pair, or 2 if the pair has to be escaped)
+  u32 words = 1;
+  for (u32 i = 0; i < size; i += 2) {
+    u16 word = packet[i] | (i + 1 < size ? packet[i + 1] << 8 : 0);
+    u16 encoded = word ^ 0x8000;
+    words += encoded == 0x0000 || encoded >= 0xFFFE ? 2 : 1;
+  }
+  return words;
+}
+
+void sendPackets(Node& node,
+                 u32 playerId,
+                 u32 size,
+                 Pattern pattern,
+                 Result& result,
+                 Options& opts) {
+  u8 packet[LINK_CABLE_PACKET_SIZE];
+
+  while (node.sentPackets < opts.packets) {
+    fillPacket(packet, size, pattern, playerId, node.sentPackets);
+    if (!node.linkCable->sendPacket(packet, size))
+      return;
+    result.sentWords += packetWords(packet, size);
+    node.sentPackets++;
+    result.sentPackets++;
+  }
+}
+
+void receivePackets(Node& node,
+                    u32 remotePlayerId,
+                    u32 size,
+                    Pattern pattern,
+                    Result& result) {
+  u8 packet[LINK_CABLE_PACKET_SIZE];
+
+  u32 length;
+  while ((length = node.linkCable->receivePacket(remotePlayerId, packet,
+                                                 sizeof(packet))) > 0) {
+    if (length != size)
+      result.errors++;
+    result.errors += checkPacket(packet, size, pattern, remotePlayerId,
+                                 node.receivedPackets);
+    result.receivedBytes += length;
+    node.receivedPackets++;
+  }
+}
+
+// Urgent messages (`-u 1`)
+
+void exchangeUrgent(Node& node, u32 remotePlayerId, Result& result) {
+  // (`1~0x7FFF`, so the values are always valid)
+  while (node.linkCable->canReadUrgent(remotePlayerId)) {
+    u16 expected = node.receivedUrgent % 0x7FFF + 1;
+    if (node.linkCable->readUrgent(remotePlayerId) != expected)
+      result.errors++;
+    node.receivedUrgent = expected;
+  }
+
+  u64 now = bus.cycles();
+  if (now - node.lastUrgentAt >= Link::Host::CYCLES_PER_FRAME &&
+      node.linkCable->sendUrgent(node.sentUrgent % 0x7FFF + 1)) {
+    node.sentUrgent = node.sentUrgent % 0x7FFF + 1;
+    node.lastUrgentAt = now;
+  }
+}
+
+// Hand-rolled framing
+
+void sendHandRolled(Node& node,
+                    u32 playerId,
+                    u32 size,
+                    Pattern pattern,
+                    Result& result,
+                    Options& opts) {
+  auto& sender = node.sender;
+
+  while (node.linkCable->canSend()) {
+    if (!sender.isPending) {
+      if (node.sentPackets >= opts.packets)
+        return;
+      fillPacket(sender.packet, size, pattern, playerId, node.sentPackets);
+      sender.position = 0;
+      sender.isPending = true;
+    }
+
+    u16 word = sender.position == 0
+                   ? (u16)size
+                   : 0x100 | sender.packet[sender.position - 1];
+    node.linkCable->send(word);
+    result.sentWords++;
+    sender.position++;
+
+    if (sender.position > size) {
+      sender.isPending = false;
+      node.sentPackets++;
+      result.sentPackets++;
+    }
+  }
+}
+
+void receiveHandRolled(Node& node,
+                       u32 remotePlayerId,
+                       u32 size,
+                       Pattern pattern,
+                       Result& result) {
+  auto& receiver = node.receiver;
+
+  while (node.linkCable->canRead(remotePlayerId)) {
+    u16 word = node.linkCable->read(remotePlayerId);
+
+    if (receiver.length == 0) {
+      receiver.length = word;
+      receiver.position = 0;
+      continue;
+    }
+
+    receiver.packet[receiver.position++] = word & 0xFF;
+    if (receiver.position < receiver.length)
+      continue;
+
+    if (receiver.length != size)
+      result.errors++;
+    result.errors += checkPacket(receiver.packet, size, pattern,
+                                 remotePlayerId, node.receivedPackets);
+    result.receivedBytes += receiver.length;
+    node.receivedPackets++;
+    receiver.length = 0;
+  }
+}
+
+// Runner
+
+void tick(Framing framing,
+          u32 playerId,
+          u32 size,
+          Pattern pattern,
+          Result& result,
+          Options& opts) {
+  auto& node = nodes[playerId];
+  node.linkCable->sync();
+
+  if (!node.linkCable->isConnected() ||
+      node.linkCable->playerCount() != PLAYERS)
+    return;
+
+  u32 remotePlayerId = !playerId;
+  if (opts.urgent)
+    exchangeUrgent(node, remotePlayerId, result);
+  if (framing == Framing::PACKET) {
+    receivePackets(node, remotePlayerId, size, pattern, result);
+    sendPackets(node, playerId, size, pattern, result, opts);
+  } else {
+    receiveHandRolled(node, remotePlayerId, size, pattern, result);
+    sendHandRolled(node, playerId, size, pattern, result, opts);
+  }
+}
+
+bool isDone(Options& opts) {
+  for (u32 i = 0; i < PLAYERS; i++) {
+    if (nodes[i].receivedPackets < opts.packets)
+      return false;
+  }
+  return true;
+}
+
+Result run(Framing framing, u32 size, Pattern pattern, Options& opts) {
+  Result result;
+
+  for (u32 i = 0; i < PLAYERS; i++) {
+    auto& node = nodes[i];
+    node.sentPackets = 0;
+    node.receivedPackets = 0;
+    node.sentUrgent = 0;
+    node.receivedUrgent = 0;
+    node.lastUrgentAt = 0;
+    node.sender = HandRolledSender{};
+    node.receiver = HandRolledReceiver{};
+    node.machine.activate();
+    node.machine.reset();
+    node.linkCable = new BenchCable(BenchCable::BaudRate::BAUD_RATE_1,
+                                    LINK_CABLE_DEFAULT_TIMEOUT, opts.interval);
+    node.linkCable->activate();
+    Link::IRQ::install();
+  }
+
+  bus = MultiPlayBus{};
+  for (u32 i = 0; i < PLAYERS; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = 0;
+  bool hasStarted = false;
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    for (u32 i = 0; i < PLAYERS; i++) {
+      auto& node = nodes[i];
+      if (!(node.machine._takeDispatchedIRQs() & WAKE_IRQS))
+        continue;
+
+      node.machine.activate();
+      if (!hasStarted && node.linkCable->isConnected()) {
+        startCycles = bus.cycles();
+        hasStarted = true;
+      }
+      tick(framing, i, size, pattern, result, opts);
+    }
+
+    if (hasStarted && isDone(opts)) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  for (u32 i = 0; i < PLAYERS; i++) {
+    nodes[i].machine.activate();
+    nodes[i].linkCable->deactivate();
+    delete nodes[i].linkCable;
+    nodes[i].linkCable = nullptr;
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+double bytesPerSecond(Result& result) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  return seconds > 0 ? result.receivedBytes / seconds / PLAYERS : 0;
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.packets = atoi(Bench::option(argc, argv, "-n", "200"));
+  opts.interval = atoi(Bench::option(argc, argv, "-i", "10"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "36000"));
+  opts.urgent = atoi(Bench::option(argc, argv, "-u", "0")) != 0;
+  auto sizes = Bench::parseList(Bench::option(argc, argv, "-s", "2,8,16,24"));
+
+  for (u32 size : sizes) {
+    if (size < 1 || size > LINK_CABLE_PACKET_SIZE) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+
+  printf("LinkCablePacket_bench (%u packets per node, interval %u%s)\n",
+         opts.packets, opts.interval, opts.urgent ? ", urgent" : "");
+  printf("(payload bytes per second received by each node)\n");
+
+  struct {
+    Pattern pattern;
+    const char* name;
+  } patterns[] = {{Pattern::RANDOM, "random"},
+                  {Pattern::ZEROS, "zeros"},
+                  {Pattern::WORST, "worst"}};
+
+  for (auto& entry : patterns) {
+    printf("\n%s\n", entry.name);
+    printf("%6s %12s %10s %12s %10s %9s %7s\n", "size", "hand B/s",
+           "words/pkt", "packet B/s", "words/pkt", "speedup", "errors");
+
+    for (u32 size : sizes) {
+      auto handRolled = run(Framing::HAND_ROLLED, size, entry.pattern, opts);
+      auto packet = run(Framing::PACKET, size, entry.pattern, opts);
+
+      double handRolledSpeed = bytesPerSecond(handRolled);
+      double packetSpeed = bytesPerSecond(packet);
+      bool completed = handRolled.completed && packet.completed;
+
+      printf("%6u %12.1f %10.2f %12.1f %10.2f %8.2fx %7s\n", size,
+             handRolledSpeed,
+             (double)handRolled.sentWords / handRolled.sentPackets,
+             packetSpeed, (double)packet.sentWords / packet.sentPackets,
+             handRolledSpeed > 0 ? packetSpeed / handRolledSpeed : 0,
+             completed ? std::to_string(handRolled.errors + packet.errors)
+                             .c_str()
+                       : "TIMEOUT");
+    }
+  }
+
+  return 0;
+}
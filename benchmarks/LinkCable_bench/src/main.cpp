@@ -0,0 +1,648 @@
+// BENCHMARK:
+// This program runs the LinkCable_stress tests on 2-4 simulated GBAs
+// connected with a Multi-Play bus, for multiple `config.interval` values.
+// A) Packet loss test:
+//   - Every node keeps its send queue full of consecutive values.
+//   - When a node receives something not equal to previousValue + 1, it's an
+//     error.
+// B) Packet sync test:
+//   - Like (A), but in lockstep: nodes wait for all remote counters to match
+//     the local counter before sending the next value.
+// L) Measure ping latency:
+//   - Measures how much time it takes to receive a packet from other nodes.
+// R) Measure ping-pong latency (2 players only):
+//   - Like (L), but adding a validation response and adding that time.
+// U) Measure urgent latency:
+//   - Like (A), but every node also sends a ping once per frame with
+//     `sendUrgent(...)`, so it has to overtake a full send queue.
+//   - p50/p99 only measure pings, the rest of the columns include everything.
+// Output:
+// - msgs/s: Received messages per second (all nodes).
+// - p50/p99: Message latency, in scanlines.
+// - ISR: Average *host* cycles per call of each interrupt handler.
+// - cyc/frm: Total *host* cycles spent in interrupt handlers per frame (per
+//   node).
+// Options:
+// - `-r 1` enables the reliable mode.
+// - `-e N` makes every Nth transfer fail on one of the nodes (round-robin).
+// - `-a 1` enables the adaptive interval (`interval` is the initial value, and
+//   `final` is the master's interval at the end of the test).
+// - `-s N` enables the burst mode, with up to N transfers per timer tick.
+// - `-c 1` receives messages with `config.onReceive` instead of polling (only
+//   A and L).
+// - `-v 1` runs the game loop (`sync()`, `send(...)` and `read(...)`) only
+//   on VBlank, like most games do. Otherwise, it runs after every interrupt.
+// - `-u 0` sends the pings of (U) with `send(...)` instead, for comparison.
+// - `-w N` sets `config.urgentWeight` (urgent messages per bulk message).
+// Usage:
+//   ./LinkCable_bench [-t ABLRU] [-p players] [-b baudRate] [-n messages]
+//                     [-i intervals] [-f maxFrames] [-r reliable] [-e faults]
+//                     [-a adaptive] [-s burstSize] [-c callbacks] [-v vblank]
+//                     [-u urgent] [-w urgentWeight]
+//   (e.g. ./LinkCable_bench -t AL -p 4 -b 3 -i 10,25,50)
+//   (e.g. ./LinkCable_bench -t A -r 1 -e 50)
+//   (e.g. ./LinkCable_bench -t AL -s 4 -i 25,50,100)
+//   (e.g. ./LinkCable_bench -t L -v 1 -c 1)
+//   (e.g. ./LinkCable_bench -t U -u 0 && ./LinkCable_bench -t U -u 1)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkCable.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+
+enum class Test { PACKET_LOSS, PACKET_SYNC, PING, PING_PONG, URGENT };
+
+static constexpr u16 URGENT_MASK = 0x8000;  // (pings of the urgent test)
+static constexpr u16 BULK_MAX = URGENT_MASK - 1;
+static constexpr u16 PING_MAX = 0x7FFC;  // (0xFFFC is the urgent prefix)
+
+struct Options {
+  u32 players;
+  u32 baudRate;
+  u32 messages;
+  u32 maxFrames;
+  bool reliable;
+  u32 faultInterval;
+  bool adaptiveInterval;
+  u32 burstSize;
+  bool callbacks;
+  bool vblankOnly;
+  bool urgent;
+  u32 urgentWeight;
+};
+
+struct NodeState {
+  u16 localCounter = 0;
+  u16 expectedCounters[LINK_CABLE_MAX_PLAYERS] = {};
+  u16 pendingValidation = 0;
+  u64 sentAt = 0;
+  bool isWaiting = false;
+  bool isWaitingPong = false;
+  u32 received = 0;
+  u32 receivedPlayers = 0;  // (bitmask, for callbacks)
+  u16 pingCounter = 0;      // (urgent test)
+  u64 lastPingAt = 0;       // (urgent test)
+};
+
+struct Node {
+  Machine machine;
+  LinkCable* linkCable = nullptr;
+  NodeState state;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u32 received = 0;
+  u64 elapsedCycles = 0;
+  Bench::Samples latencies;
+  double vblankCycles = 0;
+  double serialCycles = 0;
+  double timerCycles = 0;
+  double cyclesPerFrame = 0;
+  u16 finalInterval = 0;
+};
+
+static constexpr u16 WAKE_IRQS =
+    Link::_IRQ_VBLANK | Link::_IRQ_SERIAL |
+    Link::_TIMER_IRQ_IDS[LINK_CABLE_DEFAULT_SEND_TIMER_ID];
+
+LinkCable* linkCable = nullptr;
+Node nodes[LINK_CABLE_MAX_PLAYERS];
+MultiPlayBus bus;
+u64 sentTimes[LINK_CABLE_MAX_PLAYERS][0x10000];
+Test currentTest;
+Result* currentResult = nullptr;
+Options* currentOptions = nullptr;
+
+template <u32 N>
+void onVBlank() {
+  nodes[N].linkCable->_onVBlank();
+}
+template <u32 N>
+void onSerial() {
+  nodes[N].linkCable->_onSerial();
+}
+template <u32 N>
+void onTimer() {
+  nodes[N].linkCable->_onTimer();
+}
+
+static constexpr Link::Host::ISR VBLANK_ISRS[] = {onVBlank<0>, onVBlank<1>,
+                                                  onVBlank<2>, onVBlank<3>};
+static constexpr Link::Host::ISR SERIAL_ISRS[] = {onSerial<0>, onSerial<1>,
+                                                  onSerial<2>, onSerial<3>};
+static constexpr Link::Host::ISR TIMER_ISRS[] = {onTimer<0>, onTimer<1>,
+                                                 onTimer<2>, onTimer<3>};
+
+// Messages
+
+u16 nextValue(u16 value) {
+  value++;
+  return value == LINK_CABLE_DISCONNECTED || value == LINK_CABLE_NO_DATA
+             ? 1
+             : value;
+}
+
+bool send(u32 playerId, Node& node, u16 value) {
+  if (!node.linkCable->send(value))
+    return false;
+
+  sentTimes[playerId][value] = bus.cycles();
+  return true;
+}
+
+void track(Node& node, u32 remotePlayerId, u16 value, Result& result) {
+  result.latencies.add(bus.cycles() - sentTimes[remotePlayerId][value]);
+  result.received++;
+  node.state.received++;
+}
+
+u16 receive(Node& node, u32 remotePlayerId, Result& result) {
+  u16 value = node.linkCable->read(remotePlayerId);
+  track(node, remotePlayerId, value, result);
+  return value;
+}
+
+void checkCounter(Node& node, u32 remotePlayerId, u16 value, Result& result) {
+  node.state.expectedCounters[remotePlayerId]++;
+  if (value != node.state.expectedCounters[remotePlayerId]) {
+    result.errors++;
+    node.state.expectedCounters[remotePlayerId] = value;
+  }
+}
+
+bool canReadAll(Node& node, u32 playerId, u32 players) {
+  for (u32 i = 0; i < players; i++) {
+    if (i != playerId && !node.linkCable->canRead(i))
+      return false;
+  }
+  return true;
+}
+
+// Tests
+
+void testPacketLoss(Node& node, u32 playerId, Result& result, Options& opts) {
+  while (node.state.localCounter < opts.messages && node.linkCable->canSend()) {
+    node.state.localCounter++;
+    send(playerId, node, node.state.localCounter);
+  }
+
+  for (u32 i = 0; i < opts.players; i++) {
+    if (i == playerId)
+      continue;
+
+    while (node.linkCable->canRead(i))
+      checkCounter(node, i, receive(node, i, result), result);
+  }
+}
+
+void testPacketSync(Node& node, u32 playerId, Result& result, Options& opts) {
+  if (!node.state.isWaiting) {
+    if (node.state.localCounter >= opts.messages)
+      return;
+    node.state.localCounter++;
+    if (!send(playerId, node, node.state.localCounter)) {
+      node.state.localCounter--;
+      return;
+    }
+    node.state.sentAt = bus.cycles();
+    node.state.isWaiting = true;
+  }
+
+  if (!canReadAll(node, playerId, opts.players))
+    return;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    if (i == playerId)
+      continue;
+    u16 message = node.linkCable->read(i);
+    if (message != node.state.localCounter)
+      result.errors++;
+    result.received++;
+    node.state.received++;
+  }
+  result.latencies.add(bus.cycles() - node.state.sentAt);
+  node.state.isWaiting = false;
+}
+
+void testPing(Node& node, u32 playerId, Result& result, Options& opts) {
+  if (!node.state.isWaiting) {
+    if (node.state.localCounter >= opts.messages)
+      return;
+    if (!send(playerId, node, nextValue(node.state.localCounter)))
+      return;
+    node.state.localCounter = nextValue(node.state.localCounter);
+    node.state.isWaiting = true;
+  }
+
+  if (!canReadAll(node, playerId, opts.players))
+    return;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    if (i != playerId)
+      receive(node, i, result);
+  }
+  node.state.isWaiting = false;
+}
+
+void testPingPong(Node& node, u32 playerId, Result& result, Options& opts) {
+  u32 remotePlayerId = !playerId;
+
+  while (true) {
+    if (!node.state.isWaiting && !node.state.isWaitingPong) {
+      if (node.state.received >= opts.messages * 2)
+        return;
+      u16 ping = 11 + playerId * 10 + (node.state.localCounter++ % 1000) * 2;
+      if (!send(playerId, node, ping)) {
+        node.state.localCounter--;
+        return;
+      }
+      node.state.pendingValidation = ping;
+      node.state.sentAt = bus.cycles();
+      node.state.isWaiting = true;
+    }
+
+    if (!node.linkCable->canRead(remotePlayerId))
+      return;
+
+    u16 message = node.linkCable->read(remotePlayerId);
+    result.received++;
+    node.state.received++;
+
+    if (node.state.isWaiting) {
+      node.linkCable->send(message);
+      node.state.isWaiting = false;
+      node.state.isWaitingPong = true;
+    } else {
+      if (message != node.state.pendingValidation)
+        result.errors++;
+      result.latencies.add(bus.cycles() - node.state.sentAt);
+      node.state.isWaitingPong = false;
+    }
+  }
+}
+
+void testUrgent(Node& node, u32 playerId, Result& result, Options& opts) {
+  // (bulk values stay below `URGENT_MASK`, pings have it set)
+  u64 now = bus.cycles();
+  if (now - node.state.lastPingAt >= Link::Host::CYCLES_PER_FRAME) {
+    u16 ping = URGENT_MASK | node.state.pingCounter;
+    bool sent = opts.urgent ? node.linkCable->sendUrgent(ping)
+                            : node.linkCable->send(ping);
+    if (sent) {
+      sentTimes[playerId][ping] = now;
+      node.state.pingCounter = (node.state.pingCounter + 1) % PING_MAX;
+      node.state.lastPingAt = now;
+    }
+  }
+
+  while (node.state.localCounter < opts.messages && node.linkCable->canSend()) {
+    node.state.localCounter++;
+    node.linkCable->send((node.state.localCounter - 1) % BULK_MAX + 1);
+  }
+
+  for (u32 i = 0; i < opts.players; i++) {
+    if (i == playerId)
+      continue;
+
+    // (urgent pings must arrive on their own channel)
+    while (node.linkCable->canReadUrgent(i)) {
+      u16 value = node.linkCable->readUrgent(i);
+      if (!opts.urgent || !(value & URGENT_MASK)) {
+        result.errors++;
+        continue;
+      }
+      result.latencies.add(bus.cycles() - sentTimes[i][value]);
+      result.received++;
+    }
+
+    while (node.linkCable->canRead(i)) {
+      u16 value = node.linkCable->read(i);
+      if (value & URGENT_MASK) {
+        // (only bulk messages count to finish the test)
+        if (opts.urgent)
+          result.errors++;
+        result.latencies.add(bus.cycles() - sentTimes[i][value]);
+        result.received++;
+        continue;
+      }
+
+      u16& expected = node.state.expectedCounters[i];
+      expected = expected % BULK_MAX + 1;
+      if (value != expected) {
+        result.errors++;
+        expected = value;
+      }
+      result.received++;
+      node.state.received++;
+    }
+  }
+}
+
+// Callbacks (`-c 1`, called from the SERIAL IRQ)
+
+template <u32 N>
+void onReceive(u8 playerId, u16 data) {
+  auto& node = nodes[N];
+  auto& result = *currentResult;
+  track(node, playerId, data, result);
+
+  if (currentTest == Test::PACKET_LOSS) {
+    checkCounter(node, playerId, data, result);
+    return;
+  }
+
+  // (ping: the next one is sent when all the other players answered)
+  u32 allPlayers = (1 << currentOptions->players) - 1;
+  node.state.receivedPlayers |= 1 << playerId;
+  if (node.state.receivedPlayers == (allPlayers & ~(1 << N))) {
+    node.state.receivedPlayers = 0;
+    node.state.isWaiting = false;
+  }
+}
+
+static constexpr Link::ReceiveCallback RECEIVE_CALLBACKS[] = {
+    onReceive<0>, onReceive<1>, onReceive<2>, onReceive<3>};
+
+bool isDone(Test test, Options& opts) {
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    switch (test) {
+      case Test::PACKET_LOSS:
+      case Test::URGENT: {
+        if (node.state.received < opts.messages * (opts.players - 1))
+          return false;
+        break;
+      }
+      case Test::PACKET_SYNC:
+      case Test::PING: {
+        if (node.state.localCounter < opts.messages || node.state.isWaiting)
+          return false;
+        break;
+      }
+      case Test::PING_PONG: {
+        if (node.state.received < opts.messages * 2)
+          return false;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+void tick(Test test, u32 playerId, Result& result, Options& opts) {
+  auto& node = nodes[playerId];
+  node.linkCable->sync();
+
+  if (!node.linkCable->isConnected() ||
+      node.linkCable->playerCount() != opts.players)
+    return;
+
+  if (opts.callbacks) {
+    // (only sends, the callbacks receive)
+    if (test == Test::PACKET_LOSS) {
+      while (node.state.localCounter < opts.messages &&
+             send(playerId, node, node.state.localCounter + 1))
+        node.state.localCounter++;
+    } else if (!node.state.isWaiting &&
+               node.state.localCounter < opts.messages &&
+               send(playerId, node, nextValue(node.state.localCounter))) {
+      node.state.localCounter = nextValue(node.state.localCounter);
+      node.state.isWaiting = true;
+    }
+    return;
+  }
+
+  switch (test) {
+    case Test::PACKET_LOSS: {
+      testPacketLoss(node, playerId, result, opts);
+      break;
+    }
+    case Test::PACKET_SYNC: {
+      testPacketSync(node, playerId, result, opts);
+      break;
+    }
+    case Test::PING: {
+      testPing(node, playerId, result, opts);
+      break;
+    }
+    case Test::PING_PONG: {
+      testPingPong(node, playerId, result, opts);
+      break;
+    }
+    case Test::URGENT: {
+      testUrgent(node, playerId, result, opts);
+      break;
+    }
+  }
+}
+
+// Runner
+
+Result run(Test test, u16 interval, Options& opts) {
+  Result result;
+  currentTest = test;
+  currentResult = &result;
+  currentOptions = &opts;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    node.state = NodeState{};
+    node.machine.activate();
+    node.machine.reset();
+    node.machine.setISR(Link::_IRQ_VBLANK, VBLANK_ISRS[i]);
+    node.machine.setISR(Link::_IRQ_SERIAL, SERIAL_ISRS[i]);
+    node.machine.setISR(Link::_TIMER_IRQ_IDS[LINK_CABLE_DEFAULT_SEND_TIMER_ID],
+                        TIMER_ISRS[i]);
+    node.linkCable = new LinkCable(
+        (LinkCable::BaudRate)opts.baudRate, LINK_CABLE_DEFAULT_TIMEOUT,
+        interval, LINK_CABLE_DEFAULT_SEND_TIMER_ID, opts.reliable);
+    node.linkCable->config.adaptiveInterval = opts.adaptiveInterval;
+    node.linkCable->config.burstSize = opts.burstSize;
+    node.linkCable->config.urgentWeight = opts.urgentWeight;
+    if (opts.callbacks)
+      node.linkCable->config.onReceive = RECEIVE_CALLBACKS[i];
+    node.linkCable->activate();
+  }
+
+  bus = MultiPlayBus{};
+  bus.faultInterval = opts.faultInterval;
+  for (u32 i = 0; i < opts.players; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = 0;
+  bool hasStarted = false;
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    for (u32 i = 0; i < opts.players; i++) {
+      auto& node = nodes[i];
+      u16 irqs = node.machine._takeDispatchedIRQs();
+      if (!(irqs & (opts.vblankOnly ? Link::_IRQ_VBLANK : WAKE_IRQS)))
+        continue;
+
+      node.machine.activate();
+      if (!hasStarted && node.linkCable->isConnected()) {
+        startCycles = bus.cycles();
+        hasStarted = true;
+        for (u32 j = 0; j < opts.players; j++)
+          nodes[j].machine.resetStats();
+      }
+      tick(test, i, result, opts);
+    }
+
+    if (hasStarted && isDone(test, opts)) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  result.finalInterval = nodes[0].linkCable->getInterval();
+  double frames =
+      (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME;
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& machine = nodes[i].machine;
+    auto vblank = machine.isrStats(Link::_IRQ_VBLANK);
+    auto serial = machine.isrStats(Link::_IRQ_SERIAL);
+    auto timer = machine.isrStats(
+        Link::_TIMER_IRQ_IDS[LINK_CABLE_DEFAULT_SEND_TIMER_ID]);
+    result.vblankCycles += Bench::perCall(vblank) / opts.players;
+    result.serialCycles += Bench::perCall(serial) / opts.players;
+    result.timerCycles += Bench::perCall(timer) / opts.players;
+    if (frames > 0)
+      result.cyclesPerFrame +=
+          (vblank.totalCycles + serial.totalCycles + timer.totalCycles) /
+          frames / opts.players;
+
+    delete nodes[i].linkCable;
+    nodes[i].linkCable = nullptr;
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+void printHeader(const char* name) {
+  printf("\n%s\n", name);
+  printf("%8s %8s %10s %8s %8s %7s %8s %8s %8s %8s %6s\n", "interval",
+         "status", "msgs/s", "p50", "p99", "errors", "isrVBL", "isrSER",
+         "isrTIM", "cyc/frm", "final");
+}
+
+void printResult(u16 interval, Result& result) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  printf("%8u %8s %10.1f %8.1f %8.1f %7u %8.0f %8.0f %8.0f %8.0f %6u\n",
+         interval, result.completed ? "OK" : "TIMEOUT",
+         seconds > 0 ? result.received / seconds : 0,
+         Bench::toScanlines(result.latencies.percentile(50)),
+         Bench::toScanlines(result.latencies.percentile(99)), result.errors,
+         result.vblankCycles, result.serialCycles, result.timerCycles,
+         result.cyclesPerFrame, result.finalInterval);
+}
+
+int main(int argc, char* argv[]) {
+  std::string tests = Bench::option(argc, argv, "-t", "ABLR");
+  Options opts;
+  opts.players = atoi(Bench::option(argc, argv, "-p", "2"));
+  opts.baudRate = atoi(Bench::option(argc, argv, "-b", "1"));
+  opts.messages = atoi(Bench::option(argc, argv, "-n", "1000"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "36000"));
+  opts.reliable = atoi(Bench::option(argc, argv, "-r", "0")) != 0;
+  opts.faultInterval = atoi(Bench::option(argc, argv, "-e", "0"));
+  opts.adaptiveInterval = atoi(Bench::option(argc, argv, "-a", "0")) != 0;
+  opts.burstSize = atoi(Bench::option(argc, argv, "-s", "1"));
+  opts.callbacks = atoi(Bench::option(argc, argv, "-c", "0")) != 0;
+  opts.vblankOnly = atoi(Bench::option(argc, argv, "-v", "0")) != 0;
+  opts.urgent = atoi(Bench::option(argc, argv, "-u", "1")) != 0;
+  opts.urgentWeight = atoi(Bench::option(argc, argv, "-w", "0"));
+  auto intervals =
+      Bench::parseList(Bench::option(argc, argv, "-i", "10,25,50,75,100"));
+
+  if (opts.players < 2 || opts.players > LINK_CABLE_MAX_PLAYERS ||
+      opts.baudRate > 3 || opts.messages < 1 || opts.messages > 65534 ||
+      opts.burstSize > 255 || opts.urgentWeight > 255) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  printf("LinkCable_bench (%u players, baud rate #%u, %u messages%s)\n",
+         opts.players, opts.baudRate, opts.messages,
+         opts.reliable ? ", reliable" : "");
+  if (opts.adaptiveInterval)
+    printf("(adaptive interval)\n");
+  if (opts.burstSize > 1)
+    printf("(bursts of up to %u transfers per tick)\n", opts.burstSize);
+  if (opts.faultInterval > 0)
+    printf("(1 failed transfer every %u transfers)\n", opts.faultInterval);
+  if (opts.callbacks)
+    printf("(receiving with callbacks)\n");
+  if (opts.vblankOnly)
+    printf("(game loop on VBlank)\n");
+  if (tests.find('U') != std::string::npos)
+    printf("(U pings sent with %s, urgent weight %u)\n",
+           opts.urgent ? "sendUrgent" : "send", opts.urgentWeight);
+  printf("(latencies in scanlines, ISR costs in host cycles per call)\n");
+
+  for (char c : tests) {
+    Test test;
+    const char* name;
+    switch (c) {
+      case 'A': {
+        test = Test::PACKET_LOSS;
+        name = "A) Packet loss";
+        break;
+      }
+      case 'B': {
+        test = Test::PACKET_SYNC;
+        name = "B) Packet sync";
+        break;
+      }
+      case 'L': {
+        test = Test::PING;
+        name = "L) Ping latency";
+        break;
+      }
+      case 'R': {
+        test = Test::PING_PONG;
+        name = "R) Ping-pong latency";
+        break;
+      }
+      case 'U': {
+        test = Test::URGENT;
+        name = "U) Urgent latency";
+        break;
+      }
+      default:
+        continue;
+    }
+
+    if (opts.callbacks && (test == Test::PACKET_SYNC ||
+                           test == Test::PING_PONG || test == Test::URGENT)) {
+      printf("\n%s: skipped (polling only)\n", name);
+      continue;
+    }
+    if (test == Test::PING_PONG && opts.players != 2) {
+      printf("\n%s: skipped (2 players only)\n", name);
+      continue;
+    }
+
+    printHeader(name);
+    for (u32 interval : intervals) {
+      auto result = run(test, interval, opts);
+      printResult(interval, result);
+    }
+  }
+
+  return 0;
+}
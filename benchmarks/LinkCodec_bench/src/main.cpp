@@ -0,0 +1,284 @@
+// BENCHMARK:
+// This program compresses recorded link traffic with `LinkCodec`, in batches,
+// and checks that every batch decodes back to the original messages.
+// - tilemap: Rows of a 32x32 tilemap (repeated tiles, flipped/high palettes).
+// - tile diff: XOR between consecutive frames of the tilemap (mostly zeros).
+// - entities: A 16x8 entity table (positions, states, `-1` targets) sent on
+//   every frame, with slow changes.
+// - inputs: Histories of held `REG_KEYS` values (like a replay).
+// - random: Uniform random values (the worst case).
+// - A raw capture (a file with little-endian u16 messages) can be added with
+//   `-r file`.
+// Output:
+// - ratio: Messages per encoded word (higher is better).
+// - enc/byte, dec/byte: Host cycles per uncompressed byte (best of multiple
+//   runs).
+// - errors: Batches that didn't decode to the original messages.
+// Usage:
+//   ./LinkCodec_bench [-s batchSize] [-n frames] [-r file]
+//   (e.g. ./LinkCodec_bench -s 32 -r capture.bin)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkCodec.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+
+using BenchEncoder = LinkCodec::Encoder<LinkCodec::MAX_BATCH_LIMIT>;
+using BenchDecoder = LinkCodec::Decoder<LinkCodec::MAX_BATCH_LIMIT>;
+using Trace = std::vector<u16>;
+
+static constexpr u32 RUNS = 10;
+static constexpr u32 MAP_SIZE = 32;
+static constexpr u32 ENTITIES = 16;
+static constexpr u32 FIELDS = 8;
+
+struct Result {
+  u32 messages = 0;
+  u32 words = 0;
+  u32 errors = 0;
+  double encodeCycles = 0;
+  double decodeCycles = 0;
+};
+
+volatile u32 sink = 0;
+u32 seed = 0x2545F491;
+
+u32 nextRandom() {
+  seed ^= seed << 13;
+  seed ^= seed >> 17;
+  seed ^= seed << 5;
+  return seed;
+}
+
+// Traces
+
+void fillMap(u16* map, u32 frame) {
+  // (a background made of a few repeated 2x2 metatiles, with a scrolling
+  // band of tiles that use a high palette and flips)
+  for (u32 y = 0; y < MAP_SIZE; y++) {
+    for (u32 x = 0; x < MAP_SIZE; x++) {
+      u32 metatile = ((x / 2) * 7 + (y / 2) * 3) % 5;
+      u16 tile = 1 + metatile * 4 + (y % 2) * 2 + (x % 2);
+      if (y >= 20 && y < 24 && (x + frame) % 8 < 3)
+        tile |= 0x9C00;  // (palette 9, flipped)
+      map[y * MAP_SIZE + x] = tile;
+    }
+  }
+}
+
+Trace tilemapTrace(u32 frames) {
+  Trace trace;
+  u16 map[MAP_SIZE * MAP_SIZE];
+  for (u32 frame = 0; frame < frames; frame++) {
+    fillMap(map, frame);
+    trace.insert(trace.end(), map, map + MAP_SIZE * MAP_SIZE);
+  }
+  return trace;
+}
+
+Trace tileDiffTrace(u32 frames) {
+  Trace trace;
+  u16 previous[MAP_SIZE * MAP_SIZE];
+  u16 map[MAP_SIZE * MAP_SIZE];
+  fillMap(previous, 0);
+  for (u32 frame = 1; frame <= frames; frame++) {
+    fillMap(map, frame);
+    for (u32 i = 0; i < MAP_SIZE * MAP_SIZE; i++) {
+      trace.push_back(map[i] ^ previous[i]);
+      previous[i] = map[i];
+    }
+  }
+  return trace;
+}
+
+Trace entitiesTrace(u32 frames) {
+  Trace trace;
+  u16 entities[ENTITIES][FIELDS];
+  for (u32 i = 0; i < ENTITIES; i++) {
+    entities[i][0] = nextRandom() % 240;  // x
+    entities[i][1] = nextRandom() % 160;  // y
+    entities[i][2] = i < 10 ? 1 : 0;      // state
+    entities[i][3] = 100;                 // hp
+    entities[i][4] = 0xFFFF;              // target (none)
+    entities[i][5] = 0;                   // timer
+    entities[i][6] = i % 3;               // kind
+    entities[i][7] = 0;                   // flags
+  }
+
+  for (u32 frame = 0; frame < frames; frame++) {
+    for (u32 i = 0; i < ENTITIES; i++) {
+      if (entities[i][2] == 0)
+        continue;
+      if (nextRandom() % 4 == 0)
+        entities[i][0] = (entities[i][0] + 1) % 240;
+      if (nextRandom() % 8 == 0)
+        entities[i][1] = (entities[i][1] + 159) % 160;
+      if (nextRandom() % 64 == 0)
+        entities[i][4] = entities[i][4] == 0xFFFF ? nextRandom() % 16 : 0xFFFF;
+      if (nextRandom() % 128 == 0)
+        entities[i][3] -= 10;
+    }
+    for (u32 i = 0; i < ENTITIES; i++)
+      trace.insert(trace.end(), entities[i], entities[i] + FIELDS);
+  }
+  return trace;
+}
+
+Trace inputsTrace(u32 frames) {
+  Trace trace;
+  u16 keys = 0;
+  for (u32 frame = 0; frame < frames * 16; frame++) {
+    if (nextRandom() % 12 == 0)
+      keys = nextRandom() & 0x3FF & (nextRandom() | 0x2F0);
+    trace.push_back(keys);
+  }
+  return trace;
+}
+
+Trace randomTrace(u32 frames) {
+  Trace trace;
+  for (u32 i = 0; i < frames * 128; i++)
+    trace.push_back(nextRandom());
+  return trace;
+}
+
+bool loadTrace(const char* path, Trace& trace) {
+  FILE* file = fopen(path, "rb");
+  if (!file)
+    return false;
+
+  u8 bytes[2];
+  while (fread(bytes, 1, 2, file) == 2)
+    trace.push_back(bytes[0] | (bytes[1] << 8));
+  fclose(file);
+  return !trace.empty();
+}
+
+// Runner
+
+Result run(const Trace& trace, u32 batchSize) {
+  Result result;
+  u32 count = trace.size();
+  std::vector<u16> encoded;
+  std::vector<u32> batchWords;
+  u64 bestEncode = ~0ull;
+  u64 bestDecode = ~0ull;
+
+  u32 overhead = LinkCodec::maxEncodedSize(batchSize) - batchSize;
+  encoded.resize(count + (count / batchSize + 1) * overhead);
+
+  for (u32 run = 0; run < RUNS; run++) {
+    u16* out = encoded.data();
+    batchWords.clear();
+
+    u64 start = Link::Host::hostCycles();
+    for (u32 i = 0; i < count; i += batchSize) {
+      u32 size = Link::_min(batchSize, count - i);
+      u32 words = LinkCodec::encode(trace.data() + i, size, out);
+      batchWords.push_back(words);
+      out += words;
+    }
+    u64 elapsed = Link::Host::hostCycles() - start;
+    bestEncode = std::min(bestEncode, elapsed);
+  }
+
+  static BenchDecoder decoder;
+  for (u32 run = 0; run < RUNS; run++) {
+    u32 errors = 0;
+    u32 total = 0;
+    const u16* in = encoded.data();
+    decoder.reset();
+
+    u64 start = Link::Host::hostCycles();
+    for (u32 i = 0, batch = 0; i < count; i += batchSize, batch++) {
+      u32 size = Link::_min(batchSize, count - i);
+      bool isComplete = false;
+      for (u32 j = 0; j < batchWords[batch]; j++)
+        isComplete = decoder.push(*in++);
+
+      if (!isComplete || decoder.size() != size ||
+          !std::equal(decoder.data(), decoder.data() + size,
+                      trace.data() + i))
+        errors++;
+      total += decoder.size();
+    }
+    u64 elapsed = Link::Host::hostCycles() - start;
+    sink = sink + total;
+    bestDecode = std::min(bestDecode, elapsed);
+    result.errors = errors;
+  }
+
+  result.messages = count;
+  for (u32 words : batchWords)
+    result.words += words;
+  result.encodeCycles = (double)bestEncode / (count * 2);
+  result.decodeCycles = (double)bestDecode / (count * 2);
+  return result;
+}
+
+u32 checkEncoder(const Trace& trace, u32 batchSize) {
+  // (the same batches, queued with `Encoder` and flushed through a fake link)
+  struct FakeLink {
+    BenchDecoder* decoder;
+    u32 batches = 0;
+    bool canSend() { return true; }
+    void send(u16 word) { batches += decoder->push(word); }
+  };
+
+  static BenchEncoder encoder;
+  static BenchDecoder decoder;
+  FakeLink link{&decoder};
+  u32 expectedBatches = 0;
+
+  encoder.clear();
+  for (u32 i = 0; i < trace.size(); i += batchSize) {
+    encoder.send(trace.data() + i, Link::_min(batchSize, trace.size() - i));
+    encoder.flush(&link);
+    expectedBatches++;
+  }
+  return link.batches != expectedBatches || decoder.didFail();
+}
+
+void printResult(const char* name, const Trace& trace, u32 batchSize) {
+  auto result = run(trace, batchSize);
+  result.errors += checkEncoder(trace, batchSize);
+
+  printf("%-10s %9u %9u %7.2f %10.2f %10.2f %7u\n", name, result.messages,
+         result.words, (double)result.messages / result.words,
+         result.encodeCycles, result.decodeCycles, result.errors);
+}
+
+int main(int argc, char* argv[]) {
+  u32 batchSize = atoi(Bench::option(argc, argv, "-s", "64"));
+  u32 frames = atoi(Bench::option(argc, argv, "-n", "300"));
+  const char* path = Bench::option(argc, argv, "-r", nullptr);
+
+  if (batchSize < 1 || batchSize > LinkCodec::MAX_BATCH_LIMIT || frames < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  Trace capture;
+  if (path && !loadTrace(path, capture)) {
+    fprintf(stderr, "Cannot read %s\n", path);
+    return 1;
+  }
+
+  printf("LinkCodec_bench (batch size %u, %u frames)\n", batchSize, frames);
+  printf("%-10s %9s %9s %7s %10s %10s %7s\n", "trace", "messages", "words",
+         "ratio", "enc/byte", "dec/byte", "errors");
+
+  printResult("tilemap", tilemapTrace(frames), batchSize);
+  printResult("tile diff", tileDiffTrace(frames), batchSize);
+  printResult("entities", entitiesTrace(frames), batchSize);
+  printResult("inputs", inputsTrace(frames), batchSize);
+  printResult("random", randomTrace(frames), batchSize);
+  if (path)
+    printResult("capture", capture, batchSize);
+
+  return 0;
+}
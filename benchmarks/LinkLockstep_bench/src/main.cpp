@@ -0,0 +1,208 @@
+// BENCHMARK:
+// This program runs a lockstep game loop on 2-4 simulated GBAs connected with
+// a Multi-Play bus (`LinkLockstep` on top of `LinkCable`), for a sweep of
+// input delays and `interval` values.
+// - On each VBlank, every node calls `update(input)`, where `input` is a
+//   pseudo-random value derived from its player ID and current frame.
+// - When a frame advances, every node checks the inputs of all players
+//   against the expected values (so a wrong or reordered input is an error).
+// - An input delay of `0` is the classic frame-locked exchange (send my
+//   keys, wait for everyone, advance).
+// Output:
+// - fps: Simulated frames per second (per node, the VBlank rate is ~59.73).
+// - stalls/100: Stalled `update(...)` calls every 100 simulated frames.
+// - longest: Longest run of consecutive stalls.
+// Usage:
+//   ./LinkLockstep_bench [-p players] [-d delays] [-i intervals] [-n frames]
+//                        [-b baudRate] [-f maxFrames]
+//   (e.g. ./LinkLockstep_bench -p 4 -d 0,1,2 -i 25,50)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkLockstep.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+
+using BenchLockstep = LinkLockstepT<LinkCable, LINK_CABLE_MAX_PLAYERS>;
+
+static constexpr u32 MAX_PLAYERS = LINK_CABLE_MAX_PLAYERS;
+
+struct Options {
+  u32 players;
+  u32 frames;
+  u32 baudRate;
+  u32 maxFrames;
+};
+
+struct Node {
+  Machine machine;
+  LinkCable* linkCable = nullptr;
+  BenchLockstep* lockstep = nullptr;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u32 stalls = 0;
+  u32 longestStall = 0;
+  u64 frames = 0;
+  u64 elapsedCycles = 0;
+};
+
+Node nodes[MAX_PLAYERS];
+
+u16 inputOf(u32 playerId, u32 frame) {
+  u32 x = (playerId + 1) * 0x9E3779B9 ^ frame * 0x85EBCA6B;
+  x ^= x >> 15;
+  x *= 0x2C1B3C6D;
+  x ^= x >> 12;
+  return x & LINK_LOCKSTEP_INPUT_MASK;
+}
+
+void tick(Node& node, u32 playerId, u8 delay, Result& result, Options& opts) {
+  auto lockstep = node.lockstep;
+
+  if (!lockstep->isActive()) {
+    // (start when everyone is connected)
+    node.linkCable->sync();
+    if (node.linkCable->playerCount() != opts.players)
+      return;
+    lockstep->activate();
+  }
+
+  // (the input is sampled at frame `F` and used at frame `F + delay`)
+  if (!lockstep->update(inputOf(playerId, lockstep->currentFrame())))
+    return;
+
+  u32 frame = lockstep->currentFrame() - 1;
+  for (u32 i = 0; i < lockstep->playerCount(); i++) {
+    u16 expected = frame >= (u32)delay ? inputOf(i, frame - delay) : 0;
+    if (lockstep->getInput(i) != expected)
+      result.errors++;
+  }
+}
+
+bool isDone(Options& opts) {
+  for (u32 i = 0; i < opts.players; i++) {
+    if (nodes[i].lockstep->currentFrame() < opts.frames)
+      return false;
+  }
+  return true;
+}
+
+Result run(u8 delay, u16 interval, Options& opts) {
+  Result result;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    node.machine.activate();
+    node.machine.reset();
+    node.linkCable =
+        new LinkCable(static_cast<LinkCable::BaudRate>(opts.baudRate),
+                      LINK_CABLE_DEFAULT_TIMEOUT, interval);
+    node.lockstep = new BenchLockstep(node.linkCable, delay);
+    node.linkCable->activate();
+    Link::IRQ::install();
+  }
+
+  MultiPlayBus bus;
+  for (u32 i = 0; i < opts.players; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = 0;
+  bool hasStarted = false;
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    for (u32 i = 0; i < opts.players; i++) {
+      auto& node = nodes[i];
+      if (!(node.machine._takeDispatchedIRQs() & Link::_IRQ_VBLANK))
+        continue;
+
+      node.machine.activate();
+      tick(node, i, delay, result, opts);
+      if (!hasStarted && node.lockstep->isActive()) {
+        startCycles = bus.cycles();
+        hasStarted = true;
+      }
+    }
+
+    if (hasStarted && isDone(opts)) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    result.frames += node.lockstep->currentFrame();
+    result.stalls += node.lockstep->getStallCount();
+    if (node.lockstep->getLongestStall() > result.longestStall)
+      result.longestStall = node.lockstep->getLongestStall();
+    if (node.lockstep->didDesync())
+      result.errors++;
+
+    node.machine.activate();
+    node.linkCable->deactivate();
+    delete node.lockstep;
+    delete node.linkCable;
+    node.lockstep = nullptr;
+    node.linkCable = nullptr;
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.players = atoi(Bench::option(argc, argv, "-p", "2"));
+  opts.frames = atoi(Bench::option(argc, argv, "-n", "600"));
+  opts.baudRate = atoi(Bench::option(argc, argv, "-b", "1"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "36000"));
+  auto delays = Bench::parseList(Bench::option(argc, argv, "-d", "0,1,2,3"));
+  auto intervals =
+      Bench::parseList(Bench::option(argc, argv, "-i", "25,50,100"));
+
+  if (opts.players < 2 || opts.players > MAX_PLAYERS || opts.baudRate > 3 ||
+      opts.frames < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  for (u32 delay : delays) {
+    if (delay > BenchLockstep::MAX_INPUT_DELAY) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+
+  printf("LinkLockstep_bench (%u players, %u frames, baud rate %u)\n",
+         opts.players, opts.frames, opts.baudRate);
+  printf("%8s %6s %8s %8s %12s %8s %7s\n", "interval", "delay", "status",
+         "fps", "stalls/100", "longest", "errors");
+
+  for (u32 interval : intervals) {
+    for (u32 delay : delays) {
+      auto result = run(delay, interval, opts);
+      double seconds = Bench::toSeconds(result.elapsedCycles);
+      double frames = (double)result.frames / opts.players;
+
+      printf("%8u %6u %8s %8.2f %12.1f %8u %7u\n", interval, delay,
+             result.completed ? "OK" : "TIMEOUT",
+             seconds > 0 ? frames / seconds : 0,
+             result.frames > 0 ? result.stalls * 100.0 / result.frames : 0,
+             result.longestStall, result.errors);
+    }
+  }
+
+  return 0;
+}
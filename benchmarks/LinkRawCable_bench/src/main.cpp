@@ -0,0 +1,251 @@
+// BENCHMARK:
+// This program pushes a block of words over `LinkRawCable` on 2-4 simulated
+// GBAs connected with a Multi-Play bus, in three different ways:
+// - vblank: `transferAsync(...)` + `getAsyncState()`, polled once per frame
+//   (like a game loop).
+// - loop: Like `vblank`, but polled after every interrupt (like a busy main
+//   loop, the best case for polling).
+// - block: `transferBlockAsync(...)`, chained by the SERIAL IRQ.
+// Every node sends its own sequence, and every response is checked against
+// the words that the other nodes sent.
+// Output:
+// - words/s: Exchanged words per second (per node).
+// - frames: Frames until all the nodes finished the block.
+// - errors: Wrong responses (or missing words, if it didn't finish).
+// - cyc/frm: Total *host* cycles spent in interrupt handlers per frame (per
+//   node).
+// Usage:
+//   ./LinkRawCable_bench [-p players] [-b baudRates] [-n words]
+//                        [-f maxFrames]
+//   (e.g. ./LinkRawCable_bench -p 4 -b 3 -n 8192)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkRawCable.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+
+using Response = LinkRawCable::Response;
+
+enum class Mode { VBLANK, LOOP, BLOCK };
+
+struct Options {
+  u32 players;
+  u32 words;
+  u32 maxFrames;
+};
+
+struct Node {
+  Machine machine;
+  LinkRawCable* linkRawCable = nullptr;
+  std::vector<u16> outgoing;
+  std::vector<Response> responses;
+  u32 index = 0;  // (polling modes)
+  bool isDone = false;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u64 elapsedCycles = 0;
+  double cyclesPerFrame = 0;
+};
+
+LinkRawCable* linkRawCable = nullptr;
+Node nodes[LINK_RAW_CABLE_MAX_PLAYERS];
+
+void onVBlank() {}  // (only wakes up the polling loops)
+template <u32 N>
+void onSerial() {
+  nodes[N].linkRawCable->_onSerial();
+}
+template <u32 N>
+void onBlockComplete(bool success) {
+  (void)success;  // (errors are counted at the end)
+  nodes[N].isDone = true;
+}
+
+static constexpr Link::Host::ISR SERIAL_ISRS[] = {onSerial<0>, onSerial<1>,
+                                                  onSerial<2>, onSerial<3>};
+static constexpr LinkRawCable::BlockCallback BLOCK_CALLBACKS[] = {
+    onBlockComplete<0>, onBlockComplete<1>, onBlockComplete<2>,
+    onBlockComplete<3>};
+
+u16 wordOf(u32 playerId, u32 index) {
+  // (the high bit is never set, so it can't be 0xFFFF)
+  return (index * 7 + playerId * 0x1000 + 1) & 0x7FFF;
+}
+
+// Polling
+
+void poll(Node& node, Options& opts) {
+  auto linkRawCable = node.linkRawCable;
+  if (node.isDone)
+    return;
+
+  auto state = linkRawCable->getAsyncState();
+  if (state == LinkRawCable::AsyncState::WAITING)
+    return;
+  if (state == LinkRawCable::AsyncState::READY) {
+    node.responses[node.index++] = linkRawCable->getAsyncData();
+    if (node.index == opts.words) {
+      node.isDone = true;
+      return;
+    }
+  }
+
+  linkRawCable->transferAsync(node.outgoing[node.index]);
+}
+
+// Runner
+
+Result run(Mode mode, u32 baudRate, Options& opts) {
+  Result result;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    node.machine.activate();
+    node.machine.reset();
+    node.machine.setISR(Link::_IRQ_VBLANK, onVBlank);
+    node.machine.setISR(Link::_IRQ_SERIAL, SERIAL_ISRS[i]);
+    node.linkRawCable = new LinkRawCable();
+    node.outgoing.resize(opts.words);
+    for (u32 j = 0; j < opts.words; j++)
+      node.outgoing[j] = wordOf(i, j);
+    node.responses.assign(opts.words, Response{});
+    node.index = 0;
+    node.isDone = false;
+    node.linkRawCable->activate((LinkRawCable::BaudRate)baudRate);
+  }
+
+  MultiPlayBus bus;
+  for (u32 i = 0; i < opts.players; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+  bus.step(bus.quantum);  // (lets the bus see that everyone is ready)
+
+  if (mode == Mode::BLOCK) {
+    // (slaves first, so their first word is loaded when the master starts)
+    for (int i = opts.players - 1; i >= 0; i--) {
+      auto& node = nodes[i];
+      node.machine.activate();
+      node.linkRawCable->transferBlockAsync(node.outgoing.data(),
+                                            node.responses.data(), opts.words,
+                                            BLOCK_CALLBACKS[i]);
+    }
+  }
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = bus.cycles();
+  for (u32 i = 0; i < opts.players; i++)
+    nodes[i].machine.resetStats();
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    // (slaves first, like above)
+    for (int i = opts.players - 1; i >= 0; i--) {
+      auto& node = nodes[i];
+      u16 irqs = node.machine._takeDispatchedIRQs();
+      if (mode == Mode::BLOCK)
+        continue;
+      if (mode == Mode::VBLANK ? !(irqs & Link::_IRQ_VBLANK) : irqs == 0)
+        continue;
+
+      node.machine.activate();
+      poll(node, opts);
+    }
+
+    bool isDone = true;
+    for (u32 i = 0; i < opts.players; i++) {
+      if (!nodes[i].isDone)
+        isDone = false;
+    }
+    if (isDone) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  double frames = (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME;
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    for (u32 j = 0; j < opts.words; j++) {
+      for (u32 k = 0; k < opts.players; k++) {
+        if (node.responses[j].data[k] != wordOf(k, j)) {
+          result.errors++;
+          break;
+        }
+      }
+    }
+
+    auto serial = node.machine.isrStats(Link::_IRQ_SERIAL);
+    auto vblank = node.machine.isrStats(Link::_IRQ_VBLANK);
+    if (frames > 0)
+      result.cyclesPerFrame +=
+          (serial.totalCycles + vblank.totalCycles) / frames / opts.players;
+
+    node.machine.activate();
+    node.linkRawCable->deactivate();
+    delete node.linkRawCable;
+    node.linkRawCable = nullptr;
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+void printResult(const char* name,
+                 u32 baudRate,
+                 Result& result,
+                 Options& opts) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  printf("%-7s %5u %8s %10.1f %9.1f %7u %8.0f\n", name, baudRate,
+         result.completed ? "OK" : "TIMEOUT",
+         seconds > 0 ? opts.words / seconds : 0,
+         (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME,
+         result.errors, result.cyclesPerFrame);
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.players = atoi(Bench::option(argc, argv, "-p", "2"));
+  opts.words = atoi(Bench::option(argc, argv, "-n", "1024"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "3600"));
+  auto baudRates = Bench::parseList(Bench::option(argc, argv, "-b", "1,3"));
+
+  if (opts.players < 2 || opts.players > LINK_RAW_CABLE_MAX_PLAYERS ||
+      opts.words < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  for (u32 baudRate : baudRates) {
+    if (baudRate > 3) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+
+  printf("LinkRawCable_bench (%u players, %u words)\n", opts.players,
+         opts.words);
+  printf("%-7s %5s %8s %10s %9s %7s %8s\n", "mode", "baud", "status",
+         "words/s", "frames", "errors", "cyc/frm");
+
+  for (u32 baudRate : baudRates) {
+    auto vblank = run(Mode::VBLANK, baudRate, opts);
+    printResult("vblank", baudRate, vblank, opts);
+
+    auto loop = run(Mode::LOOP, baudRate, opts);
+    printResult("loop", baudRate, loop, opts);
+
+    auto block = run(Mode::BLOCK, baudRate, opts);
+    printResult("block", baudRate, block, opts);
+  }
+
+  return 0;
+}
@@ -0,0 +1,559 @@
+// BENCHMARK:
+// This program runs common `LinkRawWireless` command sequences against a
+// simulated Wireless Adapter, in four different ways:
+// - sync: `sendCommand(...)` (or `activate()`).
+// - async: `sendCommandAsync(...)` (or `activateAsync()`), polled after every
+//   interrupt (like a busy main loop, the best case for polling).
+// - frame: Like `async`, but polled once per frame (like a game loop).
+// - queue: `queueCommand(...)`, with a callback for each command.
+// - spin: Like `async`, but with the ACKs polled inside the SERIAL handler
+//   (like `LinkWireless` does during sessions; only for `session`).
+// The sequences are:
+// - activate: Ping + login + HELLO (no `queue` run).
+// - host: Setup + Broadcast + StartHost.
+// - discovery: Setup + BroadcastReadStart + BroadcastReadPoll +
+//   BroadcastReadEnd.
+// - session: SendData + SignalLevel + ReceiveData + PollConnections +
+//   SlotStatus (data transfers interleaved with housekeeping commands).
+// The simulated adapter answers every command word, does its side of the
+// SO/SI handshake after a fixed latency, and counts protocol violations.
+// Before that, it checks that a command queued (from VBlank) while a sync
+// command runs is started when the sync command finishes.
+// Output:
+// - time(us): Time until the sequence finished.
+// - blocked(us): Time that the main loop was blocked inside the API.
+// - irqs: SERIAL + TIMER interrupts.
+// - cyc/irq: Average *host* cycles per interrupt.
+// - errors: Failed commands + protocol violations seen by the adapter.
+// Usage:
+//   ./LinkRawWireless_bench [-a ackLatency] [-s servers]
+//   (e.g. ./LinkRawWireless_bench -a 500 -s 5)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkRawWireless.hpp"
+
+using Bench::u8;
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Link::Host::Machine;
+
+static constexpr u16 TIMER_IRQ =
+    Link::_TIMER_IRQ_IDS[LINK_RAW_WIRELESS_DEFAULT_TIMER_ID];
+
+enum class Scenario { ACTIVATE, HOST, DISCOVERY, SESSION };
+enum class Api { SYNC, ASYNC, FRAME, QUEUE, SPIN };
+
+struct Options {
+  u32 ackLatency;
+  u32 servers;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u64 elapsedCycles = 0;
+  u64 blockedCycles = 0;
+  u32 irqs = 0;
+  double cyclesPerIRQ = 0;
+};
+
+// Adapter
+
+class WirelessAdapter : public Link::Host::Peripheral {
+ public:
+  u32 ackLatency = 0;
+  u32 servers = 0;
+  u32 errors = 0;
+
+  void reset() {
+    isTransferring = false;
+    remainingCycles = 0;
+    si = false;
+    ackPhase = AckPhase::NONE;
+    loginPackets = 0;
+    previousGBAData = 0xFFFF;
+    phase = Phase::IDLE;
+    outgoing = DATA_REQUEST;
+    errors = 0;
+  }
+
+  void step(Machine& machine, u32 cycles) override {
+    auto& siocnt = machine.reg16(REG_SIOCNT);
+    bool isMaster = siocnt & BIT_CLOCK;  // (clock inversion isn't simulated)
+
+    if (isMaster && (siocnt & BIT_START)) {
+      if (!isTransferring) {
+        if (ackPhase != AckPhase::NONE)
+          errors++;  // (a new word before the ACK finished)
+        isTransferring = true;
+        remainingCycles = 32 * (siocnt & BIT_CLOCK_SPEED ? 8 : 64);
+      }
+      if (remainingCycles > cycles) {
+        remainingCycles -= cycles;
+      } else {
+        isTransferring = false;
+        u32 received = machine.reg32(REG_SIODATA32);
+        machine.reg32(REG_SIODATA32) = exchange(received);
+        siocnt &= ~BIT_START;
+        if (siocnt & BIT_IRQ)
+          machine.raiseIRQ(Link::_IRQ_SERIAL);
+      }
+    }
+
+    bool isSOHigh = siocnt & BIT_SO;
+    if (ackPhase == AckPhase::RAISE && !isSOHigh) {
+      if (countdown(cycles)) {
+        si = true;
+        ackPhase = AckPhase::LOWER;
+        ackCycles = ackLatency;
+      }
+    } else if (ackPhase == AckPhase::LOWER && isSOHigh) {
+      if (countdown(cycles)) {
+        si = false;
+        ackPhase = AckPhase::NONE;
+      }
+    }
+
+    siocnt = (siocnt & ~BIT_SI) | (si ? BIT_SI : 0);
+  }
+
+ private:
+  static constexpr u32 REG_SIODATA32 = 0x0120;
+  static constexpr u32 REG_SIOCNT = 0x0128;
+  static constexpr u16 BIT_CLOCK = 1 << 0;
+  static constexpr u16 BIT_CLOCK_SPEED = 1 << 1;
+  static constexpr u16 BIT_SI = 1 << 2;
+  static constexpr u16 BIT_SO = 1 << 3;
+  static constexpr u16 BIT_START = 1 << 7;
+  static constexpr u16 BIT_IRQ = 1 << 14;
+  static constexpr u32 DATA_REQUEST = 0x80000000;
+  static constexpr u32 HEADER = 0x9966;
+
+  enum class AckPhase { NONE, RAISE, LOWER };
+  enum class Phase { IDLE, PARAMETERS, RESPONSE_REQUEST, RESPONSES };
+
+  bool isTransferring = false;
+  u32 remainingCycles = 0;
+  bool si = false;
+  AckPhase ackPhase = AckPhase::NONE;
+  u32 ackCycles = 0;
+  u32 loginPackets = 0;
+  u16 previousGBAData = 0xFFFF;
+  Phase phase = Phase::IDLE;
+  u32 outgoing = DATA_REQUEST;
+  u8 command = 0;
+  u32 parameters = 0;
+  u32 receivedParameters = 0;
+  std::vector<u32> responses;
+  u32 sentResponses = 0;
+
+  bool countdown(u32 cycles) {
+    if (ackCycles > cycles) {
+      ackCycles -= cycles;
+      return false;
+    }
+    return true;
+  }
+
+  u32 exchange(u32 received) {
+    if (loginPackets < LinkRawWireless::LOGIN_STEPS) {
+      // (echoes the GBA's data + the complement of its previous data)
+      u16 data = received & 0xFFFF;
+      u32 response = (data << 16) | (u16)~previousGBAData;
+      previousGBAData = data;
+      loginPackets++;
+      return response;
+    }
+
+    u32 response = outgoing;
+    receive(received);
+    ackPhase = AckPhase::RAISE;
+    ackCycles = ackLatency;
+    return response;
+  }
+
+  void receive(u32 word) {
+    switch (phase) {
+      case Phase::IDLE: {
+        if (word >> 16 != HEADER) {
+          errors++;
+          return;
+        }
+        command = word & 0xFF;
+        parameters = (word >> 8) & 0xFF;
+        receivedParameters = 0;
+        if (parameters == 0)
+          prepareResponses();
+        else
+          phase = Phase::PARAMETERS;
+        break;
+      }
+      case Phase::PARAMETERS: {
+        if (++receivedParameters == parameters)
+          prepareResponses();
+        break;
+      }
+      case Phase::RESPONSE_REQUEST:
+      case Phase::RESPONSES: {
+        if (word != DATA_REQUEST)
+          errors++;
+        if (sentResponses < responses.size()) {
+          phase = Phase::RESPONSES;
+          outgoing = responses[sentResponses++];
+        } else {
+          phase = Phase::IDLE;
+          outgoing = DATA_REQUEST;
+        }
+        break;
+      }
+    }
+  }
+
+  void prepareResponses() {
+    responses.clear();
+    sentResponses = 0;
+    u8 ack = command + LinkRawWireless::RESPONSE_ACK;
+
+    switch (command) {
+      case LinkRawWireless::COMMAND_HELLO:
+      case LinkRawWireless::COMMAND_SETUP:
+      case LinkRawWireless::COMMAND_BROADCAST:
+      case LinkRawWireless::COMMAND_START_HOST:
+      case LinkRawWireless::COMMAND_BROADCAST_READ_START:
+      case LinkRawWireless::COMMAND_BROADCAST_READ_END:
+      case LinkRawWireless::COMMAND_POLL_CONNECTIONS:
+      case LinkRawWireless::COMMAND_SEND_DATA:
+      case LinkRawWireless::COMMAND_RECEIVE_DATA:
+        break;
+      case LinkRawWireless::COMMAND_SIGNAL_LEVEL: {
+        responses.push_back(0x000000FF);  // (client 1)
+        break;
+      }
+      case LinkRawWireless::COMMAND_SLOT_STATUS: {
+        responses.push_back(0x01);  // (next client number)
+        break;
+      }
+      case LinkRawWireless::COMMAND_BROADCAST_READ_POLL: {
+        for (u32 i = 0; i < servers; i++) {
+          responses.push_back(0x1000 + i);  // (server id)
+          for (u32 j = 0; j < LINK_RAW_WIRELESS_BROADCAST_LENGTH; j++)
+            responses.push_back(0x41414141 + j);
+        }
+        break;
+      }
+      default: {
+        ack = 0xEE;  // (unknown command)
+        responses.push_back(2);
+      }
+    }
+
+    phase = Phase::RESPONSE_REQUEST;
+    outgoing = (HEADER << 16) | (responses.size() << 8) | ack;
+  }
+};
+
+// Runner
+
+LinkRawWireless* linkRawWireless = nullptr;
+Machine gba;
+WirelessAdapter adapter;
+
+bool spinAcks = false;
+
+void onSerial() {
+  if (spinAcks)
+    linkRawWireless->_onSerial(false, true);
+  else
+    LINK_RAW_WIRELESS_ISR_SERIAL();
+}
+void onTimer() {
+  LINK_RAW_WIRELESS_ISR_TIMER();
+}
+void onVBlank();
+
+struct Command {
+  u8 type;
+  std::vector<u32> params;
+  u32 expectedResponses;
+};
+
+std::vector<Command> commandsOf(Scenario scenario, Options& opts) {
+  switch (scenario) {
+    case Scenario::HOST:
+      return {{LinkRawWireless::COMMAND_SETUP, {0x003C0420}, 0},
+              {LinkRawWireless::COMMAND_BROADCAST, {1, 2, 3, 4, 5, 6}, 0},
+              {LinkRawWireless::COMMAND_START_HOST, {}, 0}};
+    case Scenario::DISCOVERY:
+      return {{LinkRawWireless::COMMAND_SETUP, {0x003C0420}, 0},
+              {LinkRawWireless::COMMAND_BROADCAST_READ_START, {}, 0},
+              {LinkRawWireless::COMMAND_BROADCAST_READ_POLL,
+               {},
+               opts.servers * LINK_RAW_WIRELESS_BROADCAST_RESPONSE_LENGTH},
+              {LinkRawWireless::COMMAND_BROADCAST_READ_END, {}, 0}};
+    case Scenario::SESSION:
+      return {{LinkRawWireless::COMMAND_SEND_DATA, {4, 0x12345678}, 0},
+              {LinkRawWireless::COMMAND_SIGNAL_LEVEL, {}, 1},
+              {LinkRawWireless::COMMAND_RECEIVE_DATA, {}, 0},
+              {LinkRawWireless::COMMAND_POLL_CONNECTIONS, {}, 0},
+              {LinkRawWireless::COMMAND_SLOT_STATUS, {}, 1}};
+    default:
+      return {};
+  }
+}
+
+// (`checkSyncThenQueue()` queues a command from VBlank while a sync one runs)
+bool queueOnVBlank = false;
+bool didQueuedCommandFinish = false;
+
+void onQueuedAfterSync(const LinkRawWireless::CommandResult& result) {
+  didQueuedCommandFinish = result.success;
+}
+
+void onVBlank() {  // (otherwise, only wakes up the game loop)
+  if (!queueOnVBlank ||
+      linkRawWireless->getAsyncState() == LinkRawWireless::AsyncState::IDLE)
+    return;
+
+  if (linkRawWireless->queueCommand(LinkRawWireless::COMMAND_SIGNAL_LEVEL, {},
+                                    0, onQueuedAfterSync, true))
+    queueOnVBlank = false;
+}
+
+u32 check(const LinkRawWireless::CommandResult& result,
+          const Command* command) {
+  if (!result.success)
+    return 1;
+  if (command && result.dataSize != command->expectedResponses)
+    return 1;
+  return 0;
+}
+
+std::vector<Command>* queuedCommands = nullptr;
+u32 completedCommands = 0;
+u32 queueErrors = 0;
+
+void onCommandComplete(const LinkRawWireless::CommandResult& result) {
+  queueErrors += check(result, &(*queuedCommands)[completedCommands]);
+  completedCommands++;
+}
+
+Result run(Scenario scenario, Api api, Options& opts) {
+  Result result;
+
+  gba.activate();
+  gba.reset();
+  adapter.reset();
+  adapter.ackLatency = opts.ackLatency;
+  adapter.servers = opts.servers;
+  gba.setPeripheral(&adapter);
+  gba.setISR(Link::_IRQ_SERIAL, onSerial);
+  gba.setISR(TIMER_IRQ, onTimer);
+  gba.setISR(Link::_IRQ_VBLANK, onVBlank);
+  linkRawWireless = new LinkRawWireless();
+
+  if (scenario != Scenario::ACTIVATE) {
+    if (!linkRawWireless->activate())
+      result.errors++;
+  }
+  spinAcks = api == Api::SPIN;
+  if (spinAcks) {
+    // (the ACKs are only spun during sessions)
+    auto hostCommands = commandsOf(Scenario::HOST, opts);
+    hostCommands.pop_back();
+    for (auto& command : hostCommands)
+      result.errors += check(linkRawWireless->sendCommand(
+                                 command.type, command.params.data(),
+                                 command.params.size()),
+                             &command);
+    result.errors += !linkRawWireless->startHost();
+  }
+
+  auto commands = commandsOf(scenario, opts);
+  u32 errors = 0;
+  u64 startCycles = gba.cycles();
+  gba.resetStats();
+
+  if (api == Api::SYNC) {
+    if (scenario == Scenario::ACTIVATE) {
+      errors += !linkRawWireless->activate();
+    } else {
+      for (auto& command : commands) {
+        auto commandResult = linkRawWireless->sendCommand(
+            command.type, command.params.data(), command.params.size());
+        errors += check(commandResult, &command);
+      }
+    }
+    result.completed = true;
+    result.blockedCycles = gba.cycles() - startCycles;
+  } else if (api == Api::QUEUE) {
+    queuedCommands = &commands;
+    completedCommands = queueErrors = 0;
+    u32 next = 0;
+    auto refill = [&]() {
+      u64 callStart = gba.cycles();
+      while (next < commands.size()) {
+        auto& command = commands[next];
+        if (!linkRawWireless->queueCommand(command.type, command.params.data(),
+                                           command.params.size(),
+                                           onCommandComplete))
+          break;
+        next++;
+      }
+      result.blockedCycles += gba.cycles() - callStart;
+    };
+
+    refill();
+    u64 maxCycles = startCycles + 60 * Link::Host::CYCLES_PER_FRAME;
+    while (gba.cycles() < maxCycles) {
+      gba.step(Link::Host::NormalBus::DEFAULT_QUANTUM);
+      if (completedCommands == commands.size()) {
+        result.completed = true;
+        break;
+      }
+      refill();
+    }
+    errors += queueErrors;
+  } else {
+    u32 next = 0;
+    auto start = [&]() {
+      u64 callStart = gba.cycles();
+      if (scenario == Scenario::ACTIVATE) {
+        linkRawWireless->activateAsync();
+      } else {
+        auto& command = commands[next];
+        linkRawWireless->sendCommandAsync(
+            command.type, command.params.data(), command.params.size());
+      }
+      result.blockedCycles += gba.cycles() - callStart;
+    };
+
+    start();
+    u64 maxCycles = startCycles + 60 * Link::Host::CYCLES_PER_FRAME;
+    while (gba.cycles() < maxCycles) {
+      gba.step(Link::Host::NormalBus::DEFAULT_QUANTUM);
+      u16 irqs = gba._takeDispatchedIRQs();
+      if (api == Api::FRAME && !(irqs & Link::_IRQ_VBLANK))
+        continue;
+      if (linkRawWireless->getAsyncState() !=
+          LinkRawWireless::AsyncState::READY)
+        continue;
+
+      auto commandResult = linkRawWireless->getAsyncCommandResult();
+      errors += check(commandResult, scenario == Scenario::ACTIVATE
+                                         ? nullptr
+                                         : &commands[next]);
+      next++;
+      if (next >= commands.size()) {
+        result.completed = true;
+        break;
+      }
+      start();
+    }
+  }
+
+  result.elapsedCycles = gba.cycles() - startCycles;
+  result.errors += errors + adapter.errors;
+  auto serial = gba.isrStats(Link::_IRQ_SERIAL);
+  auto timer = gba.isrStats(TIMER_IRQ);
+  result.irqs = serial.calls + timer.calls;
+  if (result.irqs > 0)
+    result.cyclesPerIRQ =
+        (double)(serial.totalCycles + timer.totalCycles) / result.irqs;
+
+  spinAcks = false;
+  linkRawWireless->deactivate();
+  delete linkRawWireless;
+  linkRawWireless = nullptr;
+
+  return result;
+}
+
+bool checkSyncThenQueue(Options& opts) {
+  gba.activate();
+  gba.reset();
+  adapter.reset();
+  adapter.ackLatency = opts.ackLatency;
+  adapter.servers = opts.servers;
+  gba.setPeripheral(&adapter);
+  gba.setISR(Link::_IRQ_SERIAL, onSerial);
+  gba.setISR(TIMER_IRQ, onTimer);
+  gba.setISR(Link::_IRQ_VBLANK, onVBlank);
+  linkRawWireless = new LinkRawWireless();
+  bool passed = linkRawWireless->activate();
+
+  // (sync commands until a VBlank interrupts one of them)
+  queueOnVBlank = true;
+  didQueuedCommandFinish = false;
+  for (u32 i = 0; passed && queueOnVBlank && i < 10000; i++)
+    passed = linkRawWireless->sendCommand(LinkRawWireless::COMMAND_SLOT_STATUS)
+                 .success;
+  passed = passed && !queueOnVBlank;
+
+  // (the queued command must start once the sync one finishes)
+  u64 maxCycles = gba.cycles() + 10 * Link::Host::CYCLES_PER_FRAME;
+  while (passed && !didQueuedCommandFinish && gba.cycles() < maxCycles)
+    gba.step(Link::Host::NormalBus::DEFAULT_QUANTUM);
+  passed = passed && didQueuedCommandFinish && adapter.errors == 0;
+
+  queueOnVBlank = false;
+  linkRawWireless->deactivate();
+  delete linkRawWireless;
+  linkRawWireless = nullptr;
+
+  return passed;
+}
+
+void printResult(const char* name, const char* api, Result& result) {
+  double us = Bench::toSeconds(result.elapsedCycles) * 1000000;
+  double blockedUs = Bench::toSeconds(result.blockedCycles) * 1000000;
+  printf("%-10s %-6s %8s %9.0f %12.0f %6u %8.0f %7u\n", name, api,
+         result.completed ? "OK" : "TIMEOUT", us, blockedUs, result.irqs,
+         result.cyclesPerIRQ, result.errors);
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.ackLatency = atoi(Bench::option(argc, argv, "-a", "100"));
+  opts.servers = atoi(Bench::option(argc, argv, "-s", "2"));
+
+  if (opts.servers > LINK_RAW_WIRELESS_MAX_SERVERS) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+
+  printf("LinkRawWireless_bench (ACK latency: %u cycles, %u servers)\n",
+         opts.ackLatency, opts.servers);
+  bool passed = checkSyncThenQueue(opts);
+  printf("queued during a sync command: %s\n\n", passed ? "OK" : "FAILED");
+
+  printf("%-10s %-6s %8s %9s %12s %6s %8s %7s\n", "scenario", "api",
+         "status", "time(us)", "blocked(us)", "irqs", "cyc/irq", "errors");
+
+  static const char* NAMES[] = {"activate", "host", "discovery", "session"};
+  for (u32 i = 0; i < 4; i++) {
+    auto scenario = (Scenario)i;
+
+    auto sync = run(scenario, Api::SYNC, opts);
+    printResult(NAMES[i], "sync", sync);
+
+    auto async = run(scenario, Api::ASYNC, opts);
+    printResult(NAMES[i], "async", async);
+
+    auto frame = run(scenario, Api::FRAME, opts);
+    printResult(NAMES[i], "frame", frame);
+
+    if (scenario != Scenario::ACTIVATE) {
+      auto queue = run(scenario, Api::QUEUE, opts);
+      printResult(NAMES[i], "queue", queue);
+    }
+
+    if (scenario == Scenario::SESSION) {
+      auto spin = run(scenario, Api::SPIN, opts);
+      printResult(NAMES[i], "spin", spin);
+    }
+  }
+
+  return passed ? 0 : 1;
+}
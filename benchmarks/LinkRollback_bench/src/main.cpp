@@ -0,0 +1,329 @@
+// BENCHMARK:
+// This program compares `LinkRollback` against `LinkLockstep` on 2-4
+// simulated GBAs connected with a Multi-Play bus (both on top of
+// `LinkCable`), for a sweep of input delays.
+// - On each VBlank, every node calls `update(input)`, where `input` is a
+//   pseudo-random value derived from its player ID and current frame, held
+//   for a few frames (like real button presses).
+// - The game state is a hash of all the inputs. With rollback, nodes save
+//   their state on every frame and simulate again after mispredictions.
+// - At the end, all the states up to the confirmed frame are checked against
+//   a reference simulation (so any wrong input is an error).
+// Output:
+// - fps: Simulated frames per second (per node, the VBlank rate is ~59.73).
+// - stalls/100: Stalled `update(...)` calls every 100 simulated frames.
+// - rb/100: Rollbacks every 100 simulated frames.
+// - resim/frm: Average frames simulated again per frame.
+// - longest: Longest rollback, in frames.
+// Usage:
+//   ./LinkRollback_bench [-p players] [-d delays] [-m maxRollback]
+//                        [-h holdFrames] [-i interval] [-n frames]
+//   (e.g. ./LinkRollback_bench -p 4 -d 0,1 -m 7 -h 4)
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkLockstep.hpp"
+#include "../../../lib/LinkRollback.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+using Link::Host::Machine;
+using Link::Host::MultiPlayBus;
+
+using BenchLockstep = LinkLockstepT<LinkCable, LINK_CABLE_MAX_PLAYERS>;
+using BenchRollback = LinkRollbackT<LinkCable, LINK_CABLE_MAX_PLAYERS>;
+
+static constexpr u32 MAX_PLAYERS = LINK_CABLE_MAX_PLAYERS;
+static constexpr u32 MAX_FRAMES = 10000;
+
+enum class Mode { LOCKSTEP, ROLLBACK };
+
+struct Options {
+  u32 players;
+  u32 frames;
+  u32 hold;
+  u8 maxRollback;
+  u16 interval;
+  u32 maxFrames;
+};
+
+struct Node {
+  Machine machine;
+  LinkCable* linkCable = nullptr;
+  BenchLockstep* lockstep = nullptr;
+  BenchRollback* rollback = nullptr;
+  LinkRollbackStates<u32>* states = nullptr;
+  u32 game = 0;
+  u32 history[MAX_FRAMES];  // (state after each frame)
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u32 stalls = 0;
+  u32 rollbacks = 0;
+  u64 resimulatedFrames = 0;
+  u32 longestRollback = 0;
+  u64 frames = 0;
+  u64 elapsedCycles = 0;
+};
+
+Node nodes[MAX_PLAYERS];
+
+// Game
+
+u16 inputOf(u32 playerId, u32 frame, Options& opts) {
+  u32 x = (playerId + 1) * 0x9E3779B9 ^ (frame / opts.hold) * 0x85EBCA6B;
+  x ^= x >> 15;
+  x *= 0x2C1B3C6D;
+  x ^= x >> 12;
+  return x & LINK_LOCKSTEP_INPUT_MASK;
+}
+
+u16 expectedInput(u32 playerId, u32 frame, u8 delay, Options& opts) {
+  return frame >= delay ? inputOf(playerId, frame - delay, opts) : 0;
+}
+
+template <typename F>
+u32 simulate(u32 game, u32 players, F getInput) {
+  for (u32 i = 0; i < players; i++)
+    game = (game ^ (getInput(i) + 1) * (i + 1)) * 0x01000193;
+  return game;
+}
+
+// Runner
+
+template <typename T>
+bool start(Node& node, T* sync, Options& opts) {
+  if (sync->isActive())
+    return true;
+
+  // (start when everyone is connected)
+  node.linkCable->sync();
+  if (node.linkCable->playerCount() != opts.players)
+    return false;
+  node.game = 0;
+  return sync->activate();
+}
+
+void tickLockstep(Node& node, u32 playerId, Options& opts) {
+  auto lockstep = node.lockstep;
+  if (!start(node, lockstep, opts))
+    return;
+
+  u16 input = inputOf(playerId, lockstep->currentFrame(), opts);
+  if (!lockstep->update(input))
+    return;
+
+  u32 frame = lockstep->currentFrame() - 1;
+  node.game = simulate(node.game, lockstep->playerCount(),
+                       [&](u8 i) { return lockstep->getInput(i); });
+  if (frame < MAX_FRAMES)
+    node.history[frame] = node.game;
+}
+
+void tickRollback(Node& node, u32 playerId, Result& result, Options& opts) {
+  auto rollback = node.rollback;
+  if (!start(node, rollback, opts))
+    return;
+
+  u16 input = inputOf(playerId, rollback->currentFrame(), opts);
+  if (!rollback->update(input))
+    return;
+
+  u32 frame = rollback->currentFrame() - 1;
+  if (rollback->needsRollback()) {
+    u32 from = rollback->getRollbackFrame();
+    node.game = *node.states->load(from);
+    for (u32 f = from; f < frame; f++) {
+      *node.states->save(f) = node.game;
+      node.game = simulate(node.game, rollback->playerCount(),
+                           [&](u8 i) { return rollback->getInput(i, f); });
+      if (f < MAX_FRAMES)
+        node.history[f] = node.game;
+    }
+    result.resimulatedFrames += frame - from;
+  }
+
+  *node.states->save(frame) = node.game;
+  node.game = simulate(node.game, rollback->playerCount(),
+                       [&](u8 i) { return rollback->getInput(i, frame); });
+  if (frame < MAX_FRAMES)
+    node.history[frame] = node.game;
+}
+
+u32 currentFrame(Node& node, Mode mode) {
+  return mode == Mode::LOCKSTEP ? node.lockstep->currentFrame()
+                                : node.rollback->currentFrame();
+}
+
+u32 checkHistory(Mode mode, u8 delay, Options& opts) {
+  // (only confirmed frames are final)
+  u32 lastFrame = opts.frames;
+  for (u32 i = 0; i < opts.players; i++) {
+    u32 confirmedFrame = mode == Mode::LOCKSTEP
+                             ? nodes[i].lockstep->currentFrame()
+                             : nodes[i].rollback->getConfirmedFrame();
+    if (confirmedFrame < lastFrame)
+      lastFrame = confirmedFrame;
+  }
+
+  u32 errors = 0;
+  u32 game = 0;
+  for (u32 frame = 0; frame < lastFrame; frame++) {
+    game = simulate(game, opts.players, [&](u8 i) {
+      return expectedInput(i, frame, delay, opts);
+    });
+    for (u32 i = 0; i < opts.players; i++) {
+      if (nodes[i].history[frame] != game)
+        errors++;
+    }
+  }
+  return errors;
+}
+
+Result run(Mode mode, u8 delay, Options& opts) {
+  Result result;
+
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    node.machine.activate();
+    node.machine.reset();
+    node.linkCable =
+        new LinkCable(LinkCable::BaudRate::BAUD_RATE_1,
+                      LINK_CABLE_DEFAULT_TIMEOUT, opts.interval);
+    node.lockstep = new BenchLockstep(node.linkCable, delay);
+    node.rollback = new BenchRollback(node.linkCable, delay, opts.maxRollback);
+    node.states = new LinkRollbackStates<u32>();
+    node.linkCable->activate();
+    Link::IRQ::install();
+  }
+
+  MultiPlayBus bus;
+  for (u32 i = 0; i < opts.players; i++)
+    bus.connect(i, &nodes[i].machine);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = 0;
+  bool hasStarted = false;
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    for (u32 i = 0; i < opts.players; i++) {
+      auto& node = nodes[i];
+      if (!(node.machine._takeDispatchedIRQs() & Link::_IRQ_VBLANK))
+        continue;
+
+      node.machine.activate();
+      if (mode == Mode::LOCKSTEP)
+        tickLockstep(node, i, opts);
+      else
+        tickRollback(node, i, result, opts);
+
+      if (!hasStarted &&
+          (node.lockstep->isActive() || node.rollback->isActive())) {
+        startCycles = bus.cycles();
+        hasStarted = true;
+      }
+    }
+
+    bool isDone = hasStarted;
+    for (u32 i = 0; i < opts.players; i++) {
+      if (currentFrame(nodes[i], mode) < opts.frames)
+        isDone = false;
+    }
+    if (isDone) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  result.errors = checkHistory(mode, delay, opts);
+  for (u32 i = 0; i < opts.players; i++) {
+    auto& node = nodes[i];
+    result.frames += currentFrame(node, mode);
+    if (mode == Mode::LOCKSTEP) {
+      result.stalls += node.lockstep->getStallCount();
+      if (node.lockstep->didDesync())
+        result.errors++;
+    } else {
+      result.stalls += node.rollback->getStallCount();
+      result.rollbacks += node.rollback->getRollbackCount();
+      if (node.rollback->getLongestRollback() > result.longestRollback)
+        result.longestRollback = node.rollback->getLongestRollback();
+      if (node.rollback->didDesync())
+        result.errors++;
+    }
+
+    node.machine.activate();
+    node.linkCable->deactivate();
+    delete node.states;
+    delete node.rollback;
+    delete node.lockstep;
+    delete node.linkCable;
+    node.states = nullptr;
+    node.rollback = nullptr;
+    node.lockstep = nullptr;
+    node.linkCable = nullptr;
+  }
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+void printResult(const char* name, u8 delay, Result& result, Options& opts) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  double frames = (double)result.frames / opts.players;
+  double perFrame = result.frames > 0 ? 100.0 / result.frames : 0;
+
+  printf("%-9s %6u %8s %8.2f %11.1f %7.1f %10.2f %8u %7u\n", name, delay,
+         result.completed ? "OK" : "TIMEOUT",
+         seconds > 0 ? frames / seconds : 0, result.stalls * perFrame,
+         result.rollbacks * perFrame,
+         result.resimulatedFrames * perFrame / 100, result.longestRollback,
+         result.errors);
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.players = atoi(Bench::option(argc, argv, "-p", "2"));
+  opts.frames = atoi(Bench::option(argc, argv, "-n", "600"));
+  opts.hold = atoi(Bench::option(argc, argv, "-h", "8"));
+  opts.maxRollback = atoi(Bench::option(argc, argv, "-m", "7"));
+  opts.interval = atoi(Bench::option(argc, argv, "-i", "50"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "36000"));
+  auto delays = Bench::parseList(Bench::option(argc, argv, "-d", "0,1,2"));
+
+  if (opts.players < 2 || opts.players > MAX_PLAYERS || opts.hold < 1 ||
+      opts.frames < 1 || opts.frames > MAX_FRAMES) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  for (u32 delay : delays) {
+    if (delay + opts.maxRollback > BenchRollback::MAX_WINDOW) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+
+  printf("LinkRollback_bench (%u players, %u frames, interval %u, hold %u)\n",
+         opts.players, opts.frames, opts.interval, opts.hold);
+  printf("%-9s %6s %8s %8s %11s %7s %10s %8s %7s\n", "mode", "delay",
+         "status", "fps", "stalls/100", "rb/100", "resim/frm", "longest",
+         "errors");
+
+  for (u32 delay : delays) {
+    auto lockstep = run(Mode::LOCKSTEP, delay, opts);
+    printResult("lockstep", delay, lockstep, opts);
+
+    auto rollback = run(Mode::ROLLBACK, delay, opts);
+    printResult("rollback", delay, rollback, opts);
+  }
+
+  return 0;
+}
@@ -0,0 +1,326 @@
+// BENCHMARK:
+// This program pushes a block of words from a master to a slave over `LinkSPI`
+// on 2 simulated GBAs connected with a `NormalBus`, in three different ways:
+// - vblank: `transferAsync(...)` + `getAsyncState()`, polled once per frame
+//   (like a game loop).
+// - loop: Like `vblank`, but polled after every interrupt (like a busy main
+//   loop, the best case for polling).
+// - stream: `startStream()` + `send(...)` / `read()`, refilled once per frame.
+// The slave runs in one of these ways:
+// - isr: `transferAsync(...)`, re-armed from its SERIAL handler (the best case
+//   for a single pre-loaded word).
+// - vblank: `transferAsync(...)`, re-armed from its game loop.
+// - stream: `startStream()` + `send(...)` / `read()`, refilled once per frame.
+// Both ends check every received word.
+// Output:
+// - KB/s: Exchanged kilobytes per second (per direction).
+// - frames: Frames until the master received the whole block.
+// - stalls: Times the stream had to wait (see `getStreamStats()`).
+// - errors: Wrong received words (or missing words, if it didn't finish).
+// - cyc/frm: Total *host* cycles spent in interrupt handlers per frame
+//   (master).
+// Usage:
+//   ./LinkSPI_bench [-s speeds] [-l slaveModes] [-w waitMode] [-n words]
+//                   [-f maxFrames]
+//   (e.g. ./LinkSPI_bench -s 1 -l 0,1,2 -w 1 -n 65536)
+
+// (enough room for a whole frame of words at 2Mbps)
+#define LINK_SPI_STREAM_QUEUE_SIZE 1024
+
+#include "../../_lib/bench.h"
+
+#include "../../../lib/LinkSPI.hpp"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Link::Host::Machine;
+using Link::Host::NormalBus;
+
+static constexpr u16 STREAM_TIMER_IRQ =
+    Link::_TIMER_IRQ_IDS[LINK_SPI_DEFAULT_STREAM_TIMER_ID];
+
+enum class Mode { VBLANK, LOOP, STREAM };
+enum class SlaveMode { ISR, VBLANK, STREAM };
+
+struct Options {
+  u32 waitMode;
+  u32 words;
+  u32 maxFrames;
+};
+
+struct Result {
+  bool completed = false;
+  u32 errors = 0;
+  u32 stalls = 0;
+  u32 received = 0;
+  u64 elapsedCycles = 0;
+  double cyclesPerFrame = 0;
+};
+
+LinkSPIStream* linkSPIStream = nullptr;
+Machine master, slave;
+LinkSPIStream* masterSPI = nullptr;
+LinkSPIStream* slaveSPI = nullptr;
+
+u32 sentWords = 0;      // (master)
+u32 receivedWords = 0;  // (master)
+u32 slaveWords = 0;
+u32 slaveSentWords = 0;
+SlaveMode slaveMode = SlaveMode::ISR;
+u32 totalWords = 0;
+u32 errors = 0;
+
+u32 masterWordOf(u32 index) {
+  return index * 0x9E3779B1;
+}
+u32 slaveWordOf(u32 index) {
+  return ~(index * 0x9E3779B1);
+}
+
+void check(u32 data, u32 expected) {
+  if (data != expected)
+    errors++;
+}
+
+void onVBlank() {}  // (only wakes up the game loop)
+void onMasterSerial() {
+  masterSPI->_onSerial();
+}
+void onMasterTimer() {
+  masterSPI->_onTimer();
+}
+void onSlaveSerial() {
+  slaveSPI->_onSerial();
+}
+void onSlaveSerialRearm() {
+  slaveSPI->_onSerial();
+  check(slaveSPI->getAsyncData(), masterWordOf(slaveWords));
+  slaveWords++;
+  slaveSPI->transferAsync(slaveWordOf(++slaveSentWords));
+}
+
+// Master
+
+void poll(Options& opts) {
+  auto state = masterSPI->getAsyncState();
+  if (state == LinkSPIStream::AsyncState::WAITING)
+    return;
+  if (state == LinkSPIStream::AsyncState::READY) {
+    check(masterSPI->getAsyncData(), slaveWordOf(receivedWords));
+    receivedWords++;
+  }
+
+  if (sentWords < opts.words)
+    masterSPI->transferAsync(masterWordOf(sentWords++));
+}
+
+void refill(Options& opts) {
+  while (masterSPI->canRead()) {
+    check(masterSPI->read(), slaveWordOf(receivedWords));
+    receivedWords++;
+  }
+
+  while (sentWords < opts.words && masterSPI->canSend())
+    masterSPI->send(masterWordOf(sentWords++));
+}
+
+// Slave
+
+void slavePoll() {
+  auto state = slaveSPI->getAsyncState();
+  if (state == LinkSPIStream::AsyncState::WAITING)
+    return;
+  if (state == LinkSPIStream::AsyncState::READY) {
+    check(slaveSPI->getAsyncData(), masterWordOf(slaveWords));
+    slaveWords++;
+    slaveSentWords++;
+  }
+
+  slaveSPI->transferAsync(slaveWordOf(slaveSentWords));
+}
+
+void slaveRefill() {
+  while (slaveSPI->canRead()) {
+    check(slaveSPI->read(), masterWordOf(slaveWords));
+    slaveWords++;
+  }
+
+  while (slaveSentWords < totalWords && slaveSPI->canSend())
+    slaveSPI->send(slaveWordOf(slaveSentWords++));
+}
+
+// (the slave's game loop runs on its VBlank handler, so it doesn't depend on
+// how the master's loop is scheduled)
+void onSlaveVBlank() {
+  if (slaveMode == SlaveMode::STREAM)
+    slaveRefill();
+  else if (slaveMode == SlaveMode::VBLANK)
+    slavePoll();
+}
+
+// Runner
+
+Result run(Mode mode, LinkSPIStream::Mode speed, Options& opts) {
+  Result result;
+  sentWords = receivedWords = slaveWords = slaveSentWords = errors = 0;
+  totalWords = opts.words;
+
+  slave.activate();
+  slave.reset();
+  slave.setISR(Link::_IRQ_VBLANK, onSlaveVBlank);
+  slave.setISR(Link::_IRQ_SERIAL, slaveMode == SlaveMode::ISR
+                                      ? onSlaveSerialRearm
+                                      : onSlaveSerial);
+  slaveSPI = new LinkSPIStream();
+  slaveSPI->activate(LinkSPIStream::Mode::SLAVE);
+  if (slaveMode == SlaveMode::STREAM)
+    slaveSPI->startStream();
+  if (slaveMode == SlaveMode::ISR)
+    slaveSPI->transferAsync(slaveWordOf(0));
+  else
+    onSlaveVBlank();
+
+  master.activate();
+  master.reset();
+  master.setISR(Link::_IRQ_VBLANK, onVBlank);
+  master.setISR(Link::_IRQ_SERIAL, onMasterSerial);
+  master.setISR(STREAM_TIMER_IRQ, onMasterTimer);
+  masterSPI = new LinkSPIStream();
+  masterSPI->activate(speed);
+  masterSPI->setWaitModeActive(opts.waitMode);
+  if (mode == Mode::STREAM)
+    masterSPI->startStream();
+
+  NormalBus bus;
+  bus.connect(0, &master);
+  bus.connect(1, &slave);
+  bus.install();
+
+  u64 maxCycles = (u64)opts.maxFrames * Link::Host::CYCLES_PER_FRAME;
+  u64 startCycles = bus.cycles();
+  master.resetStats();
+
+  // (everything starts right away)
+  if (mode == Mode::STREAM)
+    refill(opts);
+  else
+    poll(opts);
+
+  while (bus.cycles() < maxCycles) {
+    bus.step(bus.quantum);
+
+    u16 irqs = master._takeDispatchedIRQs();
+    (void)slave._takeDispatchedIRQs();
+    // (the stream ends with the last transfer, not with the next refill)
+    bool isStreamDone = mode == Mode::STREAM &&
+                        masterSPI->getStreamStats().words == opts.words;
+    if (mode == Mode::LOOP ? irqs == 0
+                           : !(irqs & Link::_IRQ_VBLANK) && !isStreamDone)
+      continue;
+
+    master.activate();
+    if (mode == Mode::STREAM)
+      refill(opts);
+    else
+      poll(opts);
+
+    if (receivedWords == opts.words) {
+      result.completed = true;
+      break;
+    }
+  }
+
+  result.elapsedCycles = bus.cycles() - startCycles;
+  slave.activate();
+  onSlaveVBlank();  // (reads the remaining words)
+  result.received = receivedWords;
+  result.errors = errors + (opts.words - receivedWords) +
+                  (opts.words - std::min(slaveWords, opts.words));
+  result.stalls = masterSPI->getStreamStats().stalls;
+
+  double frames = (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME;
+  u64 total = master.isrStats(Link::_IRQ_VBLANK).totalCycles +
+              master.isrStats(Link::_IRQ_SERIAL).totalCycles +
+              master.isrStats(STREAM_TIMER_IRQ).totalCycles;
+  if (frames > 0)
+    result.cyclesPerFrame = total / frames;
+
+  master.activate();
+  masterSPI->deactivate();
+  delete masterSPI;
+  slave.activate();
+  slaveSPI->deactivate();
+  delete slaveSPI;
+  Link::Host::setClockDriver(nullptr);
+
+  return result;
+}
+
+void printResult(const char* name,
+                 const char* slaveName,
+                 const char* speed,
+                 Result& result) {
+  double seconds = Bench::toSeconds(result.elapsedCycles);
+  double bytes = (double)result.received * 4;
+  printf("%-7s %-7s %-6s %8s %9.1f %8.1f %7u %7u %8.0f\n", name, slaveName,
+         speed,
+         result.completed ? "OK" : "TIMEOUT",
+         seconds > 0 ? bytes / seconds / 1024 : 0,
+         (double)result.elapsedCycles / Link::Host::CYCLES_PER_FRAME,
+         result.stalls, result.errors, result.cyclesPerFrame);
+}
+
+int main(int argc, char* argv[]) {
+  Options opts;
+  opts.waitMode = atoi(Bench::option(argc, argv, "-w", "0"));
+  opts.words = atoi(Bench::option(argc, argv, "-n", "1024"));
+  opts.maxFrames = atoi(Bench::option(argc, argv, "-f", "3600"));
+  auto speeds = Bench::parseList(Bench::option(argc, argv, "-s", "0,1"));
+  auto slaveModes = Bench::parseList(Bench::option(argc, argv, "-l", "0"));
+
+  if (opts.words < 1) {
+    fprintf(stderr, "Invalid arguments\n");
+    return 1;
+  }
+  for (u32 speed : speeds) {
+    if (speed > 1) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+  for (u32 slaveModeId : slaveModes) {
+    if (slaveModeId > 2) {
+      fprintf(stderr, "Invalid arguments\n");
+      return 1;
+    }
+  }
+
+  printf("LinkSPI_bench (%u words, waitMode: %u)\n", opts.words,
+         opts.waitMode);
+  printf("%-7s %-7s %-6s %8s %9s %8s %7s %7s %8s\n", "mode", "slave",
+         "speed", "status", "KB/s", "frames", "stalls", "errors", "cyc/frm");
+
+  static const char* SLAVE_NAMES[] = {"isr", "vblank", "stream"};
+  for (u32 speed : speeds) {
+    auto mode = speed == 0 ? LinkSPIStream::Mode::MASTER_256KBPS
+                           : LinkSPIStream::Mode::MASTER_2MBPS;
+    auto name = speed == 0 ? "256K" : "2M";
+
+    for (u32 slaveModeId : slaveModes) {
+      slaveMode = (SlaveMode)slaveModeId;
+      auto slaveName = SLAVE_NAMES[slaveModeId];
+
+      auto vblank = run(Mode::VBLANK, mode, opts);
+      printResult("vblank", slaveName, name, vblank);
+
+      auto loop = run(Mode::LOOP, mode, opts);
+      printResult("loop", slaveName, name, loop);
+
+      auto stream = run(Mode::STREAM, mode, opts);
+      printResult("stream", slaveName, name, stream);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,258 @@
+// BENCHMARK:
+// This program compares `Link::Queue` against `Link::RingBuffer`.
+// - push/pop: One push followed by one pop (like a SERIAL ISR that receives a
+//   value and moves it to another queue).
+// - sync push/pop: Like push/pop, but using `syncPush(...)`/`syncPop()` on
+//   `Link::Queue` (like `send(...)` and `read()` calls from the user).
+// - fill/drain: Fills the queue and then empties it.
+// - move: Moves all items from a full queue to an empty one (like
+//   `copyState()`), one by one on `Link::Queue` and with `moveTo(...)` on
+//   `Link::RingBuffer`.
+// Before that, it checks that a `syncClear()` from the other side between
+// `readSpans(...)` and `commitRead(...)` (or in the middle of `popMany(...)` /
+// `moveTo(...)`) leaves the buffer empty and usable, and that an old
+// `syncClear()` is still ignored after 2^31 items.
+// Output:
+// - Host cycles per item (best of multiple runs).
+// - On the GBA, the difference is larger: `Link::Queue` calls a software
+//   division routine on every push and pop when `Size` is not a power of two.
+// Usage:
+//   ./Queue_bench [-n iterations]
+
+#include "../../_lib/bench.h"
+
+using Bench::u16;
+using Bench::u32;
+using Bench::u64;
+using Bench::u8;
+
+static constexpr u32 RUNS = 10;
+
+struct Message {
+  u16 packetId;
+  u16 data;
+  u8 playerId;
+};
+
+volatile u32 sink = 0;
+
+template <typename T>
+T makeItem(u32 i) {
+  return (T)(i + 1);
+}
+
+template <>
+Message makeItem<Message>(u32 i) {
+  return Message{(u16)i, (u16)(i + 1), (u8)(i & 3)};
+}
+
+template <typename T>
+u32 toNumber(T item) {
+  return (u32)item;
+}
+
+template <>
+u32 toNumber<Message>(Message item) {
+  return item.data;
+}
+
+template <typename Q, typename T, typename Push, typename Pop>
+double measurePushPop(u32 iterations, Push push, Pop pop) {
+  static Q queue;
+  u64 best = ~0ull;
+
+  for (u32 run = 0; run < RUNS; run++) {
+    u32 total = 0;
+    u64 start = Link::Host::hostCycles();
+    for (u32 i = 0; i < iterations; i++) {
+      push(queue, makeItem<T>(i));
+      total += toNumber(pop(queue));
+    }
+    u64 elapsed = Link::Host::hostCycles() - start;
+    sink = sink + total;
+    best = std::min(best, elapsed);
+  }
+
+  return (double)best / iterations;
+}
+
+template <typename Q, typename T, u32 Size>
+double measureFillDrain(u32 iterations) {
+  static Q queue;
+  u64 best = ~0ull;
+  u32 rounds = Link::_max(iterations / Size, 1);
+
+  for (u32 run = 0; run < RUNS; run++) {
+    u32 total = 0;
+    u64 start = Link::Host::hostCycles();
+    for (u32 i = 0; i < rounds; i++) {
+      for (u32 j = 0; j < Size; j++)
+        queue.push(makeItem<T>(j));
+      while (!queue.isEmpty())
+        total += toNumber(queue.pop());
+    }
+    u64 elapsed = Link::Host::hostCycles() - start;
+    sink = sink + total;
+    best = std::min(best, elapsed);
+  }
+
+  return (double)best / (rounds * Size);
+}
+
+template <typename Q, typename T, u32 Size, typename Move>
+double measureMove(u32 iterations, Move move) {
+  static Q source, target;
+  u64 best = ~0ull;
+  u32 rounds = Link::_max(iterations / Size, 1);
+
+  for (u32 run = 0; run < RUNS; run++) {
+    u64 elapsed = 0;
+    u32 total = 0;
+    for (u32 i = 0; i < rounds; i++) {
+      for (u32 j = 0; j < Size; j++)
+        source.push(makeItem<T>(j));
+
+      u64 start = Link::Host::hostCycles();
+      move(source, target);
+      elapsed += Link::Host::hostCycles() - start;
+
+      total += toNumber(target.peek());
+      target.clear();
+    }
+    sink = sink + total;
+    best = std::min(best, elapsed);
+  }
+
+  return (double)best / (rounds * Size);
+}
+
+// (simulates a producer-side `syncClear()` that interrupts a read)
+template <typename Read>
+bool checkSyncClearDuringRead(Read read) {
+  using Buffer = Link::RingBuffer<u16, 16>;
+  static Buffer buffer;
+  buffer = Buffer{};
+
+  for (u32 i = 0; i < 8; i++)
+    buffer.push(makeItem<u16>(i));
+  read(buffer);  // (calls `syncClear()` after taking the spans)
+  if (!buffer.isEmpty())
+    return false;
+
+  for (u32 i = 0; i < 16; i++) {
+    if (!buffer.push(makeItem<u16>(i)))
+      return false;
+  }
+  return buffer.size() == 16 && buffer.pop() == makeItem<u16>(0);
+}
+
+bool checkSyncClear() {
+  using Buffer = Link::RingBuffer<u16, 16>;
+
+  bool spans = checkSyncClearDuringRead([](Buffer& buffer) {
+    Buffer::Span first, second;
+    buffer.readSpans(first, second);
+    buffer.syncClear();
+    buffer.commitRead(first, 3);
+  });
+  bool popMany = checkSyncClearDuringRead([](Buffer& buffer) {
+    u16 items[3];
+    Buffer::Span first, second;
+    buffer.readSpans(first, second);
+    for (u32 i = 0; i < 3; i++)
+      items[i] = first.data[i];
+    buffer.syncClear();
+    buffer.commitRead(first, 3);
+    sink = sink + items[0];
+  });
+  bool moveTo = checkSyncClearDuringRead([](Buffer& buffer) {
+    static Link::RingBuffer<u16, 4> target;
+    target.clear();
+    Buffer::Span first, second;
+    buffer.readSpans(first, second);
+    target.pushMany(first.data, 4);
+    buffer.syncClear();
+    buffer.commitRead(first, 4);
+  });
+
+  return spans && popMany && moveTo;
+}
+
+// (an old `syncClear()` index must not come back when `head` moves 2^31 items
+// past it)
+bool checkSyncClearAfterWrap() {
+  using Buffer = Link::RingBuffer<u16, 16>;
+  static Buffer buffer;
+  buffer = Buffer{};
+
+  buffer.push(makeItem<u16>(0));
+  buffer.syncClear();
+
+  Buffer::Span first, second;
+  for (u64 i = 0; i <= (1ull << 31) / 16; i++) {
+    buffer.writeSpans(first, second);
+    buffer.commitWrite(16);
+    buffer.readSpans(first, second);
+    buffer.commitRead(first, 16);
+  }
+  if (!buffer.isEmpty())
+    return false;
+
+  buffer.push(makeItem<u16>(1));
+  return buffer.size() == 1 && buffer.pop() == makeItem<u16>(1);
+}
+
+template <typename T, u32 Size>
+void compare(const char* name, u32 iterations) {
+  using OldQueue = Link::Queue<T, Size>;
+  using NewQueue = Link::RingBuffer<T, Size>;
+
+  double oldPushPop = measurePushPop<OldQueue, T>(
+      iterations, [](OldQueue& q, T item) { q.push(item); },
+      [](OldQueue& q) { return q.pop(); });
+  double newPushPop = measurePushPop<NewQueue, T>(
+      iterations, [](NewQueue& q, T item) { q.push(item); },
+      [](NewQueue& q) { return q.pop(); });
+  double oldSyncPushPop = measurePushPop<OldQueue, T>(
+      iterations, [](OldQueue& q, T item) { q.syncPush(item); },
+      [](OldQueue& q) { return q.syncPop(); });
+  double oldFillDrain = measureFillDrain<OldQueue, T, Size>(iterations);
+  double newFillDrain = measureFillDrain<NewQueue, T, Size>(iterations);
+  double oldMove =
+      measureMove<OldQueue, T, Size>(iterations, [](OldQueue& s, OldQueue& t) {
+        while (!s.isEmpty() && !t.isFull())
+          t.push(s.pop());
+      });
+  double newMove = measureMove<NewQueue, T, Size>(
+      iterations, [](NewQueue& s, NewQueue& t) { s.moveTo(t); });
+
+  printf("%-14s %5u %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f %10.2f\n", name,
+         Size, oldPushPop, newPushPop, oldSyncPushPop, oldFillDrain,
+         newFillDrain, oldMove, newMove);
+}
+
+int main(int argc, char* argv[]) {
+  u32 iterations = atoi(Bench::option(argc, argv, "-n", "1000000"));
+
+  printf("Queue_bench (%u iterations, host cycles per item)\n\n", iterations);
+
+  bool isSyncClearOK = checkSyncClear();
+  printf("syncClear() during a read: %s\n", isSyncClearOK ? "OK" : "FAILED");
+  bool isWrapOK = checkSyncClearAfterWrap();
+  printf("syncClear() after 2^31 items: %s\n\n", isWrapOK ? "OK" : "FAILED");
+  if (!isSyncClearOK || !isWrapOK)
+    return 1;
+
+  printf("%-14s %5s %10s %10s %10s %10s %10s %10s %10s\n", "type", "size",
+         "Q push/pop", "R push/pop", "Q sync", "Q fill", "R fill", "Q move",
+         "R move");
+  printf("(Q = Link::Queue, R = Link::RingBuffer)\n");
+
+  compare<u16, 15>("u16 (Cable)", iterations);
+  compare<u16, 16>("u16", iterations);
+  compare<Message, 30>("Message (Wi)", iterations);
+  compare<u32, 10>("u32 (Cube)", iterations);
+  compare<u8, 256>("u8 (UART)", iterations);
+
+  return 0;
+}
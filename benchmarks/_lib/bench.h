@@ -0,0 +1,110 @@
+#ifndef LINK_BENCHMARKS_BENCH_H
+#define LINK_BENCHMARKS_BENCH_H
+
+#ifndef LINK_HOST
+#define LINK_HOST
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "../../lib/_link_common.hpp"
+
+/**
+ * @brief This namespace contains shared code between all the benchmarks.
+ */
+namespace Bench {
+
+using u64 = Link::Host::u64;
+using u32 = Link::u32;
+using u16 = Link::u16;
+using u8 = Link::u8;
+
+// Samples
+
+/**
+ * @brief A list of measurements, with percentiles.
+ */
+class Samples {
+ public:
+  void add(u64 value) { values.push_back(value); }
+  void clear() { values.clear(); }
+  [[nodiscard]] u32 size() const { return values.size(); }
+
+  [[nodiscard]] u64 percentile(u32 percent) {
+    if (values.empty())
+      return 0;
+    std::sort(values.begin(), values.end());
+    u32 index = (u32)((u64)(values.size() - 1) * percent / 100);
+    return values[index];
+  }
+
+  [[nodiscard]] double mean() const {
+    if (values.empty())
+      return 0;
+    double total = 0;
+    for (auto value : values)
+      total += value;
+    return total / values.size();
+  }
+
+ private:
+  std::vector<u64> values;
+};
+
+// Units
+
+static inline double toSeconds(u64 cycles) {
+  return (double)cycles / Link::Host::CPU_FREQUENCY;
+}
+
+static inline double toScanlines(u64 cycles) {
+  return (double)cycles / Link::Host::CYCLES_PER_SCANLINE;
+}
+
+static inline double perCall(const Link::Host::Machine::ISRStats& stats) {
+  return stats.calls > 0 ? (double)stats.totalCycles / stats.calls : 0;
+}
+
+// Arguments
+
+/**
+ * @brief Parses a comma-separated list of numbers (e.g. `10,25,50`).
+ */
+static inline std::vector<u32> parseList(const char* text) {
+  std::vector<u32> list;
+  std::string token;
+  for (const char* c = text;; c++) {
+    if (*c == ',' || *c == '\0') {
+      if (!token.empty())
+        list.push_back((u32)strtoul(token.c_str(), nullptr, 10));
+      token.clear();
+      if (*c == '\0')
+        break;
+    } else {
+      token += *c;
+    }
+  }
+  return list;
+}
+
+/**
+ * @brief Returns the value of the `-name value` argument, or `fallback`.
+ */
+static inline const char* option(int argc,
+                                 char* argv[],
+                                 const char* name,
+                                 const char* fallback) {
+  for (int i = 1; i < argc - 1; i++) {
+    if (std::string(argv[i]) == name)
+      return argv[i + 1];
+  }
+  return fallback;
+}
+
+}  // namespace Bench
+
+#endif  // LINK_BENCHMARKS_BENCH_H
@@ -26,12 +26,6 @@ void measureLatency(bool withPong);
 void forceSync();
 bool needsReset();
 
-u32 vblankTime = 0;
-u32 serialTime = 0;
-u32 timerTime = 0;
-u32 vblankIRQs = 0;
-u32 serialIRQs = 0;
-u32 timerIRQs = 0;
 u32 avgTime = 0;
 
 #ifndef USE_LINK_UNIVERSAL
@@ -74,54 +68,17 @@ void setInterval(u16 interval) {
 #endif
 }
 
-void setUpInterrupts(bool profiler) {
-  vblankIRQs = 0;
-  vblankTime = 0;
-  serialTime = 0;
-  timerTime = 0;
-  serialIRQs = 0;
-  timerIRQs = 0;
-
+void setUpInterrupts() {
 #ifndef USE_LINK_UNIVERSAL
   // LinkCable
-  interrupt_add(INTR_VBLANK, profiler ? []() {
-    Common::profileStart();
-    LINK_CABLE_ISR_VBLANK();
-    vblankTime += Common::profileStop();
-    vblankIRQs++;
-  } : LINK_CABLE_ISR_VBLANK);
-  interrupt_add(INTR_SERIAL, profiler ? []() {
-    Common::profileStart();
-    LINK_CABLE_ISR_SERIAL();
-    serialTime += Common::profileStop();
-    serialIRQs++;
-  } : LINK_CABLE_ISR_SERIAL);
-  interrupt_add(INTR_TIMER3, profiler ? []() {
-    Common::profileStart();
-    LINK_CABLE_ISR_TIMER();
-    timerTime += Common::profileStop();
-    timerIRQs++;
-  } : LINK_CABLE_ISR_TIMER);
+  interrupt_add(INTR_VBLANK, LINK_CABLE_ISR_VBLANK);
+  interrupt_add(INTR_SERIAL, LINK_CABLE_ISR_SERIAL);
+  interrupt_add(INTR_TIMER3, LINK_CABLE_ISR_TIMER);
 #else
   // LinkUniversal
-  interrupt_add(INTR_VBLANK, profiler ? []() {
-    Common::profileStart();
-    LINK_UNIVERSAL_ISR_VBLANK();
-    vblankTime += Common::profileStop();
-    vblankIRQs++;
-  } : LINK_UNIVERSAL_ISR_VBLANK);
-  interrupt_add(INTR_SERIAL, profiler ? []() {
-    Common::profileStart();
-    LINK_UNIVERSAL_ISR_SERIAL();
-    serialTime += Common::profileStop();
-    serialIRQs++;
-  } : LINK_UNIVERSAL_ISR_SERIAL);
-  interrupt_add(INTR_TIMER3, profiler ? []() {
-    Common::profileStart();
-    LINK_UNIVERSAL_ISR_TIMER();
-    timerTime += Common::profileStop();
-    timerIRQs++;
-  } : LINK_UNIVERSAL_ISR_TIMER);
+  interrupt_add(INTR_VBLANK, LINK_UNIVERSAL_ISR_VBLANK);
+  interrupt_add(INTR_SERIAL, LINK_UNIVERSAL_ISR_SERIAL);
+  interrupt_add(INTR_TIMER3, LINK_UNIVERSAL_ISR_TIMER);
 #endif
 }
 
@@ -129,7 +86,7 @@ void init() {
   Common::initTTE();
 
   interrupt_init();
-  setUpInterrupts(false);
+  setUpInterrupts();
 }
 
 int main() {
@@ -163,19 +120,14 @@ int main() {
 
     linkConnection->activate();
 
-    if (initialKeys & KEY_A) {
-      setUpInterrupts(true);
+    if (initialKeys & KEY_A)
       test(false);
-    } else if (initialKeys & KEY_B) {
-      setUpInterrupts(true);
+    else if (initialKeys & KEY_B)
       test(true);
-    } else if (initialKeys & KEY_L) {
-      setUpInterrupts(false);
+    else if (initialKeys & KEY_L)
       measureLatency(false);
-    } else if (initialKeys & KEY_R) {
-      setUpInterrupts(false);
+    else if (initialKeys & KEY_R)
       measureLatency(true);
-    }
   }
 
   return 0;
@@ -195,15 +147,11 @@ void test(bool withSync) {
     if (needsReset())
       return;
 
-    if (vblankIRQs >= 60) {
-      avgTime = (vblankTime + serialTime + timerTime) / 60;
-
-      vblankIRQs = 0;
-      vblankTime = 0;
-      serialTime = 0;
-      timerTime = 0;
-      serialIRQs = 0;
-      timerIRQs = 0;
+    if (linkConnection->getStats().vblank.calls >= 60) {
+      auto stats = linkConnection->getStats(true);
+      avgTime = (stats.vblank.totalCycles + stats.serial.totalCycles +
+                 stats.timer.totalCycles) /
+                60;
     }
 
     u16 keys = ~REG_KEYS & KEY_ANY;
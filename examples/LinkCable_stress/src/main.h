@@ -2,6 +2,7 @@
 #define MAIN_H
 
 // #define USE_LINK_UNIVERSAL
+#define LINK_ENABLE_STATS 1
 
 #ifndef USE_LINK_UNIVERSAL
 #include "../../../lib/LinkCable.hpp"
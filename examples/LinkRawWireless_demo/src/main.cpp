@@ -1,4 +1,5 @@
 #define LINK_RAW_WIRELESS_ENABLE_LOGGING
+#define LINK_LOG_SIZE 512
 
 #include "../../../lib/LinkRawWireless.hpp"
 
@@ -33,6 +34,7 @@ inline void setUpInterrupts() {
 
   interrupt_add(INTR_VBLANK, [] {});
   interrupt_add(INTR_SERIAL, LINK_RAW_WIRELESS_ISR_SERIAL);
+  interrupt_add(INTR_TIMER2, LINK_RAW_WIRELESS_ISR_TIMER);
 
   // A+B+START+SELECT = SoftReset
 #if MULTIBOOT_BUILD == 0
@@ -1,4 +1,5 @@
 #define LINK_RAW_WIRELESS_ENABLE_LOGGING
+#define LINK_LOG_SIZE 512
 
 #include "../../../../lib/LinkRawWireless.hpp"
 
@@ -34,6 +35,7 @@ static std::unique_ptr<InputHandler> rightHandler =
 static std::vector<std::string> logLines;
 static u32 currentLogLine = 0;
 static bool useVerboseLog = true;
+static Link::BinaryLog binaryLog;
 
 static const std::string CHARACTERS[] = {
     "0", "1", "2", "3", "4", "5", "6", "7", "8", "9", "a", "b", "c",
@@ -109,7 +111,26 @@ void clear() {
   print();
 }
 
+bool flushLog() {
+  bool hasLines = false;
+  Link::LogEntry entry;
+  char line[64];
+  while (binaryLog.read(entry)) {
+    if (!useVerboseLog)
+      continue;
+    entry.toString(line, sizeof(line));
+    logLines.push_back(line);
+    hasLines = true;
+  }
+  if (binaryLog.hasOverflowed()) {
+    logLines.push_back("! log overflow");
+    hasLines = true;
+  }
+  return hasLines;
+}
+
 void log(std::string string) {
+  flushLog();
   logLines.push_back(string);
   scrollPageDown();
 }
@@ -131,10 +152,7 @@ void DebugScene::load() {
   SCENE_init();
   BACKGROUND_enable(true, false, false, false);
 
-  linkRawWireless->logger = [](std::string string) {
-    if (useVerboseLog)
-      log(string);
-  };
+  linkRawWireless->logger = &binaryLog;
 
   log("---");
   log("LinkRawWireless_demo");
@@ -183,6 +201,9 @@ void DebugScene::tick(u16 keys) {
                : ""),
       0, -3);
 
+  if (flushLog())
+    scrollPageDown();
+
   processKeys(keys);
   processButtons();
 
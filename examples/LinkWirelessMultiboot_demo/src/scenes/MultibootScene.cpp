@@ -43,6 +43,7 @@ static std::vector<std::string> logLines;
 static u32 currentLogLine = 0;
 static u32 selectedFile = 0;
 static u32 players = 5;
+static Link::BinaryLog binaryLog;
 
 #define MAX_LINES 20
 #define DRAW_LINE 0
@@ -110,7 +111,24 @@ void clear() {
   print();
 }
 
+bool flushLog() {
+  bool hasLines = false;
+  Link::LogEntry entry;
+  char line[64];
+  while (binaryLog.read(entry)) {
+    entry.toString(line, sizeof(line));
+    logLines.push_back(line);
+    hasLines = true;
+  }
+  if (binaryLog.hasOverflowed()) {
+    logLines.push_back("! log overflow");
+    hasLines = true;
+  }
+  return hasLines;
+}
+
 void log(std::string string) {
+  flushLog();
   logLines.push_back(string);
   scrollPageDown();
 }
@@ -182,11 +200,11 @@ void MultibootScene::load() {
   BACKGROUND_enable(true, false, false, false);
 
 #ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
-  linkWirelessMultiboot->logger = [](std::string string) { log(string); };
+  linkWirelessMultiboot->logger = &binaryLog;
 #endif
 
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
-  linkWirelessMultiboot->_setLogger([](std::string string) { log(string); });
+  linkWirelessMultiboot->_setLogger(&binaryLog);
 #endif
 
   log("---");
@@ -261,6 +279,8 @@ void MultibootScene::processButtons() {
         romToSend, fileLength, "Multiboot", "Test", 0xFFFF, players,
         [&percentage](LinkWirelessMultiboot::MultibootProgress progress) {
           // Show progress
+          if (flushLog())
+            scrollPageDown();
           if (percentage != progress.percentage) {
             percentage = progress.percentage;
             log("-> " + std::to_string(percentage));
@@ -42,7 +42,7 @@ int main() {
 #ifdef LINK_WIRELESS_ENABLE_NESTED_IRQ
   buildSettings += " + irq_nested\n";
 #endif
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS != 0
   buildSettings += " + profiler\n";
 #endif
 
@@ -277,7 +277,7 @@ void messageLoop() {
   bool switching = true;
   bool moreKeys = true;
 
-#ifndef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS == 0
   u32 lostPackets = 0;
   u32 lastLostPacketPlayerId = 0;
   u32 lastLostPacketExpected = 0;
@@ -335,13 +335,13 @@ void messageLoop() {
     for (u32 i = 0; i < receivedCount; i++) {
       auto message = messages[i];
 
-#ifndef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS == 0
       u32 expected = counters[message.playerId] + 1;
 #endif
 
       counters[message.playerId] = message.data;
 
-#ifndef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS == 0
       // Check for packet loss
       if (altView && message.data != expected) {
         lostPackets++;
@@ -361,7 +361,7 @@ void messageLoop() {
 
     // Packet loss check setting
     if (Common::didPress(KEY_UP, switching)) {
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS != 0
       // In the profiler ROM, pressing UP will update the broadcast data
       if (linkWireless->getState() == LinkWireless::State::SERVING &&
           !(keys & KEY_START)) {
@@ -390,7 +390,7 @@ void messageLoop() {
 #endif
 
       altView = !altView;
-#ifndef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS == 0
       if (!altView) {
         lostPackets = 0;
         lastLostPacketPlayerId = 0;
@@ -403,25 +403,19 @@ void messageLoop() {
 
     // Normal output
     std::string altOptionName = "Packet check";
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS != 0
     altOptionName = "Show profiler";
 
-    if (linkWireless->vblankIRQs >= 60) {
-      avgVBlankTime = linkWireless->vblankTime / 60;
-      avgSerialTime = linkWireless->serialTime / 60;
-      avgTimerTime = linkWireless->timerTime / 60;
-      avgSerialIRQs = linkWireless->serialIRQs / 60;
-      avgTimerIRQs = linkWireless->timerIRQs / 60;
-      avgTime = (linkWireless->vblankTime + linkWireless->serialTime +
-                 linkWireless->timerTime) /
+    if (linkWireless->getStats().vblank.calls >= 60) {
+      auto stats = linkWireless->getStats(true);
+      avgVBlankTime = stats.vblank.totalCycles / 60;
+      avgSerialTime = stats.serial.totalCycles / 60;
+      avgTimerTime = stats.timer.totalCycles / 60;
+      avgSerialIRQs = stats.serial.calls / 60;
+      avgTimerIRQs = stats.timer.calls / 60;
+      avgTime = (stats.vblank.totalCycles + stats.serial.totalCycles +
+                 stats.timer.totalCycles) /
                 60;
-
-      linkWireless->vblankIRQs = 0;
-      linkWireless->vblankTime = 0;
-      linkWireless->serialTime = 0;
-      linkWireless->timerTime = 0;
-      linkWireless->serialIRQs = 0;
-      linkWireless->timerIRQs = 0;
     }
 #endif
     LinkWireless::SignalLevelResponse levels;
@@ -474,7 +468,7 @@ void messageLoop() {
       }
     }
     if (altView) {
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
+#if LINK_ENABLE_STATS != 0
       output += "\n_onVBlank: " + std::to_string(avgVBlankTime);
       output += "\n_onSerial: " + std::to_string(avgSerialTime);
       output += "\n_onTimer: " + std::to_string(avgTimerTime);
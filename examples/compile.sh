@@ -148,7 +148,7 @@ compile() {
   # LinkWireless_prof_code_iwram
   cd LinkWireless_demo/
   mv LinkWireless_demo$suffix.gba backup.gba || :
-  cmd_make rebuild $args USERFLAGS="-DLINK_WIRELESS_PUT_ISR_IN_IWRAM=1 -DLINK_WIRELESS_PROFILING_ENABLED=1"
+  cmd_make rebuild $args USERFLAGS="-DLINK_WIRELESS_PUT_ISR_IN_IWRAM=1 -DLINK_ENABLE_STATS=1"
   cp LinkWireless_demo$suffix.gba ../$folder/LinkWireless_prof_code_iwram$suffix.gba
   mv backup.gba LinkWireless_demo$suffix.gba || :
   cd ..
@@ -156,7 +156,7 @@ compile() {
   # LinkWireless_prof_code_rom
   cd LinkWireless_demo/
   mv LinkWireless_demo$suffix.gba backup.gba || :
-  cmd_make rebuild $args USERFLAGS="-DLINK_WIRELESS_PROFILING_ENABLED=1"
+  cmd_make rebuild $args USERFLAGS="-DLINK_ENABLE_STATS=1"
   cp LinkWireless_demo$suffix.gba ../$folder/LinkWireless_prof_code_rom$suffix.gba
   mv backup.gba LinkWireless_demo$suffix.gba || :
   cd ..
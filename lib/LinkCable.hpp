@@ -26,6 +26,25 @@
 //         u16 message = linkCable->read(!currentPlayerId);
 //         // ...
 //       }
+// - 6) (Optional) Send/receive variable-length packets by using:
+//       linkCable->sendPacket(bytes, length);
+//       u8 packet[LINK_CABLE_PACKET_SIZE];
+//       u32 size = linkCable->receivePacket(!currentPlayerId, packet,
+//                                           sizeof(packet));
+//       if (size > 0) {
+//         // ...
+//       }
+// - 7) (Optional) Receive messages as soon as they arrive, instead of
+//      polling with `sync()` and `read(...)`:
+//       linkCable->config.onReceive = [](u8 playerId, u16 data) {
+//         // (called from the SERIAL IRQ: keep it short!)
+//       };
+// - 8) (Optional) Send time-critical messages ahead of the bulk traffic:
+//       linkCable->sendUrgent(0x5678);
+//       if (isConnected && linkCable->canReadUrgent(!currentPlayerId)) {
+//         u16 message = linkCable->readUrgent(!currentPlayerId);
+//         // ...
+//       }
 // --------------------------------------------------------------------------
 // (*1) libtonc's interrupt handler sometimes ignores interrupts due to a bug.
 //      That causes packet loss. You REALLY want to use libugba's instead.
@@ -56,35 +75,92 @@
  * store at max **per player**). The default value is `15`, which seems fine for
  * most games.
  * \warning This affects how much memory is allocated. With the default value,
- * it's around `390` bytes. There's a double-buffered pending queue (to avoid
- * data races), 1 incoming queue and 1 outgoing queue.
- * \warning You can approximate the usage with `LINK_CABLE_QUEUE_SIZE * 26`.
+ * it's around `270` bytes. There's a double-buffered incoming queue (swapped
+ * on `sync()`) and 1 outgoing queue.
+ * \warning You can approximate the usage with `LINK_CABLE_QUEUE_SIZE * 18`.
+ * \warning Queues are ring buffers, so their storage is rounded up to the
+ * next power of two (`16` for the default value).
  */
 #define LINK_CABLE_QUEUE_SIZE 15
 #endif
 
+#ifndef LINK_CABLE_PACKET_SIZE
+/**
+ * @brief Maximum packet size, in bytes (for `sendPacket(...)` and
+ * `receivePacket(...)`). The default value is `24`, which fits in the default
+ * send queue.
+ * \warning This affects how much memory is allocated. There's one reassembly
+ * buffer **per player**, so it's around `LINK_CABLE_PACKET_SIZE * 4` bytes.
+ * \warning A packet of `N` bytes needs around `N / 2 + 1` slots in the send
+ * queue, so bigger packets also require a bigger `LINK_CABLE_QUEUE_SIZE`.
+ */
+#define LINK_CABLE_PACKET_SIZE 24
+#endif
+
+#ifndef LINK_CABLE_URGENT_QUEUE_SIZE
+/**
+ * @brief Urgent buffer size (how many outgoing messages sent with
+ * `sendUrgent(...)` can wait at max, and how many incoming urgent messages
+ * can wait per player). The default value is `4`, since urgent messages are
+ * expected to be rare and short (e.g. inputs or acks).
+ * \warning This affects how much memory is allocated (`2` bytes per slot,
+ * rounded up to the next power of two). The incoming queues are double
+ * buffered, so it's around `LINK_CABLE_URGENT_QUEUE_SIZE * 2 * 9` bytes.
+ */
+#define LINK_CABLE_URGENT_QUEUE_SIZE 4
+#endif
+
 LINK_VERSION_TAG LINK_CABLE_VERSION = "vLinkCable/v8.0.3";
 
 #define LINK_CABLE_MAX_PLAYERS LINK_RAW_CABLE_MAX_PLAYERS
 #define LINK_CABLE_DEFAULT_TIMEOUT 3
 #define LINK_CABLE_DEFAULT_INTERVAL 50
+#define LINK_CABLE_DEFAULT_MIN_INTERVAL 10
+#define LINK_CABLE_DEFAULT_MAX_INTERVAL 100
+#define LINK_CABLE_DEFAULT_BURST_SIZE 1
+#define LINK_CABLE_DEFAULT_URGENT_WEIGHT 0
 #define LINK_CABLE_DEFAULT_SEND_TIMER_ID 3
 #define LINK_CABLE_DISCONNECTED LINK_RAW_CABLE_DISCONNECTED
 #define LINK_CABLE_NO_DATA 0x0
 
 /**
  * @brief A Link Cable connection for Multi-Play mode.
+ * @tparam QueueSize Buffer size (see `LINK_CABLE_QUEUE_SIZE`).
+ * @tparam MaxPlayers `(2~4)` Maximum number of players. Consoles with higher
+ * player IDs are ignored.
+ * @tparam PacketSize Maximum packet size (see `LINK_CABLE_PACKET_SIZE`).
+ * @tparam UrgentQueueSize Urgent buffer size (see
+ * `LINK_CABLE_URGENT_QUEUE_SIZE`).
+ * \warning `LinkCable` is an alias for the default configuration.
  */
-class LinkCable {
+template <Link::u32 QueueSize = LINK_CABLE_QUEUE_SIZE,
+          Link::u32 MaxPlayers = LINK_CABLE_MAX_PLAYERS,
+          Link::u32 PacketSize = LINK_CABLE_PACKET_SIZE,
+          Link::u32 UrgentQueueSize = LINK_CABLE_URGENT_QUEUE_SIZE>
+class LinkCableT {
  private:
   using u32 = Link::u32;
   using u16 = Link::u16;
   using u8 = Link::u8;
   using vu8 = Link::vu8;
-  using U16Queue = Link::Queue<u16, LINK_CABLE_QUEUE_SIZE>;
+  using U16Queue = Link::RingBuffer<u16, QueueSize>;
+  using UrgentQueue = Link::RingBuffer<u16, UrgentQueueSize>;
 
   static constexpr auto BASE_FREQUENCY = Link::_TM_FREQ_1024;
   static constexpr int MSG_TIMEOUT_OFFLINE = -1;
+  static constexpr u16 PACKET_MASK = 0x8000;
+  static constexpr u16 PACKET_ESCAPE = 0xFFFE;
+  static constexpr u16 PACKET_ESCAPE_BASE = 0xFFFD;
+  static constexpr u16 CHANNEL_ESCAPE = 0xFFFC;  // (urgent prefix)
+  static constexpr u16 RELIABLE_TYPE_MASK = 0xC000;
+  static constexpr u16 RELIABLE_FIRST = 0x8000;   // 10 + ID + high data bits
+  static constexpr u16 RELIABLE_SECOND = 0x4000;  // 01 + low data bits + ACKs
+  static constexpr u16 RELIABLE_ACK = 0xC000;     // 110 + ACKs
+  static constexpr u16 RELIABLE_START = 0xE000;   // 111 + ID + 0 + ACKs
+  static constexpr u32 RELIABLE_MAX_ID = 7;       // (IDs are 1~7, 0 = none)
+  static constexpr u32 RELIABLE_WINDOW = RELIABLE_MAX_ID - 1;
+  static constexpr u32 RELIABLE_RETRANSMIT_DELAY = 8;  // (in transfers)
+  static constexpr u16 BURST_GAP = 2;  // (in 1024-cycle ticks)
 
  public:
   using BaudRate = LinkRawCable::BaudRate;
@@ -98,17 +174,28 @@ class LinkCable {
    * *(50 = 3.052ms)*. It's the interval of Timer #`sendTimerId`. Lower values
    * will transfer faster but also consume more CPU.
    * @param sendTimerId `(0~3)` GBA Timer to use for sending.
+   * @param reliable If `true`, messages are confirmed by all the other players
+   * and retransmitted when they get lost. Each message takes 2 transfers.
    * \warning You can use `Link::perFrame(...)` to convert from *packets per
    * frame* to *interval values*.
+   * \warning All players must use the same `reliable` value.
    */
-  explicit LinkCable(BaudRate baudRate = BaudRate::BAUD_RATE_1,
-                     u32 timeout = LINK_CABLE_DEFAULT_TIMEOUT,
-                     u16 interval = LINK_CABLE_DEFAULT_INTERVAL,
-                     u8 sendTimerId = LINK_CABLE_DEFAULT_SEND_TIMER_ID) {
+  explicit LinkCableT(BaudRate baudRate = BaudRate::BAUD_RATE_1,
+                      u32 timeout = LINK_CABLE_DEFAULT_TIMEOUT,
+                      u16 interval = LINK_CABLE_DEFAULT_INTERVAL,
+                      u8 sendTimerId = LINK_CABLE_DEFAULT_SEND_TIMER_ID,
+                      bool reliable = false) {
     config.baudRate = baudRate;
     config.timeout = timeout;
     config.interval = interval;
     config.sendTimerId = sendTimerId;
+    config.reliable = reliable;
+    config.adaptiveInterval = false;
+    config.minInterval = LINK_CABLE_DEFAULT_MIN_INTERVAL;
+    config.maxInterval = LINK_CABLE_DEFAULT_MAX_INTERVAL;
+    config.burstSize = LINK_CABLE_DEFAULT_BURST_SIZE;
+    config.urgentWeight = LINK_CABLE_DEFAULT_URGENT_WEIGHT;
+    config.onReceive = nullptr;
   }
 
   /**
@@ -121,12 +208,22 @@ class LinkCable {
    */
   void activate() {
     LINK_READ_TAG(LINK_CABLE_VERSION);
-    static_assert(LINK_CABLE_QUEUE_SIZE >= 1);
+    static_assert(QueueSize >= 1);
+    static_assert(UrgentQueueSize >= 1);
+    static_assert(MaxPlayers >= 2 && MaxPlayers <= LINK_CABLE_MAX_PLAYERS);
+    static_assert(PacketSize >= 1 && PacketSize < PACKET_ESCAPE_BASE);
 
     LINK_BARRIER;
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    intervalController.reset(config.interval, config.minInterval,
+                             config.maxInterval);
+    LINK_IRQ_SET(Link::_IRQ_VBLANK, LinkCableT, _onVBlank);
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkCableT, _onSerial);
+    LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[config.sendTimerId], LinkCableT,
+                 _onTimer);
     reset();
     clearIncomingMessages();
 
@@ -143,6 +240,7 @@ class LinkCable {
     isEnabled = false;
     LINK_BARRIER;
 
+    Link::IRQ::unsetAll(this);
     resetState();
     stop();
     clearIncomingMessages();
@@ -169,23 +267,28 @@ class LinkCable {
    * @brief Collects available messages from interrupts for later processing
    * with `read(...)`. Call this method whenever you need to fetch new data, and
    * always process all messages before calling it again.
+   * \warning If `config.onReceive` is set, messages go to the callback instead,
+   * so the queues (and `receivePacket(...)`) stay empty.
    */
   void sync() {
     if (!isEnabled)
       return;
 
-    LINK_BARRIER;
-    isReadingMessages = true;
-    LINK_BARRIER;
-
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++)
-      move(_state.readyToSyncMessages[i], state.syncedIncomingMessages[i]);
-
-    LINK_BARRIER;
-    isReadingMessages = false;
-    LINK_BARRIER;
+    if (isFrontBufferEmpty()) {
+      // (the ISRs can't interrupt the swap, so this is the whole handover)
+      LINK_BARRIER;
+      _state.backBufferIndex = !_state.backBufferIndex;
+      LINK_BARRIER;
+    } else {
+      for (u32 i = 0; i < MaxPlayers; i++) {
+        backBuffer().messages[i].moveTo(frontBuffer().messages[i]);
+        backBuffer().urgentMessages[i].moveTo(
+            frontBuffer().urgentMessages[i]);
+      }
+    }
 
-    if (!isConnected())
+    // (in reliable mode, received messages are already confirmed)
+    if (!isConnected() && !config.reliable)
       clearIncomingMessages();
   }
 
@@ -229,7 +332,7 @@ class LinkCable {
    * until you *fetch new data* with `sync()`.
    */
   [[nodiscard]] bool canRead(u8 playerId) {
-    return !state.syncedIncomingMessages[playerId].isEmpty();
+    return !frontBuffer().messages[playerId].isEmpty();
   }
 
   /**
@@ -237,7 +340,7 @@ class LinkCable {
    * @param playerId A player ID.
    * \warning If there's no data from that player, a `0` will be returned.
    */
-  u16 read(u8 playerId) { return state.syncedIncomingMessages[playerId].pop(); }
+  u16 read(u8 playerId) { return frontBuffer().messages[playerId].pop(); }
 
   /**
    * @brief Returns the next message from player #`playerId` without dequeuing
@@ -246,7 +349,28 @@ class LinkCable {
    * \warning If there's no data from that player, a `0` will be returned.
    */
   [[nodiscard]] u16 peek(u8 playerId) {
-    return state.syncedIncomingMessages[playerId].peek();
+    return frontBuffer().messages[playerId].peek();
+  }
+
+  /**
+   * @brief Returns `true` if there are pending urgent messages (the ones sent
+   * with `sendUrgent(...)`) from player #`playerId`.
+   * @param playerId A player ID.
+   * \warning Like `canRead(...)`, this only sees data fetched with `sync()`.
+   */
+  [[nodiscard]] bool canReadUrgent(u8 playerId) {
+    return !frontBuffer().urgentMessages[playerId].isEmpty();
+  }
+
+  /**
+   * @brief Dequeues and returns the next urgent message from player
+   * #`playerId`. Urgent messages don't appear in `read(...)` or
+   * `receivePacket(...)`.
+   * @param playerId A player ID.
+   * \warning If there's no data from that player, a `0` will be returned.
+   */
+  u16 readUrgent(u8 playerId) {
+    return frontBuffer().urgentMessages[playerId].pop();
   }
 
   /**
@@ -260,7 +384,8 @@ class LinkCable {
         data == LINK_CABLE_NO_DATA || !canSend())
       return false;
 
-    _state.outgoingMessages.syncPush(data);
+    _state.outgoingMessages.push(data);
+    LINK_STATS_MARK(outgoingHighWaterMark, _state.outgoingMessages.size());
     return true;
   }
 
@@ -270,6 +395,89 @@ class LinkCable {
    */
   bool canSend() { return !_state.outgoingMessages.isFull(); }
 
+  /**
+   * @brief Sends `data` to all connected players, ahead of the messages queued
+   * with `send(...)` and `sendPacket(...)`. Urgent messages keep their order
+   * among themselves, and receivers get them with `readUrgent(...)`, apart
+   * from the rest (so they can arrive in the middle of a packet without
+   * breaking it).
+   * @param data The value to be sent.
+   * \warning If `data` is invalid or the urgent queue is full, a `false` will
+   * be returned. Besides `0x0` and `0xFFFF`, `0xFFFC` is also reserved here.
+   * \warning Each urgent message takes 2 words (see the notes at the end).
+   * \warning In reliable mode, they only overtake messages that weren't
+   * transferred yet (the ones in flight are always sent first).
+   */
+  bool sendUrgent(u16 data) {
+    if (!isEnabled || data == LINK_CABLE_DISCONNECTED ||
+        data == LINK_CABLE_NO_DATA || data == CHANNEL_ESCAPE ||
+        !canSendUrgent())
+      return false;
+
+    _state.urgentMessages.push(data);
+    return true;
+  }
+
+  /**
+   * @brief Returns whether a `sendUrgent(...)` call would fail due to the
+   * urgent queue being full.
+   */
+  bool canSendUrgent() { return !_state.urgentMessages.isFull(); }
+
+  /**
+   * @brief Sends a packet of `length` bytes to all connected players. Bytes
+   * are packed in pairs into the 16-bit stream, after a header with the length.
+   * Words that would collide with the reserved values are escaped.
+   * @param data The bytes to be sent.
+   * @param length The number of bytes `(1~PacketSize)`.
+   * \warning If `length` is invalid or the packet doesn't fit in the send
+   * queue, a `false` will be returned and nothing will be sent.
+   */
+  bool sendPacket(const u8* data, u32 length) {
+    if (!isEnabled || length == 0 || length > PacketSize)
+      return false;
+
+    u32 words = 0;
+    encodePacket(data, length, [&words](u16) { words++; });
+    if (_state.outgoingMessages.available() < words)
+      return false;
+
+    encodePacket(data, length,
+                 [this](u16 word) { _state.outgoingMessages.push(word); });
+    LINK_STATS_MARK(outgoingHighWaterMark, _state.outgoingMessages.size());
+    return true;
+  }
+
+  /**
+   * @brief Reassembles the next packet from player #`playerId`, copying it to
+   * `buffer`. Returns its size in bytes, or `0` if there's no complete packet
+   * yet (partial packets are kept between calls).
+   * @param playerId A player ID.
+   * @param buffer The destination buffer.
+   * @param size The size of `buffer`. Longer packets are truncated, but their
+   * full size is returned.
+   * \warning Don't mix `read(...)` and `receivePacket(...)` calls for the same
+   * player: both consume the same incoming queue.
+   * \warning Like `read(...)`, this only sees data fetched with `sync()`.
+   */
+  u32 receivePacket(u8 playerId, u8* buffer, u32 size) {
+    auto& reader = _packetReaders[playerId];
+    auto& messages = frontBuffer().messages[playerId];
+
+    while (!messages.isEmpty()) {
+      if (!reader.receive(messages.pop()))
+        continue;
+
+      u32 length = reader.length;
+      for (u32 i = 0; i < length && i < size; i++)
+        buffer[i] = reader.data[i];
+      reader.reset();
+      return length;
+    }
+
+    return 0;
+  }
+
   /**
    * @brief Returns whether the internal queue lost messages at some point due
    * to being full. This can happen if your queue size is too low, if you
@@ -280,18 +488,35 @@ class LinkCable {
   bool didQueueOverflow(bool clear = true) {
     bool overflow = false;
 
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++) {
-      overflow = overflow || _state.newMessages[i].overflow ||
-                 _state.readyToSyncMessages[i].overflow;
-      if (clear) {
-        _state.newMessages[i].overflow = false;
-        state.syncedIncomingMessages[i].overflow = false;
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      for (u32 j = 0; j < 2; j++) {
+        auto& buffer = _state.buffers[j];
+        overflow = overflow || buffer.messages[i].overflow ||
+                   buffer.urgentMessages[i].overflow;
+        if (clear) {
+          buffer.messages[i].overflow = false;
+          buffer.urgentMessages[i].overflow = false;
+        }
       }
     }
 
     return overflow;
   }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief Resets other players' timeout count to `0`.
    * \warning Call this if you changed `config.timeout`.
@@ -307,27 +532,41 @@ class LinkCable {
 
   /**
    * @brief Restarts the send timer without disconnecting.
-   * \warning Call this if you changed `config.interval`.
+   * \warning Call this if you changed `config.interval` or the adaptive
+   * interval bounds.
    */
   void resetTimer() {
     if (!isEnabled)
       return;
 
     stopTimer();
+    _state.isBurstGap = false;
+    intervalController.reset(config.interval, config.minInterval,
+                             config.maxInterval);
     startTimer();
   }
 
+  /**
+   * @brief Returns the current send interval. It's `config.interval`, unless
+   * `config.adaptiveInterval` is `true`.
+   */
+  [[nodiscard]] u16 getInterval() {
+    return config.adaptiveInterval ? intervalController.interval()
+                                   : config.interval;
+  }
+
   /**
    * @brief This method is called by the VBLANK interrupt handler.
    * \warning This is internal API!
    */
   void _onVBlank() {
+    LINK_STATS_ISR(vblank);
     if (!isEnabled)
       return;
 
     if (_state.isResetTimeoutPending) {
       _state.IRQTimeout = 0;
-      for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++)
+      for (u32 i = 0; i < MaxPlayers; i++)
         _state.msgTimeouts[i] = 0;
       _state.isResetTimeoutPending = false;
     }
@@ -336,18 +575,22 @@ class LinkCable {
       _state.IRQTimeout++;
     _state.IRQFlag = false;
 
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++) {
+    for (u32 i = 0; i < MaxPlayers; i++) {
       if (isOnline(i) && !_state.msgFlags[i])
         _state.msgTimeouts[i]++;
       _state.msgFlags[i] = false;
     }
 
     if (didTimeout()) {
+      LINK_STATS_COUNT(timeouts);
+      LINK_STATS_COUNT(resets);
+      LINK_TRACE(CABLE, TIMEOUT, state.currentPlayerId, _state.IRQTimeout);
       reset();
-      return;
+      _state.hadErrors = true;
     }
 
-    copyState();
+    if (config.adaptiveInterval)
+      updateInterval();
   }
 
   /**
@@ -355,11 +598,15 @@ class LinkCable {
    * \warning This is internal API!
    */
   void _onSerial() {
+    LINK_STATS_ISR(serial);
     if (!isEnabled)
       return;
 
     if (!LinkRawCable::allReady() || LinkRawCable::hasError()) {
-      reset();
+      LINK_STATS_COUNT(resets);
+      LINK_TRACE(CABLE, RESET, LinkRawCable::hasError(), 0);
+      reset(config.reliable);
+      _state.hadErrors = true;
       return;
     }
 
@@ -373,34 +620,51 @@ class LinkCable {
     _state.IRQTimeout = 0;
 
     u8 newPlayerCount = 0;
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++) {
+    for (u32 i = 0; i < MaxPlayers; i++) {
       u16 data = response.data[i];
 
       if (data != LINK_CABLE_DISCONNECTED) {
-        if (data != LINK_CABLE_NO_DATA && i != state.currentPlayerId)
-          _state.newMessages[i].push(data);
+        if (data != LINK_CABLE_NO_DATA && i != state.currentPlayerId) {
+          if (config.reliable)
+            receiveReliable(i, data);
+          else
+            receive(i, data);
+        }
         newPlayerCount++;
         setOnline(i);
       } else if (isOnline(i)) {
         if (_state.msgTimeouts[i] >= (int)config.timeout) {
-          _state.newMessages[i].clear();
+          LINK_TRACE(CABLE, TIMEOUT, i, _state.msgTimeouts[i]);
+          backBuffer().messages[i].syncClear();
+          backBuffer().urgentMessages[i].syncClear();
           setOffline(i);
+          resetReliablePeer(i);
+          _state.isChannelEscaped[i] = false;
+          _state.hadErrors = true;
         } else {
           newPlayerCount++;
         }
       }
     }
 
+#if LINK_ENABLE_TRACE != 0
+    if (newPlayerCount != state.playerCount)
+      LINK_TRACE(CABLE, STATE_CHANGE, newPlayerCount, state.playerCount);
+#endif
+
     LINK_BARRIER;
     state.playerCount = newPlayerCount;
     LINK_BARRIER;
 
+    if (config.reliable)
+      releaseConfirmedMessages();
+
     LinkRawCable::setData(LINK_CABLE_NO_DATA);
 
     if (!LinkRawCable::isMasterNode())
       sendPendingData();
-
-    copyState();
+    else if (shouldContinueBurst())
+      startBurstGap();
   }
 
   /**
@@ -408,14 +672,28 @@ class LinkCable {
    * \warning This is internal API!
    */
   void _onTimer() {
+    LINK_STATS_ISR(timer);
     if (!isEnabled)
       return;
 
-    if (LinkRawCable::isMasterNode() && LinkRawCable::allReady() &&
-        !LinkRawCable::isSending())
-      sendPendingData();
+    // (the tick period starts again after a burst gap, even if the burst
+    // can't continue, so the timer doesn't keep firing at the gap's rate)
+    bool isBurstGap = _state.isBurstGap;
+    if (isBurstGap) {
+      _state.isBurstGap = false;
+      stopTimer();
+      startTimer();
+    }
+
+    if (!LinkRawCable::isMasterNode() || !LinkRawCable::allReady() ||
+        LinkRawCable::isSending())
+      return;
 
-    copyState();
+    if (!isBurstGap)
+      _state.burstTransfers = 0;
+
+    _state.burstTransfers++;
+    sendPendingData();
   }
 
   struct Config {
@@ -423,6 +701,13 @@ class LinkCable {
     u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
     u16 interval;  // can be changed in realtime, but call `resetTimer()`
     u8 sendTimerId;
+    bool reliable;
+    bool adaptiveInterval;  // if true, `interval` is only the initial value
+    u16 minInterval;        // (lower bound for the adaptive interval)
+    u16 maxInterval;        // (upper bound for the adaptive interval)
+    u8 burstSize;  // max transfers per timer tick when there's a backlog
+    u8 urgentWeight;  // urgent msgs per bulk msg when both wait (0 = strict)
+    Link::ReceiveCallback onReceive;  // (if set, messages skip the queues)
   };
 
   /**
@@ -435,71 +720,460 @@ class LinkCable {
  private:
 #endif
   struct ExternalState {
-    U16Queue syncedIncomingMessages[LINK_CABLE_MAX_PLAYERS];
     vu8 playerCount = 1;
     vu8 currentPlayerId = 0;
   };
 
+  struct MessageBuffer {
+    U16Queue messages[MaxPlayers];
+    UrgentQueue urgentMessages[MaxPlayers];
+  };
+
+  struct PacketReader {
+    u8 data[PacketSize];
+    u32 length = 0;
+    u32 position = 0;
+    bool isEscaped = false;
+
+    /**
+     * @brief Consumes one word. Returns `true` when the packet is complete.
+     */
+    bool receive(u16 word) {
+      if (length == 0) {
+        // (invalid headers are skipped, to resync after an overflow)
+        if (word <= PacketSize)
+          length = word;
+        return false;
+      }
+
+      if (isEscaped) {
+        word += PACKET_ESCAPE_BASE;
+        isEscaped = false;
+      } else if (word == PACKET_ESCAPE) {
+        isEscaped = true;
+        return false;
+      }
+
+      word ^= PACKET_MASK;
+      data[position++] = word & 0xFF;
+      if (position < length)
+        data[position++] = word >> 8;
+
+      return position == length;
+    }
+
+    void reset() {
+      length = 0;
+      position = 0;
+      isEscaped = false;
+    }
+  };
+
+  struct ReliableState {
+    u16 window[RELIABLE_MAX_ID + 1];  // unconfirmed messages, by ID
+    u8 firstId = 1;                   // oldest unconfirmed ID
+    u8 count = 0;                     // messages in the window
+    u8 cursor = 0;                    // next message to transfer (offset)
+    u8 sendingId = 0;  // (first word sent, second word pending)
+    bool isStartSent = false;  // (start marker sent, first word pending)
+    bool isAckPending = false;
+    u32 transfersWithoutProgress = 0;
+    u8 lastReceivedIds[MaxPlayers];  // (0 = nothing received yet)
+    u8 lastAckedIds[MaxPlayers];     // (0 = nothing confirmed yet)
+    u16 firstWords[MaxPlayers];      // (0 = no first word pending)
+    u8 startIds[MaxPlayers];         // (0 = no start marker received yet)
+  };
+
   struct InternalState {
     U16Queue outgoingMessages;
-    U16Queue readyToSyncMessages[LINK_CABLE_MAX_PLAYERS];
-    U16Queue newMessages[LINK_CABLE_MAX_PLAYERS];
+    UrgentQueue urgentMessages;  // (sent before `outgoingMessages`)
+    u8 urgentStreak = 0;         // (urgent messages sent in a row)
+    u16 pendingChannelWord = LINK_CABLE_NO_DATA;  // (after a CHANNEL_ESCAPE)
+    bool isChannelEscaped[MaxPlayers];  // (received a CHANNEL_ESCAPE)
+    ReliableState reliable;  // (only used if `config.reliable` is `true`)
+    MessageBuffer buffers[2];  // back: write by irq ; front: read by user
+    vu8 backBufferIndex = 0;   // (flipped by the user on `sync()`)
     u32 IRQTimeout = 0;
-    int msgTimeouts[LINK_CABLE_MAX_PLAYERS];
-    bool msgFlags[LINK_CABLE_MAX_PLAYERS];
+    int msgTimeouts[MaxPlayers];
+    bool msgFlags[MaxPlayers];
     bool IRQFlag = false;
+    bool hadErrors = false;  // (since the last adaptive interval update)
+    bool isBurstGap = false;  // (the timer is waiting to chain a transfer)
+    u8 burstTransfers = 0;    // (transfers since the last timer tick)
     volatile bool isResetTimeoutPending = false;
   };
 
   ExternalState state;
   InternalState _state;
+  PacketReader _packetReaders[MaxPlayers];
+  Link::IntervalController intervalController;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
-  volatile bool isReadingMessages = false;
 
   bool didTimeout() { return _state.IRQTimeout >= config.timeout; }
 
+  void receive(u8 playerId, u16 data) {
+    LINK_TRACE(CABLE, WORD_RECEIVED, data, playerId);
+
+    // `CHANNEL_ESCAPE, data` is an urgent message, and
+    // `CHANNEL_ESCAPE, CHANNEL_ESCAPE` is a regular `CHANNEL_ESCAPE`
+    bool& isEscaped = _state.isChannelEscaped[playerId];
+    if (!isEscaped && data == CHANNEL_ESCAPE) {
+      isEscaped = true;
+      return;
+    }
+    bool isUrgent = isEscaped && data != CHANNEL_ESCAPE;
+    isEscaped = false;
+
+    if (config.onReceive) {
+      config.onReceive(playerId, data);
+      return;
+    }
+
+    if (isUrgent) {
+      if (!backBuffer().urgentMessages[playerId].push(data)) {
+        LINK_STATS_COUNT(overflows);
+        LINK_TRACE(CABLE, QUEUE_OVERFLOW, data, playerId);
+      }
+      return;
+    }
+
+    auto& messages = backBuffer().messages[playerId];
+    if (!messages.push(data)) {
+      LINK_STATS_COUNT(overflows);
+      LINK_TRACE(CABLE, QUEUE_OVERFLOW, data, playerId);
+      return;
+    }
+    LINK_STATS_MARK(incomingHighWaterMark, messages.size());
+  }
+
+  bool canReceive(u8 playerId, u16 data) {
+    if (config.onReceive)
+      return true;
+
+    bool isEscaped = _state.isChannelEscaped[playerId];
+    if (!isEscaped)
+      return data == CHANNEL_ESCAPE ||
+             !backBuffer().messages[playerId].isFull();
+    return data == CHANNEL_ESCAPE
+               ? !backBuffer().messages[playerId].isFull()
+               : !backBuffer().urgentMessages[playerId].isFull();
+  }
+
   void sendPendingData() {
-    if (_state.outgoingMessages.isWriting())
+    transfer(config.reliable ? nextReliableWord() : popOutgoing());
+  }
+
+  bool hasOutgoingMessages() {
+    return _state.pendingChannelWord != LINK_CABLE_NO_DATA ||
+           !_state.urgentMessages.isEmpty() ||
+           !_state.outgoingMessages.isEmpty();
+  }
+
+  u16 popOutgoing() {
+    // (the second word of an urgent message or an escaped bulk message)
+    if (_state.pendingChannelWord != LINK_CABLE_NO_DATA) {
+      u16 word = _state.pendingChannelWord;
+      _state.pendingChannelWord = LINK_CABLE_NO_DATA;
+      return word;
+    }
+
+    // urgent messages go first, unless `config.urgentWeight` of them were
+    // already sent in a row and there are bulk messages waiting; they're
+    // prefixed with `CHANNEL_ESCAPE`, so receivers can tell them apart
+    bool hasBulk = !_state.outgoingMessages.isEmpty();
+    if (!_state.urgentMessages.isEmpty() &&
+        (!hasBulk || config.urgentWeight == 0 ||
+         _state.urgentStreak < config.urgentWeight)) {
+      _state.urgentStreak++;
+      _state.pendingChannelWord = _state.urgentMessages.pop();
+      return CHANNEL_ESCAPE;
+    }
+
+    _state.urgentStreak = 0;
+    u16 word = _state.outgoingMessages.pop();
+    if (word == CHANNEL_ESCAPE)
+      _state.pendingChannelWord = CHANNEL_ESCAPE;
+    return word;
+  }
+
+  bool hasPendingData() {
+    if (!config.reliable)
+      return hasOutgoingMessages();
+
+    auto& reliable = _state.reliable;
+    return reliable.sendingId != 0 || reliable.cursor < reliable.count ||
+           (reliable.count < RELIABLE_WINDOW && hasOutgoingMessages());
+  }
+
+  bool shouldContinueBurst() {
+    return _state.burstTransfers < config.burstSize && hasPendingData();
+  }
+
+  void startBurstGap() {
+    // slaves need some time to load their next word after the SERIAL IRQ,
+    // so the next transfer starts after a short gap instead of right away
+    _state.isBurstGap = true;
+    stopTimer();
+    Link::_REG_TM[config.sendTimerId].start = -BURST_GAP;
+    Link::_REG_TM[config.sendTimerId].cnt =
+        Link::_TM_ENABLE | Link::_TM_IRQ | BASE_FREQUENCY;
+  }
+
+  void receiveReliable(u8 playerId, u16 data) {
+    auto& reliable = _state.reliable;
+
+    switch (data & RELIABLE_TYPE_MASK) {
+      case RELIABLE_FIRST: {
+        reliable.firstWords[playerId] = data;
+        return;
+      }
+      case RELIABLE_SECOND: {
+        receiveAck(playerId, data);
+
+        u16 first = reliable.firstWords[playerId];
+        reliable.firstWords[playerId] = 0;
+        u8 id = (first >> 11) & 0b111;
+        if (first == 0 || id == 0)
+          return;
+
+        // go-back-N: only the next ID is accepted, everything else is
+        // confirmed again (the sender will retransmit the gap); the first
+        // message must be the sender's oldest unconfirmed one, which is
+        // announced with a start marker
+        u8 lastId = reliable.lastReceivedIds[playerId];
+        u8 expectedId =
+            lastId != 0 ? nextId(lastId) : reliable.startIds[playerId];
+        reliable.isAckPending = true;
+        if (id != expectedId)
+          return;
+        u16 message = ((first & 0x7FF) << 5) | ((data >> 9) & 0b11111);
+        if (!canReceive(playerId, message))
+          return;
+
+        receive(playerId, message);
+        reliable.lastReceivedIds[playerId] = id;
+        return;
+      }
+      case RELIABLE_ACK: {
+        receiveAck(playerId, data);
+        if ((data & RELIABLE_START) == RELIABLE_START)
+          reliable.startIds[playerId] = (data >> 10) & 0b111;
+        return;
+      }
+      default:
+        return;
+    }
+  }
+
+  void receiveAck(u8 playerId, u16 data) {
+    u32 slot = ackSlot(state.currentPlayerId, playerId);
+    _state.reliable.lastAckedIds[playerId] = (data >> (slot * 3)) & 0b111;
+  }
+
+  void releaseConfirmedMessages() {
+    auto& reliable = _state.reliable;
+    if (reliable.count == 0) {
+      reliable.transfersWithoutProgress = 0;
       return;
+    }
 
-    LINK_BARRIER;
+    // a message is confirmed when all the other online players confirmed it
+    u32 confirmed = reliable.count;
+    u8 lastReleasedId = previousId(reliable.firstId);
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      if (i == state.currentPlayerId || !isOnline(i))
+        continue;
+
+      u8 ackId = reliable.lastAckedIds[i];
+      u32 acked = ackId != 0 ? idDistance(lastReleasedId, ackId) : 0;
+      if (acked > reliable.count)
+        acked = 0;
+      if (acked < confirmed)
+        confirmed = acked;
+    }
+
+    if (confirmed > 0) {
+      LINK_TRACE(CABLE, ACK, reliable.firstId, confirmed);
+      reliable.firstId = idAt(confirmed);
+      reliable.count -= confirmed;
+      reliable.cursor =
+          reliable.cursor > confirmed ? reliable.cursor - confirmed : 0;
+      reliable.transfersWithoutProgress = 0;
+      return;
+    }
+
+    // go-back-N: no progress in a while, so transfer the window again
+    reliable.transfersWithoutProgress++;
+    if (reliable.transfersWithoutProgress >= RELIABLE_RETRANSMIT_DELAY &&
+        reliable.cursor > 0 && reliable.sendingId == 0) {
+      LINK_STATS_COUNT(retransmissions);
+      _state.hadErrors = true;
+      LINK_TRACE(CABLE, RETRANSMIT, reliable.firstId, reliable.count);
+      reliable.cursor = 0;
+      reliable.transfersWithoutProgress = 0;
+    }
+  }
+
+  u16 nextReliableWord() {
+    auto& reliable = _state.reliable;
+
+    if (reliable.sendingId != 0) {
+      u8 id = reliable.sendingId;
+      reliable.sendingId = 0;
+      reliable.isAckPending = false;
+      if (reliable.cursor < reliable.count && idAt(reliable.cursor) == id)
+        reliable.cursor++;
+      return RELIABLE_SECOND | ((reliable.window[id] & 0b11111) << 9) |
+             ackBits();
+    }
+
+    if (reliable.cursor == reliable.count &&
+        reliable.count < RELIABLE_WINDOW && hasOutgoingMessages()) {
+      reliable.window[idAt(reliable.count)] = popOutgoing();
+      reliable.count++;
+    }
+
+    if (reliable.cursor < reliable.count) {
+      u8 id = idAt(reliable.cursor);
+      if (reliable.cursor == 0 && !reliable.isStartSent && hasNewPeers()) {
+        // (peers that didn't receive anything yet only accept this ID)
+        reliable.isStartSent = true;
+        reliable.isAckPending = false;
+        return RELIABLE_START | (id << 10) | ackBits();
+      }
+      reliable.isStartSent = false;
+      reliable.sendingId = id;
+      return RELIABLE_FIRST | (id << 11) | (reliable.window[id] >> 5);
+    }
+
+    if (reliable.isAckPending) {
+      reliable.isAckPending = false;
+      return RELIABLE_ACK | ackBits();
+    }
 
-    transfer(_state.outgoingMessages.pop());
+    return LINK_CABLE_NO_DATA;
+  }
+
+  bool hasNewPeers() {
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      if (i != state.currentPlayerId && isOnline(i) &&
+          _state.reliable.lastAckedIds[i] == 0)
+        return true;
+    }
+    return false;
+  }
+
+  u16 ackBits() {
+    u16 bits = 0;
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      if (i != state.currentPlayerId)
+        bits |= _state.reliable.lastReceivedIds[i]
+                << (ackSlot(i, state.currentPlayerId) * 3);
+    }
+    return bits;
+  }
+
+  u8 idAt(u32 offset) {
+    u32 id = _state.reliable.firstId + offset;
+    return id > RELIABLE_MAX_ID ? id - RELIABLE_MAX_ID : id;
+  }
+
+  static u8 nextId(u8 id) { return id == RELIABLE_MAX_ID ? 1 : id + 1; }
+  static u8 previousId(u8 id) { return id == 1 ? RELIABLE_MAX_ID : id - 1; }
+  static u32 idDistance(u8 from, u8 to) {
+    int distance = to - from;
+    return distance < 0 ? distance + RELIABLE_MAX_ID : distance;
+  }
+
+  /**
+   * @brief Returns the ACK slot (`0~2`) that `senderId` uses for `playerId`.
+   */
+  static u32 ackSlot(u32 playerId, u32 senderId) {
+    return playerId < senderId ? playerId : playerId - 1;
+  }
+
+  void resetReliablePeer(u8 playerId) {
+    _state.reliable.lastReceivedIds[playerId] = 0;
+    _state.reliable.lastAckedIds[playerId] = 0;
+    _state.reliable.firstWords[playerId] = 0;
+    _state.reliable.startIds[playerId] = 0;
+  }
+
+  template <typename F>
+  void encodePacket(const u8* data, u32 length, F emit) {
+    emit((u16)length);
+
+    for (u32 i = 0; i < length; i += 2) {
+      u16 word = data[i] | (i + 1 < length ? data[i + 1] << 8 : 0);
+      u16 encoded = word ^ PACKET_MASK;
+
+      if (encoded == LINK_CABLE_NO_DATA || encoded == LINK_CABLE_DISCONNECTED ||
+          encoded == PACKET_ESCAPE) {
+        emit(PACKET_ESCAPE);
+        emit((u16)(encoded - PACKET_ESCAPE_BASE));
+      } else {
+        emit(encoded);
+      }
+    }
   }
 
   void transfer(u16 data) {
+    LINK_TRACE(CABLE, TRANSFER_START, data, 0);
     LinkRawCable::setData(data);
 
     if (LinkRawCable::isMasterNode())
       LinkRawCable::startTransfer();
   }
 
-  void reset() {
-    resetState();
+  void reset(bool keepMessages = false) {
+    resetState(keepMessages);
     stop();
     start();
   }
 
-  void resetState() {
+  void resetState(bool keepMessages = false) {
     LINK_BARRIER;
     state.playerCount = 1;
     state.currentPlayerId = 0;
 
-    _state.outgoingMessages.syncClear();
-
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++) {
-      if (!isReadingMessages)
-        _state.readyToSyncMessages[i].clear();
+    auto& reliable = _state.reliable;
+    reliable.cursor = 0;
+    reliable.sendingId = 0;
+    reliable.isStartSent = false;
+    reliable.transfersWithoutProgress = 0;
+    if (!keepMessages) {
+      _state.outgoingMessages.clear();
+      _state.urgentMessages.clear();
+      _state.urgentStreak = 0;
+      _state.pendingChannelWord = LINK_CABLE_NO_DATA;
+      reliable.firstId = 1;
+      reliable.count = 0;
+      reliable.isAckPending = false;
+    }
 
-      _state.newMessages[i].clear();
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      if (!keepMessages) {
+        backBuffer().messages[i].syncClear();
+        backBuffer().urgentMessages[i].syncClear();
+        resetReliablePeer(i);
+        _state.isChannelEscaped[i] = false;
+      }
+      reliable.firstWords[i] = 0;
       setOffline(i);
 
-      _state.newMessages[i].overflow = false;
-      state.syncedIncomingMessages[i].overflow = false;
+      _state.buffers[0].messages[i].overflow = false;
+      _state.buffers[1].messages[i].overflow = false;
+      _state.buffers[0].urgentMessages[i].overflow = false;
+      _state.buffers[1].urgentMessages[i].overflow = false;
     }
     _state.IRQFlag = false;
     _state.IRQTimeout = 0;
     _state.isResetTimeoutPending = false;
+    _state.isBurstGap = false;
+    _state.burstTransfers = 0;
     LINK_BARRIER;
   }
 
@@ -519,32 +1193,45 @@ class LinkCable {
         Link::_REG_TM[config.sendTimerId].cnt & (~Link::_TM_ENABLE);
   }
 
+  void updateInterval() {
+    bool hadErrors = _state.hadErrors;
+    _state.hadErrors = false;
+
+    u32 pending =
+        _state.outgoingMessages.size() + _state.urgentMessages.size();
+    if (intervalController.update(pending, QueueSize + UrgentQueueSize,
+                                  hadErrors)) {
+      // (the new reload value is used after the next overflow)
+      Link::_REG_TM[config.sendTimerId].start = -intervalController.interval();
+    }
+  }
+
   void startTimer() {
-    Link::_REG_TM[config.sendTimerId].start = -config.interval;
+    Link::_REG_TM[config.sendTimerId].start = -getInterval();
     Link::_REG_TM[config.sendTimerId].cnt =
         Link::_TM_ENABLE | Link::_TM_IRQ | BASE_FREQUENCY;
   }
 
   void clearIncomingMessages() {
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++)
-      state.syncedIncomingMessages[i].clear();
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      frontBuffer().messages[i].clear();
+      frontBuffer().urgentMessages[i].clear();
+      _packetReaders[i].reset();
+    }
   }
 
-  void copyState() {
-    if (isReadingMessages)
-      return;
-
-    for (u32 i = 0; i < LINK_CABLE_MAX_PLAYERS; i++) {
-      if (isOnline(i))
-        move(_state.newMessages[i], _state.readyToSyncMessages[i]);
-      else
-        _state.readyToSyncMessages[i].clear();
-    }
+  MessageBuffer& backBuffer() { return _state.buffers[_state.backBufferIndex]; }
+  MessageBuffer& frontBuffer() {
+    return _state.buffers[!_state.backBufferIndex];
   }
 
-  void move(U16Queue& src, U16Queue& dst) {
-    while (!src.isEmpty() && !dst.isFull())
-      dst.push(src.pop());
+  bool isFrontBufferEmpty() {
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      if (!frontBuffer().messages[i].isEmpty() ||
+          !frontBuffer().urgentMessages[i].isEmpty())
+        return false;
+    }
+    return true;
   }
 
   bool isOnline(u8 playerId) {
@@ -562,6 +1249,8 @@ class LinkCable {
   }
 };
 
+using LinkCable = LinkCableT<>;
+
 extern LinkCable* linkCable;
 
 /**
@@ -588,19 +1277,64 @@ inline void LINK_CABLE_ISR_TIMER() {
 /**
  * NOTES:
  * For end users:
- *   - `sync()` fills an incoming queue (`syncedIncomingMessages`).
- *   - `read(...)` pops one message from that queue.
+ *   - `sync()` fills the incoming queues (the *front* buffer).
+ *   - `read(...)` pops one message from those queues.
  *   - `send(...)` pushes one message to an outgoing queue (`outgoingMessages`).
+ *   - `sendUrgent(...)` pushes one message to a second outgoing queue
+ *     (`urgentMessages`), which is always drained first. With
+ *     `config.urgentWeight` = N > 0, one bulk message is sent after every N
+ *     urgent ones (if there's a backlog), so bulk traffic can't starve.
+ *   - Urgent messages are sent as `CHANNEL_ESCAPE` (0xFFFC) + the message,
+ *     and bulk messages that happen to be 0xFFFC are sent twice. Receivers
+ *     undo this and push urgent messages to separate incoming queues
+ *     (`readUrgent(...)`), so urgent messages can interrupt a packet
+ *     without breaking it.
+ *   - `sendPacket(...)` pushes a header word (the length) and then the bytes,
+ *     two per word, XORed with 0x8000 (so zeros don't collide with
+ *     `LINK_CABLE_NO_DATA`). The few words that still collide with a reserved
+ *     value (0x0, 0xFFFF or the escape value 0xFFFE) are sent as 2 words.
+ *   - `receivePacket(...)` pops words from the incoming queues into a
+ *     reassembly buffer per player, until a whole packet is there.
+ *   - If `config.onReceive` is set, the queues are not used: each message is
+ *     passed to the callback from the SERIAL IRQ (in reliable mode, only
+ *     after it was accepted in order). Urgent and bulk messages both go to
+ *     the callback.
  * Behind the curtains:
  *   - On each SERIAL IRQ:
- *     -> Each new message is pushed to `newMessages`.
- *   - On each VBLANK, SERIAL, or TIMER IRQ:
- *     -> **If the user is not syncing**:
- *       -> All `newMessages` are moved to `readyToSyncMessages`.
+ *     -> Each new message is pushed to the *back* buffer.
  *   - If (playerId == 0 && TIMER_IRQ) || (playerId > 0 && SERIAL_IRQ):
- *     -> **If the user is not sending**:
- *       -> Pops one message from `outgoingMessages` and transfers it.
- *   - `sync()` moves all `readyToSyncMessages` to `syncedIncomingMessages`.
+ *     -> Pops one message from `urgentMessages` or `outgoingMessages` and
+ *        transfers it.
+ *   - If (playerId == 0 && SERIAL_IRQ) and `config.burstSize` > 1:
+ *     -> If there's still a backlog and the tick's budget isn't spent, the
+ *        timer is re-armed with a `BURST_GAP` delay, and that TIMER_IRQ
+ *        transfers the next message (and restarts the regular period).
+ *     -> Slaves don't need to know: they always answer from the SERIAL IRQ.
+ *   - `sync()`:
+ *     -> If the front buffer is empty, swaps both buffers (no copies).
+ *     -> Otherwise, moves the back buffer's messages to the front buffer.
+ *   - `outgoingMessages`, `urgentMessages` and the back buffer are
+ *     single-producer / single-consumer ring buffers, so the user and the
+ *     ISRs never block each other.
+ * Reliable mode:
+ *   - Each message takes 2 words: `10 III DDDDDDDDDDD` (the ID, 1~7, and
+ *     the high 11 bits) and then `01 DDDDD AAA AAA AAA` (the low 5 bits and
+ *     3 ACK slots, one per other player). When there's nothing to send but
+ *     ACKs changed, `110 0000 AAA AAA AAA` is sent instead. No word can be
+ *     0x0 or 0xFFFF, so messages are never confused with idle transfers.
+ *   - Before transferring the window from its start, if an online player
+ *     didn't confirm anything yet, `111 III 0 AAA AAA AAA` announces the
+ *     oldest unconfirmed ID. Until a player accepts its first message from a
+ *     sender, it only accepts the ID of the last start marker (so that a lost
+ *     or rejected first message can't be skipped).
+ *   - Each ACK slot holds the last ID received in order from that player.
+ *     Up to 6 messages can be in flight. They're released when all the other
+ *     online players confirmed them, and if there's no progress in
+ *     `RELIABLE_RETRANSMIT_DELAY` transfers, the whole window is sent again
+ *     (go-back-N). Receivers drop out-of-order messages and messages that
+ *     don't fit in their queue, so nothing gets confirmed before it's stored.
+ *   - Transfer errors keep the queues and the window (the unconfirmed
+ *     messages are retransmitted after the reset). Timeouts don't.
  */
 
 #endif  // LINK_CABLE_H
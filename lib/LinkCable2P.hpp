@@ -0,0 +1,695 @@
+#ifndef LINK_CABLE_2P_H
+#define LINK_CABLE_2P_H
+
+// --------------------------------------------------------------------------
+// A 2-player Link Cable connection for Normal Mode (32 bits).
+// It has the same API as LinkCable, but it's built on top of LinkSPI.
+// --------------------------------------------------------------------------
+// Usage:
+// - 1) Include this header in your main.cpp file and add:
+//       LinkCable2P* linkCable2P = new LinkCable2P();
+// - 2) Add the required interrupt service routines: (*)
+//       interrupt_init();
+//       interrupt_add(INTR_VBLANK, LINK_CABLE_2P_ISR_VBLANK);
+//       interrupt_add(INTR_SERIAL, LINK_CABLE_2P_ISR_SERIAL);
+//       interrupt_add(INTR_TIMER3, LINK_CABLE_2P_ISR_TIMER);
+// - 3) Initialize the library with:
+//       linkCable2P->activate();
+//       // (use the same code on both ends, roles are negotiated)
+// - 4) Sync:
+//       linkCable2P->sync();
+//       // (put this line at the start of your game loop)
+// - 5) Send/read messages by using:
+//       bool isConnected = linkCable2P->isConnected();
+//       u8 currentPlayerId = linkCable2P->currentPlayerId();
+//       linkCable2P->send(0x1234);
+//       if (isConnected && linkCable2P->canRead(!currentPlayerId)) {
+//         u16 message = linkCable2P->read(!currentPlayerId);
+//         // ...
+//       }
+// - 6) (Optional) Receive messages as soon as they arrive, instead of
+//      polling with `sync()` and `read(...)`:
+//       linkCable2P->config.onReceive = [](u8 playerId, u16 data) {
+//         // (called from the SERIAL IRQ: keep it short!)
+//       };
+// --------------------------------------------------------------------------
+// (*) libtonc's interrupt handler sometimes ignores interrupts due to a bug.
+//     That causes packet loss. You REALLY want to use libugba's instead.
+//     (see examples)
+// --------------------------------------------------------------------------
+// considerations:
+// - use a GBC Link Cable! (Normal Mode needs the SI/SO lines crossed)
+// - only use the 2Mbps speed with custom hardware (very short wires)!
+// --------------------------------------------------------------------------
+// `send(...)` restrictions:
+// - 0xFFFF and 0x0 are reserved values, so don't send them!
+//   (they mean 'disconnected' and 'no data' respectively)
+// --------------------------------------------------------------------------
+
+#ifndef LINK_DEVELOPMENT
+#pragma GCC system_header
+#endif
+
+#include "_link_common.hpp"
+
+#include "LinkSPI.hpp"
+
+#ifndef LINK_CABLE_2P_QUEUE_SIZE
+/**
+ * @brief Buffer size (how many incoming and outgoing messages the queues can
+ * store at max). The default value is `30`, since each transfer can carry 2
+ * messages and transfers are more frequent than in `LinkCable`.
+ * \warning This affects how much memory is allocated. With the default value,
+ * it's around `200` bytes. There's a double-buffered incoming queue (swapped
+ * on `sync()`) and 1 outgoing queue.
+ * \warning Queues are ring buffers, so their storage is rounded up to the
+ * next power of two (`32` for the default value).
+ */
+#define LINK_CABLE_2P_QUEUE_SIZE 30
+#endif
+
+LINK_VERSION_TAG LINK_CABLE_2P_VERSION = "vLinkCable2P/v8.0.3";
+
+#define LINK_CABLE_2P_PLAYERS 2
+#define LINK_CABLE_2P_DEFAULT_TIMEOUT 3
+#define LINK_CABLE_2P_DEFAULT_INTERVAL 10
+#define LINK_CABLE_2P_DEFAULT_SEND_TIMER_ID 3
+#define LINK_CABLE_2P_DISCONNECTED 0xFFFF
+#define LINK_CABLE_2P_NO_DATA 0x0
+
+/**
+ * @brief A 2-player Link Cable connection for Normal Mode (32 bits).
+ * @tparam QueueSize Buffer size (see `LINK_CABLE_2P_QUEUE_SIZE`).
+ * \warning `LinkCable2P` is an alias for the default configuration.
+ */
+template <Link::u32 QueueSize = LINK_CABLE_2P_QUEUE_SIZE>
+class LinkCable2PT {
+ private:
+  using u32 = Link::u32;
+  using u16 = Link::u16;
+  using u8 = Link::u8;
+  using vu8 = Link::vu8;
+  using U16Queue = Link::RingBuffer<u16, QueueSize>;
+
+  static constexpr auto BASE_FREQUENCY = Link::_TM_FREQ_1024;
+  static constexpr u32 NO_DATA = LINK_SPI_NO_DATA_32;
+  static constexpr u32 HANDSHAKE_MASTER = 0xFFFF4D41;  // (high half = 0xFFFF,
+  static constexpr u32 HANDSHAKE_SLAVE = 0xFFFF534C;   //  so it's not data)
+  static constexpr u32 LISTEN_FRAMES_MASK = 0b111;     // (1~8 frames)
+  static constexpr u32 CALL_FRAMES = 2;
+
+ public:
+  enum class Speed { SPEED_256KBPS, SPEED_2MBPS };
+
+  /**
+   * @brief Constructs a new LinkCable2P object.
+   * @param speed Sets the SPI clock speed (used by the master).
+   * @param timeout Number of *frames* without a successful transfer to reset
+   * the connection.
+   * @param interval Number of *1024-cycle ticks* (61.04μs) between transfers
+   * *(10 = 0.61ms)*. It's the interval of Timer #`sendTimerId`. Lower values
+   * will transfer faster but also consume more CPU. Each transfer carries up
+   * to 2 messages in each direction.
+   * @param sendTimerId `(0~3)` GBA Timer to use for sending.
+   * \warning You can use `Link::perFrame(...)` to convert from *packets per
+   * frame* to *interval values*.
+   * \warning A 32-bit transfer takes ~2 ticks at 256Kbps, so intervals lower
+   * than `3` won't transfer any faster.
+   */
+  explicit LinkCable2PT(Speed speed = Speed::SPEED_256KBPS,
+                        u32 timeout = LINK_CABLE_2P_DEFAULT_TIMEOUT,
+                        u16 interval = LINK_CABLE_2P_DEFAULT_INTERVAL,
+                        u8 sendTimerId = LINK_CABLE_2P_DEFAULT_SEND_TIMER_ID) {
+    config.speed = speed;
+    config.timeout = timeout;
+    config.interval = interval;
+    config.sendTimerId = sendTimerId;
+    config.onReceive = nullptr;
+  }
+
+  /**
+   * @brief Returns whether the library is active or not.
+   */
+  [[nodiscard]] bool isActive() { return isEnabled; }
+
+  /**
+   * @brief Activates the library.
+   */
+  void activate() {
+    LINK_READ_TAG(LINK_CABLE_2P_VERSION);
+    static_assert(QueueSize >= 2);
+
+    LINK_BARRIER;
+    isEnabled = false;
+    LINK_BARRIER;
+
+    LINK_STATS_START;
+    // (set before LinkSPI, so the SERIAL IRQ is forwarded from here)
+    LINK_IRQ_SET(Link::_IRQ_VBLANK, LinkCable2PT, _onVBlank);
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkCable2PT, _onSerial);
+    LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[config.sendTimerId], LinkCable2PT,
+                 _onTimer);
+    _state.seed += Link::_REG_VCOUNT;
+    reset();
+    clearIncomingMessages();
+
+    LINK_BARRIER;
+    isEnabled = true;
+    LINK_BARRIER;
+  }
+
+  /**
+   * @brief Deactivates the library.
+   */
+  void deactivate() {
+    LINK_BARRIER;
+    isEnabled = false;
+    LINK_BARRIER;
+
+    Link::IRQ::unsetAll(this);
+    resetState();
+    stop();
+    clearIncomingMessages();
+  }
+
+  /**
+   * @brief Returns `true` if both players are connected.
+   */
+  [[nodiscard]] bool isConnected() { return state.playerCount > 1; }
+
+  /**
+   * @brief Returns the number of connected players (`1~2`).
+   */
+  [[nodiscard]] u8 playerCount() { return state.playerCount; }
+
+  /**
+   * @brief Returns the current player ID (`0~1`). The player who ended up as
+   * the master is `0`.
+   */
+  [[nodiscard]] u8 currentPlayerId() { return state.currentPlayerId; }
+
+  /**
+   * @brief Collects available messages from interrupts for later processing
+   * with `read(...)`. Call this method whenever you need to fetch new data, and
+   * always process all messages before calling it again.
+   * \warning If `config.onReceive` is set, messages go to the callback instead,
+   * so the queue stays empty.
+   */
+  void sync() {
+    if (!isEnabled)
+      return;
+
+    if (frontBuffer().isEmpty()) {
+      // (the ISRs can't interrupt the swap, so this is the whole handover)
+      LINK_BARRIER;
+      _state.backBufferIndex = !_state.backBufferIndex;
+      LINK_BARRIER;
+    } else {
+      backBuffer().moveTo(frontBuffer());
+    }
+
+    if (!isConnected())
+      clearIncomingMessages();
+  }
+
+  /**
+   * @brief Waits for data from player #`playerId`. Returns `true` on success,
+   * or `false` on disconnection.
+   * @param playerId A player ID.
+   */
+  bool waitFor(u8 playerId) {
+    return waitFor(playerId, []() { return false; });
+  }
+
+  /**
+   * @brief Waits for data from player #`playerId`. Returns `true` on success,
+   * or `false` on disconnection.
+   * @param playerId ID of player to wait data from.
+   * @param cancel A function that will be continuously invoked. If it returns
+   * `true`, the wait be aborted.
+   */
+  template <typename F>
+  bool waitFor(u8 playerId, F cancel) {
+    if (!isEnabled)
+      return false;
+
+    sync();
+
+    while (isConnected() && !canRead(playerId) && !cancel()) {
+      Link::_IntrWait(
+          1, Link::_IRQ_SERIAL | Link::_TIMER_IRQ_IDS[config.sendTimerId]);
+      sync();
+    }
+
+    return isConnected() && canRead(playerId);
+  }
+
+  /**
+   * @brief Returns `true` if there are pending messages from player
+   * #`playerId`.
+   * @param playerId A player ID.
+   * \warning Keep in mind that if this returns `false`, it will keep doing so
+   * until you *fetch new data* with `sync()`.
+   */
+  [[nodiscard]] bool canRead(u8 playerId) {
+    return isRemote(playerId) && !frontBuffer().isEmpty();
+  }
+
+  /**
+   * @brief Dequeues and returns the next message from player #`playerId`.
+   * @param playerId A player ID.
+   * \warning If there's no data from that player, a `0` will be returned.
+   */
+  u16 read(u8 playerId) {
+    return isRemote(playerId) ? frontBuffer().pop() : LINK_CABLE_2P_NO_DATA;
+  }
+
+  /**
+   * @brief Returns the next message from player #`playerId` without dequeuing
+   * it.
+   * @param playerId A player ID.
+   * \warning If there's no data from that player, a `0` will be returned.
+   */
+  [[nodiscard]] u16 peek(u8 playerId) {
+    return isRemote(playerId) ? frontBuffer().peek() : LINK_CABLE_2P_NO_DATA;
+  }
+
+  /**
+   * @brief Sends `data` to the other player.
+   * @param data The value to be sent.
+   * \warning If `data` is invalid or the send queue is full, a `false` will be
+   * returned.
+   */
+  bool send(u16 data) {
+    if (!isEnabled || data == LINK_CABLE_2P_DISCONNECTED ||
+        data == LINK_CABLE_2P_NO_DATA || !canSend())
+      return false;
+
+    _state.outgoingMessages.push(data);
+    LINK_STATS_MARK(outgoingHighWaterMark, _state.outgoingMessages.size());
+    return true;
+  }
+
+  /**
+   * @brief Returns whether a `send(...)` call would fail due to the queue being
+   * full.
+   */
+  bool canSend() { return !_state.outgoingMessages.isFull(); }
+
+  /**
+   * @brief Returns whether the internal queue lost messages at some point due
+   * to being full. This can happen if your queue size is too low, if you
+   * receive too much data without calling `sync(...)` enough times, or if you
+   * don't `read(...)` enough messages before the next `sync()` call. After this
+   * call, the overflow flag is cleared if `clear` is `true` (default behavior).
+   */
+  bool didQueueOverflow(bool clear = true) {
+    bool overflow = false;
+
+    for (u32 i = 0; i < 2; i++) {
+      overflow = overflow || _state.buffers[i].overflow;
+      if (clear)
+        _state.buffers[i].overflow = false;
+    }
+
+    return overflow;
+  }
+
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
+  /**
+   * @brief Resets the other player's timeout count to `0`.
+   * \warning Call this if you changed `config.timeout`.
+   */
+  void resetTimeout() {
+    if (!isEnabled)
+      return;
+
+    LINK_BARRIER;
+    _state.isResetTimeoutPending = true;
+    LINK_BARRIER;
+  }
+
+  /**
+   * @brief Restarts the send timer without disconnecting.
+   * \warning Call this if you changed `config.interval`.
+   */
+  void resetTimer() {
+    if (!isEnabled)
+      return;
+
+    stopTimer();
+    startTimer();
+  }
+
+  /**
+   * @brief This method is called by the VBLANK interrupt handler.
+   * \warning This is internal API!
+   */
+  void _onVBlank() {
+    LINK_STATS_ISR(vblank);
+    if (!isEnabled)
+      return;
+
+    if (_state.isResetTimeoutPending) {
+      _state.IRQTimeout = 0;
+      _state.isResetTimeoutPending = false;
+    }
+
+    if (_state.role == Role::LISTENING || _state.role == Role::CALLING) {
+      negotiate();
+      return;
+    }
+
+    if (!_state.IRQFlag)
+      _state.IRQTimeout++;
+    _state.IRQFlag = false;
+
+    if (_state.IRQTimeout >= config.timeout) {
+      LINK_STATS_COUNT(timeouts);
+      LINK_STATS_COUNT(resets);
+      LINK_TRACE(CABLE_2P, TIMEOUT, state.currentPlayerId, _state.IRQTimeout);
+      reset();
+    }
+  }
+
+  /**
+   * @brief This method is called by the SERIAL interrupt handler.
+   * \warning This is internal API!
+   */
+  void _onSerial() {
+    LINK_STATS_ISR(serial);
+    if (!isEnabled)
+      return;
+
+    linkSPI._onSerial();
+    if (linkSPI.getAsyncState() != LinkSPI::AsyncState::READY)
+      return;
+    u32 data = linkSPI.getAsyncData();
+
+    switch (_state.role) {
+      case Role::LISTENING: {
+        // (someone clocked this transfer, so they're the master)
+        if (data == NO_DATA) {
+          linkSPI.transferAsync(HANDSHAKE_SLAVE);
+          return;
+        }
+        setRole(Role::SLAVE);
+        break;
+      }
+      case Role::CALLING: {
+        // (nobody answered, or the other end is also calling)
+        if (data == NO_DATA || data == HANDSHAKE_MASTER)
+          return;
+        setRole(Role::MASTER);
+        break;
+      }
+      case Role::MASTER: {
+        if (data == NO_DATA)
+          return;
+        break;
+      }
+      default:
+        break;
+    }
+
+    _state.IRQFlag = true;
+    _state.IRQTimeout = 0;
+    receive(data);
+
+    if (_state.role == Role::SLAVE)
+      transfer(nextWord());
+  }
+
+  /**
+   * @brief This method is called by the TIMER interrupt handler.
+   * \warning This is internal API!
+   */
+  void _onTimer() {
+    LINK_STATS_ISR(timer);
+    if (!isEnabled)
+      return;
+
+    if (_state.role != Role::MASTER && _state.role != Role::CALLING)
+      return;
+
+    // (`SI` is the slave's `SO`, which is LOW when it's ready)
+    if (linkSPI.getAsyncState() != LinkSPI::AsyncState::IDLE ||
+        linkSPI._isSIHigh())
+      return;
+
+    transfer(_state.role == Role::CALLING ? HANDSHAKE_MASTER : nextWord());
+  }
+
+  struct Config {
+    Speed speed;
+    u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
+    u16 interval;  // can be changed in realtime, but call `resetTimer()`
+    u8 sendTimerId;
+    Link::ReceiveCallback onReceive;  // (if set, messages skip the queue)
+  };
+
+  /**
+   * @brief LinkCable2P configuration.
+   * \warning `deactivate()` first, change the config, and `activate()` again!
+   */
+  Config config;
+
+#ifndef LINK_CABLE_2P_DEBUG_MODE
+ private:
+#endif
+  enum class Role : u8 {
+    LISTENING,  // (negotiating as a slave, waiting to be clocked)
+    CALLING,    // (negotiating as a master, trying to clock the other end)
+    MASTER,
+    SLAVE
+  };
+
+  struct ExternalState {
+    vu8 playerCount = 1;
+    vu8 currentPlayerId = 0;
+  };
+
+  struct InternalState {
+    U16Queue outgoingMessages;
+    U16Queue buffers[2];       // back: write by irq ; front: read by user
+    vu8 backBufferIndex = 0;   // (flipped by the user on `sync()`)
+    volatile Role role = Role::LISTENING;
+    u32 negotiationFrames = 0;  // (frames left before switching roles)
+    u32 seed = 0;
+    u32 IRQTimeout = 0;
+    bool IRQFlag = false;
+    volatile bool isResetTimeoutPending = false;
+  };
+
+  ExternalState state;
+  InternalState _state;
+  LinkSPI linkSPI;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
+  volatile bool isEnabled = false;
+
+  bool isRemote(u8 playerId) { return playerId == !state.currentPlayerId; }
+
+  void receive(u32 data) {
+    u16 first = data & 0xFFFF;
+    u16 second = data >> 16;
+    if (first == LINK_CABLE_2P_DISCONNECTED ||
+        second == LINK_CABLE_2P_DISCONNECTED)
+      return;  // (handshakes)
+
+    LINK_TRACE(CABLE_2P, WORD_RECEIVED, data, 0);
+    if (first != LINK_CABLE_2P_NO_DATA)
+      push(first);
+    if (second != LINK_CABLE_2P_NO_DATA)
+      push(second);
+  }
+
+  void push(u16 message) {
+    if (config.onReceive) {
+      config.onReceive(!state.currentPlayerId, message);
+      return;
+    }
+
+    auto& messages = backBuffer();
+    if (!messages.push(message)) {
+      LINK_STATS_COUNT(overflows);
+      LINK_TRACE(CABLE_2P, QUEUE_OVERFLOW, message, 0);
+      return;
+    }
+    LINK_STATS_MARK(incomingHighWaterMark, messages.size());
+  }
+
+  u32 nextWord() {
+    // (2 messages per transfer, the first one in the low half)
+    u32 first = _state.outgoingMessages.pop();
+    u32 second = _state.outgoingMessages.pop();
+    return first | (second << 16);
+  }
+
+  void transfer(u32 data) {
+    LINK_TRACE(CABLE_2P, TRANSFER_START, data, (u32)_state.role);
+    linkSPI.transferAsync(data);
+  }
+
+  void negotiate() {
+    if (_state.negotiationFrames > 0) {
+      _state.negotiationFrames--;
+      return;
+    }
+
+    if (_state.role == Role::LISTENING)
+      call();
+    else
+      listen();
+  }
+
+  void listen() {
+    // slaves are clocked by the other end, so this side just waits with its
+    // `SO` LOW (ready) until someone starts a transfer
+    _state.role = Role::LISTENING;
+    _state.negotiationFrames = nextRandom() & LISTEN_FRAMES_MASK;
+    linkSPI.activate(LinkSPI::Mode::SLAVE);
+    linkSPI.transferAsync(HANDSHAKE_SLAVE);
+  }
+
+  void call() {
+    _state.role = Role::CALLING;
+    _state.negotiationFrames = CALL_FRAMES;
+    linkSPI.activate(config.speed == Speed::SPEED_2MBPS
+                         ? LinkSPI::Mode::MASTER_2MBPS
+                         : LinkSPI::Mode::MASTER_256KBPS);
+  }
+
+  void setRole(Role role) {
+    LINK_TRACE(CABLE_2P, STATE_CHANGE, (u32)role, (u32)_state.role);
+
+    LINK_BARRIER;
+    _state.role = role;
+    state.currentPlayerId = role == Role::MASTER ? 0 : 1;
+    state.playerCount = LINK_CABLE_2P_PLAYERS;
+    LINK_BARRIER;
+  }
+
+  u32 nextRandom() {
+    // (both ends run the same code, so the timer and VCOUNT add some entropy)
+    _state.seed = _state.seed * 1103515245 + 12345 + Link::_REG_VCOUNT +
+                  Link::_REG_TM[config.sendTimerId].count;
+    return _state.seed >> 16;
+  }
+
+  void reset() {
+    resetState();
+    stop();
+    start();
+  }
+
+  void resetState() {
+    LINK_BARRIER;
+    state.playerCount = 1;
+    state.currentPlayerId = 0;
+    _state.role = Role::LISTENING;
+    _state.outgoingMessages.clear();
+    backBuffer().syncClear();
+    _state.buffers[0].overflow = false;
+    _state.buffers[1].overflow = false;
+    _state.IRQFlag = false;
+    _state.IRQTimeout = 0;
+    _state.isResetTimeoutPending = false;
+    LINK_BARRIER;
+  }
+
+  void stop() {
+    stopTimer();
+    linkSPI.deactivate();
+  }
+
+  void start() {
+    startTimer();
+    listen();
+  }
+
+  void stopTimer() {
+    Link::_REG_TM[config.sendTimerId].cnt =
+        Link::_REG_TM[config.sendTimerId].cnt & (~Link::_TM_ENABLE);
+  }
+
+  void startTimer() {
+    Link::_REG_TM[config.sendTimerId].start = -config.interval;
+    Link::_REG_TM[config.sendTimerId].cnt =
+        Link::_TM_ENABLE | Link::_TM_IRQ | BASE_FREQUENCY;
+  }
+
+  void clearIncomingMessages() { frontBuffer().clear(); }
+
+  U16Queue& backBuffer() { return _state.buffers[_state.backBufferIndex]; }
+  U16Queue& frontBuffer() { return _state.buffers[!_state.backBufferIndex]; }
+};
+
+using LinkCable2P = LinkCable2PT<>;
+
+extern LinkCable2P* linkCable2P;
+
+/**
+ * @brief VBLANK interrupt handler.
+ */
+inline void LINK_CABLE_2P_ISR_VBLANK() {
+  linkCable2P->_onVBlank();
+}
+
+/**
+ * @brief SERIAL interrupt handler.
+ */
+inline void LINK_CABLE_2P_ISR_SERIAL() {
+  linkCable2P->_onSerial();
+}
+
+/**
+ * @brief TIMER interrupt handler.
+ */
+inline void LINK_CABLE_2P_ISR_TIMER() {
+  linkCable2P->_onTimer();
+}
+
+/**
+ * NOTES:
+ * Roles:
+ *   - Normal Mode has a master (which provides the clock) and a slave, but
+ *     both ends run the same code, so roles are negotiated on `activate()`
+ *     and after every timeout.
+ *   - Each end starts *listening* as a slave, with `SO` LOW (ready) and a
+ *     handshake word loaded. After a random number of frames (1~8), it starts
+ *     *calling* as a master for 2 frames: on each timer tick, if `SI` is LOW
+ *     (the other end is a listening slave), it starts a transfer. Then it goes
+ *     back to listening.
+ *   - The first transfer between a caller and a listener assigns the roles on
+ *     both ends. If both end up calling at the same time, neither sees the
+ *     other as ready (or they receive each other's master handshake), so they
+ *     retry with new random delays.
+ * Transfers:
+ *   - Each 32-bit transfer carries up to 2 messages per direction (the first
+ *     one in the low half). Halves that are `0x0` are empty, and words with a
+ *     `0xFFFF` half are handshakes.
+ *   - The master transfers on each timer tick, but only if the slave is
+ *     ready (its `SO` is LOW), so it never clocks a slave that's still
+ *     loading its next word. The slave loads the next word from the SERIAL
+ *     IRQ, like `LinkCable` slaves.
+ *   - The incoming queue is double-buffered like in `LinkCable`. If
+ *     `config.onReceive` is set, messages are passed to the callback from the
+ *     SERIAL IRQ instead.
+ */
+
+#endif  // LINK_CABLE_2P_H
@@ -148,7 +148,7 @@ class LinkCableMultiboot {
     LINK_READ_TAG(LINK_CABLE_MULTIBOOT_VERSION);
 
     this->_mode = mode;
-    if ((u32)rom % 4 != 0)
+    if ((uintptr_t)rom % 4 != 0)
       return Result::UNALIGNED;
     if (romSize < MIN_ROM_SIZE || romSize > MAX_ROM_SIZE ||
         (romSize % 0x10) != 0)
@@ -516,7 +516,7 @@ class LinkCableMultiboot {
       if (state != State::STOPPED)
         return false;
 
-      if ((u32)rom % 4 != 0) {
+      if ((uintptr_t)rom % 4 != 0) {
         result = Result::UNALIGNED;
         return false;
       }
@@ -936,7 +936,7 @@ class LinkCableMultiboot {
       const u16* end = (u16*)(rom + romSize);
 
       fixedData.rom = start;
-      fixedData.romSize = (u32)end - (u32)start;
+      fixedData.romSize = (u32)((uintptr_t)end - (uintptr_t)start);
       fixedData.waitForReadySignal = waitForReadySignal;
       fixedData.transferMode = mode;
     }
@@ -166,7 +166,7 @@ class LinkCard {
    */
   template <typename F>
   SendResult sendLoader(const u8* loader, u32 loaderSize, F cancel) {
-    if ((u32)loader % 4 != 0)
+    if ((uintptr_t)loader % 4 != 0)
       return SendResult::UNALIGNED;
     if (loaderSize < MIN_LOADER_SIZE || loaderSize > MAX_LOADER_SIZE ||
         (loaderSize % 0x20) != 0)
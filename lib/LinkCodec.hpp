@@ -0,0 +1,415 @@
+#ifndef LINK_CODEC_H
+#define LINK_CODEC_H
+
+// --------------------------------------------------------------------------
+// A compression layer for batches of u16 messages (RLE + small LZ window).
+// It works with LinkCable, LinkWireless and LinkUniversal.
+// --------------------------------------------------------------------------
+// Usage:
+// - 1) Include this header in your main.cpp file and add:
+//       LinkCodec::Encoder<> encoder;
+//       LinkCodec::Decoder<> decoders[LINK_UNIVERSAL_MAX_PLAYERS];
+// - 2) Queue batches of messages (any u16 value is allowed):
+//       u16 entities[64];
+//       // ...
+//       encoder.send(entities, 64);
+// - 3) Once per frame, after `sync()`, send the compressed words:
+//       encoder.flush(linkUniversal);
+// - 4) Feed the received words to the decoder of each player:
+//       while (linkUniversal->canRead(playerId)) {
+//         if (decoders[playerId].push(linkUniversal->read(playerId))) {
+//           const u16* batch = decoders[playerId].data();
+//           u32 size = decoders[playerId].size();
+//           // ...
+//         }
+//       }
+//       // (with LinkWireless, push each `message.data` received with
+//       // `receive(...)` to `decoders[message.playerId]`)
+// --------------------------------------------------------------------------
+// considerations:
+// - the link must be reliable (a lost word breaks the current batch)!
+// - don't mix compressed and regular messages in the same link!
+// --------------------------------------------------------------------------
+
+#ifndef LINK_DEVELOPMENT
+#pragma GCC system_header
+#endif
+
+#include "_link_common.hpp"
+
+#ifndef LINK_CODEC_MAX_BATCH
+/**
+ * @brief Maximum number of messages per batch. The default value is `128`.
+ * \warning This affects how much memory is allocated. With the default value,
+ * each `Decoder` uses around `256` bytes and each `Encoder` around `1` KB.
+ */
+#define LINK_CODEC_MAX_BATCH 128
+#endif
+
+LINK_VERSION_TAG LINK_CODEC_VERSION = "vLinkCodec/v8.0.3";
+
+/**
+ * @brief A compression layer for batches of u16 messages.
+ * Each encoded word is one of these tokens (never `0x0` or `0xFFFF`):
+ * - `0x0001~0x7FFF`: A literal message.
+ * - `0x8000 | n`: `n + 1` zeros.
+ * - `0x9000 | (d << 6) | l`: Copy `l + 2` messages from `d + 1` positions
+ *   back (the last 64 messages of the batch; overlaps repeat a pattern).
+ * - `0xA000 | n`: `n + 1` raw messages follow (for values >= `0x8000`).
+ * - `0xB000 | n`: `n + 1` `0xFFFF` messages.
+ * - `0xF000 | n`: Batch header, `n` messages.
+ */
+class LinkCodec {
+ private:
+  using u32 = Link::u32;
+  using u16 = Link::u16;
+
+  static constexpr u16 KIND_MASK = 0xF000;
+  static constexpr u16 ARG_MASK = 0x0FFF;
+  static constexpr u16 ZERO_RUN = 0x8000;
+  static constexpr u16 MATCH = 0x9000;
+  static constexpr u16 RAW = 0xA000;
+  static constexpr u16 ONES_RUN = 0xB000;
+  static constexpr u16 HEADER = 0xF000;
+  static constexpr u32 MATCH_DISTANCE_SHIFT = 6;
+  static constexpr u32 MATCH_LENGTH_MASK = 0x3F;
+  static constexpr u32 MAX_RUN = ARG_MASK + 1;
+  static constexpr u32 WINDOW = 64;
+  static constexpr u32 MAX_MATCH = 65;
+  static constexpr u32 MIN_MATCH = 2;
+  static constexpr u32 MAX_LITERAL = 0x7FFF;
+
+ public:
+  static constexpr u32 MAX_BATCH_LIMIT = ARG_MASK - 1;  // (0xFFFF is reserved)
+
+  /**
+   * @brief Returns the maximum number of encoded words for a batch of
+   * `count` messages (the worst case is alternating high/low values).
+   */
+  static constexpr u32 maxEncodedSize(u32 count) {
+    return count + (count + 1) / 2 + 1;
+  }
+
+  /**
+   * @brief Encodes a batch of `count` messages, calling `emit(word)` for each
+   * encoded word. Returns the number of encoded words.
+   * @param messages The messages (any u16 value).
+   * @param count The number of messages `(1~MAX_BATCH_LIMIT)`.
+   * @param emit A function that receives each encoded word.
+   */
+  template <typename F>
+  static u32 encode(const u16* messages, u32 count, F emit) {
+    u32 words = 0;
+    u32 rawStart = 0;
+    u32 rawCount = 0;
+
+    auto put = [&](u16 word) {
+      emit(word);
+      words++;
+    };
+    auto flushRaw = [&]() {
+      if (rawCount == 0)
+        return;
+      put(RAW | (rawCount - 1));
+      for (u32 i = 0; i < rawCount; i++)
+        put(messages[rawStart + i]);
+      rawCount = 0;
+    };
+
+    put(HEADER | count);
+
+    u32 i = 0;
+    while (i < count) {
+      u16 value = messages[i];
+
+      u32 matchLength = 0;
+      u32 matchDistance = 0;
+      findMatch(messages, count, i, matchLength, matchDistance);
+
+      if (value == 0 || value == 0xFFFF) {
+        u32 run = runLength(messages, count, i);
+        if (run >= matchLength) {
+          flushRaw();
+          put((value == 0 ? ZERO_RUN : ONES_RUN) | (run - 1));
+          i += run;
+          continue;
+        }
+      }
+
+      if (matchLength >= MIN_MATCH) {
+        flushRaw();
+        put(MATCH | ((matchDistance - 1) << MATCH_DISTANCE_SHIFT) |
+            (matchLength - MIN_MATCH));
+        i += matchLength;
+        continue;
+      }
+
+      if (value <= MAX_LITERAL) {
+        flushRaw();
+        put(value);
+        i++;
+        continue;
+      }
+
+      if (rawCount == 0)
+        rawStart = i;
+      rawCount++;
+      if (rawCount == MAX_RUN)
+        flushRaw();
+      i++;
+    }
+
+    flushRaw();
+    return words;
+  }
+
+  /**
+   * @brief Encodes a batch of `count` messages into `out`, which must have
+   * room for `maxEncodedSize(count)` words. Returns the number of encoded
+   * words.
+   */
+  static u32 encode(const u16* messages, u32 count, u16* out) {
+    return encode(messages, count, [&out](u16 word) { *out++ = word; });
+  }
+
+  /**
+   * @brief Queues compressed batches and sends them through a link.
+   * @tparam MaxBatch Maximum messages per batch (see `LINK_CODEC_MAX_BATCH`).
+   */
+  template <u32 MaxBatch = LINK_CODEC_MAX_BATCH>
+  class Encoder {
+    static_assert(MaxBatch >= 1 && MaxBatch <= MAX_BATCH_LIMIT,
+                  "MaxBatch must be in the range [1;4094]");
+
+   public:
+    /**
+     * @brief Compresses a batch of `count` messages and queues it. Returns
+     * `false` if `count` is invalid or the queue doesn't have room for it.
+     * @param messages The messages (any u16 value).
+     * @param count The number of messages `(1~MaxBatch)`.
+     */
+    bool send(const u16* messages, u32 count) {
+      if (count == 0 || count > MaxBatch ||
+          outgoingWords.available() < maxEncodedSize(count))
+        return false;
+
+      sentMessages += count;
+      sentWords += encode(messages, count,
+                          [this](u16 word) { outgoingWords.push(word); });
+      return true;
+    }
+
+    /**
+     * @brief Sends as many queued words as the link accepts. Returns the
+     * number of sent words.
+     * @param link A `LinkCable`, `LinkWireless` or `LinkUniversal` instance.
+     */
+    template <typename L>
+    u32 flush(L* link) {
+      u32 count = 0;
+      while (!outgoingWords.isEmpty() && link->canSend()) {
+        link->send(outgoingWords.pop());
+        count++;
+      }
+      return count;
+    }
+
+    /**
+     * @brief Returns whether there are queued words or not.
+     */
+    [[nodiscard]] bool isEmpty() { return outgoingWords.isEmpty(); }
+
+    /**
+     * @brief Discards the queued words.
+     */
+    void clear() { outgoingWords.clear(); }
+
+    /**
+     * @brief Returns the number of messages queued with `send(...)`.
+     */
+    [[nodiscard]] u32 getSentMessages() { return sentMessages; }
+
+    /**
+     * @brief Returns the number of encoded words queued with `send(...)`.
+     * The compression ratio is `getSentMessages() / getSentWords()`.
+     */
+    [[nodiscard]] u32 getSentWords() { return sentWords; }
+
+   private:
+    Link::RingBuffer<u16, maxEncodedSize(MaxBatch) * 2> outgoingWords;
+    u32 sentMessages = 0;
+    u32 sentWords = 0;
+  };
+
+  /**
+   * @brief Rebuilds the batches of one player from the received words.
+   * @tparam MaxBatch Maximum messages per batch (see `LINK_CODEC_MAX_BATCH`).
+   */
+  template <u32 MaxBatch = LINK_CODEC_MAX_BATCH>
+  class Decoder {
+    static_assert(MaxBatch >= 1 && MaxBatch <= MAX_BATCH_LIMIT,
+                  "MaxBatch must be in the range [1;4094]");
+
+   public:
+    /**
+     * @brief Decodes a received `word`. Returns `true` when a batch is
+     * complete. Then, it can be read with `data()` and `size()` until the
+     * next `push(...)` call.
+     * @param word A received word.
+     */
+    bool push(u16 word) {
+      if (isComplete)
+        reset();
+
+      if (rawRemaining > 0) {
+        rawRemaining--;
+        return append(word, 1);
+      }
+
+      u32 arg = word & ARG_MASK;
+
+      if (expectedSize == 0) {
+        // (waiting for a header)
+        if ((word & KIND_MASK) != HEADER || arg == 0 || arg > MaxBatch)
+          return fail();
+        expectedSize = arg;
+        return false;
+      }
+
+      if (word <= MAX_LITERAL)
+        return word != 0 ? append(word, 1) : fail();
+
+      switch (word & KIND_MASK) {
+        case ZERO_RUN:
+          return append(0, arg + 1);
+        case ONES_RUN:
+          return append(0xFFFF, arg + 1);
+        case MATCH:
+          return copy((arg >> MATCH_DISTANCE_SHIFT) + 1,
+                      (arg & MATCH_LENGTH_MASK) + MIN_MATCH);
+        case RAW: {
+          rawRemaining = arg + 1;
+          return false;
+        }
+        case HEADER: {
+          // (the current batch lost words, so this one starts a new batch)
+          fail();
+          return push(word);
+        }
+        default:
+          return fail();
+      }
+    }
+
+    /**
+     * @brief Returns the last complete batch.
+     */
+    [[nodiscard]] const u16* data() { return messages; }
+
+    /**
+     * @brief Returns the size of the last complete batch (or `0`).
+     */
+    [[nodiscard]] u32 size() { return isComplete ? currentSize : 0; }
+
+    /**
+     * @brief Returns whether invalid words were received at some point (which
+     * means that the link lost data). The broken batch is discarded, and
+     * decoding restarts on the next header.
+     * @param clear If `true`, the flag is cleared.
+     */
+    bool didFail(bool clear = true) {
+      bool hasFailed = failed;
+      if (clear)
+        failed = false;
+      return hasFailed;
+    }
+
+    /**
+     * @brief Discards the current batch (call this after reconnecting).
+     */
+    void reset() {
+      currentSize = 0;
+      expectedSize = 0;
+      rawRemaining = 0;
+      isComplete = false;
+    }
+
+   private:
+    u16 messages[MaxBatch];
+    u32 currentSize = 0;
+    u32 expectedSize = 0;
+    u32 rawRemaining = 0;
+    bool isComplete = false;
+    bool failed = false;
+
+    bool append(u16 value, u32 count) {
+      if (currentSize + count > expectedSize)
+        return fail();
+
+      for (u32 i = 0; i < count; i++)
+        messages[currentSize++] = value;
+      return finish();
+    }
+
+    bool copy(u32 distance, u32 count) {
+      if (distance > currentSize || currentSize + count > expectedSize)
+        return fail();
+
+      // (overlapping copies are intended: they repeat the pattern)
+      u16* source = messages + currentSize - distance;
+      u16* target = messages + currentSize;
+      for (u32 i = 0; i < count; i++)
+        target[i] = source[i];
+      currentSize += count;
+      return finish();
+    }
+
+    bool finish() {
+      if (currentSize < expectedSize || rawRemaining > 0)
+        return false;
+      isComplete = true;
+      return true;
+    }
+
+    bool fail() {
+      failed = true;
+      reset();
+      return false;
+    }
+  };
+
+ private:
+  static u32 runLength(const u16* messages, u32 count, u32 i) {
+    u16 value = messages[i];
+    u32 run = 1;
+    while (i + run < count && run < MAX_RUN && messages[i + run] == value)
+      run++;
+    return run;
+  }
+
+  static void findMatch(const u16* messages,
+                        u32 count,
+                        u32 i,
+                        u32& bestLength,
+                        u32& bestDistance) {
+    u32 maxDistance = i < WINDOW ? i : WINDOW;
+    u32 maxLength = count - i < MAX_MATCH ? count - i : MAX_MATCH;
+
+    for (u32 distance = 1; distance <= maxDistance; distance++) {
+      const u16* source = messages + i - distance;
+      const u16* target = messages + i;
+      u32 length = 0;
+      while (length < maxLength && source[length] == target[length])
+        length++;
+
+      if (length > bestLength) {
+        bestLength = length;
+        bestDistance = distance;
+        if (length == maxLength)
+          return;
+      }
+    }
+  }
+};
+
+#endif  // LINK_CODEC_H
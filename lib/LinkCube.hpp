@@ -40,6 +40,8 @@
  * it's around `120` bytes. There's a double-buffered pending queue (to avoid
  * data races), and 1 outgoing queue.
  * \warning You can approximate the usage with `LINK_CUBE_QUEUE_SIZE * 12`.
+ * \warning Queues are ring buffers, so their storage is rounded up to the
+ * next power of two (`16` for the default value).
  */
 #define LINK_CUBE_QUEUE_SIZE 10
 #endif
@@ -48,13 +50,16 @@ LINK_VERSION_TAG LINK_CUBE_VERSION = "vLinkCube/v8.0.3";
 
 /**
  * @brief A JOYBUS handler for the Link Port.
+ * @tparam QueueSize Buffer size (see `LINK_CUBE_QUEUE_SIZE`).
+ * \warning `LinkCube` is an alias for the default configuration.
  */
-class LinkCube {
+template <Link::u32 QueueSize = LINK_CUBE_QUEUE_SIZE>
+class LinkCubeT {
  private:
   using u32 = Link::u32;
   using u16 = Link::u16;
   using u8 = Link::u8;
-  using U32Queue = Link::Queue<u32, LINK_CUBE_QUEUE_SIZE>;
+  using U32Queue = Link::RingBuffer<u32, QueueSize>;
 
   static constexpr int BIT_CMD_RESET = 0;
   static constexpr int BIT_CMD_RECEIVE = 1;
@@ -75,12 +80,14 @@ class LinkCube {
    */
   void activate() {
     LINK_READ_TAG(LINK_CUBE_VERSION);
-    static_assert(LINK_CUBE_QUEUE_SIZE >= 1);
+    static_assert(QueueSize >= 1);
 
     LINK_BARRIER;
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkCubeT, _onSerial);
     resetState();
     stop();
 
@@ -96,6 +103,7 @@ class LinkCube {
    */
   void deactivate() {
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     resetState();
     stop();
   }
@@ -137,7 +145,7 @@ class LinkCube {
    * @brief Dequeues and returns the next received value.
    * \warning If there's no received data, a `0` will be returned.
    */
-  u32 read() { return incomingQueue.syncPop(); }
+  u32 read() { return incomingQueue.pop(); }
 
   /**
    * @brief Returns the next received value without dequeuing it.
@@ -148,14 +156,17 @@ class LinkCube {
   /**
    * @brief Sends 32-bit `data`.
    * @param data The value to be sent.
-   * \warning If the other end asks for data at the same time you call this
-   * method, a `0x00000000` will be sent.
+   * \warning If the outgoing queue is full, `data` will be discarded.
    */
   void send(u32 data) {
     if (!isEnabled)
       return;
 
-    outgoingQueue.syncPush(data);
+    if (!outgoingQueue.push(data)) {
+      LINK_STATS_COUNT(overflows);
+      return;
+    }
+    LINK_STATS_MARK(outgoingHighWaterMark, outgoingQueue.size());
   }
 
   /**
@@ -165,9 +176,8 @@ class LinkCube {
 
   /**
    * @brief Returns whether the internal queue lost messages at some point due
-   * to being full. This can happen if your queue size is too low, if you
-   * receive too much data without calling `read(...)` enough times, or if
-   * excessive `read(...)` calls prevent the ISR from copying data. After this
+   * to being full. This can happen if your queue size is too low, or if you
+   * receive too much data without calling `read(...)` enough times. After this
    * call, the overflow flag is cleared if `clear` is `true` (default behavior).
    */
   bool didQueueOverflow(bool clear = true) {
@@ -189,22 +199,45 @@ class LinkCube {
     return reset;
   }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the SERIAL interrupt handler.
    * \warning This is internal API!
    */
   void _onSerial() {
+    LINK_STATS_ISR(serial);
     if (!isEnabled)
       return;
 
     if (isBitHigh(BIT_CMD_RESET)) {
+      LINK_STATS_COUNT(resets);
+      LINK_TRACE(CUBE, RESET, 0, 0);
       resetState();
       resetFlag = true;
       setBitHigh(BIT_CMD_RESET);
     }
 
     if (isBitHigh(BIT_CMD_RECEIVE)) {
-      newIncomingQueue.push(getData());
+#if LINK_ENABLE_STATS != 0
+      if (newIncomingQueue.isFull())
+        LINK_STATS_COUNT(overflows);
+#endif
+      u32 data = getData();
+      LINK_TRACE(CUBE, WORD_RECEIVED, data, 0);
+      newIncomingQueue.forcePush(data);
       setBitHigh(BIT_CMD_RECEIVE);
     }
 
@@ -221,31 +254,21 @@ class LinkCube {
   U32Queue incomingQueue;
   U32Queue outgoingQueue;
   volatile bool resetFlag = false;
-  volatile bool needsClear = false;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
   void copyState() {
-    if (incomingQueue.isReading())
-      return;
-
-    if (needsClear) {
-      incomingQueue.clear();
-      needsClear = false;
-    }
-
-    while (!newIncomingQueue.isEmpty() && !incomingQueue.isFull())
-      incomingQueue.push(newIncomingQueue.pop());
+    newIncomingQueue.moveTo(incomingQueue);
+    LINK_STATS_MARK(incomingHighWaterMark, incomingQueue.size());
   }
 
   void resetState() {
     LINK_BARRIER;
-    needsClear = false;
     newIncomingQueue.clear();
-    if (incomingQueue.isReading())
-      needsClear = true;
-    else
-      incomingQueue.clear();
-    outgoingQueue.syncClear();
+    incomingQueue.syncClear();
+    outgoingQueue.clear();
     resetFlag = false;
 
     newIncomingQueue.overflow = false;
@@ -253,7 +276,9 @@ class LinkCube {
   }
 
   void setPendingData() {
-    setData(outgoingQueue.isWriting() ? 0 : outgoingQueue.pop());
+    u32 data = outgoingQueue.pop();
+    LINK_TRACE(CUBE, TRANSFER_START, data, 0);
+    setData(data);
   }
 
   void setData(u32 data) {
@@ -293,6 +318,8 @@ class LinkCube {
   void setBitLow(u8 bit) { Link::_REG_JOYCNT &= ~(1 << bit); }
 };
 
+using LinkCube = LinkCubeT<>;
+
 extern LinkCube* linkCube;
 
 /**
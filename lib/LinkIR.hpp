@@ -113,6 +113,8 @@ class LinkIR {
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkIR, _onSerial);
     resetState();
     linkGPIO.reset();
 
@@ -142,6 +144,7 @@ class LinkIR {
    */
   void deactivate() {
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     linkGPIO.reset();
   }
 
@@ -182,8 +185,10 @@ class LinkIR {
       return false;
 
     u16 pulses[NEC_TOTAL_PULSES];
-    if (!receive(pulses, NEC_TOTAL_PULSES, startTimeout))
+    if (!receive(pulses, NEC_TOTAL_PULSES, startTimeout)) {
+      LINK_STATS_COUNT(timeouts);
       return false;
+    }
 
     return parseNEC(pulses, address, command);
   }
@@ -224,8 +229,10 @@ class LinkIR {
     u8 invAddr = (data >> 8) & 0xFF;
     u8 cmd = (data >> 16) & 0xFF;
     u8 invCmd = (data >> 24) & 0xFF;
-    if ((u8)~addr != invAddr || (u8)~cmd != invCmd)
+    if ((u8)~addr != invAddr || (u8)~cmd != invCmd) {
+      LINK_STATS_COUNT(crcFailures);
       return false;
+    }
 
     address = addr;
     command = cmd;
@@ -281,6 +288,20 @@ class LinkIR {
    */
   bool isDetectingLight() { return !linkGPIO.readPin(Pin::SI); }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the SERIAL interrupt handler.
    * \warning This is internal API!
@@ -300,6 +321,9 @@ class LinkIR {
 
  private:
   LinkGPIO linkGPIO;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
   volatile bool detected = false;
   vu32 firstLightTime = 0;
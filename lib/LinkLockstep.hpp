@@ -0,0 +1,299 @@
+#ifndef LINK_LOCKSTEP_H
+#define LINK_LOCKSTEP_H
+
+// --------------------------------------------------------------------------
+// A deterministic lockstep input synchronizer built on top of LinkUniversal.
+// --------------------------------------------------------------------------
+// Usage:
+// - 1) Include this header in your main.cpp file and add:
+//       LinkUniversal* linkUniversal = new LinkUniversal();
+//       LinkLockstep* linkLockstep = new LinkLockstep(linkUniversal);
+// - 2) Set up and activate `linkUniversal` as usual (see LinkUniversal.hpp).
+// - 3) When all players are connected and ready to start the match:
+//       linkLockstep->activate();
+//       // (all players should do this at the same point of the game)
+// - 4) Once per frame, instead of calling `linkUniversal->sync()`:
+//       u16 keys = ~REG_KEYS & KEY_ANY;
+//       if (linkLockstep->update(keys)) {
+//         for (u32 i = 0; i < linkLockstep->playerCount(); i++)
+//           simulatePlayer(i, linkLockstep->getInput(i));
+//       }
+//       // (if it returns `false`, the frame is stalled: don't simulate!)
+// --------------------------------------------------------------------------
+// considerations:
+// - the link is dedicated to input messages while the lockstep is active!
+// - inputs are 10 bits wide (enough for `REG_KEYS`)
+// - if messages can get lost, use a reliable transport (such as
+//   `LinkCable`'s reliable mode), or check `didDesync()`
+// --------------------------------------------------------------------------
+
+#ifndef LINK_DEVELOPMENT
+#pragma GCC system_header
+#endif
+
+#include "_link_common.hpp"
+
+#include "LinkUniversal.hpp"
+
+#ifndef LINK_LOCKSTEP_BUFFER_FRAMES
+/**
+ * @brief Number of frames that the input buffers can store at max (per
+ * player). The default value is `32`. The maximum input delay is
+ * `(LINK_LOCKSTEP_BUFFER_FRAMES - 1) / 2` frames.
+ * \warning This affects how much memory is allocated. With the default value,
+ * it's around `64` bytes per player.
+ */
+#define LINK_LOCKSTEP_BUFFER_FRAMES 32
+#endif
+
+LINK_VERSION_TAG LINK_LOCKSTEP_VERSION = "vLinkLockstep/v8.0.3";
+
+#define LINK_LOCKSTEP_DEFAULT_INPUT_DELAY 2
+#define LINK_LOCKSTEP_INPUT_MASK 0x3FF
+
+/**
+ * @brief A deterministic lockstep input synchronizer.
+ * @tparam L The link type (`LinkUniversal`, `LinkCable`, etc.).
+ * @tparam MaxPlayers Maximum number of players.
+ * @tparam BufferFrames Input buffer size (see `LINK_LOCKSTEP_BUFFER_FRAMES`).
+ * \warning `LinkLockstep` is an alias for the default configuration.
+ */
+template <typename L = LinkUniversal,
+          Link::u32 MaxPlayers = LINK_UNIVERSAL_MAX_PLAYERS,
+          Link::u32 BufferFrames = LINK_LOCKSTEP_BUFFER_FRAMES>
+class LinkLockstepT {
+ private:
+  using u32 = Link::u32;
+  using u16 = Link::u16;
+  using u8 = Link::u8;
+
+  static constexpr u32 INPUT_BITS = 10;
+  static constexpr u32 TAG_COUNT = 62;  // (tags are 1~62: never 0x0/0xFFFF)
+
+  static_assert(BufferFrames >= 2 && BufferFrames < TAG_COUNT,
+                "BufferFrames must be in the range [2;61]");
+
+ public:
+  static constexpr u8 MAX_INPUT_DELAY = (BufferFrames - 1) / 2;
+
+  /**
+   * @brief Constructs a new LinkLockstep object.
+   * @param link The link to use. It must be active and connected before
+   * calling `activate()`.
+   * @param inputDelay Number of frames between sampling an input and using it
+   * `(0~MAX_INPUT_DELAY)`. Inputs are sent ahead of time, so higher values
+   * hide more link latency, but add input lag. `0` means the classic
+   * frame-locked exchange.
+   */
+  explicit LinkLockstepT(L* link,
+                         u8 inputDelay = LINK_LOCKSTEP_DEFAULT_INPUT_DELAY)
+      : link(link) {
+    config.inputDelay = inputDelay;
+  }
+
+  /**
+   * @brief Returns whether the library is active or not.
+   */
+  [[nodiscard]] bool isActive() { return isEnabled; }
+
+  /**
+   * @brief Starts a new session at frame `0`. Returns `false` if the link is
+   * not connected.
+   * \warning All players should call this at the same point of the game, and
+   * no other messages should be sent through the link afterwards.
+   */
+  bool activate() {
+    isEnabled = false;
+    if (!link->isConnected())
+      return false;
+
+    u8 inputDelay = config.inputDelay < MAX_INPUT_DELAY ? config.inputDelay
+                                                        : MAX_INPUT_DELAY;
+    players = link->playerCount();
+    localPlayerId = link->currentPlayerId();
+    frame = 0;
+    isInputScheduled = false;
+    hasDesynced = false;
+    stallCount = 0;
+    currentStall = 0;
+    longestStall = 0;
+
+    // (the first `inputDelay` frames have no inputs)
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      for (u32 j = 0; j < BufferFrames; j++)
+        inputs[i][j] = 0;
+      receivedFrames[i] = inputDelay;
+      currentInputs[i] = 0;
+    }
+    activeInputDelay = inputDelay;
+
+    isEnabled = true;
+    return true;
+  }
+
+  /**
+   * @brief Deactivates the library. The link is not affected.
+   */
+  void deactivate() { isEnabled = false; }
+
+  /**
+   * @brief Syncs the link, sends the local `input`, and tries to advance to
+   * the next frame. Returns `true` if the frame can be simulated (the inputs
+   * of all players are available through `getInput(...)`), or `false` if it
+   * has to stall.
+   * @param input The local input for this frame (10 bits).
+   * \warning Call this once per frame (it calls `sync()` on the link).
+   * \warning While stalled, `input` is ignored: each input is sampled once,
+   * when its frame is scheduled.
+   * \warning If the link disconnects or the player count changes, the
+   * library deactivates itself. Check `isActive()`.
+   */
+  bool update(u16 input) {
+    if (!isEnabled)
+      return false;
+
+    link->sync();
+    if (!link->isConnected() || link->playerCount() != players) {
+      deactivate();
+      return false;
+    }
+
+    receive();
+
+    if (!isInputScheduled) {
+      if (!link->canSend())
+        return stall();
+
+      u32 targetFrame = frame + activeInputDelay;
+      input &= LINK_LOCKSTEP_INPUT_MASK;
+      link->send(encode(targetFrame, input));
+      store(localPlayerId, targetFrame, input);
+      isInputScheduled = true;
+    }
+
+    if (!isReady())
+      return stall();
+
+    for (u32 i = 0; i < players; i++)
+      currentInputs[i] = inputs[i][frame % BufferFrames];
+    frame++;
+    isInputScheduled = false;
+    currentStall = 0;
+    return true;
+  }
+
+  /**
+   * @brief Returns the input of player #`playerId` for the last frame that
+   * `update(...)` advanced.
+   * @param playerId A player ID.
+   */
+  [[nodiscard]] u16 getInput(u8 playerId) {
+    return playerId < players ? currentInputs[playerId] : 0;
+  }
+
+  /**
+   * @brief Returns the number of advanced frames since `activate()`.
+   */
+  [[nodiscard]] u32 currentFrame() { return frame; }
+
+  /**
+   * @brief Returns the number of players in the session.
+   */
+  [[nodiscard]] u8 playerCount() { return players; }
+
+  /**
+   * @brief Returns the current player ID.
+   */
+  [[nodiscard]] u8 currentPlayerId() { return localPlayerId; }
+
+  /**
+   * @brief Returns how many `update(...)` calls couldn't advance since
+   * `activate()`, because a frame's inputs were missing.
+   */
+  [[nodiscard]] u32 getStallCount() { return stallCount; }
+
+  /**
+   * @brief Returns the longest run of consecutive stalls since `activate()`.
+   */
+  [[nodiscard]] u32 getLongestStall() { return longestStall; }
+
+  /**
+   * @brief Returns `true` if a remote input arrived with an unexpected frame
+   * tag (which means that messages were lost, and the simulation is no longer
+   * deterministic).
+   */
+  [[nodiscard]] bool didDesync() { return hasDesynced; }
+
+  struct Config {
+    u8 inputDelay;  // (call `activate()` again after changing it)
+  };
+
+  /**
+   * @brief LinkLockstep configuration.
+   */
+  Config config;
+
+ private:
+  L* link;
+  u16 inputs[MaxPlayers][BufferFrames];
+  u32 receivedFrames[MaxPlayers];  // (next frame to fill, per player)
+  u16 currentInputs[MaxPlayers];
+  u32 frame = 0;
+  u32 stallCount = 0;
+  u32 currentStall = 0;
+  u32 longestStall = 0;
+  u8 players = 0;
+  u8 localPlayerId = 0;
+  u8 activeInputDelay = 0;
+  bool isInputScheduled = false;
+  bool hasDesynced = false;
+  volatile bool isEnabled = false;
+
+  void receive() {
+    for (u32 i = 0; i < players; i++) {
+      if (i == localPlayerId)
+        continue;
+
+      while (link->canRead(i)) {
+        u16 word = link->read(i);
+        u32 targetFrame = receivedFrames[i];
+        if (word >> INPUT_BITS != tag(targetFrame))
+          hasDesynced = true;
+        store(i, targetFrame, word & LINK_LOCKSTEP_INPUT_MASK);
+      }
+    }
+  }
+
+  bool isReady() {
+    for (u32 i = 0; i < players; i++) {
+      if (receivedFrames[i] <= frame)
+        return false;
+    }
+    return true;
+  }
+
+  bool stall() {
+    stallCount++;
+    currentStall++;
+    if (currentStall > longestStall)
+      longestStall = currentStall;
+    return false;
+  }
+
+  void store(u8 playerId, u32 targetFrame, u16 input) {
+    inputs[playerId][targetFrame % BufferFrames] = input;
+    receivedFrames[playerId] = targetFrame + 1;
+  }
+
+  u16 encode(u32 targetFrame, u16 input) {
+    return (u16)(tag(targetFrame) << INPUT_BITS) | input;
+  }
+
+  u32 tag(u32 targetFrame) { return targetFrame % TAG_COUNT + 1; }
+};
+
+using LinkLockstep = LinkLockstepT<>;
+
+extern LinkLockstep* linkLockstep;
+
+#endif  // LINK_LOCKSTEP_H
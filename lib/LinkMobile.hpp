@@ -291,6 +291,11 @@ class LinkMobile {
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_VBLANK, LinkMobile, _onVBlank);
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkMobile, _onSerial);
+    LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[config.timerId], LinkMobile,
+                 _onTimer);
     resetState();
     stop();
 
@@ -309,6 +314,7 @@ class LinkMobile {
   void deactivate() {
     error = {};
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     resetState();
     stop();
   }
@@ -631,11 +637,26 @@ class LinkMobile {
    */
   [[nodiscard]] Error getError() { return error; }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the VBLANK interrupt handler.
    * \warning This is internal API!
    */
   void _onVBlank() {
+    LINK_STATS_ISR(vblank);
     if (!isEnabled)
       return;
 
@@ -661,6 +682,7 @@ class LinkMobile {
    * \warning This is internal API!
    */
   void _onSerial() {
+    LINK_STATS_ISR(serial);
     if (!isEnabled)
       return;
 
@@ -699,6 +721,7 @@ class LinkMobile {
    * \warning This is internal API!
    */
   void _onTimer() {
+    LINK_STATS_ISR(timer);
     if (!isEnabled || !hasPendingTransfer)
       return;
 
@@ -905,6 +928,9 @@ class LinkMobile {
   u32 pendingTransfer = 0;
   AdapterType adapterType = AdapterType::UNKNOWN;
   Error error = {};
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
   void processUserRequests() {
@@ -1081,6 +1107,12 @@ class LinkMobile {
 
   void processAsyncCommand() {
     if (asyncCommand.result != CommandResult::SUCCESS) {
+#if LINK_ENABLE_STATS != 0
+      if (asyncCommand.result == CommandResult::WRONG_CHECKSUM)
+        LINK_STATS_COUNT(crcFailures);
+#endif
+      LINK_TRACE(MOBILE, COMMAND_FAILURE, asyncCommand.relatedCommandId(),
+                 asyncCommand.result);
       if (shouldAbortOnCommandFailure())
         return abort(Error::Type::COMMAND_FAILED);
       else
@@ -1467,6 +1499,7 @@ class LinkMobile {
     request.timeout = 0;
     request.finished = false;
     userRequests.syncPush(request);
+    LINK_STATS_MARK(outgoingHighWaterMark, userRequests.size());
   }
 
   void popRequest() {
@@ -1524,6 +1557,7 @@ class LinkMobile {
     timeoutStateFrames = 0;
     pingFrameCount = 0;
     _LMLOG_("!! new state: %d -> %d", oldState, newState);
+    LINK_TRACE(MOBILE, STATE_CHANGE, newState, oldState);
     (void)oldState;
   }
 
@@ -1547,7 +1581,17 @@ class LinkMobile {
         newError.cmdErrorCode);
     (void)newError;
 
+#if LINK_ENABLE_STATS != 0
+    if (errorType == Error::Type::TIMEOUT ||
+        errorType == Error::Type::ADAPTER_NOT_CONNECTED)
+      LINK_STATS_COUNT(timeouts);
+    else
+      LINK_STATS_COUNT(commandFailures);
+#endif
+
     if (fatal) {
+      LINK_STATS_COUNT(resets);
+      LINK_TRACE(MOBILE, RESET, errorType, state);
       error = newError;
       resetState();
       stop();
@@ -1605,6 +1649,7 @@ class LinkMobile {
 
   void sendCommandAsync(Command command) {
     _LMLOG_(">> $%X [%d] (...)", command.header.commandId, command.header.size);
+    LINK_TRACE(MOBILE, COMMAND, command.header.commandId, command.header.size);
     asyncCommand.reset();
     asyncCommand.cmd = command;
     asyncCommand.isActive = true;
@@ -87,6 +87,9 @@ class LinkPS2Keyboard {
 
     deactivate();
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_VBLANK, LinkPS2Keyboard, _onVBlank);
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkPS2Keyboard, _onSerial);
     Link::_REG_RCNT = RCNT_GPIO_AND_SI_IRQ;
     Link::_REG_SIOCNT = 0;
 
@@ -104,16 +107,32 @@ class LinkPS2Keyboard {
    */
   void deactivate() {
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
 
     Link::_REG_RCNT = RCNT_GPIO;
     Link::_REG_SIOCNT = 0;
   }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the VBLANK interrupt handler.
    * \warning This is internal API!
    */
   void _onVBlank() {
+    LINK_STATS_ISR(vblank);
     if (!isEnabled)
       return;
 
@@ -125,6 +144,7 @@ class LinkPS2Keyboard {
    * \warning This is internal API!
    */
   void _onSerial() {
+    LINK_STATS_ISR(serial);
     if (!isEnabled)
       return;
 
@@ -132,6 +152,12 @@ class LinkPS2Keyboard {
 
     u32 nowFrame = frameCounter;
     if (nowFrame - prevFrame > TIMEOUT_FRAMES) {
+#if LINK_ENABLE_STATS != 0 || LINK_ENABLE_TRACE != 0
+      if (bitcount > 0) {
+        LINK_STATS_COUNT(timeouts);
+        LINK_TRACE(PS2_KEYBOARD, TIMEOUT, 0, bitcount);
+      }
+#endif
       bitcount = 0;
       incoming = 0;
       parityBit = 0;
@@ -156,8 +182,16 @@ class LinkPS2Keyboard {
           parity += (incoming >> i) & 1;
         parity += parityBit;
 
-        if (parity % 2 != 0)  // odd parity as expected
+        if (parity % 2 != 0) {  // odd parity as expected
+          LINK_TRACE(PS2_KEYBOARD, WORD_RECEIVED, incoming, 0);
           onEvent(incoming);
+        } else {
+          LINK_STATS_COUNT(crcFailures);
+          LINK_TRACE(PS2_KEYBOARD, CRC_FAILURE, incoming, parityBit);
+        }
+      } else {
+        LINK_STATS_COUNT(crcFailures);
+        LINK_TRACE(PS2_KEYBOARD, CRC_FAILURE, incoming, parityBit);
       }
       bitcount = 0;
       incoming = 0;
@@ -167,6 +201,9 @@ class LinkPS2Keyboard {
 
  private:
   volatile bool isEnabled = false;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   u8 bitcount = 0;
   u8 incoming = 0;
   u8 parityBit = 0;
@@ -28,6 +28,13 @@
 //         LinkRawCable::Response data = linkRawCable->getAsyncData();
 //         // ...
 //       }
+// - 7) Exchange a block of words asynchronously:
+//       u16 words[256] = { ... };
+//       LinkRawCable::Response responses[256];
+//       linkRawCable->transferBlockAsync(words, responses, 256, [](bool ok) {
+//         // (called from the SERIAL IRQ when the whole block is done)
+//       });
+//       // (or poll `getBlockState()` and `getBlockProgress()`)
 // --------------------------------------------------------------------------
 // (*) libtonc's interrupt handler sometimes ignores interrupts due to a bug.
 //     That causes packet loss. You REALLY want to use libugba's instead.
@@ -37,6 +44,8 @@
 // - advanced usage only; if you're building a game, use `LinkCable`!
 // - don't send 0xFFFF, it's a reserved value that means <disconnected client>!
 // - only `transfer(...)` if `isReady()`!
+// - in block transfers, slaves must load their next word before the master
+//   starts the next transfer (keep other ISRs short, or nest interrupts)!
 // --------------------------------------------------------------------------
 
 #ifndef LINK_DEVELOPMENT
@@ -81,6 +90,14 @@ class LinkRawCable {
     int playerId = -1;  // (-1 = unknown)
   };
   enum class AsyncState { IDLE, WAITING, READY };
+  enum class BlockState { IDLE, WAITING, DONE, FAILED };
+
+  /**
+   * @brief A function that is called from the SERIAL IRQ when a block
+   * transfer ends. `success` is `false` if a transfer failed or the block was
+   * cancelled.
+   */
+  using BlockCallback = void (*)(bool success);
 
  private:
   static constexpr Response EMPTY_RESPONSE = {
@@ -105,7 +122,10 @@ class LinkRawCable {
     this->baudRate = baudRate;
     this->asyncState = AsyncState::IDLE;
     this->asyncData = EMPTY_RESPONSE;
+    this->block = Block{};
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkRawCable, _onSerial);
     setMultiPlayMode(baudRate);
     isEnabled = true;
   }
@@ -115,11 +135,13 @@ class LinkRawCable {
    */
   void deactivate() {
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     setGeneralPurposeMode();
 
     baudRate = BaudRate::BAUD_RATE_1;
     asyncState = AsyncState::IDLE;
     asyncData = EMPTY_RESPONSE;
+    block = Block{};
   }
 
   /**
@@ -145,6 +167,7 @@ class LinkRawCable {
     if (!isEnabled || asyncState != AsyncState::IDLE)
       return EMPTY_RESPONSE;
 
+    LINK_TRACE(RAW_CABLE, TRANSFER_START, data, _async);
     setData(data);
 
     if (_async) {
@@ -159,11 +182,13 @@ class LinkRawCable {
     if (_async)
       return EMPTY_RESPONSE;
 
-    while (isSending())
+    while (isSending()) {
+      LINK_BUSY_WAIT;
       if (cancel()) {
         stopTransfer();
         return EMPTY_RESPONSE;
       }
+    }
 
     if (isReady() && !hasError())
       return getData();
@@ -200,6 +225,73 @@ class LinkRawCable {
     return data;
   }
 
+  /**
+   * @brief Schedules the transfer of `count` words and returns. The SERIAL
+   * IRQ stores each response and starts the next transfer right away (on the
+   * master) or loads the next word (on slaves), until the block is done.
+   * Returns `false` if another transfer is pending.
+   * @param data The words to be sent (they must stay valid until the end).
+   * @param responses An array of `count` responses to be filled, or
+   * `nullptr` to discard them.
+   * @param count The number of words.
+   * @param onComplete An optional function to be called when the block ends.
+   * \warning If a transfer fails, the block ends there (see
+   * `getBlockProgress()`). There are no retries!
+   * \warning Until the block ends, normal `transfer(...)`s won't do anything.
+   */
+  bool transferBlockAsync(const u16* data,
+                          Response* responses,
+                          u32 count,
+                          BlockCallback onComplete = nullptr) {
+    if (!isEnabled || asyncState != AsyncState::IDLE ||
+        block.state == BlockState::WAITING || count == 0)
+      return false;
+
+    block.data = data;
+    block.responses = responses;
+    block.count = count;
+    block.index = 0;
+    block.onComplete = onComplete;
+    block.state = BlockState::WAITING;
+    asyncState = AsyncState::WAITING;
+
+    LINK_TRACE(RAW_CABLE, TRANSFER_START, data[0], 0);
+    setData(data[0]);
+    setInterruptsOn();
+    startTransfer();
+    return true;
+  }
+
+  /**
+   * @brief Returns the state of the last block transfer.
+   * @return One of the enum values from `LinkRawCable::BlockState`.
+   */
+  [[nodiscard]] BlockState getBlockState() { return block.state; }
+
+  /**
+   * @brief Returns the number of words of the current (or last) block that
+   * were successfully transferred.
+   */
+  [[nodiscard]] u32 getBlockProgress() { return block.index; }
+
+  /**
+   * @brief Aborts the current block transfer. The completion callback is
+   * called with `success = false`. If the block has already finished, this
+   * does nothing.
+   */
+  void cancelBlock() {
+    if (block.state != BlockState::WAITING)
+      return;
+
+    setInterruptsOff();
+    LINK_BARRIER;
+    if (block.state != BlockState::WAITING)
+      return;  // (the last word finished before the IRQ was disabled)
+
+    stopTransfer();
+    finishBlock(false);
+  }
+
   /**
    * @brief Returns the current `baudRate`.
    */
@@ -217,19 +309,44 @@ class LinkRawCable {
    */
   [[nodiscard]] bool isReady() { return allReady(); }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the SERIAL interrupt handler.
    * \warning This is internal API!
    */
   void _onSerial() {
+    LINK_STATS_ISR(serial);
     if (!isEnabled || asyncState != AsyncState::WAITING)
       return;
 
+    if (block.state == BlockState::WAITING) {
+      continueBlock();
+      return;
+    }
+
     setInterruptsOff();
     asyncState = AsyncState::READY;
     asyncData = EMPTY_RESPONSE;
-    if (isReady() && !hasError())
+    if (isReady() && !hasError()) {
       asyncData = getData();
+      // (packed: players 0-1 in data0, players 2-3 in data1)
+      LINK_TRACE(RAW_CABLE, WORD_RECEIVED,
+                 asyncData.data[0] | (asyncData.data[1] << 16),
+                 asyncData.data[2] | (asyncData.data[3] << 16));
+    }
   }
 
   // -------------
@@ -269,11 +386,63 @@ class LinkRawCable {
   // -------------
 
  private:
+  struct Block {
+    const u16* data = nullptr;
+    Response* responses = nullptr;
+    u32 count = 0;
+    volatile u32 index = 0;  // (next word to be completed)
+    BlockCallback onComplete = nullptr;
+    volatile BlockState state = BlockState::IDLE;
+  };
+
   BaudRate baudRate = BaudRate::BAUD_RATE_1;
   volatile AsyncState asyncState = AsyncState::IDLE;
   Response asyncData = EMPTY_RESPONSE;
+  Block block;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
+  void continueBlock() {
+    if (!isReady() || hasError()) {
+      finishBlock(false);
+      return;
+    }
+
+    u32 index = block.index;
+    if (block.responses) {
+      block.responses[index] = getData();
+      LINK_TRACE(RAW_CABLE, WORD_RECEIVED,
+                 block.responses[index].data[0] |
+                     (block.responses[index].data[1] << 16),
+                 index);
+    }
+
+    index++;
+    block.index = index;
+    if (index == block.count) {
+      finishBlock(true);
+      return;
+    }
+
+    // (slaves only load their word, the master's start is what clocks them)
+    u16 data = block.data[index];
+    LINK_TRACE(RAW_CABLE, TRANSFER_START, data, index);
+    setData(data);
+    startTransfer();
+  }
+
+  void finishBlock(bool success) {
+    setInterruptsOff();
+    auto newState = success ? BlockState::DONE : BlockState::FAILED;
+    LINK_TRACE(RAW_CABLE, STATE_CHANGE, (u32)newState, block.index);
+    block.state = newState;
+    asyncState = AsyncState::IDLE;
+    if (block.onComplete)
+      block.onComplete(success);
+  }
+
   static bool isBitHigh(u8 bit) { return (Link::_REG_SIOCNT >> bit) & 1; }
   static void setBitHigh(u8 bit) { Link::_REG_SIOCNT |= 1 << bit; }
   static void setBitLow(u8 bit) { Link::_REG_SIOCNT &= ~(1 << bit); }
@@ -29,11 +29,19 @@
 // - Use `sendCommand(...)` to send arbitrary commands.
 // - Use `sendCommandAsync(...)` to send arbitrary commands asynchronously.
 //   - This requires setting `LINK_RAW_WIRELESS_ISR_SERIAL` as the `SERIAL`
-//   interrupt handler.
+//   interrupt handler and `LINK_RAW_WIRELESS_ISR_TIMER` as the `TIMER`
+//   interrupt handler (timer 2 by default).
 //   - After calling this method, call `getAsyncState()` and
 //   `getAsyncCommandResult()`.
 //   - Do not call any other methods until the async state is `IDLE` again, or
 //   the adapter will desync!
+// - Use `activateAsync()` to activate the library without blocking (it needs
+//   the same interrupt handlers).
+//   - The activation finishes like an async command (HELLO = `0x10`).
+// - Use `queueCommand(...)` to chain async commands.
+//   - Queued commands run in order, back to back, right after the current
+//   async command (they're started by the interrupt handlers).
+//   - Each one can have a callback, which receives its result.
 // - When sending arbitrary commands, the responses are not parsed. The
 //   exceptions are SendData and ReceiveData, which have these helpers:
 //   - `getSendDataHeaderFor(...)`
@@ -56,14 +64,25 @@
 /**
  * @brief Enable logging.
  * \warning Set `linkRawWireless->logger` and uncomment to enable!
- * \warning This option #include`s std::string!
+ * \warning Entries are recorded in a `Link::BinaryLog` (no heap allocations).
  */
 // #define LINK_RAW_WIRELESS_ENABLE_LOGGING
 #endif
 
+#ifndef LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE
+/**
+ * @brief Maximum number of commands waiting in the command queue (see
+ * `queueCommand(...)`).
+ * \warning This affects how much memory is allocated (~`100` bytes per slot,
+ * since every slot can hold the maximum number of parameters).
+ */
+#define LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE 4
+#endif
+
 LINK_VERSION_TAG LINK_RAW_WIRELESS_VERSION = "vLinkRawWireless/v8.0.3";
 
 #define LINK_RAW_WIRELESS_MAX_PLAYERS 5
+#define LINK_RAW_WIRELESS_DEFAULT_TIMER_ID 2
 #define LINK_RAW_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH 30
 #define LINK_RAW_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH 4
 #define LINK_RAW_WIRELESS_MAX_GAME_ID 0x7FFF
@@ -78,10 +97,9 @@ LINK_VERSION_TAG LINK_RAW_WIRELESS_VERSION = "vLinkRawWireless/v8.0.3";
    LINK_RAW_WIRELESS_BROADCAST_LENGTH)
 
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
-#include <string>
-#define _LRWLOG_(str) logger(str)
+#define _LRWLOG_(...) _log(__VA_ARGS__)
 #else
-#define _LRWLOG_(str)
+#define _LRWLOG_(...)
 #endif
 
 /**
@@ -93,15 +111,17 @@ class LinkRawWireless {
   using u16 = Link::u16;
   using u8 = Link::u8;
   using vu8 = Link::vu8;
+  using vu32 = Link::vu32;
 
  public:
-  static constexpr int PING_WAIT = 50;
-  static constexpr int TRANSFER_WAIT = 15;
-  static constexpr int MICRO_WAIT = 2;
+  static constexpr int PING_WAIT_US = 3671;
+  static constexpr int TRANSFER_WAIT_US = 1101;
+  static constexpr int MICRO_WAIT_US = 40;
+  static constexpr int ACK_POLL_US = 8;
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
-  static constexpr int CMD_TIMEOUT = 228;
+  static constexpr int CMD_TIMEOUT_US = 16742;
 #else
-  static constexpr int CMD_TIMEOUT = 15;
+  static constexpr int CMD_TIMEOUT_US = 1101;
 #endif
   static constexpr int MAX_TRANSFER_BYTES_SERVER = 87;
   static constexpr int MAX_TRANSFER_BYTES_CLIENT = 16;
@@ -141,8 +161,7 @@ class LinkRawWireless {
                                         0x4E45, 0x4E45, 0x4F44, 0x4F44, 0x8001};
 
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
-  typedef void (*Logger)(std::string);
-  Logger logger = [](std::string str) {};
+  Link::BinaryLog* logger = nullptr;
 #endif
 
   enum class State {
@@ -218,6 +237,16 @@ class LinkRawWireless {
 
   enum class AsyncState { IDLE, WORKING, READY };
 
+  using CommandCallback = void (*)(const CommandResult& result);
+
+  /**
+   * @brief Constructs a new LinkRawWireless object.
+   * @param timerId `(0~3)` GBA Timer used by the command engine (for ACK
+   * polling and the adapter waits).
+   */
+  explicit LinkRawWireless(u8 timerId = LINK_RAW_WIRELESS_DEFAULT_TIMER_ID)
+      : timerId(timerId) {}
+
   /**
    * @brief Returns whether the library is active or not.
    */
@@ -226,6 +255,7 @@ class LinkRawWireless {
   /**
    * @brief Activates the library.
    * Returns whether initialization was successful or not.
+   * \warning Blocks the system until completion.
    */
   bool activate(bool _stopFirst = true) {
     LINK_READ_TAG(LINK_RAW_WIRELESS_VERSION);
@@ -234,6 +264,8 @@ class LinkRawWireless {
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    setInterruptHandlers();
     bool success = reset(_stopFirst);
 
     LINK_BARRIER;
@@ -243,6 +275,34 @@ class LinkRawWireless {
     return success;
   }
 
+  /**
+   * @brief Activates the library in the background: the adapter is pinged,
+   * authenticated and greeted (HELLO = `0x10`) from the SERIAL and TIMER
+   * interrupts. After this, wait until `getAsyncState()` is `READY` and check
+   * the `success` of `getAsyncCommandResult()`.
+   * \warning Requires `LINK_RAW_WIRELESS_ISR_SERIAL` and
+   * `LINK_RAW_WIRELESS_ISR_TIMER`.
+   */
+  void activateAsync(bool _stopFirst = true) {
+    LINK_READ_TAG(LINK_RAW_WIRELESS_VERSION);
+
+    LINK_BARRIER;
+    isEnabled = false;
+    LINK_BARRIER;
+
+    LINK_STATS_START;
+    setInterruptHandlers();
+    _resetState();
+    if (_stopFirst)
+      stop();
+
+    LINK_BARRIER;
+    isEnabled = true;
+    LINK_BARRIER;
+
+    startActivation(false);
+  }
+
   /**
    * @brief Restores the state from an existing connection on the Wireless
    * Adapter hardware. This is useful, for example, after a fresh launch of a
@@ -256,6 +316,7 @@ class LinkRawWireless {
     isEnabled = false;
     LINK_BARRIER;
 
+    setInterruptHandlers();
     _resetState();
 
     LINK_BARRIER;
@@ -306,6 +367,7 @@ class LinkRawWireless {
    */
   void deactivate() {
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     _resetState();
     stop();
   }
@@ -469,7 +531,7 @@ class LinkRawWireless {
     }
 
     if (wait)
-      Link::wait(TRANSFER_WAIT);
+      waitSync(TRANSFER_WAIT_US);
 
     _LRWLOG_("state = SERVING");
     state = State::SERVING;
@@ -535,7 +597,7 @@ class LinkRawWireless {
     u8 oldPlayerCount = sessionState.playerCount;
     sessionState.playerCount = 1 + response.connectedClientsSize;
     if (sessionState.playerCount != oldPlayerCount)
-      _LRWLOG_("now: " + std::to_string(sessionState.playerCount) + " players");
+      _LRWLOG_("now: %d players", sessionState.playerCount);
     LINK_BARRIER;
 
     return true;
@@ -567,7 +629,7 @@ class LinkRawWireless {
     u8 oldPlayerCount = sessionState.playerCount;
     sessionState.playerCount = 1 + result.dataSize;
     if (sessionState.playerCount != oldPlayerCount)
-      _LRWLOG_("now: " + std::to_string(sessionState.playerCount) + " players");
+      _LRWLOG_("now: %d players", sessionState.playerCount);
     LINK_BARRIER;
 
     return true;
@@ -599,7 +661,7 @@ class LinkRawWireless {
     u8 oldPlayerCount = sessionState.playerCount;
     sessionState.playerCount = 1 + result.dataSize;
     if (sessionState.playerCount != oldPlayerCount)
-      _LRWLOG_("now: " + std::to_string(sessionState.playerCount) + " players");
+      _LRWLOG_("now: %d players", sessionState.playerCount);
     LINK_BARRIER;
 
     _LRWLOG_("server CLOSED");
@@ -796,7 +858,7 @@ class LinkRawWireless {
 
     u32 bytes = _bytes == 0 ? dataSize * 4 : _bytes;
     u32 header = getSendDataHeaderFor(bytes);
-    _LRWLOG_("using header " + toHex(header));
+    _LRWLOG_("using header %8x", header);
 
     u32 rawData[LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH];
     rawData[0] = header;
@@ -832,7 +894,7 @@ class LinkRawWireless {
 
     u32 bytes = _bytes == 0 ? dataSize * 4 : _bytes;
     u32 header = getSendDataHeaderFor(bytes);
-    _LRWLOG_("using header " + toHex(header));
+    _LRWLOG_("using header %8x", header);
 
     u32 rawData[LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH];
     rawData[0] = header;
@@ -961,147 +1023,38 @@ class LinkRawWireless {
    * @param invertsClock Whether this command inverts the clock or not (Wait).
    * \warning If it `invertsClock`, call `receiveCommandFromAdapter()` on
    * finish.
+   * \warning Blocks the system until completion. It runs the same engine as
+   * `sendCommandAsync(...)`, but polling instead of waiting for interrupts.
    */
   CommandResult sendCommand(u8 type,
                             const u32* params = {},
                             u16 length = 0,
                             bool invertsClock = false) {
-    CommandResult result;
-    u32 command = buildCommand(type, length);
-    u32 r;
-
-    _LRWLOG_("sending command 0x" + toHex(command));
-    if ((r = transfer(command)) != DATA_REQUEST_VALUE) {
-      logExpectedButReceived(DATA_REQUEST_VALUE, r);
-      return result;
-    }
-
-    u32 parameterCount = 0;
-    for (u32 i = 0; i < length; i++) {
-      u32 param = params[i];
-      _LRWLOG_("sending param" + std::to_string(parameterCount) + ": 0x" +
-               toHex(param));
-      if ((r = transfer(param)) != DATA_REQUEST_VALUE) {
-        logExpectedButReceived(DATA_REQUEST_VALUE, r);
-        return result;
-      }
-      parameterCount++;
-    }
-
-    _LRWLOG_("sending response request");
-    u32 response = transfer(DATA_REQUEST_VALUE);
-    u16 header = Link::msB32(response);
-    u16 data = Link::lsB32(response);
-    u8 responses = Link::_min(Link::msB16(data),
-                              LINK_RAW_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH);
-    u8 ack = Link::lsB16(data);
-
-    if (header != COMMAND_HEADER_VALUE) {
-      _LRWLOG_("! expected HEADER 0x9966");
-      _LRWLOG_("! but received 0x" + toHex(header));
-      return result;
-    }
-    if (ack != type + RESPONSE_ACK) {
-      if (ack == 0xEE && responses == 1 && !invertsClock) {
-        u8 LINK_UNUSED code = (u8)transfer(DATA_REQUEST_VALUE);
-        _LRWLOG_("! error received");
-        _LRWLOG_(code == 1 ? "! invalid state" : "! unknown cmd");
-      } else {
-        _LRWLOG_("! expected ACK 0x" + toHex(type + RESPONSE_ACK));
-        _LRWLOG_("! but received 0x" + toHex(ack));
-      }
-      return result;
-    }
-    _LRWLOG_("ack ok! " + std::to_string(responses) + " responses");
-
-    if (!invertsClock) {
-      for (u32 i = 0; i < responses; i++) {
-        _LRWLOG_("response " + std::to_string(i + 1) + "/" +
-                 std::to_string(responses) + ":");
-        u32 responseData = transfer(DATA_REQUEST_VALUE);
-        result.data[result.dataSize++] = responseData;
-        _LRWLOG_("<< " + toHex(responseData));
-      }
-    }
+    if (asyncState != AsyncState::IDLE)
+      return CommandResult{};
 
-    result.success = true;
-    return result;
+    engine.isSync = true;
+    engine.clockInversionSupport = false;
+    startCommand(type, params, length, invertsClock);
+    return runSync();
   }
 
   /**
    * @brief Inverts the clock and waits until the adapter sends a command.
    * Returns the remote command.
+   * \warning Blocks the system until completion.
    */
   CommandResult receiveCommandFromAdapter() {
-    CommandResult remoteCommand;
-
-    if (!isEnabled)
-      return remoteCommand;
-
-    _LRWLOG_("setting SPI to SLAVE");
-    linkSPI.activate(LinkSPI::Mode::SLAVE);
-
-    _LRWLOG_("WAITING for adapter cmd");
-    u32 command = linkSPI.transfer(
-        DATA_REQUEST_VALUE, []() { return false; }, false, true);
-    if (!reverseAcknowledge()) {
-      _resetState();
-      return remoteCommand;
-    }
-
-    u32 lines = 0;
-    u32 vCount = Link::_REG_VCOUNT;
-
-    u16 header = Link::msB32(command);
-    u16 data = Link::lsB32(command);
-    u8 params = Link::msB16(data);
-    u8 commandId = Link::lsB16(data);
-    if (header != COMMAND_HEADER_VALUE) {
-      _LRWLOG_("! expected HEADER 0x9966");
-      _LRWLOG_("! but received 0x" + toHex(header));
-      _resetState();
-      return remoteCommand;
-    }
-    _LRWLOG_("received cmd: " + toHex(commandId) + " (" +
-             std::to_string(params) + " params)");
-
-    for (u32 i = 0; i < params; i++) {
-      _LRWLOG_("param " + std::to_string(i + 1) + "/" + std::to_string(params) +
-               ":");
-      u32 paramData = linkSPI.transfer(
-          DATA_REQUEST_VALUE,
-          [this, &lines, &vCount]() { return cmdTimeout(lines, vCount); },
-          false, true);
-      if (!reverseAcknowledge()) {
-        _resetState();
-        return remoteCommand;
-      }
-      remoteCommand.data[remoteCommand.dataSize++] = paramData;
-      _LRWLOG_("<< " + toHex(paramData));
-    }
+    if (!isEnabled || asyncState != AsyncState::IDLE)
+      return CommandResult{};
 
-    _LRWLOG_("sending ack");
-    command = linkSPI.transfer(
-        (COMMAND_HEADER_VALUE << 16) | ((commandId + RESPONSE_ACK) & 0xFF),
-        [this, &lines, &vCount]() { return cmdTimeout(lines, vCount); }, false,
-        true);
-    if (!reverseAcknowledge(true)) {
+    engine.isSync = true;
+    engine.clockInversionSupport = true;
+    asyncState = AsyncState::WORKING;
+    startReceivingCommand();
+    CommandResult remoteCommand = runSync();
+    if (!remoteCommand.success)
       _resetState();
-      return remoteCommand;
-    }
-
-    if (command != DATA_REQUEST_VALUE) {
-      _LRWLOG_("! expected CMD request");
-      _LRWLOG_("! but received 0x" + toHex(command));
-      _resetState();
-      return remoteCommand;
-    }
-
-    _LRWLOG_("setting SPI to MASTER");
-    linkSPI.activate(LinkSPI::Mode::MASTER_2MBPS);
-
-    remoteCommand.success = true;
-    remoteCommand.commandId = commandId;
 
     return remoteCommand;
   }
@@ -1116,6 +1069,8 @@ class LinkRawWireless {
    * @param invertsClock Whether this command inverts the clock or not (Wait).
    * \warning If it `invertsClock`, the command result will be the one sent by
    * the adapter.
+   * \warning The ACKs run from the SERIAL and TIMER interrupts, so both
+   * handlers are required.
    */
   bool sendCommandAsync(u8 type,
                         const u32* params = {},
@@ -1125,29 +1080,63 @@ class LinkRawWireless {
     if ((!_fromIRQ && !isEnabled) || asyncState != AsyncState::IDLE)
       return false;
 
-    asyncCommand.type = type;
-    asyncCommand.invertsClock = invertsClock;
-    asyncCommand.direction = AsyncCommand::Direction::SENDING;
-    for (u32 i = 0; i < length; i++)
-      asyncCommand.parameters[i] = params[i];
-    asyncCommand.result = CommandResult{};
-    asyncCommand.result.commandId = type;
-    asyncCommand.state = AsyncCommand::State::PENDING;
-    asyncCommand.step = AsyncCommand::Step::COMMAND_HEADER;
-    asyncCommand.sentParameters = 0;
-    asyncCommand.totalParameters = length;
-    asyncCommand.receivedResponses = 0;
-    asyncCommand.totalResponses = 0;
-    asyncState = AsyncState::WORKING;
+    engine.isSync = false;
+    startCommand(type, params, length, invertsClock, _fromIRQ);
 
-    u32 command = buildCommand(type, asyncCommand.totalParameters);
+    return true;
+  }
 
-    _LRWLOG_("sending command 0x" + toHex(command));
-    transferAsync(command, _fromIRQ);
+  /**
+   * @brief Adds an arbitrary command to the command queue. Queued commands run
+   * asynchronously and in order, right after the current async command (back
+   * to back, started by the interrupt handlers). If there's no async command
+   * running, it starts right away.
+   * @param type The ID of the command.
+   * @param params The command parameters.
+   * @param length The number of 32-bit values in the `params` array.
+   * @param onComplete A function called with the result of the command, from
+   * the interrupt handler. It can queue more commands. If it's `nullptr`, the
+   * result is returned like the ones from `sendCommandAsync(...)`, and the
+   * queue waits until `getAsyncCommandResult()` is called.
+   * \warning Returns `false` if the queue is full (see
+   * `LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE`).
+   * \warning Commands that invert the clock (Wait) can't be queued.
+   * \warning Don't queue commands from the main loop and from interrupt
+   * handlers at the same time.
+   */
+  bool queueCommand(u8 type,
+                    const u32* params = {},
+                    u16 length = 0,
+                    CommandCallback onComplete = nullptr,
+                    bool _fromIRQ = false) {
+    if ((!_fromIRQ && !isEnabled) ||
+        length > LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH ||
+        queueEnd - queueStart == LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE)
+      return false;
 
+    auto& command =
+        commandQueue[queueEnd % LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE];
+    command.type = type;
+    for (u32 i = 0; i < length; i++)
+      command.parameters[i] = params[i];
+    command.length = length;
+    command.onComplete = onComplete;
+    LINK_BARRIER;
+    queueEnd = queueEnd + 1;
+    LINK_BARRIER;
+
+    _startQueuedCommand(_fromIRQ);
     return true;
   }
 
+  /**
+   * @brief Returns the number of queued commands that haven't finished yet
+   * (including the running one).
+   */
+  [[nodiscard]] u32 getQueuedCommands() {
+    return queueEnd - queueStart + (isRunningQueuedCommand ? 1 : 0);
+  }
+
   /**
    * @brief Returns the state of the last async command.
    * @return One of the enum values from `LinkRawWireless::AsyncState`.
@@ -1164,6 +1153,7 @@ class LinkRawWireless {
 
     CommandResult data = asyncCommand.result;
     asyncState = AsyncState::IDLE;
+    _startQueuedCommand(false);
     return data;
   }
 
@@ -1209,6 +1199,20 @@ class LinkRawWireless {
    */
   [[nodiscard]] u8 currentPlayerId() { return sessionState.currentPlayerId; }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief Resets all the state.
    * \warning This is internal API!
@@ -1218,6 +1222,12 @@ class LinkRawWireless {
     _LRWLOG_("state = NEEDS_RESET");
     state = State::NEEDS_RESET;
     asyncState = AsyncState::IDLE;
+    stopTimer();
+    engine.phase = Engine::Phase::IDLE;
+    engine.isActivating = false;
+    queueStart = 0;
+    queueEnd = 0;
+    isRunningQueuedCommand = false;
     sessionState.playerCount = 1;
     sessionState.currentPlayerId = 0;
     sessionState.isServerClosed = false;
@@ -1228,17 +1238,45 @@ class LinkRawWireless {
    * @brief Returns a pointer to the internal result of the last async command
    * and switches the state back to `IDLE`.
    * \warning This is internal API!
+   * \warning Call `_startQueuedCommand()` after processing the result.
    */
   [[nodiscard]] CommandResult* _getAsyncCommandResultRef() {
     asyncState = AsyncState::IDLE;
     return &asyncCommand.result;
   }
 
+  /**
+   * @brief Starts the next queued command, if there's no async command running.
+   * \warning This is internal API!
+   */
+  void _startQueuedCommand(bool _fromIRQ = true) {
+    if (asyncState != AsyncState::IDLE || isRunningQueuedCommand ||
+        queueStart == queueEnd)
+      return;
+
+    auto& command =
+        commandQueue[queueStart % LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE];
+    isRunningQueuedCommand = true;
+    runningCallback = command.onComplete;
+    engine.isSync = false;
+    startCommand(command.type, command.parameters, command.length, false,
+                 _fromIRQ);
+    LINK_BARRIER;
+    queueStart = queueStart + 1;  // (the parameters were copied)
+    LINK_BARRIER;
+  }
+
   /**
    * @brief This method is called by the SERIAL interrupt handler.
    * \warning This is internal API!
+   * \warning With `_spinAcks`, the ACK phases of the engine are polled right
+   * here (blocking), so the TIMER interrupt handler is not needed (the timer
+   * is still used, without interrupts). That's only used by the libraries
+   * built on top of this one, during sessions.
    */
-  LINK_INLINE int _onSerial(bool _clockInversionSupport = true) {
+  LINK_INLINE int _onSerial(bool _clockInversionSupport = true,
+                            bool _spinAcks = false) {
+    LINK_STATS_ISR(serial);
     if (!isEnabled)
       return -1;
 
@@ -1249,49 +1287,47 @@ class LinkRawWireless {
       return -2;
     u32 newData = linkSPI.getAsyncData();
 
-    if (!isSessionActive() || asyncState != AsyncState::WORKING)
-      return -3;
-
-    if (asyncCommand.state == AsyncCommand::State::PENDING) {
-      if (!_clockInversionSupport ||
-          asyncCommand.direction == AsyncCommand::Direction::SENDING) {
-        if (!acknowledge())
-          return -4;
-
-#ifdef LINK_WIRELESS_ENABLE_NESTED_IRQ
-        Link::_REG_IME = 1;
-#endif
-
-        sendAsyncCommand(newData, _clockInversionSupport);
-      } else if (_clockInversionSupport) {
-        if (!reverseAcknowledge(asyncCommand.step ==
-                                AsyncCommand::Step::DATA_REQUEST))
-          return -5;
-        receiveAsyncCommand(newData);
-      }
+    if (!_spinAcks) {
+      if (asyncState != AsyncState::WORKING || engine.isSync)
+        return -3;
 
-      if (asyncCommand.state == AsyncCommand::State::COMPLETED) {
-        asyncState = AsyncState::READY;
-        return 1;
-      }
+      engine.clockInversionSupport = _clockInversionSupport;
+      onTransferCompleted(newData);
+      return asyncState == AsyncState::READY ? 1 : 0;
     }
 
-    return 0;
+    if (!isSessionActive() || asyncState != AsyncState::WORKING ||
+        engine.isSync)
+      return -3;
+
+    bool isSending = !_clockInversionSupport ||
+                     asyncCommand.direction == AsyncCommand::Direction::SENDING;
+    engine.clockInversionSupport = _clockInversionSupport;
+    engine.spinsAcks = true;
+    engine.didAckFail = false;
+    onTransferCompleted(newData);
+    while (engine.phase != Engine::Phase::IDLE &&
+           engine.phase != Engine::Phase::TRANSFER)
+      spinTimerPhase();
+    engine.spinsAcks = false;
+
+    if (engine.didAckFail)
+      return isSending ? -4 : -5;
+    return asyncState == AsyncState::READY ? 1 : 0;
   }
 
-#ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
   /**
-   * @brief Converts `w` to an hexadecimal string.
+   * @brief This method is called by the TIMER interrupt handler.
+   * \warning This is internal API!
    */
-  template <typename I>
-  [[nodiscard]] std::string toHex(I w, size_t hex_len = sizeof(I) << 1) {
-    static const char* digits = "0123456789ABCDEF";
-    std::string rc(hex_len, '0');
-    for (size_t i = 0, j = (hex_len - 1) * 4; i < hex_len; ++i, j -= 4)
-      rc[i] = digits[(w >> j) & 0x0F];
-    return rc;
+  void _onTimer() {
+    LINK_STATS_ISR(timer);
+    if (!isEnabled || engine.isSync)
+      return;
+
+    stopTimer();
+    onTimerCompleted(engine.scheduledTicks);
   }
-#endif
 
   // -------------
   // Low-level API
@@ -1305,6 +1341,13 @@ class LinkRawWireless {
   // ------------
 
  private:
+#ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
+  void _log(const char* format, u32 arg0 = 0, u32 arg1 = 0) {
+    if (logger)
+      logger->record(format, arg0, arg1);
+  }
+#endif
+
   struct LoginMemory {
     u16 previousGBAData = 0xFFFF;
     u16 previousAdapterData = 0x8000;
@@ -1331,13 +1374,61 @@ class LinkRawWireless {
     Step step;
     u32 sentParameters, totalParameters;
     u32 receivedResponses, totalResponses;
+    bool isError;
+  };
+
+  struct QueuedCommand {
+    u8 type;
+    u16 length;
+    u32 parameters[LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH];
+    CommandCallback onComplete;
+  };
+
+  struct Engine {
+    enum class Phase {
+      IDLE,
+      PING,             // SD=HIGH, waiting `PING_WAIT_US`
+      LOGIN_WAIT,       // waiting `TRANSFER_WAIT_US` before a login packet
+      LOGIN_TRANSFER,   // waiting for a login packet (SERIAL)
+      HELLO_WAIT,       // waiting `TRANSFER_WAIT_US` before HELLO
+      TRANSFER,         // waiting for a command word (SERIAL)
+      ACK_SI_HIGH,      // SO=LOW, waiting for SI=HIGH
+      ACK_SI_LOW,       // SO=HIGH, waiting for SI=LOW
+      REV_ACK_SI_LOW,   // SO=LOW, waiting for SI=LOW
+      REV_ACK_SI_HIGH,  // SO=HIGH, waiting for SI=HIGH
+      REV_ACK_WAIT,     // waiting `MICRO_WAIT_US`
+      REV_ACK_END       // SO=LOW, waiting for SI=LOW (last part only)
+    };
+
+    volatile Phase phase = Phase::IDLE;
+    bool isSync = false;     // (polled by the sync API instead of IRQs)
+    bool spinsAcks = false;  // (ACKs polled inside the SERIAL handler)
+    bool didAckFail = false;
+    bool isActivating = false;
+    bool clockInversionSupport = true;
+    bool isLastPart = false;
+    u32 word = 0;
+    u32 scheduledTicks = 0;
+    u32 elapsedTicks = 0;
+    u32 loginStep = 0;
+    LoginMemory loginMemory;
   };
 
   LinkSPI linkSPI;
   LinkGPIO linkGPIO;
+  u8 timerId;
   volatile State state = State::NEEDS_RESET;
   volatile AsyncState asyncState = AsyncState::IDLE;
   AsyncCommand asyncCommand;
+  Engine engine;
+  QueuedCommand commandQueue[LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE];
+  vu32 queueStart = 0;  // (only moved when starting commands)
+  vu32 queueEnd = 0;    // (only moved when queueing commands)
+  volatile bool isRunningQueuedCommand = false;
+  CommandCallback runningCallback = nullptr;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
   void copyName(char* target, const char* source, u32 length) {
@@ -1381,28 +1472,22 @@ class LinkRawWireless {
   void stop() { linkSPI.deactivate(); }
 
   bool start() {
-    pingAdapter();
-    _LRWLOG_("setting SPI to 256Kbps");
-    linkSPI.activate(LinkSPI::Mode::MASTER_256KBPS);
-
-    if (!login())
-      return false;
-
-    Link::wait(TRANSFER_WAIT);
-
-    _LRWLOG_("sending HELLO command");
-    if (!sendCommand(COMMAND_HELLO).success)
-      return false;
-
-    _LRWLOG_("setting SPI to 2Mbps");
-    linkSPI.activate(LinkSPI::Mode::MASTER_2MBPS);
-    _LRWLOG_("state = AUTHENTICATED");
-    state = State::AUTHENTICATED;
+    startActivation(true);
+    return runSync().success;
+  }
 
-    return true;
+  void setInterruptHandlers() {
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkRawWireless, _onSerial);
+    LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[timerId], LinkRawWireless, _onTimer);
   }
 
-  void pingAdapter() {
+  void startActivation(bool isSync) {
+    engine.isSync = isSync;
+    engine.isActivating = true;
+    engine.clockInversionSupport = false;
+    resetAsyncCommand(COMMAND_HELLO, false, AsyncCommand::Direction::SENDING);
+    asyncState = AsyncState::WORKING;
+
     linkGPIO.reset();
     _LRWLOG_("setting SO as OUTPUT");
     linkGPIO.setMode(LinkGPIO::Pin::SO, LinkGPIO::Direction::OUTPUT);
@@ -1410,31 +1495,193 @@ class LinkRawWireless {
     linkGPIO.setMode(LinkGPIO::Pin::SD, LinkGPIO::Direction::OUTPUT);
     _LRWLOG_("setting SD = HIGH");
     linkGPIO.writePin(LinkGPIO::Pin::SD, true);
-    Link::wait(PING_WAIT);
-    _LRWLOG_("setting SD = LOW");
-    linkGPIO.writePin(LinkGPIO::Pin::SD, false);
+
+    engine.phase = Engine::Phase::PING;
+    startTimer(toTicks(PING_WAIT_US));
   }
 
-  bool login() {
-    LoginMemory memory;
+  void startCommand(u8 type,
+                    const u32* params = {},
+                    u16 length = 0,
+                    bool invertsClock = false,
+                    bool fromIRQ = true) {
+    resetAsyncCommand(type, invertsClock, AsyncCommand::Direction::SENDING,
+                      length);
+    for (u32 i = 0; i < length; i++)
+      asyncCommand.parameters[i] = params[i];
+    asyncState = AsyncState::WORKING;
+    LINK_TRACE(RAW_WIRELESS, COMMAND, type, length);
 
-    for (u32 i = 0; i < LOGIN_STEPS; i++) {
-      _LRWLOG_("sending login packet " + std::to_string(i + 1) + "/" +
-               std::to_string(LOGIN_STEPS));
-      if (!exchangeLoginPacket(LOGIN_PARTS[i],
-                               i < LOGIN_JUNK_STEPS ? 0 : LOGIN_PARTS[i],
-                               memory))
-        return false;
+    u32 command = buildCommand(type, length);
+
+    _LRWLOG_("sending command 0x%8x", command);
+    transferAsync(command, fromIRQ);
+  }
+
+  void startReceivingCommand() {
+    _LRWLOG_("setting SPI to SLAVE");
+    linkSPI.activate(LinkSPI::Mode::SLAVE);
+    resetAsyncCommand(0, true, AsyncCommand::Direction::RECEIVING);
+
+    _LRWLOG_("WAITING for adapter cmd");
+    transferAsync(DATA_REQUEST_VALUE, true);
+  }
+
+  void resetAsyncCommand(u8 type,
+                         bool invertsClock,
+                         AsyncCommand::Direction direction,
+                         u32 totalParameters = 0) {
+    asyncCommand.type = type;
+    asyncCommand.invertsClock = invertsClock;
+    asyncCommand.direction = direction;
+    asyncCommand.result = CommandResult{};
+    asyncCommand.result.commandId = type;
+    asyncCommand.state = AsyncCommand::State::PENDING;
+    asyncCommand.step = AsyncCommand::Step::COMMAND_HEADER;
+    asyncCommand.sentParameters = 0;
+    asyncCommand.totalParameters = totalParameters;
+    asyncCommand.receivedResponses = 0;
+    asyncCommand.totalResponses = 0;
+    asyncCommand.isError = false;
+  }
+
+  CommandResult runSync() {
+    while (engine.phase != Engine::Phase::IDLE) {
+      if (engine.phase == Engine::Phase::TRANSFER ||
+          engine.phase == Engine::Phase::LOGIN_TRANSFER) {
+        // (the adapter can take its time to send a command)
+        bool canTimeOut =
+            asyncCommand.direction == AsyncCommand::Direction::SENDING ||
+            asyncCommand.step != AsyncCommand::Step::COMMAND_HEADER;
+        bool isLoginPacket = engine.phase == Engine::Phase::LOGIN_TRANSFER;
+        bool didTimeOut = false;
+
+        startTimer(toTicks(CMD_TIMEOUT_US));
+        u32 data = linkSPI.transfer(
+            engine.word,
+            [this, canTimeOut, &didTimeOut]() {
+              didTimeOut = canTimeOut && hasTimerElapsed();
+              return didTimeOut;
+            },
+            false, !isLoginPacket);
+        stopTimer();
+
+        if (didTimeOut) {
+          LINK_STATS_COUNT(timeouts);
+          LINK_TRACE(RAW_WIRELESS, TIMEOUT, engine.word, 0);
+          failCommand();
+        } else {
+          onTransferCompleted(data);
+        }
+      } else {
+        spinTimerPhase();
+      }
     }
 
-    return true;
+    CommandResult result = asyncCommand.result;
+    asyncState = AsyncState::IDLE;
+    if (!asyncCommand.invertsClock ||
+        asyncCommand.direction == AsyncCommand::Direction::RECEIVING)
+      _startQueuedCommand(false);  // (unless the adapter owns the clock now)
+    return result;
+  }
+
+  void spinTimerPhase() {  // (sync or spinning acks)
+    while (!hasTimerElapsed() && !isAckPhaseDone())
+      LINK_BUSY_WAIT;
+    u32 elapsedTicks = Link::_REG_TM[timerId].count;
+    stopTimer();
+    onTimerCompleted(elapsedTicks);
+  }
+
+  void onTransferCompleted(u32 newData) {  // (irq or sync)
+    if (engine.phase == Engine::Phase::LOGIN_TRANSFER) {
+      onLoginPacketCompleted(newData);
+      return;
+    }
+    if (engine.phase != Engine::Phase::TRANSFER)
+      return;
+
+    engine.word = newData;
+    engine.elapsedTicks = 0;
+    linkSPI._setSOLow();
+    if (!engine.clockInversionSupport ||
+        asyncCommand.direction == AsyncCommand::Direction::SENDING) {
+      engine.phase = Engine::Phase::ACK_SI_HIGH;
+    } else {
+      engine.isLastPart =
+          asyncCommand.step == AsyncCommand::Step::DATA_REQUEST;
+      engine.phase = Engine::Phase::REV_ACK_SI_LOW;
+    }
+    continueAck();
+  }
+
+  void onTimerCompleted(u32 elapsedTicks) {  // (irq or sync)
+    engine.elapsedTicks += elapsedTicks;
+
+    switch (engine.phase) {
+      case Engine::Phase::PING: {
+        _LRWLOG_("setting SD = LOW");
+        linkGPIO.writePin(LinkGPIO::Pin::SD, false);
+        _LRWLOG_("setting SPI to 256Kbps");
+        linkSPI.activate(LinkSPI::Mode::MASTER_256KBPS);
+
+        engine.loginStep = 0;
+        engine.loginMemory = LoginMemory{};
+        waitBeforeTransfer(Engine::Phase::LOGIN_WAIT);
+        break;
+      }
+      case Engine::Phase::LOGIN_WAIT: {
+        _LRWLOG_("sending login packet %d/%d", engine.loginStep + 1,
+                 LOGIN_STEPS);
+        u32 packet = Link::buildU32(~engine.loginMemory.previousAdapterData,
+                                    LOGIN_PARTS[engine.loginStep]);
+        transferLoginPacket(packet);
+        break;
+      }
+      case Engine::Phase::HELLO_WAIT: {
+        _LRWLOG_("sending HELLO command");
+        startCommand(COMMAND_HELLO);
+        break;
+      }
+      case Engine::Phase::REV_ACK_WAIT: {
+        if (engine.isLastPart) {
+          // (normally, this occurs on the next transfer)
+          linkSPI._setSOLow();
+          engine.phase = Engine::Phase::REV_ACK_END;
+          continueAck();
+        } else {
+          onWordAcknowledged();
+        }
+        break;
+      }
+      default: {
+        continueAck();
+      }
+    }
+  }
+
+  void onLoginPacketCompleted(u32 response) {  // (irq or sync)
+    linkSPI._setSOHigh();
+
+    u32 step = engine.loginStep;
+    u16 expectedResponse = step < LOGIN_JUNK_STEPS ? 0 : LOGIN_PARTS[step];
+    if (!checkLoginResponse(LOGIN_PARTS[step], expectedResponse, response,
+                            engine.loginMemory)) {
+      failCommand();
+      return;
+    }
+
+    engine.loginStep++;
+    waitBeforeTransfer(engine.loginStep < LOGIN_STEPS
+                           ? Engine::Phase::LOGIN_WAIT
+                           : Engine::Phase::HELLO_WAIT);
   }
 
-  bool exchangeLoginPacket(u16 data,
-                           u16 expectedResponse,
-                           LoginMemory& memory) {
-    u32 packet = Link::buildU32(~memory.previousAdapterData, data);
-    u32 response = transfer(packet, false);
+  bool checkLoginResponse(u16 data,
+                          u16 expectedResponse,
+                          u32 response,
+                          LoginMemory& memory) {
     u32 adapterData = Link::msB32(response);
 
     if (expectedResponse != 0 &&
@@ -1452,113 +1699,194 @@ class LinkRawWireless {
     return true;
   }
 
-  u32 buildCommand(u8 type, u8 length = 0) {
-    return Link::buildU32(COMMAND_HEADER_VALUE, Link::buildU16(length, type));
+  void continueAck() {  // (irq or sync)
+    while (true) {
+      switch (engine.phase) {
+        case Engine::Phase::ACK_SI_HIGH: {
+          if (!linkSPI._isSIHigh())
+            return pollAck();
+          linkSPI._setSOHigh();
+          engine.phase = Engine::Phase::ACK_SI_LOW;
+          break;
+        }
+        case Engine::Phase::ACK_SI_LOW: {
+          if (linkSPI._isSIHigh())
+            return pollAck();
+          linkSPI._setSOLow();
+          return onWordAcknowledged();
+        }
+        case Engine::Phase::REV_ACK_SI_LOW: {
+          if (linkSPI._isSIHigh())
+            return pollAck();
+          linkSPI._setSOHigh();
+          engine.phase = Engine::Phase::REV_ACK_SI_HIGH;
+          break;
+        }
+        case Engine::Phase::REV_ACK_SI_HIGH: {
+          if (!linkSPI._isSIHigh())
+            return pollAck();
+          // this wait is VERY important to avoid desyncs! (at least 40us)
+          engine.phase = Engine::Phase::REV_ACK_WAIT;
+          return startTimer(toTicks(MICRO_WAIT_US));
+        }
+        case Engine::Phase::REV_ACK_END: {
+          if (linkSPI._isSIHigh())
+            return pollAck();
+          return onWordAcknowledged();
+        }
+        default:
+          return;
+      }
+    }
   }
 
-  u32 transfer(u32 data, bool customAck = true) {
-    if (!customAck)
-      Link::wait(TRANSFER_WAIT);
-
-    u32 lines = 0;
-    u32 vCount = Link::_REG_VCOUNT;
-    u32 receivedData = linkSPI.transfer(
-        data, [this, &lines, &vCount]() { return cmdTimeout(lines, vCount); },
-        false, customAck);
+  bool isAckPhaseDone() {
+    switch (engine.phase) {
+      case Engine::Phase::ACK_SI_HIGH:
+      case Engine::Phase::REV_ACK_SI_HIGH:
+        return linkSPI._isSIHigh();
+      case Engine::Phase::ACK_SI_LOW:
+      case Engine::Phase::REV_ACK_SI_LOW:
+      case Engine::Phase::REV_ACK_END:
+        return !linkSPI._isSIHigh();
+      default:
+        return false;
+    }
+  }
 
-    if (customAck && !acknowledge())
-      return LINK_SPI_NO_DATA_32;
+  void pollAck() {  // (irq or sync)
+    if (engine.elapsedTicks > toTicks(CMD_TIMEOUT_US)) {
+      _LRWLOG_("! ACK failed (phase %d)", (u32)engine.phase);
+      LINK_STATS_COUNT(timeouts);
+      LINK_TRACE(RAW_WIRELESS, TIMEOUT, (u32)engine.phase,
+                 engine.elapsedTicks);
+      engine.didAckFail = true;
+      failCommand();
+      return;
+    }
 
-    return receivedData;
+    startTimer(toTicks(ACK_POLL_US));
   }
 
-  bool acknowledge() {
-    u32 lines = 0;
-    u32 vCount = Link::_REG_VCOUNT;
+  void onWordAcknowledged() {  // (irq or sync)
+    engine.phase = Engine::Phase::IDLE;
 
-    linkSPI._setSOLow();
-    while (!linkSPI._isSIHigh()) {
-      if (cmdTimeout(lines, vCount)) {
-        _LRWLOG_("! ACK 1 failed. I put SO=LOW,");
-        _LRWLOG_("! but SI didn't become HIGH.");
-        return false;
-      }
+    if (!engine.clockInversionSupport ||
+        asyncCommand.direction == AsyncCommand::Direction::SENDING) {
+#ifdef LINK_WIRELESS_ENABLE_NESTED_IRQ
+      if (engine.spinsAcks)
+        Link::_REG_IME = 1;
+#endif
+      sendAsyncCommand(engine.word, engine.clockInversionSupport);
+    } else {
+      receiveAsyncCommand(engine.word);
     }
-    linkSPI._setSOHigh();
-    while (linkSPI._isSIHigh()) {
-      if (cmdTimeout(lines, vCount)) {
-        _LRWLOG_("! ACK 2 failed. I put SO=HIGH,");
-        _LRWLOG_("! but SI didn't become LOW.");
-        return false;
+
+    if (asyncCommand.state == AsyncCommand::State::COMPLETED)
+      finishCommand();
+  }
+
+  void failCommand() {  // (irq or sync)
+    LINK_TRACE(RAW_WIRELESS, COMMAND_FAILURE, asyncCommand.type,
+               (u32)engine.phase);
+    asyncCommand.result.success = false;
+    asyncCommand.state = AsyncCommand::State::COMPLETED;
+    finishCommand();
+  }
+
+  void finishCommand() {  // (irq or sync)
+    engine.phase = Engine::Phase::IDLE;
+    stopTimer();
+
+    if (!asyncCommand.result.success)
+      LINK_STATS_COUNT(commandFailures);
+
+    if (engine.isActivating) {
+      engine.isActivating = false;
+      if (asyncCommand.result.success) {
+        _LRWLOG_("setting SPI to 2Mbps");
+        linkSPI.activate(LinkSPI::Mode::MASTER_2MBPS);
+        _LRWLOG_("state = AUTHENTICATED");
+        state = State::AUTHENTICATED;
       }
     }
-    linkSPI._setSOLow();
 
+    asyncState = AsyncState::READY;
+    finishQueuedCommand();
+  }
+
+  LINK_INLINE bool finishQueuedCommand() {  // (irq only)
+    if (!isRunningQueuedCommand)
+      return false;
+    isRunningQueuedCommand = false;
+    if (!runningCallback)
+      return false;
+
+    // (the state is still `READY`, so the callback can only queue commands)
+    runningCallback(asyncCommand.result);
+    asyncState = AsyncState::IDLE;
+    _startQueuedCommand();
     return true;
   }
 
-  bool reverseAcknowledge(bool isLastPart = false) {
-    // `isLastPart` is required when there's no subsequent
-    // `linkSPI.transfer(...)` call.
-    u32 lines = 0;
-    u32 vCount = Link::_REG_VCOUNT;
+  void waitBeforeTransfer(Engine::Phase phase) {
+    engine.phase = phase;
+    startTimer(toTicks(TRANSFER_WAIT_US));
+  }
 
-    linkSPI._setSOLow();
-    while (linkSPI._isSIHigh()) {
-      if (cmdTimeout(lines, vCount)) {
-        _LRWLOG_("! RevAck0 failed. I put SO=LOW,");
-        _LRWLOG_("! but SI didn't become LOW.");
-        return false;
-      }
+  void transferLoginPacket(u32 packet) {
+    engine.phase = Engine::Phase::LOGIN_TRANSFER;
+    if (engine.isSync) {
+      engine.word = packet;
+      return;
     }
 
-    linkSPI._setSOHigh();
-    while (!linkSPI._isSIHigh()) {
-      if (cmdTimeout(lines, vCount)) {
-        _LRWLOG_("! RevAck1 failed. I put SO=HIGH,");
-        _LRWLOG_("! but SI didn't become HIGH.");
-        return false;
-      }
-    }
+    linkSPI.transfer(packet, []() { return false; }, true, true);
+  }
 
-    Link::wait(MICRO_WAIT);  // this wait is VERY important to avoid desyncs!
-    // wait at least 40us; monitoring VCOUNT to avoid requiring a timer or
-    // putting some wait code in IWRAM
-
-    // (normally, this occurs on the next linkSPI.transfer(...) call)
-    if (isLastPart) {
-      linkSPI._setSOLow();
-      while (linkSPI._isSIHigh()) {
-        if (cmdTimeout(lines, vCount)) {
-          _LRWLOG_("! RevAck2 failed. I put SO=LOW,");
-          _LRWLOG_("! but SI didn't become LOW.");
-          return false;
-        }
-      }
+  void startTimer(u16 ticks) {
+    engine.scheduledTicks = ticks;
+    Link::_REG_TM[timerId].cnt = 0;
+    if (engine.isSync || engine.spinsAcks) {
+      Link::_REG_TM[timerId].start = 0;
+      Link::_REG_TM[timerId].cnt = Link::_TM_ENABLE | Link::_TM_FREQ_64;
+    } else {
+      Link::_REG_TM[timerId].start = -ticks;
+      Link::_REG_TM[timerId].cnt =
+          Link::_TM_ENABLE | Link::_TM_IRQ | Link::_TM_FREQ_64;
     }
+  }
 
-    return true;
+  void stopTimer() { Link::_REG_TM[timerId].cnt = 0; }
+
+  void waitSync(u32 microseconds) {
+    engine.isSync = true;
+    startTimer(toTicks(microseconds));
+    while (!hasTimerElapsed())
+      LINK_BUSY_WAIT;
+    stopTimer();
   }
 
-  bool cmdTimeout(u32& lines, u32& vCount) {
-    return timeout(CMD_TIMEOUT, lines, vCount);
+  bool hasTimerElapsed() {
+    return Link::_REG_TM[timerId].count >= engine.scheduledTicks;
   }
 
-  bool timeout(u32 limit, u32& lines, u32& vCount) {
-    if (Link::_REG_VCOUNT != vCount) {
-      lines += Link::_max((int)Link::_REG_VCOUNT - (int)vCount, 0);
-      vCount = Link::_REG_VCOUNT;
-    }
+  static constexpr u16 toTicks(u32 microseconds) {  // (64 cycles/tick)
+    return (u16)((microseconds * 16777 + 63999) / 64000);
+  }
 
-    return lines > limit;
+  u32 buildCommand(u8 type, u8 length = 0) {
+    return Link::buildU32(COMMAND_HEADER_VALUE, Link::buildU16(length, type));
   }
 
   LINK_INLINE void sendAsyncCommand(
       u32 newData,
-      bool _clockInversionSupport = true) {  // (irq only)
+      bool _clockInversionSupport = true) {  // (irq or sync)
     switch (asyncCommand.step) {
       case AsyncCommand::Step::COMMAND_HEADER: {
         if (newData != DATA_REQUEST_VALUE) {
+          LINK_TRACE(RAW_WIRELESS, COMMAND_FAILURE, asyncCommand.type,
+                     newData);
           asyncCommand.state = AsyncCommand::State::COMPLETED;
           return;
         }
@@ -1568,6 +1896,8 @@ class LinkRawWireless {
       }
       case AsyncCommand::Step::COMMAND_PARAMETERS: {
         if (newData != DATA_REQUEST_VALUE) {
+          LINK_TRACE(RAW_WIRELESS, COMMAND_FAILURE, asyncCommand.type,
+                     newData);
           asyncCommand.state = AsyncCommand::State::COMPLETED;
           return;
         }
@@ -1581,28 +1911,42 @@ class LinkRawWireless {
         u8 responses = Link::msB16(data);
         u8 ack = Link::lsB16(data);
 
+        if (header == COMMAND_HEADER_VALUE && ack == 0xEE && responses == 1 &&
+            !asyncCommand.invertsClock) {
+          // (the error code has to be read, or the adapter will desync)
+          _LRWLOG_("! error received");
+          asyncCommand.isError = true;
+          asyncCommand.totalResponses = responses;
+          asyncCommand.result.dataSize = responses;
+          receiveResponseOrFinish(_clockInversionSupport);
+          break;
+        }
+
         if (header != COMMAND_HEADER_VALUE ||
             ack != asyncCommand.type + RESPONSE_ACK ||
             responses > LINK_RAW_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH) {
           if (header != COMMAND_HEADER_VALUE) {
             _LRWLOG_("! expected HEADER 0x9966");
-            _LRWLOG_("! but received 0x" + toHex(header));
+            _LRWLOG_("! but received 0x%4x", header);
           }
           if (ack != asyncCommand.type + RESPONSE_ACK) {
             if (ack == 0xEE) {
               _LRWLOG_("! error received");
             } else {
-              _LRWLOG_("! expected ACK 0x" +
-                       toHex(asyncCommand.type + RESPONSE_ACK));
-              _LRWLOG_("! but received 0x" + toHex(ack));
+              _LRWLOG_("! expected ACK 0x%2x",
+                       asyncCommand.type + RESPONSE_ACK);
+              _LRWLOG_("! but received 0x%2x", ack);
             }
           }
 
+          LINK_TRACE(RAW_WIRELESS, COMMAND_FAILURE, asyncCommand.type,
+                     newData);
           asyncCommand.state = AsyncCommand::State::COMPLETED;
           return;
         }
 
-        _LRWLOG_("ack ok! " + std::to_string(responses) + " responses");
+        _LRWLOG_("ack ok! %d responses", responses);
+        LINK_TRACE(RAW_WIRELESS, ACK, ack, responses);
 
         asyncCommand.totalResponses = responses;
         asyncCommand.result.dataSize = responses;
@@ -1611,10 +1955,9 @@ class LinkRawWireless {
         break;
       }
       case AsyncCommand::Step::DATA_REQUEST: {
-        _LRWLOG_("response " +
-                 std::to_string(asyncCommand.receivedResponses + 1) + "/" +
-                 std::to_string(asyncCommand.totalResponses) + ":");
-        _LRWLOG_("<< " + toHex(newData));
+        _LRWLOG_("response %d/%d:", asyncCommand.receivedResponses + 1,
+                 asyncCommand.totalResponses);
+        _LRWLOG_("<< %8x", newData);
 
         asyncCommand.result.data[asyncCommand.receivedResponses] = newData;
         asyncCommand.receivedResponses++;
@@ -1627,12 +1970,11 @@ class LinkRawWireless {
     }
   }
 
-  void sendParametersOrRequestResponse() {  // (irq only)
+  void sendParametersOrRequestResponse() {  // (irq or sync)
     if (asyncCommand.sentParameters < asyncCommand.totalParameters) {
       asyncCommand.step = AsyncCommand::Step::COMMAND_PARAMETERS;
-      _LRWLOG_("sending param" + std::to_string(asyncCommand.sentParameters) +
-               ": 0x" +
-               toHex(asyncCommand.parameters[asyncCommand.sentParameters]));
+      _LRWLOG_("sending param%d: 0x%8x", asyncCommand.sentParameters,
+               asyncCommand.parameters[asyncCommand.sentParameters]);
       transferAsync(asyncCommand.parameters[asyncCommand.sentParameters], true);
       asyncCommand.sentParameters++;
     } else {
@@ -1643,36 +1985,24 @@ class LinkRawWireless {
   }
 
   void receiveResponseOrFinish(
-      bool _clockInversionSupport = true) {  // (irq only)
+      bool _clockInversionSupport = true) {  // (irq or sync)
     if (asyncCommand.receivedResponses < asyncCommand.totalResponses) {
       asyncCommand.step = AsyncCommand::Step::DATA_REQUEST;
       transferAsync(DATA_REQUEST_VALUE, true);
     } else {
       if (_clockInversionSupport && asyncCommand.invertsClock) {
-        _LRWLOG_("setting SPI to SLAVE");
-        linkSPI.activate(LinkSPI::Mode::SLAVE);
-
-        asyncCommand.type = 0;
-        asyncCommand.invertsClock = true;
-        asyncCommand.direction = AsyncCommand::Direction::RECEIVING;
-        asyncCommand.result = CommandResult{};
-        asyncCommand.state = AsyncCommand::State::PENDING;
-        asyncCommand.step = AsyncCommand::Step::COMMAND_HEADER;
-        asyncCommand.sentParameters = 0;
-        asyncCommand.totalParameters = 0;
-        asyncCommand.receivedResponses = 0;
-        asyncCommand.totalResponses = 0;
-
-        _LRWLOG_("WAITING for adapter cmd");
-        transferAsync(DATA_REQUEST_VALUE, true);
+        startReceivingCommand();
       } else {
-        asyncCommand.result.success = true;
+        if (asyncCommand.isError)
+          LINK_TRACE(RAW_WIRELESS, COMMAND_FAILURE, asyncCommand.type,
+                     asyncCommand.result.data[0]);
+        asyncCommand.result.success = !asyncCommand.isError;
         asyncCommand.state = AsyncCommand::State::COMPLETED;
       }
     }
   }
 
-  LINK_INLINE void receiveAsyncCommand(u32 newData) {  // (irq only)
+  LINK_INLINE void receiveAsyncCommand(u32 newData) {  // (irq or sync)
     switch (asyncCommand.step) {
       case AsyncCommand::Step::COMMAND_HEADER: {
         u16 header = Link::msB32(newData);
@@ -1682,12 +2012,12 @@ class LinkRawWireless {
 
         if (header != COMMAND_HEADER_VALUE) {
           _LRWLOG_("! expected HEADER 0x9966");
-          _LRWLOG_("! but received 0x" + toHex(header));
+          _LRWLOG_("! but received 0x%4x", header);
           asyncCommand.state = AsyncCommand::State::COMPLETED;
           return;
         }
-        _LRWLOG_("received cmd: " + toHex(commandId) + " (" +
-                 std::to_string(params) + " params)");
+        _LRWLOG_("received cmd: %2x (%d params)", commandId, params);
+        LINK_TRACE(RAW_WIRELESS, WORD_RECEIVED, newData, 0);
 
         asyncCommand.type = commandId;
         asyncCommand.result.commandId = asyncCommand.type;
@@ -1695,7 +2025,7 @@ class LinkRawWireless {
 
         if (params > 0) {
           asyncCommand.step = AsyncCommand::Step::COMMAND_PARAMETERS;
-          _LRWLOG_("param 1/" + std::to_string(params) + ":");
+          _LRWLOG_("param 1/%d:", params);
           transferAsync(DATA_REQUEST_VALUE, true);
         } else {
           acknowledgeRemoteCommand();
@@ -1706,9 +2036,9 @@ class LinkRawWireless {
       case AsyncCommand::Step::COMMAND_PARAMETERS: {
         asyncCommand.result.data[asyncCommand.sentParameters++] = newData;
 
-        _LRWLOG_("param " + std::to_string(asyncCommand.sentParameters + 1) +
-                 "/" + std::to_string(asyncCommand.totalParameters) + ":");
-        _LRWLOG_("<< " + toHex(newData));
+        _LRWLOG_("param %d/%d:", asyncCommand.sentParameters + 1,
+                 asyncCommand.totalParameters);
+        _LRWLOG_("<< %8x", newData);
 
         if (asyncCommand.sentParameters < asyncCommand.result.dataSize)
           transferAsync(DATA_REQUEST_VALUE, true);
@@ -1723,7 +2053,7 @@ class LinkRawWireless {
       case AsyncCommand::Step::DATA_REQUEST: {
         if (newData != DATA_REQUEST_VALUE) {
           _LRWLOG_("! expected CMD request");
-          _LRWLOG_("! but received 0x" + toHex(newData));
+          _LRWLOG_("! but received 0x%8x", newData);
           asyncCommand.state = AsyncCommand::State::COMPLETED;
           return;
         }
@@ -1737,7 +2067,7 @@ class LinkRawWireless {
     }
   }
 
-  void acknowledgeRemoteCommand() {  // (irq only)
+  void acknowledgeRemoteCommand() {  // (irq or sync)
     _LRWLOG_("sending ack");
     asyncCommand.step = AsyncCommand::Step::DATA_REQUEST;
     u32 ack = (COMMAND_HEADER_VALUE << 16) |
@@ -1746,6 +2076,12 @@ class LinkRawWireless {
   }
 
   void transferAsync(u32 data, bool fromIRQ) {
+    engine.phase = Engine::Phase::TRANSFER;
+    if (engine.isSync) {
+      engine.word = data;
+      return;
+    }
+
 #ifdef LINK_WIRELESS_ENABLE_NESTED_IRQ
     if (fromIRQ)
       Link::_REG_IME = 0;
@@ -1755,8 +2091,8 @@ class LinkRawWireless {
   }
 
   void logExpectedButReceived(u32 expected, u32 received) {
-    _LRWLOG_("! expected 0x" + toHex(expected));
-    _LRWLOG_("! but received 0x" + toHex(received));
+    _LRWLOG_("! expected 0x%8x", expected);
+    _LRWLOG_("! but received 0x%8x", received);
   }
 };
 
@@ -1769,6 +2105,13 @@ inline void LINK_RAW_WIRELESS_ISR_SERIAL() {
   linkRawWireless->_onSerial();
 }
 
+/**
+ * @brief TIMER interrupt handler.
+ */
+inline void LINK_RAW_WIRELESS_ISR_TIMER() {
+  linkRawWireless->_onTimer();
+}
+
 #undef _LRWLOG_
 
 #endif  // LINK_RAW_WIRELESS_H
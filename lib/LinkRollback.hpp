@@ -0,0 +1,484 @@
+#ifndef LINK_ROLLBACK_H
+#define LINK_ROLLBACK_H
+
+// --------------------------------------------------------------------------
+// A rollback input synchronizer built on top of LinkUniversal.
+// --------------------------------------------------------------------------
+// Usage:
+// - 1) Include this header in your main.cpp file and add:
+//       LinkUniversal* linkUniversal = new LinkUniversal();
+//       LinkRollback* linkRollback = new LinkRollback(linkUniversal);
+//       LinkRollbackStates<GameState>* states =
+//         new LinkRollbackStates<GameState>();
+// - 2) Set up and activate `linkUniversal` as usual (see LinkUniversal.hpp).
+// - 3) When all players are connected and ready to start the match:
+//       linkRollback->activate();
+//       // (all players should do this at the same point of the game)
+// - 4) Once per frame, instead of calling `linkUniversal->sync()`:
+//       u16 keys = ~REG_KEYS & KEY_ANY;
+//       if (linkRollback->update(keys)) {
+//         u32 frame = linkRollback->currentFrame() - 1;
+//         if (linkRollback->needsRollback()) {
+//           u32 from = linkRollback->getRollbackFrame();
+//           game = *states->load(from);
+//           for (u32 f = from; f < frame; f++) {
+//             *states->save(f) = game;
+//             simulate(game, f);  // (using `linkRollback->getInput(i, f)`)
+//           }
+//         }
+//         *states->save(frame) = game;
+//         simulate(game, frame);
+//       }
+// --------------------------------------------------------------------------
+// considerations:
+// - the link is dedicated to input messages while the rollback is active!
+// - inputs are 10 bits wide (enough for `REG_KEYS`)
+// - the simulation must be deterministic: same inputs => same state!
+// - it uses the same messages as LinkLockstep, but both libraries can't be
+//   mixed in the same session
+// --------------------------------------------------------------------------
+
+#ifndef LINK_DEVELOPMENT
+#pragma GCC system_header
+#endif
+
+#include "_link_common.hpp"
+
+#include "LinkUniversal.hpp"
+
+#ifndef LINK_ROLLBACK_BUFFER_FRAMES
+/**
+ * @brief Number of frames that the input histories can store at max (per
+ * player). The default value is `32`. The input delay plus the rollback
+ * window can't exceed `(LINK_ROLLBACK_BUFFER_FRAMES - 1) / 2` frames.
+ * \warning This affects how much memory is allocated. With the default value,
+ * it's around `64` bytes per player.
+ */
+#define LINK_ROLLBACK_BUFFER_FRAMES 32
+#endif
+
+LINK_VERSION_TAG LINK_ROLLBACK_VERSION = "vLinkRollback/v8.0.3";
+
+#define LINK_ROLLBACK_DEFAULT_INPUT_DELAY 1
+#define LINK_ROLLBACK_DEFAULT_MAX_ROLLBACK 7
+#define LINK_ROLLBACK_INPUT_MASK 0x3FF
+
+/**
+ * @brief A rollback input synchronizer.
+ * @tparam L The link type (`LinkUniversal`, `LinkCable`, etc.).
+ * @tparam MaxPlayers Maximum number of players.
+ * @tparam BufferFrames History size (see `LINK_ROLLBACK_BUFFER_FRAMES`).
+ * \warning `LinkRollback` is an alias for the default configuration.
+ */
+template <typename L = LinkUniversal,
+          Link::u32 MaxPlayers = LINK_UNIVERSAL_MAX_PLAYERS,
+          Link::u32 BufferFrames = LINK_ROLLBACK_BUFFER_FRAMES>
+class LinkRollbackT {
+ private:
+  using u32 = Link::u32;
+  using u16 = Link::u16;
+  using u8 = Link::u8;
+
+  static constexpr u32 INPUT_BITS = 10;
+  static constexpr u32 TAG_COUNT = 62;  // (tags are 1~62: never 0x0/0xFFFF)
+
+  static_assert(BufferFrames >= 2 && BufferFrames < TAG_COUNT,
+                "BufferFrames must be in the range [2;61]");
+
+ public:
+  /**
+   * @brief Returns the predicted input of player #`playerId` for `frame`.
+   * `lastInput` is the last confirmed input of that player.
+   */
+  using PredictionCallback = u16 (*)(u8 playerId, u32 frame, u16 lastInput);
+
+  static constexpr u8 MAX_WINDOW = (BufferFrames - 1) / 2;
+
+  /**
+   * @brief Constructs a new LinkRollback object.
+   * @param link The link to use. It must be active and connected before
+   * calling `activate()`.
+   * @param inputDelay Number of frames between sampling an input and using
+   * it. Small values (like `1`) reduce the number of rollbacks.
+   * @param maxRollback Maximum number of frames that can be simulated with
+   * predicted inputs. When a player's inputs are older than that, `update()`
+   * stalls. `0` means lockstep.
+   * \warning `inputDelay + maxRollback` must be `<= MAX_WINDOW`.
+   */
+  explicit LinkRollbackT(L* link,
+                         u8 inputDelay = LINK_ROLLBACK_DEFAULT_INPUT_DELAY,
+                         u8 maxRollback = LINK_ROLLBACK_DEFAULT_MAX_ROLLBACK)
+      : link(link) {
+    config.inputDelay = inputDelay;
+    config.maxRollback = maxRollback;
+    config.predict = nullptr;
+  }
+
+  /**
+   * @brief Returns whether the library is active or not.
+   */
+  [[nodiscard]] bool isActive() { return isEnabled; }
+
+  /**
+   * @brief Starts a new session at frame `0`. Returns `false` if the link is
+   * not connected.
+   * \warning All players should call this at the same point of the game, and
+   * no other messages should be sent through the link afterwards.
+   */
+  bool activate() {
+    isEnabled = false;
+    if (!link->isConnected())
+      return false;
+
+    activeInputDelay = config.inputDelay < MAX_WINDOW ? config.inputDelay
+                                                      : MAX_WINDOW;
+    activeMaxRollback = config.maxRollback < MAX_WINDOW - activeInputDelay
+                            ? config.maxRollback
+                            : MAX_WINDOW - activeInputDelay;
+    players = link->playerCount();
+    localPlayerId = link->currentPlayerId();
+    frame = 0;
+    rollbackFrame = 0;
+    isInputScheduled = false;
+    isRollbackPending = false;
+    hasAdvanced = false;
+    hasDesynced = false;
+    stallCount = 0;
+    rollbackCount = 0;
+    longestRollback = 0;
+
+    // (the first `inputDelay` frames have no inputs)
+    for (u32 i = 0; i < MaxPlayers; i++) {
+      for (u32 j = 0; j < BufferFrames; j++)
+        inputs[i][j] = 0;
+      confirmedFrames[i] = activeInputDelay;
+    }
+
+    isEnabled = true;
+    return true;
+  }
+
+  /**
+   * @brief Deactivates the library. The link is not affected.
+   */
+  void deactivate() { isEnabled = false; }
+
+  /**
+   * @brief Syncs the link, sends the local `input`, and advances to the next
+   * frame, predicting the inputs that didn't arrive yet. Returns `true` if
+   * the frame can be simulated, or `false` if it has to stall (because the
+   * rollback window is exhausted).
+   * @param input The local input for this frame (10 bits).
+   * \warning Call this once per frame (it calls `sync()` on the link).
+   * \warning After it returns `true`, check `needsRollback()`.
+   * \warning While stalled, `input` is ignored: each input is sampled once,
+   * when its frame is scheduled.
+   * \warning If the link disconnects or the player count changes, the
+   * library deactivates itself. Check `isActive()`.
+   */
+  bool update(u16 input) {
+    if (!isEnabled)
+      return false;
+
+    if (hasAdvanced) {
+      isRollbackPending = false;
+      hasAdvanced = false;
+    }
+
+    link->sync();
+    if (!link->isConnected() || link->playerCount() != players) {
+      deactivate();
+      return false;
+    }
+
+    receive();
+
+    if (!isInputScheduled) {
+      if (!link->canSend())
+        return stall();
+
+      u32 targetFrame = frame + activeInputDelay;
+      input &= LINK_ROLLBACK_INPUT_MASK;
+      link->send(encode(targetFrame, input));
+      inputs[localPlayerId][targetFrame % BufferFrames] = input;
+      confirmedFrames[localPlayerId] = targetFrame + 1;
+      isInputScheduled = true;
+    }
+
+    if (frame >= getConfirmedFrame() + activeMaxRollback)
+      return stall();
+
+    for (u32 i = 0; i < players; i++) {
+      if (frame >= confirmedFrames[i])
+        inputs[i][frame % BufferFrames] = predict(i, frame);
+    }
+
+    if (isRollbackPending) {
+      rollbackCount++;
+      if (frame - rollbackFrame > longestRollback)
+        longestRollback = frame - rollbackFrame;
+    }
+
+    frame++;
+    isInputScheduled = false;
+    hasAdvanced = true;
+    return true;
+  }
+
+  /**
+   * @brief Returns `true` if some inputs were mispredicted, and the game has
+   * to restore the state of `getRollbackFrame()` and simulate again up to
+   * the current frame.
+   * \warning Check this right after `update(...)` returns `true`.
+   */
+  [[nodiscard]] bool needsRollback() { return isRollbackPending; }
+
+  /**
+   * @brief Returns the earliest mispredicted frame (only valid if
+   * `needsRollback()` is `true`).
+   */
+  [[nodiscard]] u32 getRollbackFrame() { return rollbackFrame; }
+
+  /**
+   * @brief Returns the input of player #`playerId` for the last frame that
+   * `update(...)` advanced.
+   * @param playerId A player ID.
+   */
+  [[nodiscard]] u16 getInput(u8 playerId) {
+    return frame > 0 ? getInput(playerId, frame - 1) : 0;
+  }
+
+  /**
+   * @brief Returns the input of player #`playerId` for `frameNumber`
+   * (confirmed or predicted). It must be inside the rollback window.
+   * @param playerId A player ID.
+   * @param frameNumber A frame number.
+   */
+  [[nodiscard]] u16 getInput(u8 playerId, u32 frameNumber) {
+    return playerId < players ? inputs[playerId][frameNumber % BufferFrames]
+                              : 0;
+  }
+
+  /**
+   * @brief Returns whether the input of player #`playerId` for
+   * `frameNumber` is confirmed (received) or not (predicted).
+   * @param playerId A player ID.
+   * @param frameNumber A frame number.
+   */
+  [[nodiscard]] bool isConfirmed(u8 playerId, u32 frameNumber) {
+    return playerId < players && frameNumber < confirmedFrames[playerId];
+  }
+
+  /**
+   * @brief Returns the confirmed-frame watermark of player #`playerId`: all
+   * its inputs before that frame are confirmed.
+   * @param playerId A player ID.
+   */
+  [[nodiscard]] u32 getConfirmedFrame(u8 playerId) {
+    return playerId < players ? confirmedFrames[playerId] : 0;
+  }
+
+  /**
+   * @brief Returns the confirmed-frame watermark of all players: frames
+   * before that one will never be rolled back, so their states can be
+   * discarded.
+   */
+  [[nodiscard]] u32 getConfirmedFrame() {
+    u32 minFrame = confirmedFrames[0];
+    for (u32 i = 1; i < players; i++) {
+      if (confirmedFrames[i] < minFrame)
+        minFrame = confirmedFrames[i];
+    }
+    return minFrame;
+  }
+
+  /**
+   * @brief Returns the number of advanced frames since `activate()`.
+   */
+  [[nodiscard]] u32 currentFrame() { return frame; }
+
+  /**
+   * @brief Returns the number of players in the session.
+   */
+  [[nodiscard]] u8 playerCount() { return players; }
+
+  /**
+   * @brief Returns the current player ID.
+   */
+  [[nodiscard]] u8 currentPlayerId() { return localPlayerId; }
+
+  /**
+   * @brief Returns how many `update(...)` calls couldn't advance since
+   * `activate()`.
+   */
+  [[nodiscard]] u32 getStallCount() { return stallCount; }
+
+  /**
+   * @brief Returns how many rollbacks happened since `activate()`.
+   */
+  [[nodiscard]] u32 getRollbackCount() { return rollbackCount; }
+
+  /**
+   * @brief Returns the longest rollback (in re-simulated frames) since
+   * `activate()`.
+   */
+  [[nodiscard]] u32 getLongestRollback() { return longestRollback; }
+
+  /**
+   * @brief Returns `true` if a remote input arrived with an unexpected frame
+   * tag (which means that messages were lost, and the simulation is no longer
+   * deterministic).
+   */
+  [[nodiscard]] bool didDesync() { return hasDesynced; }
+
+  struct Config {
+    u8 inputDelay;   // (call `activate()` again after changing it)
+    u8 maxRollback;  // (call `activate()` again after changing it)
+    PredictionCallback predict;  // (`nullptr` = repeat the last input)
+  };
+
+  /**
+   * @brief LinkRollback configuration.
+   */
+  Config config;
+
+ private:
+  L* link;
+  u16 inputs[MaxPlayers][BufferFrames];  // (confirmed or predicted)
+  u32 confirmedFrames[MaxPlayers];       // (next frame to confirm)
+  u32 frame = 0;
+  u32 rollbackFrame = 0;
+  u32 stallCount = 0;
+  u32 rollbackCount = 0;
+  u32 longestRollback = 0;
+  u8 players = 0;
+  u8 localPlayerId = 0;
+  u8 activeInputDelay = 0;
+  u8 activeMaxRollback = 0;
+  bool isInputScheduled = false;
+  bool isRollbackPending = false;
+  bool hasAdvanced = false;
+  bool hasDesynced = false;
+  volatile bool isEnabled = false;
+
+  void receive() {
+    u32 firstMispredictedFrame = frame;
+
+    for (u32 i = 0; i < players; i++) {
+      if (i == localPlayerId)
+        continue;
+
+      while (link->canRead(i)) {
+        u16 word = link->read(i);
+        u32 targetFrame = confirmedFrames[i];
+        u16 input = word & LINK_ROLLBACK_INPUT_MASK;
+        u16& slot = inputs[i][targetFrame % BufferFrames];
+
+        if (word >> INPUT_BITS != tag(targetFrame))
+          hasDesynced = true;
+        if (targetFrame < frame && slot != input &&
+            targetFrame < firstMispredictedFrame)
+          firstMispredictedFrame = targetFrame;
+
+        slot = input;
+        confirmedFrames[i] = targetFrame + 1;
+      }
+    }
+
+    if (firstMispredictedFrame == frame)
+      return;
+
+    // (predictions after the first wrong one are refreshed)
+    for (u32 f = firstMispredictedFrame; f < frame; f++) {
+      for (u32 i = 0; i < players; i++) {
+        if (f >= confirmedFrames[i])
+          inputs[i][f % BufferFrames] = predict(i, f);
+      }
+    }
+
+    if (!isRollbackPending || firstMispredictedFrame < rollbackFrame)
+      rollbackFrame = firstMispredictedFrame;
+    isRollbackPending = true;
+  }
+
+  bool stall() {
+    stallCount++;
+    return false;
+  }
+
+  u16 predict(u8 playerId, u32 targetFrame) {
+    u32 confirmedFrame = confirmedFrames[playerId];
+    u16 lastInput = confirmedFrame > 0
+                        ? inputs[playerId][(confirmedFrame - 1) % BufferFrames]
+                        : 0;
+    return config.predict != nullptr
+               ? config.predict(playerId, targetFrame, lastInput) &
+                     LINK_ROLLBACK_INPUT_MASK
+               : lastInput;
+  }
+
+  u16 encode(u32 targetFrame, u16 input) {
+    return (u16)(tag(targetFrame) << INPUT_BITS) | input;
+  }
+
+  u32 tag(u32 targetFrame) { return targetFrame % TAG_COUNT + 1; }
+};
+
+using LinkRollback = LinkRollbackT<>;
+
+/**
+ * @brief A ring of save states, indexed by frame.
+ * @tparam T The game state type.
+ * @tparam Slots Number of slots (at least the rollback window + 1).
+ */
+template <typename T, Link::u32 Slots = LINK_ROLLBACK_BUFFER_FRAMES>
+class LinkRollbackStates {
+ private:
+  using u32 = Link::u32;
+
+  static constexpr u32 NO_FRAME = 0xFFFFFFFF;
+
+ public:
+  LinkRollbackStates() { clear(); }
+
+  /**
+   * @brief Returns the slot of `frame`, to be filled with the state *before*
+   * simulating that frame. It replaces the oldest state.
+   * @param frame A frame number.
+   */
+  T* save(u32 frame) {
+    frames[frame % Slots] = frame;
+    return &slots[frame % Slots];
+  }
+
+  /**
+   * @brief Returns the saved state of `frame`, or `nullptr` if it was
+   * replaced (or never saved).
+   * @param frame A frame number.
+   */
+  [[nodiscard]] T* load(u32 frame) {
+    return has(frame) ? &slots[frame % Slots] : nullptr;
+  }
+
+  /**
+   * @brief Returns whether the state of `frame` is available or not.
+   * @param frame A frame number.
+   */
+  [[nodiscard]] bool has(u32 frame) { return frames[frame % Slots] == frame; }
+
+  /**
+   * @brief Discards all the saved states.
+   */
+  void clear() {
+    for (u32 i = 0; i < Slots; i++)
+      frames[i] = NO_FRAME;
+  }
+
+ private:
+  T slots[Slots];
+  u32 frames[Slots];
+};
+
+extern LinkRollback* linkRollback;
+
+#endif  // LINK_ROLLBACK_H
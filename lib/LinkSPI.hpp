@@ -29,6 +29,19 @@
 //         u32 data = linkSPI->getAsyncData();
 //         // ...
 //       }
+// - 7) Stream data with interrupt-chained transfers (opt-in):
+//       LinkSPIStream* linkSPIStream = new LinkSPIStream();
+//       interrupt_add(INTR_SERIAL, LINK_SPI_STREAM_ISR_SERIAL);
+//       interrupt_add(INTR_TIMER3, LINK_SPI_STREAM_ISR_TIMER); // (master only)
+//       linkSPIStream->activate(LinkSPIStream::Mode::MASTER_256KBPS);
+//       linkSPIStream->startStream();
+//       // ...
+//       linkSPIStream->send(0x12345678);
+//       // ...
+//       while (linkSPIStream->canRead()) {
+//         u32 data = linkSPIStream->read();
+//         // ...
+//       }
 // --------------------------------------------------------------------------
 // (*) libtonc's interrupt handler sometimes ignores interrupts due to a bug.
 //     That causes packet loss. You REALLY want to use libugba's instead.
@@ -46,21 +59,47 @@
 
 #include "_link_common.hpp"
 
+#include <type_traits>
+
+#ifndef LINK_SPI_STREAM_QUEUE_SIZE
+/**
+ * @brief Buffer size (in words) of the streaming queues (one for outgoing
+ * words and one for incoming words) of `LinkSPIStream`.
+ * \warning This affects how much memory is allocated (`4` bytes per slot and
+ * per queue, rounded up to the next power of two). Only `LinkSPIStream`
+ * instances have them: `LinkSPI` (which is what the other libraries use)
+ * doesn't support streaming, so it doesn't pay for them.
+ */
+#define LINK_SPI_STREAM_QUEUE_SIZE 32
+#endif
+
 LINK_VERSION_TAG LINK_SPI_VERSION = "vLinkSPI/v8.0.3";
 
 #define LINK_SPI_NO_DATA_32 0xFFFFFFFF
 #define LINK_SPI_NO_DATA_8 0xFF
 #define LINK_SPI_NO_DATA LINK_SPI_NO_DATA_32
+#define LINK_SPI_DEFAULT_STREAM_TIMER_ID 3
+
+#define LINK_SPI_STREAM_ONLY                        \
+  static_assert(StreamQueueSize > 0,                \
+                "Streaming requires LinkSPIStream " \
+                "(or LinkSPIT<StreamQueueSize>)")
 
 /**
  * @brief An SPI handler for the Link Port (Normal Mode, either 32 or 8 bits).
+ * @tparam StreamQueueSize Buffer size of the streaming queues. `0` (the
+ * default, used by `LinkSPI`) disables streaming at compile time. See
+ * `LinkSPIStream`.
  */
-class LinkSPI {
+template <Link::u32 StreamQueueSize = 0>
+class LinkSPIT {
  private:
   using u32 = Link::u32;
   using u16 = Link::u16;
   using u8 = Link::u8;
   using vu32 = Link::vu32;
+  using U32Queue = Link::RingBuffer<u32, StreamQueueSize>;
+  static constexpr bool Streaming = StreamQueueSize > 0;
 
   static constexpr int BIT_CLOCK = 0;
   static constexpr int BIT_CLOCK_SPEED = 1;
@@ -71,12 +110,24 @@ class LinkSPI {
   static constexpr int BIT_IRQ = 14;
   static constexpr int BIT_GENERAL_PURPOSE_LOW = 14;
   static constexpr int BIT_GENERAL_PURPOSE_HIGH = 15;
+  static constexpr int STREAM_GAP_CYCLES = 128;
+  static constexpr int STREAM_RETRY_CYCLES = 1024;
 
  public:
   enum class Mode { SLAVE, MASTER_256KBPS, MASTER_2MBPS };
   enum class DataSize { SIZE_32BIT, SIZE_8BIT };
   enum class AsyncState { IDLE, WAITING, READY };
 
+  /**
+   * @brief Streaming counters (see `getStreamStats(...)`).
+   */
+  struct StreamStats {
+    u32 words = 0;      //!< Exchanged words
+    u32 bytes = 0;      //!< Exchanged bytes (`4` or `1` per word)
+    u32 stalls = 0;     //!< Times the next transfer had to wait
+    u32 overflows = 0;  //!< Words rejected by `send(...)` (full queue)
+  };
+
   /**
    * @brief Returns whether the library is active or not.
    */
@@ -96,6 +147,8 @@ class LinkSPI {
     this->asyncState = AsyncState::IDLE;
     this->asyncData = 0;
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkSPIT, _onSerial);
     setNormalMode();
     disableTransfer();
 
@@ -117,7 +170,13 @@ class LinkSPI {
    * @brief Deactivates the library.
    */
   void deactivate() {
+    if constexpr (Streaming) {
+      if (stream.isActive)
+        stopStream();
+    }
+
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     setGeneralPurposeMode();
 
     mode = Mode::SLAVE;
@@ -147,9 +206,11 @@ class LinkSPI {
                F cancel,
                bool _async = false,
                bool _customAck = false) {
-    if ((!_customAck && !isEnabled) || asyncState != AsyncState::IDLE)
+    if ((!_customAck && !isEnabled) || asyncState != AsyncState::IDLE ||
+        isStreaming())
       return noData();
 
+    LINK_TRACE(SPI, TRANSFER_START, data, _async);
     setData(data);
 
     if (_async) {
@@ -159,13 +220,15 @@ class LinkSPI {
       setInterruptsOff();
     }
 
-    while (isMaster() && waitMode && !isSlaveReady())
+    while (isMaster() && waitMode && !isSlaveReady()) {
+      LINK_BUSY_WAIT;
       if (cancel()) {
         disableTransfer();
         setInterruptsOff();
         asyncState = AsyncState::IDLE;
         return noData();
       }
+    }
 
     enableTransfer();
     startTransfer();
@@ -173,12 +236,14 @@ class LinkSPI {
     if (_async)
       return noData();
 
-    while (!isReady())
+    while (!isReady()) {
+      LINK_BUSY_WAIT;
       if (cancel()) {
         stopTransfer();
         disableTransfer();
         return noData();
       }
+    }
 
     if (!_customAck)
       disableTransfer();
@@ -265,12 +330,191 @@ class LinkSPI {
    */
   [[nodiscard]] bool isWaitModeActive() { return waitMode; }
 
+  /**
+   * @brief Starts streaming. In this mode, words added with `send(...)` are
+   * transferred back to back: the SERIAL interrupt handler starts the next
+   * transfer as soon as the previous one ends, and stores the received words,
+   * which can be retrieved with `read()`. Returns whether it could start.
+   * As slave, the handler pre-loads the next outgoing word and drives `SO`:
+   * it signals "not ready" (`SO=HIGH`) while the outgoing queue is empty or
+   * the incoming queue is full, so a master with `waitMode` (*) waits instead
+   * of clocking out stale data.
+   * @param timerId GBA Timer to use for checking whether the slave is ready
+   * (only used as master with `waitMode`).
+   * \warning Only available with no pending async transfer.
+   * \warning Normal `transfer(...)`s won't do anything until `stopStream()`.
+   * \warning Only available in `LinkSPIStream`.
+   */
+  bool startStream(u8 timerId = LINK_SPI_DEFAULT_STREAM_TIMER_ID) {
+    LINK_SPI_STREAM_ONLY;
+    if (!isEnabled || stream.isActive || asyncState != AsyncState::IDLE)
+      return false;
+
+    stream.timerId = timerId;
+    stream.isBusy = false;
+    stream.isStalled = false;
+    stream.incoming.syncClear();
+    stream.outgoing.clear();
+    stream.stats = StreamStats{};
+    if (isMaster())
+      LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[timerId], LinkSPIT, _onTimer);
+    else
+      disableTransfer();
+
+    LINK_BARRIER;
+    stream.isActive = true;
+    LINK_BARRIER;
+
+    return true;
+  }
+
+  /**
+   * @brief Stops streaming. The pending outgoing words are discarded, but the
+   * received ones can still be retrieved with `read()`.
+   */
+  void stopStream() {
+    LINK_SPI_STREAM_ONLY;
+    if (!stream.isActive)
+      return;
+
+    LINK_BARRIER;
+    stream.isActive = false;
+    LINK_BARRIER;
+
+    if (isMaster()) {
+      stopTimer();
+      Link::IRQ::unset(Link::_TIMER_IRQ_IDS[stream.timerId], this);
+    }
+    setInterruptsOff();
+    stopTransfer();
+    disableTransfer();
+
+    stream.isBusy = false;
+    stream.isStalled = false;
+    stream.outgoing.clear();
+  }
+
+  /**
+   * @brief Returns whether the library is streaming or not.
+   */
+  [[nodiscard]] bool isStreaming() {
+    if constexpr (Streaming)
+      return stream.isActive;
+    else
+      return false;
+  }
+
+  /**
+   * @brief Returns whether there's room for another word in the outgoing
+   * queue or not.
+   */
+  [[nodiscard]] bool canSend() {
+    LINK_SPI_STREAM_ONLY;
+    return stream.isActive && !stream.outgoing.isFull();
+  }
+
+  /**
+   * @brief Adds `data` to the outgoing queue (and starts transferring, if the
+   * link was idle). Returns whether it was added or not.
+   * @param data The value to be sent.
+   * \warning Only available while streaming. If the queue is full, `data` is
+   * discarded and `false` is returned.
+   */
+  bool send(u32 data) {
+    LINK_SPI_STREAM_ONLY;
+    if (!stream.isActive)
+      return false;
+
+    if (!stream.outgoing.push(data)) {
+      stream.stats.overflows++;
+      LINK_STATS_COUNT(overflows);
+      LINK_TRACE(SPI, QUEUE_OVERFLOW, data, 0);
+      return false;
+    }
+    LINK_STATS_MARK(outgoingHighWaterMark, stream.outgoing.size());
+
+    if (!stream.isBusy)
+      continueStream();
+    return true;
+  }
+
+  /**
+   * @brief Returns whether there are received words to read or not.
+   */
+  [[nodiscard]] bool canRead() {
+    LINK_SPI_STREAM_ONLY;
+    return !stream.incoming.isEmpty();
+  }
+
+  /**
+   * @brief Dequeues and returns the oldest received word. If there are no
+   * words, returns an empty response.
+   */
+  u32 read() {
+    LINK_SPI_STREAM_ONLY;
+    if (stream.incoming.isEmpty())
+      return noData();
+
+    u32 data = stream.incoming.pop();
+    if (stream.isActive && !stream.isBusy)
+      continueStream();
+    return data;
+  }
+
+  /**
+   * @brief Returns the number of words waiting in the outgoing queue.
+   */
+  [[nodiscard]] u32 getPendingCount() {
+    LINK_SPI_STREAM_ONLY;
+    return stream.outgoing.size();
+  }
+
+  /**
+   * @brief Returns the streaming counters. Use them (e.g. once per second) to
+   * measure throughput in bytes per second.
+   * @param clear Whether the counters should be reset after reading them.
+   */
+  [[nodiscard]] StreamStats getStreamStats(bool clear = false) {
+    LINK_SPI_STREAM_ONLY;
+    StreamStats stats;
+    stats.words = stream.stats.words;
+    stats.bytes = stream.stats.bytes;
+    stats.stalls = stream.stats.stalls;
+    stats.overflows = stream.stats.overflows;
+    if (clear)
+      stream.stats = StreamStats{};
+    return stats;
+  }
+
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief This method is called by the SERIAL interrupt handler.
    * \warning This is internal API!
    */
   void _onSerial(bool _customAck = false) {
-    if (!isEnabled || asyncState != AsyncState::WAITING)
+    LINK_STATS_ISR(serial);
+    if (!isEnabled)
+      return;
+    if constexpr (Streaming) {
+      if (stream.isActive) {
+        receiveStreamWord();
+        return;
+      }
+    }
+    if (asyncState != AsyncState::WAITING)
       return;
 
     if (!_customAck)
@@ -279,6 +523,23 @@ class LinkSPI {
     setInterruptsOff();
     asyncState = AsyncState::READY;
     asyncData = getData();
+    LINK_TRACE(SPI, WORD_RECEIVED, asyncData, 0);
+  }
+
+  /**
+   * @brief This method is called by the TIMER interrupt handler (only used by
+   * masters, while streaming).
+   * \warning This is internal API!
+   */
+  void _onTimer() {
+    LINK_STATS_ISR(timer);
+    if constexpr (Streaming) {
+      if (!isEnabled || !stream.isActive)
+        return;
+
+      stopTimer();
+      continueStream();
+    }
   }
 
   /**
@@ -305,8 +566,115 @@ class LinkSPI {
   bool waitMode = false;
   volatile AsyncState asyncState = AsyncState::IDLE;
   vu32 asyncData = 0;
+
+  struct Stream {
+    U32Queue incoming;
+    U32Queue outgoing;
+    StreamStats stats;
+    u8 timerId = LINK_SPI_DEFAULT_STREAM_TIMER_ID;
+    volatile bool isActive = false;
+    volatile bool isBusy = false;  // (a transfer or a retry is pending)
+    volatile bool isStalled = false;
+  };
+  struct NoStream {};
+  std::conditional_t<Streaming, Stream, NoStream> stream;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
+  void receiveStreamWord() {
+    if (!isMaster())
+      disableTransfer();  // (not ready until the next word is loaded)
+
+    u32 data = getData();
+    stream.incoming.push(data);
+    stream.stats.words++;
+    stream.stats.bytes += dataSize == DataSize::SIZE_32BIT ? 4 : 1;
+    LINK_STATS_MARK(incomingHighWaterMark, stream.incoming.size());
+    LINK_TRACE(SPI, WORD_RECEIVED, data, 0);
+
+    if (isMaster() && waitMode) {
+      // the slave's SO stays LOW until its SERIAL handler runs, so SI is only
+      // checked after a short gap (the timer calls `continueStream()`)
+      stream.isBusy = true;
+      startTimer(STREAM_GAP_CYCLES);
+      return;
+    }
+
+    continueStream();
+  }
+
+  void continueStream() {
+    // (called from the ISRs, or from the user side when `isBusy` is false)
+    if (stream.outgoing.isEmpty()) {
+      // (as slave, the master has to wait for `send(...)`)
+      if (!isMaster())
+        markStall();
+      stream.isBusy = false;
+      return;
+    }
+
+    if (stream.incoming.isFull()) {
+      // `read()` resumes the stream
+      markStall();
+      stream.isBusy = false;
+      return;
+    }
+
+    if (!isMaster()) {
+      armSlave();
+      return;
+    }
+
+    if (waitMode && !isSlaveReady()) {
+      // (the timer retries without blocking the CPU)
+      markStall();
+      stream.isBusy = true;
+      startTimer(STREAM_RETRY_CYCLES);
+      return;
+    }
+
+    stream.isStalled = false;
+    stream.isBusy = true;
+
+    u32 data = stream.outgoing.pop();
+    LINK_TRACE(SPI, TRANSFER_START, data, 1);
+    setData(data);
+    setInterruptsOn();
+    enableTransfer();
+    startTransfer();
+  }
+
+  void armSlave() {
+    stream.isStalled = false;
+    stream.isBusy = true;
+
+    u32 data = stream.outgoing.pop();
+    LINK_TRACE(SPI, TRANSFER_START, data, 1);
+    setData(data);
+    setInterruptsOn();
+    startTransfer();
+    enableTransfer();  // (ready: SO=LOW)
+  }
+
+  void markStall() {
+    if (!stream.isStalled)
+      stream.stats.stalls++;
+    stream.isStalled = true;
+  }
+
+  void startTimer(u16 cycles) {
+    Link::_REG_TM[stream.timerId].start = -cycles;
+    Link::_REG_TM[stream.timerId].cnt =
+        Link::_TM_ENABLE | Link::_TM_IRQ | Link::_TM_FREQ_1;
+  }
+
+  void stopTimer() {
+    Link::_REG_TM[stream.timerId].cnt =
+        Link::_REG_TM[stream.timerId].cnt & (~Link::_TM_ENABLE);
+  }
+
   void setNormalMode() {
     Link::_REG_RCNT = Link::_REG_RCNT & ~(1 << BIT_GENERAL_PURPOSE_HIGH);
 
@@ -358,7 +726,20 @@ class LinkSPI {
   void setBitLow(u8 bit) { Link::_REG_SIOCNT &= ~(1 << bit); }
 };
 
+/**
+ * @brief The default `LinkSPI` (no streaming).
+ */
+using LinkSPI = LinkSPIT<>;
+
+/**
+ * @brief A `LinkSPI` that also supports streaming (see `startStream(...)`).
+ */
+using LinkSPIStream = LinkSPIT<LINK_SPI_STREAM_QUEUE_SIZE>;
+
+#undef LINK_SPI_STREAM_ONLY
+
 extern LinkSPI* linkSPI;
+extern LinkSPIStream* linkSPIStream;
 
 /**
  * @brief SERIAL interrupt handler.
@@ -367,4 +748,19 @@ inline void LINK_SPI_ISR_SERIAL() {
   linkSPI->_onSerial();
 }
 
+/**
+ * @brief SERIAL interrupt handler (for `LinkSPIStream`).
+ */
+inline void LINK_SPI_STREAM_ISR_SERIAL() {
+  linkSPIStream->_onSerial();
+}
+
+/**
+ * @brief TIMER interrupt handler (for `LinkSPIStream`, only required for
+ * streaming as master).
+ */
+inline void LINK_SPI_STREAM_ISR_TIMER() {
+  linkSPIStream->_onTimer();
+}
+
 #endif  // LINK_SPI_H
@@ -33,6 +33,8 @@
 #ifndef LINK_UART_QUEUE_SIZE
 /**
  * @brief Buffer size in bytes.
+ * \warning Queues are ring buffers, so their storage is rounded up to the
+ * next power of two.
  */
 #define LINK_UART_QUEUE_SIZE 256
 #endif
@@ -41,13 +43,16 @@ LINK_VERSION_TAG LINK_UART_VERSION = "vLinkUART/v8.0.3";
 
 /**
  * @brief A UART handler for the Link Port (8N1, 7N1, 8E1, 7E1, 8O1, 7E1).
+ * @tparam QueueSize Buffer size (see `LINK_UART_QUEUE_SIZE`).
+ * \warning `LinkUART` is an alias for the default configuration.
  */
-class LinkUART {
+template <Link::u32 QueueSize = LINK_UART_QUEUE_SIZE>
+class LinkUARTT {
  private:
   using u32 = Link::u32;
   using u16 = Link::u16;
   using u8 = Link::u8;
-  using U8Queue = Link::Queue<u8, LINK_UART_QUEUE_SIZE>;
+  using U8Queue = Link::RingBuffer<u8, QueueSize>;
 
   static constexpr int BIT_CTS = 2;
   static constexpr int BIT_PARITY_CONTROL = 3;
@@ -78,7 +83,7 @@ class LinkUART {
   /**
    * @brief Constructs a new LinkUART object.
    */
-  explicit LinkUART() {
+  explicit LinkUARTT() {
     config.baudRate = BaudRate::BAUD_RATE_0;
     config.dataSize = DataSize::SIZE_8_BITS;
     config.parity = Parity::NO;
@@ -103,7 +108,7 @@ class LinkUART {
                 Parity parity = Parity::NO,
                 bool useCTS = false) {
     LINK_READ_TAG(LINK_UART_VERSION);
-    static_assert(LINK_UART_QUEUE_SIZE >= 1);
+    static_assert(QueueSize >= 1);
 
     config.baudRate = baudRate;
     config.dataSize = dataSize;
@@ -114,6 +119,8 @@ class LinkUART {
     isEnabled = false;
     LINK_BARRIER;
 
+    LINK_STATS_START;
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkUARTT, _onSerial);
     reset();
 
     LINK_BARRIER;
@@ -129,6 +136,7 @@ class LinkUART {
     isEnabled = false;
     LINK_BARRIER;
 
+    Link::IRQ::unsetAll(this);
     resetState();
     stop();
   }
@@ -157,9 +165,11 @@ class LinkUART {
       return;
 
     for (u32 i = 0; string[i] != '\0'; i++) {
-      while (!canSend())
+      while (!canSend()) {
+        LINK_BUSY_WAIT;
         if (cancel())
           return;
+      }
       send(string[i]);
     }
     send('\n');
@@ -174,7 +184,7 @@ class LinkUART {
    * @param limit The character limit.
    * \warning Blocks the system until completion.
    */
-  bool readLine(char* string, u32 limit = LINK_UART_QUEUE_SIZE) {
+  bool readLine(char* string, u32 limit = QueueSize) {
     return readLine(string, []() { return false; }, limit);
   }
 
@@ -190,7 +200,7 @@ class LinkUART {
    * \warning Blocks the system until completion or cancellation.
    */
   template <typename F>
-  bool readLine(char* string, F cancel, u32 limit = LINK_UART_QUEUE_SIZE) {
+  bool readLine(char* string, F cancel, u32 limit = QueueSize) {
     if (!isEnabled)
       return false;
 
@@ -199,9 +209,11 @@ class LinkUART {
     bool aborted = false;
 
     while (lastChar != '\n') {
-      while (!canRead())
+      while (!canRead()) {
+        LINK_BUSY_WAIT;
         if (cancel())
           return false;
+      }
       string[readBytes++] = lastChar = read();
       if (readBytes >= limit - 1) {
         aborted = true;
@@ -218,13 +230,19 @@ class LinkUART {
    * @param buffer The source buffer.
    * @param size The size in bytes.
    * @param offset The starting offset.
+   * \warning Bytes that don't fit in the outgoing queue are discarded.
    */
   void send(const u8* buffer, u32 size, u32 offset = 0) {
     if (!isEnabled)
       return;
 
-    for (u32 i = 0; i < size; i++)
-      send(buffer[offset + i]);
+    u32 pushed = outgoingQueue.pushMany(buffer + offset, size);
+#if LINK_ENABLE_STATS != 0
+    _stats.overflows += size - pushed;
+#else
+    (void)pushed;
+#endif
+    LINK_STATS_MARK(outgoingHighWaterMark, outgoingQueue.size());
   }
 
   /**
@@ -238,13 +256,7 @@ class LinkUART {
     if (!isEnabled)
       return 0;
 
-    for (u32 i = 0; i < size; i++) {
-      if (!canRead())
-        return i;
-      buffer[offset + i] = read();
-    }
-
-    return size;
+    return incomingQueue.popMany(buffer + offset, size);
   }
 
   /**
@@ -267,13 +279,13 @@ class LinkUART {
    * bytes).
    */
   [[nodiscard]] u32 availableForSend() {
-    return LINK_UART_QUEUE_SIZE - outgoingQueue.size();
+    return QueueSize - outgoingQueue.size();
   }
 
   /**
    * @brief Reads a byte. Returns 0 if nothing is found.
    */
-  u8 read() { return incomingQueue.syncPop(); }
+  u8 read() { return incomingQueue.pop(); }
 
   /**
    * @brief Sends a `data` byte.
@@ -283,7 +295,25 @@ class LinkUART {
     if (!isEnabled)
       return;
 
-    outgoingQueue.syncPush(data);
+    if (!outgoingQueue.push(data)) {
+      LINK_STATS_COUNT(overflows);
+      return;
+    }
+    LINK_STATS_MARK(outgoingHighWaterMark, outgoingQueue.size());
+  }
+
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
   }
 
   /**
@@ -291,14 +321,31 @@ class LinkUART {
    * \warning This is internal API!
    */
   void _onSerial() {
-    if (!isEnabled || hasError())
+    LINK_STATS_ISR(serial);
+    if (!isEnabled)
       return;
+    if (hasError()) {
+      LINK_STATS_COUNT(crcFailures);
+      LINK_TRACE(UART, CRC_FAILURE, Link::_REG_SIODATA8, 0);
+      return;
+    }
 
-    if (!incomingQueue.isReading() && canReceive())
-      incomingQueue.push((u8)Link::_REG_SIODATA8);
+    if (canReceive()) {
+      u8 data = (u8)Link::_REG_SIODATA8;
+      LINK_TRACE(UART, WORD_RECEIVED, data, 0);
+      if (!incomingQueue.push(data)) {
+        LINK_STATS_COUNT(overflows);
+        LINK_TRACE(UART, QUEUE_OVERFLOW, data, 0);
+      } else {
+        LINK_STATS_MARK(incomingHighWaterMark, incomingQueue.size());
+      }
+    }
 
-    if (!outgoingQueue.isWriting() && canTransfer() && needsTransfer())
-      Link::_REG_SIODATA8 = outgoingQueue.pop();
+    if (canTransfer() && needsTransfer()) {
+      u8 data = outgoingQueue.pop();
+      LINK_TRACE(UART, TRANSFER_START, data, 0);
+      Link::_REG_SIODATA8 = data;
+    }
   }
 
  private:
@@ -312,6 +359,9 @@ class LinkUART {
   Config config;
   U8Queue incomingQueue;
   U8Queue outgoingQueue;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
   bool canReceive() { return !isBitHigh(BIT_RECEIVE_DATA_FLAG); }
@@ -327,7 +377,7 @@ class LinkUART {
 
   void resetState() {
     LINK_BARRIER;
-    incomingQueue.clear();
+    incomingQueue.syncClear();
     outgoingQueue.clear();
     LINK_BARRIER;
   }
@@ -377,6 +427,8 @@ class LinkUART {
   void setBitLow(u8 bit) { Link::_REG_SIOCNT &= ~(1 << bit); }
 };
 
+using LinkUART = LinkUARTT<>;
+
 extern LinkUART* linkUART;
 
 /**
@@ -26,6 +26,18 @@
 //         u16 message = linkUniversal->read(!currentPlayerId);
 //         // ...
 //       }
+// - 6) (Optional) Receive messages as soon as they arrive, instead of
+//      polling with `canRead(...)` and `read(...)`:
+//       linkUniversal->setReceiveCallback([](u8 playerId, u16 data) {
+//         // (called from the SERIAL IRQ: keep it short!)
+//       });
+//       // (`sync()` is still required!)
+// - 7) (Optional) Send time-critical messages ahead of the bulk traffic:
+//       linkUniversal->sendUrgent(0x5678);
+//       if (isConnected && linkUniversal->canReadUrgent(!currentPlayerId)) {
+//         u16 message = linkUniversal->readUrgent(!currentPlayerId);
+//         // ...
+//       }
 // --------------------------------------------------------------------------
 // (*1) libtonc's interrupt handler sometimes ignores interrupts due to a bug.
 //      That causes packet loss. You REALLY want to use libugba's instead.
@@ -41,6 +53,8 @@
 // `send(...)` restrictions:
 // - 0xFFFF and 0x0 are reserved values, so don't use them!
 //   (they mean 'disconnected' and 'no data' respectively)
+// - 0xFFFC can't be sent with `sendUrgent(...)`
+//   (it's the urgent channel prefix)
 // --------------------------------------------------------------------------
 
 #ifndef LINK_DEVELOPMENT
@@ -84,6 +98,7 @@ class LinkUniversal {
   using u8 = Link::u8;
   using s8 = Link::s8;
   using U16Queue = Link::Queue<u16, LINK_CABLE_QUEUE_SIZE>;
+  using UrgentQueue = Link::Queue<u16, LINK_CABLE_URGENT_QUEUE_SIZE>;
 
   static constexpr int MAX_ROOM_NUMBER = 32000;
   static constexpr int INIT_WAIT_FRAMES = 10;
@@ -119,6 +134,7 @@ class LinkUniversal {
     u32 timeout;
     u16 interval;
     u8 sendTimerId;
+    u8 commandTimerId = LINK_WIRELESS_DEFAULT_COMMAND_TIMER_ID;
   };
 
   /**
@@ -143,7 +159,8 @@ class LinkUniversal {
                                  true, true, LINK_UNIVERSAL_MAX_PLAYERS,
                                  LINK_WIRELESS_DEFAULT_TIMEOUT,
                                  LINK_WIRELESS_DEFAULT_INTERVAL,
-                                 LINK_WIRELESS_DEFAULT_SEND_TIMER_ID})
+                                 LINK_WIRELESS_DEFAULT_SEND_TIMER_ID,
+                                 LINK_WIRELESS_DEFAULT_COMMAND_TIMER_ID})
       : linkCable(cableOptions.baudRate,
                   cableOptions.timeout,
                   cableOptions.interval,
@@ -154,7 +171,8 @@ class LinkUniversal {
             Link::_min(wirelessOptions.maxPlayers, LINK_UNIVERSAL_MAX_PLAYERS),
             wirelessOptions.timeout,
             wirelessOptions.interval,
-            wirelessOptions.sendTimerId) {
+            wirelessOptions.sendTimerId,
+            wirelessOptions.commandTimerId) {
     config.protocol = protocol;
     config.gameName = gameName;
   }
@@ -355,6 +373,27 @@ class LinkUniversal {
     return incomingMessages[playerId].peek();
   }
 
+  /**
+   * @brief Returns `true` if there are pending urgent messages from player
+   * #`playerId`.
+   * @param playerId A player ID.
+   * \warning Keep in mind that if this returns `false`, it will keep doing so
+   * until you *fetch new data* with `sync()`.
+   */
+  [[nodiscard]] bool canReadUrgent(u8 playerId) {
+    return !incomingUrgentMessages[playerId].isEmpty();
+  }
+
+  /**
+   * @brief Dequeues and returns the next urgent message from player
+   * #`playerId`. Urgent messages don't appear in `read(...)`.
+   * @param playerId A player ID.
+   * \warning If there's no data from that player, a `0` will be returned.
+   */
+  u16 readUrgent(u8 playerId) {
+    return incomingUrgentMessages[playerId].pop();
+  }
+
   /**
    * @brief Returns whether a `send(...)` call would fail due to the queue being
    * full or not.
@@ -379,6 +418,31 @@ class LinkUniversal {
                                     : linkWireless.send(data);
   }
 
+  /**
+   * @brief Returns whether a `sendUrgent(...)` call would fail due to the
+   * urgent queue being full or not.
+   */
+  bool canSendUrgent() {
+    return mode == Mode::LINK_CABLE ? linkCable.canSendUrgent()
+                                    : linkWireless.canSendUrgent();
+  }
+
+  /**
+   * @brief Sends `data` to all connected players, ahead of the messages queued
+   * with `send(...)`. Receivers get it with `readUrgent(...)`.
+   * @param data The value to be sent.
+   * \warning If `data` is invalid (including `0xFFFC`) or the urgent queue is
+   * full, a `false` will be returned.
+   */
+  bool sendUrgent(u16 data) {
+    if (!isEnabled || data == LINK_CABLE_DISCONNECTED ||
+        data == LINK_CABLE_NO_DATA)
+      return false;
+
+    return mode == Mode::LINK_CABLE ? linkCable.sendUrgent(data)
+                                    : linkWireless.sendUrgent(data);
+  }
+
   /**
    * @brief Returns whether the internal queue lost messages at some point due
    * to being full. This can happen if your queue size is too low, if you
@@ -392,14 +456,28 @@ class LinkUniversal {
                         : linkWireless.didQueueOverflow(clear);
 
     for (u32 i = 0; i < LINK_UNIVERSAL_MAX_PLAYERS; i++) {
-      overflow = overflow || incomingMessages[i].overflow;
-      if (clear)
+      overflow = overflow || incomingMessages[i].overflow ||
+                 incomingUrgentMessages[i].overflow;
+      if (clear) {
         incomingMessages[i].overflow = false;
+        incomingUrgentMessages[i].overflow = false;
+      }
     }
 
     return overflow;
   }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`) of the
+   * active protocol (`LinkCable` or `LinkWireless`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+    return mode == Mode::LINK_CABLE ? linkCable.getStats(clear)
+                                    : linkWireless.getStats(clear);
+  }
+
   /**
    * @brief Resets other players' timeout count to `0`.
    * \warning Call this if you changed `config.timeout`.
@@ -452,6 +530,32 @@ class LinkUniversal {
    */
   void setProtocol(Protocol protocol) { this->config.protocol = protocol; }
 
+  /**
+   * @brief Sets a function that receives each message as soon as it arrives,
+   * from the `SERIAL` IRQ of the active protocol. Then, messages skip the
+   * queues, and `canRead(...)` always returns `false`.
+   * @param callback The callback, or `nullptr` to use the queues again.
+   * \warning Call this before `activate()`.
+   * \warning `sync()` still has to be called once per frame, since it also
+   * manages the connection.
+   */
+  void setReceiveCallback(Link::ReceiveCallback callback) {
+    linkCable.config.onReceive = callback;
+    linkWireless.config.onReceive = callback;
+  }
+
+  /**
+   * @brief Sets how many urgent messages are sent per bulk message when both
+   * kinds are waiting, in both protocols. `0` means that urgent messages
+   * always go first.
+   * @param weight The weight.
+   * \warning Call this before `activate()`.
+   */
+  void setUrgentWeight(u8 weight) {
+    linkCable.config.urgentWeight = weight;
+    linkWireless.config.urgentWeight = weight;
+  }
+
   /**
    * @brief Returns `true` if there are at least 2 connected players.
    * \warning Can change between `sync()` calls.
@@ -541,6 +645,7 @@ class LinkUniversal {
   LinkCable linkCable;
   LinkWireless linkWireless;
   U16Queue incomingMessages[LINK_UNIVERSAL_MAX_PLAYERS];
+  UrgentQueue incomingUrgentMessages[LINK_UNIVERSAL_MAX_PLAYERS];
   Config config;
   State state = State::INITIALIZING;
   Mode mode = Mode::LINK_CABLE;
@@ -559,6 +664,8 @@ class LinkUniversal {
     for (u32 i = 0; i < MAX_PLAYERS; i++) {
       while (linkCable.canRead(i))
         incomingMessages[i].push(linkCable.read(i));
+      while (linkCable.canReadUrgent(i))
+        incomingUrgentMessages[i].push(linkCable.readUrgent(i));
     }
   }
 
@@ -570,7 +677,12 @@ class LinkUniversal {
     for (u32 i = 0; i < receivedCount; i++) {
       auto message = messages[i];
 
-      if (message.playerId < LINK_UNIVERSAL_MAX_PLAYERS)
+      if (message.playerId >= LINK_UNIVERSAL_MAX_PLAYERS)
+        continue;
+
+      if (message.isUrgent)
+        incomingUrgentMessages[message.playerId].push(message.data);
+      else
         incomingMessages[message.playerId].push(message.data);
     }
   }
@@ -751,6 +863,8 @@ class LinkUniversal {
     for (u32 i = 0; i < LINK_UNIVERSAL_MAX_PLAYERS; i++) {
       incomingMessages[i].clear();
       incomingMessages[i].overflow = false;
+      incomingUrgentMessages[i].clear();
+      incomingUrgentMessages[i].overflow = false;
     }
     LINK_BARRIER;
   }
@@ -35,10 +35,17 @@
 //       // `playerCount()` should return the number of active consoles
 // - 6) Send data:
 //       linkWireless->send(0x1234);
+//       // (or, to send it ahead of the bulk traffic:)
+//       linkWireless->sendUrgent(0x5678);
 // - 7) Receive data:
 //       LinkWireless::Message messages[LINK_WIRELESS_QUEUE_SIZE];
 //       u32 receivedCount;
 //       linkWireless->receive(messages, receivedCount);
+//       // (messages sent with `sendUrgent(...)` have `isUrgent` set)
+//       // (or, to receive messages as soon as they arrive:)
+//       linkWireless->config.onReceive = [](u8 playerId, u16 data) {
+//         // (called from the SERIAL IRQ: keep it short!)
+//       };
 // - 8) Disconnect:
 //       linkWireless->activate();
 //       // (resets the adapter)
@@ -62,13 +69,32 @@
  * store at max **per player**). The default value is `30`, which seems fine for
  * most games.
  * \warning This affects how much memory is allocated. With the default value,
- * it's around `480` bytes. There's a double-buffered incoming queue and a
+ * it's around `720` bytes. There's a double-buffered incoming queue and a
  * double-buffered outgoing queue (to avoid data races).
- * \warning You can approximate the usage with `LINK_WIRELESS_QUEUE_SIZE * 16`.
+ * \warning You can approximate the usage with `LINK_WIRELESS_QUEUE_SIZE * 24`.
+ * \warning Queues are ring buffers, so their storage is rounded up to the
+ * next power of two (`32` for the default value).
+ * \warning On each timer tick, the internal outgoing queue only takes the
+ * messages that fit in the next transfer (so urgent ones can overtake the
+ * backlog), so `send(...)` fails with `BUFFER_IS_FULL` once this many messages
+ * are waiting. Before priority channels, the internal queue also took the
+ * backlog, so around twice as many messages fit. If you relied on that,
+ * double this value.
  */
 #define LINK_WIRELESS_QUEUE_SIZE 30
 #endif
 
+#ifndef LINK_WIRELESS_URGENT_QUEUE_SIZE
+/**
+ * @brief Urgent buffer size (how many outgoing messages sent with
+ * `sendUrgent(...)` can wait at max). The default value is `4`, since urgent
+ * messages are expected to be rare and short (e.g. inputs or acks).
+ * \warning This affects how much memory is allocated (`6` bytes per slot,
+ * rounded up to the next power of two).
+ */
+#define LINK_WIRELESS_URGENT_QUEUE_SIZE 4
+#endif
+
 #ifndef LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH
 /**
  * @brief Max server transfer length per timer tick. Must be in the range
@@ -99,7 +125,8 @@
  * disabled by default to conserve IWRAM space, which is limited.
  * \warning If you enable this, make sure that `lib/iwram_code/LinkWireless.cpp`
  * gets compiled! For example, in a Makefile-based project, verify that the
- * directory is in your `SRCDIRS` list.
+ * directory is in your `SRCDIRS` list. Custom `LinkWirelessT<...>` instances
+ * need `LINK_WIRELESS_INSTANTIATE(...)` (see `LinkWirelessT`).
  */
 // #define LINK_WIRELESS_PUT_ISR_IN_IWRAM
 #endif
@@ -139,7 +166,12 @@ LINK_VERSION_TAG LINK_WIRELESS_VERSION = "vLinkWireless/v8.0.3";
 #define LINK_WIRELESS_MAX_USER_NAME_LENGTH 8
 #define LINK_WIRELESS_DEFAULT_TIMEOUT 10
 #define LINK_WIRELESS_DEFAULT_INTERVAL 75
+#define LINK_WIRELESS_DEFAULT_MIN_INTERVAL 25
+#define LINK_WIRELESS_DEFAULT_MAX_INTERVAL 150
 #define LINK_WIRELESS_DEFAULT_SEND_TIMER_ID 3
+#define LINK_WIRELESS_DEFAULT_COMMAND_TIMER_ID \
+  LINK_RAW_WIRELESS_DEFAULT_TIMER_ID
+#define LINK_WIRELESS_DEFAULT_URGENT_WEIGHT 0
 
 #define LINK_WIRELESS_RESET_IF_NEEDED                   \
   if (!isEnabled)                                       \
@@ -163,6 +195,12 @@ LINK_VERSION_TAG LINK_WIRELESS_VERSION = "vLinkWireless/v8.0.3";
 #define LINK_WIRELESS_ISR_FUNC(name, params, args, body) \
   void name params;                                      \
   LINK_INLINE void _##name params body
+
+#define LINK_WIRELESS_INSTANTIATE(...)                                 \
+  template void __VA_ARGS__::_onSerial();                              \
+  template void __VA_ARGS__::_onTimer();                               \
+  template void __VA_ARGS__::processMessage(Link::u32, Link::u32,      \
+                                            Link::u32&, Link::u32&, int&);
 #else
 #define LINK_WIRELESS_SERIAL_ISR
 #define LINK_WIRELESS_TIMER_ISR
@@ -171,12 +209,43 @@ LINK_VERSION_TAG LINK_WIRELESS_VERSION = "vLinkWireless/v8.0.3";
     _##name args;                                        \
   }                                                      \
   LINK_INLINE void _##name params body
+
+#define LINK_WIRELESS_INSTANTIATE(...)
 #endif
 
 /**
  * @brief A high level driver for the GBA Wireless Adapter.
+ * @tparam QueueSize Buffer size (see `LINK_WIRELESS_QUEUE_SIZE`).
+ * @tparam MaxPlayers `(2~5)` Maximum number of players that the arrays are
+ * sized for. `config.maxPlayers` can't be higher than this.
+ * @tparam ServerTransferLength `(6~21)` Biggest allowed transfer per timer tick
+ * for servers (see `LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH`).
+ * @tparam Forwarding Whether forwarding support is compiled in. If `false`,
+ * `config.forwarding` is ignored.
+ * @tparam Retransmission Whether retransmission support is compiled in. If
+ * `false`, `config.retransmission` is ignored.
+ * @tparam ClientTransferLength `(2~4)` Biggest allowed transfer per timer tick
+ * for clients (see `LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH`).
+ * @tparam UrgentQueueSize Urgent buffer size (see
+ * `LINK_WIRELESS_URGENT_QUEUE_SIZE`).
+ * \warning `LinkWireless` is an alias for the default configuration.
+ * \warning With `LINK_WIRELESS_PUT_ISR_IN_IWRAM`, only `LinkWireless` is
+ * instantiated in `lib/iwram_code/LinkWireless.cpp`. For other configurations,
+ * add a source file with:
+ *   #include "lib/iwram_code/_link_wireless_isr.hpp"
+ *   LINK_WIRELESS_INSTANTIATE(LinkWirelessT<8, 2>)
+ * (it expands to nothing when the ISRs aren't in IWRAM)
  */
-class LinkWireless {
+template <Link::u32 QueueSize = LINK_WIRELESS_QUEUE_SIZE,
+          Link::u32 MaxPlayers = LINK_WIRELESS_MAX_PLAYERS,
+          Link::u32 ServerTransferLength =
+              LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH,
+          bool Forwarding = true,
+          bool Retransmission = true,
+          Link::u32 ClientTransferLength =
+              LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH,
+          Link::u32 UrgentQueueSize = LINK_WIRELESS_URGENT_QUEUE_SIZE>
+class LinkWirelessT {
  private:
   using u32 = Link::u32;
   using u16 = Link::u16;
@@ -192,6 +261,7 @@ class LinkWireless {
   static constexpr int MAX_INFLIGHT_PACKETS_CLIENT =
       MAX_PACKET_IDS_CLIENT / 2 - 1;
   static constexpr int NO_ID_ASSIGNED_YET = 0xFF;
+  static constexpr u16 CHANNEL_ESCAPE = 0xFFFC;  // (urgent prefix)
   static constexpr u32 NO_ACK_RECEIVED_YET = 0xFFFFFFFF;
   static constexpr int HAS_FIRST_MSG_MASK = 0b10000;
   static constexpr int MAX_PLAYER_BITMAP_ENTRIES = 5;
@@ -200,16 +270,6 @@ class LinkWireless {
   static constexpr int BIT_HAS_MORE = 15;
 
  public:
-// #define LINK_WIRELESS_PROFILING_ENABLED
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-  u32 vblankTime = 0;
-  u32 serialTime = 0;
-  u32 timerTime = 0;
-  u32 vblankIRQs = 0;
-  u32 serialIRQs = 0;
-  u32 timerIRQs = 0;
-#endif
-
   using State = LinkRawWireless::State;
   using SignalLevelResponse = LinkRawWireless::SignalLevelResponse;
 
@@ -235,6 +295,7 @@ class LinkWireless {
     u16 data = 0;
     u8 playerId = 0;
     u8 packetId = NO_ID_ASSIGNED_YET;
+    bool isUrgent = false;  // (sent with `sendUrgent(...)`)
   };
 
   struct Server {
@@ -254,28 +315,38 @@ class LinkWireless {
    * (ignoring other peers).
    * @param retransmission If `true`, the library handles retransmission for
    * you, so there should be no packet loss.
-   * @param maxPlayers `(2~5)` Maximum number of allowed players.
+   * @param maxPlayers `(2~MaxPlayers)` Maximum number of allowed players.
    * @param timeout Number of *frames* without receiving *any* data to reset the
    * connection.
    * @param interval Number of *1024-cycle ticks* (61.04μs) between transfers
    * *(75 = 4.578ms)*. It's the interval of Timer #`sendTimerId`. Lower values
    * will transfer faster but also consume more CPU.
    * @param sendTimerId `(0~3)` GBA Timer to use for sending.
+   * @param commandTimerId `(0~3)` GBA Timer used by `LinkRawWireless` to run
+   * the adapter commands (it's stopped on every reset).
    * \warning You can use `Link::perFrame(...)` to convert from *packets per
    * frame* to *interval values*.
    */
-  explicit LinkWireless(bool forwarding = true,
-                        bool retransmission = true,
-                        u8 maxPlayers = LINK_WIRELESS_MAX_PLAYERS,
-                        u32 timeout = LINK_WIRELESS_DEFAULT_TIMEOUT,
-                        u16 interval = LINK_WIRELESS_DEFAULT_INTERVAL,
-                        u8 sendTimerId = LINK_WIRELESS_DEFAULT_SEND_TIMER_ID) {
+  explicit LinkWirelessT(
+      bool forwarding = true,
+      bool retransmission = true,
+      u8 maxPlayers = MaxPlayers,
+      u32 timeout = LINK_WIRELESS_DEFAULT_TIMEOUT,
+      u16 interval = LINK_WIRELESS_DEFAULT_INTERVAL,
+      u8 sendTimerId = LINK_WIRELESS_DEFAULT_SEND_TIMER_ID,
+      u8 commandTimerId = LINK_WIRELESS_DEFAULT_COMMAND_TIMER_ID)
+      : linkRawWireless(commandTimerId) {
     config.forwarding = forwarding;
     config.retransmission = retransmission;
     config.maxPlayers = maxPlayers;
     config.timeout = timeout;
     config.interval = interval;
     config.sendTimerId = sendTimerId;
+    config.adaptiveInterval = false;
+    config.minInterval = LINK_WIRELESS_DEFAULT_MIN_INTERVAL;
+    config.maxInterval = LINK_WIRELESS_DEFAULT_MAX_INTERVAL;
+    config.onReceive = nullptr;
+    config.urgentWeight = LINK_WIRELESS_DEFAULT_URGENT_WEIGHT;
   }
 
   /**
@@ -290,17 +361,22 @@ class LinkWireless {
    */
   bool activate() {
     LINK_READ_TAG(LINK_WIRELESS_VERSION);
-    static_assert(LINK_WIRELESS_QUEUE_SIZE >= 1);
-    static_assert(LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH >= 6 &&
-                  LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH <= 21);
-    static_assert(LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH >= 2 &&
-                  LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH <= 4);
+    static_assert(QueueSize >= 1);
+    static_assert(UrgentQueueSize >= 1);
+    static_assert(MaxPlayers >= LINK_WIRELESS_MIN_PLAYERS &&
+                  MaxPlayers <= LINK_RAW_WIRELESS_MAX_PLAYERS);
+    static_assert(ServerTransferLength >= 6 && ServerTransferLength <= 21);
+    static_assert(ClientTransferLength >= 2 && ClientTransferLength <= 4);
 
     LINK_BARRIER;
     isEnabled = false;
     LINK_BARRIER;
 
     lastError = Error::NONE;
+    LINK_STATS_START;
+    intervalController.reset(config.interval, config.minInterval,
+                             config.maxInterval);
+    setIRQs();
     bool success = reset();
 
     LINK_BARRIER;
@@ -323,12 +399,15 @@ class LinkWireless {
     isEnabled = false;
     LINK_BARRIER;
 
+    intervalController.reset(config.interval, config.minInterval,
+                             config.maxInterval);
+    setIRQs();
     resetState();
     stopTimer();
     startTimer();
 
     if (!linkRawWireless.restoreExistingConnection() ||
-        linkRawWireless.sessionState.playerCount > config.maxPlayers) {
+        linkRawWireless.sessionState.playerCount > getMaxPlayers()) {
       deactivate();
       return false;
     }
@@ -355,6 +434,7 @@ class LinkWireless {
 
     lastError = Error::NONE;
     isEnabled = false;
+    Link::IRQ::unsetAll(this);
     resetState();
     stop();
 
@@ -389,7 +469,7 @@ class LinkWireless {
       return badRequest(Error::BUSY_TRY_AGAIN);
 
     if (linkRawWireless.getState() != State::SERVING) {
-      if (!setup(config.maxPlayers))
+      if (!setup(getMaxPlayers()))
         return abort(Error::COMMAND_FAILED);
     }
 
@@ -443,8 +523,9 @@ class LinkWireless {
    * clients, it will only include the index corresponding to the
    * `currentPlayerId()`.
    * @param response A structure that will be filled with the signal levels.
-   * \warning For clients, this action can fail if the adapter is busy. In that
-   * case, this will return `false` and `getLastError()` will be
+   * \warning For clients, each call queues a new command between data
+   * transfers and returns the levels of the last one that finished. Until the
+   * first one finishes, this will return `false` and `getLastError()` will be
    * `BUSY_TRY_AGAIN`. For hosts, you already have this data, so it's free!
    */
   bool getSignalLevel(SignalLevelResponse& response) {
@@ -453,24 +534,27 @@ class LinkWireless {
       return badRequest(Error::WRONG_STATE);
 
     if (linkRawWireless.getState() == LinkRawWireless::State::SERVING) {
-      for (u32 i = 0; i < LINK_WIRELESS_MAX_PLAYERS; i++)
+      for (u32 i = 0; i < MaxPlayers; i++)
         response.signalLevels[i] = sessionState.signalLevel.level[i];
       return true;
     }
 
-    isSendingSyncCommand = true;
-    if (isAsyncCommandActive())
-      return badRequest(Error::BUSY_TRY_AGAIN);
-
-    bool success = linkRawWireless.getSignalLevel(response);
-
-    if (!success)
-      return abort(Error::COMMAND_FAILED);
+    if (!sessionState.isSignalLevelPending) {
+      isSendingSyncCommand = true;
+      sessionState.isSignalLevelPending = true;
+      LINK_BARRIER;
+      if (!linkRawWireless.queueCommand(LinkRawWireless::COMMAND_SIGNAL_LEVEL))
+        sessionState.isSignalLevelPending = false;
+      LINK_BARRIER;
+      isSendingSyncCommand = false;
+      LINK_BARRIER;
+    }
 
-    LINK_BARRIER;
-    isSendingSyncCommand = false;
-    LINK_BARRIER;
+    if (!sessionState.isSignalLevelReady)
+      return badRequest(Error::BUSY_TRY_AGAIN);
 
+    for (u32 i = 0; i < MaxPlayers; i++)
+      response.signalLevels[i] = sessionState.signalLevel.level[i];
     return true;
   }
 
@@ -636,6 +720,48 @@ class LinkWireless {
       return badRequest(Error::WRONG_STATE);
 
     if (!canSend()) {
+      LINK_STATS_COUNT(overflows);
+      lastError = Error::BUFFER_IS_FULL;
+      return false;
+    }
+
+    Message message;
+    message.playerId = linkRawWireless.sessionState.currentPlayerId;
+    message.data = data;
+
+    sessionState.newOutgoingMessages.push(message);
+
+    return true;
+  }
+
+  /**
+   * @brief Returns whether a `sendUrgent(...)` call would fail due to the
+   * urgent queue being full or not.
+   */
+  bool canSendUrgent() { return !sessionState.newUrgentMessages.isFull(); }
+
+  /**
+   * @brief Enqueues `data` to be sent to other nodes, ahead of the messages
+   * enqueued with `send(...)`. Urgent messages keep their order among
+   * themselves, and receivers get them with `isUrgent` set, so they can be
+   * told apart from the rest (e.g. in the middle of a multi-message packet).
+   * @param data The value to be sent.
+   * \warning They only overtake messages that didn't get a packet ID yet (the
+   * inflight ones are always sent first). Forwarded messages are not affected.
+   * \warning Each urgent message takes 2 slots in a transfer (see the notes at
+   * the end). `0xFFFC` is reserved here, so it returns `false` (without
+   * changing `getLastError()`).
+   */
+  bool sendUrgent(u16 data) {
+    LINK_WIRELESS_RESET_IF_NEEDED
+    if (!isSessionActive())
+      return badRequest(Error::WRONG_STATE);
+
+    if (data == CHANNEL_ESCAPE)
+      return false;
+
+    if (!canSendUrgent()) {
+      LINK_STATS_COUNT(overflows);
       lastError = Error::BUFFER_IS_FULL;
       return false;
     }
@@ -644,7 +770,7 @@ class LinkWireless {
     message.playerId = linkRawWireless.sessionState.currentPlayerId;
     message.data = data;
 
-    sessionState.newOutgoingMessages.syncPush(message);
+    sessionState.newUrgentMessages.push(message);
 
     return true;
   }
@@ -654,6 +780,8 @@ class LinkWireless {
    * @param messages The array to be filled with data.
    * @param receivedCount The number to be filled with the number of received
    * messages.
+   * \warning If `config.onReceive` is set, messages go to the callback instead,
+   * so this always returns `0` messages.
    */
   bool receive(Message messages[], u32& receivedCount) {
     receivedCount = 0;
@@ -661,22 +789,15 @@ class LinkWireless {
     if (!isSessionActive())
       return false;
 
-    LINK_BARRIER;
-    sessionState.incomingMessages.startReading();
-    LINK_BARRIER;
-
-    while (!sessionState.incomingMessages.isEmpty()) {
-      auto message = sessionState.incomingMessages.pop();
-      if (message.playerId < LINK_WIRELESS_MAX_PLAYERS) {
-        messages[receivedCount] = message;
+    u32 count = sessionState.incomingMessages.popMany(messages,
+                                                      QueueSize);
+    for (u32 i = 0; i < count; i++) {
+      if (messages[i].playerId < MaxPlayers) {
+        messages[receivedCount] = messages[i];
         receivedCount++;
       }
     }
 
-    LINK_BARRIER;
-    sessionState.incomingMessages.stopReading();
-    LINK_BARRIER;
-
     return true;
   }
 
@@ -724,9 +845,8 @@ class LinkWireless {
 
   /**
    * @brief Returns whether the internal queue lost messages at some point due
-   * to being full. This can happen if your queue size is too low, if you
-   * receive too much data without calling `receive(...)` enough times, or if
-   * excessive `receive(...)` calls prevent the ISR from copying data. After
+   * to being full. This can happen if your queue size is too low, or if you
+   * receive too much data without calling `receive(...)` enough times. After
    * this call, the overflow flag is cleared if `clear` is `true` (default
    * behavior).
    */
@@ -740,6 +860,20 @@ class LinkWireless {
     return overflowReceive || overflowForwardedMessage;
   }
 
+  /**
+   * @brief Returns the instrumentation counters (see `Link::Stats`).
+   * @param clear Whether the counters should be reset after reading them.
+   * \warning Always empty unless `LINK_ENABLE_STATS` is `1`.
+   */
+  [[nodiscard]] Link::Stats getStats(bool clear = false) {
+#if LINK_ENABLE_STATS != 0
+    return Link::_readStats(_stats, clear);
+#else
+    (void)clear;
+    return {};
+#endif
+  }
+
   /**
    * @brief Resets other players' timeout count to `0`.
    * \warning Call this if you changed `config.timeout`.
@@ -755,16 +889,28 @@ class LinkWireless {
 
   /**
    * @brief Restarts the send timer without disconnecting.
-   * \warning Call this if you changed `config.interval`.
+   * \warning Call this if you changed `config.interval` or the adaptive
+   * interval bounds.
    */
   void resetTimer() {
     if (!isEnabled)
       return;
 
     stopTimer();
+    intervalController.reset(config.interval, config.minInterval,
+                             config.maxInterval);
     startTimer();
   }
 
+  /**
+   * @brief Returns the current send interval. It's `config.interval`, unless
+   * `config.adaptiveInterval` is `true`.
+   */
+  [[nodiscard]] u16 getInterval() {
+    return config.adaptiveInterval ? intervalController.interval()
+                                   : config.interval;
+  }
+
   /**
    * @brief If one of the other methods returns `false`, you can inspect this to
    * know the cause. After this call, the last error is cleared if `clear` is
@@ -783,7 +929,9 @@ class LinkWireless {
    * \warning This is internal API!
    */
   [[nodiscard]] u32 _getPendingCount() {
-    return sessionState.outgoingMessages.size();
+    return sessionState.outgoingMessages.size() +
+           sessionState.newOutgoingMessages.size() +
+           sessionState.newUrgentMessages.size();
   }
 
   /**
@@ -847,10 +995,10 @@ class LinkWireless {
   }
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
   /**
-   * @brief Sets a logger function.
+   * @brief Sets the `Link::BinaryLog` of the internal `LinkRawWireless`.
    * \warning This is internal API!
    */
-  void _setLogger(LinkRawWireless::Logger logger) {
+  void _setLogger(Link::BinaryLog* logger) {
     linkRawWireless.logger = logger;
   }
 #endif
@@ -864,6 +1012,8 @@ class LinkWireless {
 #else
   void _onVBlank() {
 #endif
+    LINK_STATS_ISR(vblank);
+
     if (!isEnabled)
       return;
 
@@ -874,16 +1024,12 @@ class LinkWireless {
     }
 #endif
 
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    profileStart();
-#endif
-
     if (!isSessionActive())
       return;
 
     if (sessionState.isResetTimeoutPending) {
       sessionState.recvTimeout = 0;
-      for (u32 i = 0; i < LINK_WIRELESS_MAX_PLAYERS; i++)
+      for (u32 i = 0; i < MaxPlayers; i++)
         sessionState.msgTimeouts[i] = 0;
       sessionState.isResetTimeoutPending = false;
     }
@@ -896,13 +1042,11 @@ class LinkWireless {
     if (!checkRemoteTimeouts())
       return (void)abort(Error::REMOTE_TIMEOUT);
 
+    if (config.adaptiveInterval)
+      updateInterval();
+
     sessionState.recvFlag = false;
     sessionState.signalLevelCalled = false;
-
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    vblankTime += profileStop();
-    vblankIRQs++;
-#endif
   }
 
   /**
@@ -951,6 +1095,11 @@ class LinkWireless {
     u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
     u16 interval;  // can be changed in realtime, but call `resetTimer()`
     u8 sendTimerId;
+    bool adaptiveInterval;  // if true, `interval` is only the initial value
+    u16 minInterval;        // (lower bound for the adaptive interval)
+    u16 maxInterval;        // (upper bound for the adaptive interval)
+    Link::ReceiveCallback onReceive;  // (if set, messages skip the queues)
+    u8 urgentWeight;  // urgent msgs per bulk msg when both wait (0 = strict)
   };
 
   /**
@@ -963,7 +1112,7 @@ class LinkWireless {
    * Returns whether the current multiboot ROM has started wirelessly or not.
    */
   static bool isWirelessMultibootRom() {
-    const vu8* ewram = (const vu8*)0x02000000;
+    const vu8* ewram = Link::_MEM_EWRAM;
     static const u8 header[12] = {0x52, 0x46, 0x55, 0x2D, 0x4D, 0x42,
                                   0x4F, 0x4F, 0x54, 0x00, 0x00, 0x00};
 
@@ -977,25 +1126,31 @@ class LinkWireless {
 #ifndef LINK_WIRELESS_DEBUG_MODE
  private:
 #endif
-  using MessageQueue = Link::Queue<Message, LINK_WIRELESS_QUEUE_SIZE>;
+  using MessageQueue = Link::RingBuffer<Message, QueueSize>;
+  using UrgentQueue = Link::RingBuffer<Message, UrgentQueueSize>;
 
   struct SignalLevel {
-    vu8 level[LINK_WIRELESS_MAX_PLAYERS] = {};
+    vu8 level[MaxPlayers] = {};
   };
 
   struct SessionState {
-    MessageQueue incomingMessages;     // read by user, write by irq&user
+    MessageQueue incomingMessages;     // read by user, write by irq
     MessageQueue outgoingMessages;     // read and write by irq
     MessageQueue newIncomingMessages;  // read and write by irq
-    MessageQueue newOutgoingMessages;  // read by irq, write by user&irq
+    MessageQueue newOutgoingMessages;  // read by irq, write by user
+    UrgentQueue newUrgentMessages;     // read by irq, write by user
     SignalLevel signalLevel;           // write by irq, read by any
+    u8 urgentStreak = 0;               // (urgent messages moved in a row)
+    bool isChannelEscaped[MaxPlayers];  // (received a CHANNEL_ESCAPE)
 
-    u32 recvTimeout = 0;                         // (~= LinkCable::IRQTimeout)
-    u32 msgTimeouts[LINK_WIRELESS_MAX_PLAYERS];  // (~= LinkCable::msgTimeouts)
-    bool recvFlag = false;                       // (~= LinkCable::IRQFlag)
-    bool msgFlags[LINK_WIRELESS_MAX_PLAYERS];    // (~= LinkCable::msgFlags)
+    u32 recvTimeout = 0;          // (~= LinkCable::IRQTimeout)
+    u32 msgTimeouts[MaxPlayers];  // (~= LinkCable::msgTimeouts)
+    bool recvFlag = false;        // (~= LinkCable::IRQFlag)
+    bool msgFlags[MaxPlayers];    // (~= LinkCable::msgFlags)
 
     bool signalLevelCalled = false;
+    volatile bool isSignalLevelReady = false;    // (clients)
+    volatile bool isSignalLevelPending = false;  // (clients)
     bool sendReceiveLatch = false;  // true = send ; false = receive
     bool shouldWaitForServer = false;
 
@@ -1005,9 +1160,9 @@ class LinkWireless {
     u32 lastPacketId = 0;
     u32 lastPacketIdFromServer = 0;
     u32 lastAckFromServer = 0;
-    u32 lastPacketIdFromClients[LINK_WIRELESS_MAX_PLAYERS];
-    u32 lastAckFromClients[LINK_WIRELESS_MAX_PLAYERS];
-    int lastHeartbeatFromClients[LINK_WIRELESS_MAX_PLAYERS];
+    u32 lastPacketIdFromClients[MaxPlayers];
+    u32 lastAckFromClients[MaxPlayers];
+    int lastHeartbeatFromClients[MaxPlayers];
     int localHeartbeat = -1;
     volatile bool isResetTimeoutPending = false;
   };
@@ -1092,10 +1247,14 @@ class LinkWireless {
 
   LinkRawWireless linkRawWireless;
   SessionState sessionState;
+  Link::IntervalController intervalController;
   u32 nextAsyncCommandData[LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH];
   u32 nextAsyncCommandDataSize = 0;
   volatile bool isSendingSyncCommand = false;
   volatile Error lastError = Error::NONE;
+#if LINK_ENABLE_STATS != 0
+  Link::Stats _stats;
+#endif
   volatile bool isEnabled = false;
 
 #ifdef LINK_WIRELESS_ENABLE_NESTED_IRQ
@@ -1113,45 +1272,32 @@ class LinkWireless {
 #endif
 
   LINK_INLINE void ___onSerial() {
+    LINK_STATS_ISR(serial);
+
     if (!isEnabled)
       return;
 
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    profileStart();
-#endif
-
-    int status = linkRawWireless._onSerial(false);
+    int status = linkRawWireless._onSerial(false, true);
     if (status <= -4) {
       return (void)abort(Error::ACKNOWLEDGE_FAILED);
     } else if (status > 0) {
       auto result = linkRawWireless._getAsyncCommandResultRef();
       processAsyncCommand(result);
+      linkRawWireless._startQueuedCommand();
     }
-
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    serialTime += profileStop();
-    serialIRQs++;
-#endif
   }
 
   LINK_INLINE void ___onTimer() {
+    LINK_STATS_ISR(timer);
+
     if (!isEnabled)
       return;
 
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    profileStart();
-#endif
-
     if (!isSessionActive())
       return;
 
     if (!isAsyncCommandActive())
       checkConnectionsOrTransferData();
-
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-    timerTime += profileStop();
-    timerIRQs++;
-#endif
   }
 
   LINK_INLINE void processAsyncCommand(
@@ -1170,17 +1316,23 @@ class LinkWireless {
         // SignalLevel (end)
         u32 levels = commandResult->dataSize > 0 ? commandResult->data[0] : 0;
         u32 players = 1;
-        for (u32 i = 1; i < LINK_WIRELESS_MAX_PLAYERS; i++) {
+        for (u32 i = 1; i < MaxPlayers; i++) {
           u32 level = (levels >> ((i - 1) * 8)) & 0xFF;
           sessionState.signalLevel.level[i] = level;
           if (level > 0)
             players++;
         }
 
+        if (linkRawWireless.getState() != State::SERVING) {
+          sessionState.isSignalLevelReady = true;
+          sessionState.isSignalLevelPending = false;
+          break;
+        }
+
         if (players > linkRawWireless.sessionState.playerCount) {
           LINK_BARRIER;
           linkRawWireless.sessionState.playerCount =
-              Link::_min(players, config.maxPlayers);
+              Link::_min(players, getMaxPlayers());
           LINK_BARRIER;
         }
 
@@ -1219,13 +1371,7 @@ class LinkWireless {
   }
 
   LINK_WIRELESS_TIMER_ISR void checkConnectionsOrTransferData() {  // (irq only)
-    if (linkRawWireless.getState() == State::SERVING &&
-        !sessionState.signalLevelCalled) {
-      // SignalLevel (start)
-      if (sendCommandAsync(LinkRawWireless::COMMAND_SIGNAL_LEVEL))
-        sessionState.signalLevelCalled = true;
-    } else if (linkRawWireless.getState() == State::CONNECTED ||
-               isConnected()) {
+    if (linkRawWireless.getState() == State::CONNECTED || isConnected()) {
       bool shouldReceive =
           !sessionState.sendReceiveLatch || sessionState.shouldWaitForServer;
 
@@ -1237,6 +1383,13 @@ class LinkWireless {
         sendPendingData();
       }
     }
+
+    if (linkRawWireless.getState() == State::SERVING &&
+        !sessionState.signalLevelCalled) {
+      // SignalLevel (start, queued right after the data transfer)
+      if (queueCommand(LinkRawWireless::COMMAND_SIGNAL_LEVEL))
+        sessionState.signalLevelCalled = true;
+    }
   }
 
   LINK_WIRELESS_TIMER_ISR void sendPendingData() {  // (irq only)
@@ -1278,6 +1431,10 @@ class LinkWireless {
             } else {
               return false;
             }
+          } else {
+            LINK_STATS_COUNT(retransmissions);
+            LINK_TRACE(WIRELESS, RETRANSMIT, message->packetId,
+                       message->playerId);
           }
 
           // get first added packet ID and add first msg if needed
@@ -1329,6 +1486,7 @@ class LinkWireless {
           // only continue if we have available halfwords
           return nextAsyncCommandDataSize < maxTransferLength || highPart;
         });
+    LINK_TRACE(WIRELESS, TRANSFER_START, firstPacketId, msgCount);
 
     // fill Transfer header
     nextAsyncCommandData[1] = buildTransferHeader(isServer, firstPacketId,
@@ -1389,8 +1547,10 @@ class LinkWireless {
   }
 
   void clearInflightMessagesIfNeeded() {  // (irq only)
-    if (config.retransmission)
-      return;
+    if constexpr (Retransmission) {
+      if (config.retransmission)
+        return;
+    }
 
     while (!sessionState.outgoingMessages.isEmpty()) {
       u32 packetId = sessionState.outgoingMessages.peek().packetId;
@@ -1408,7 +1568,7 @@ class LinkWireless {
   LINK_WIRELESS_SERIAL_ISR void addIncomingMessagesFromData(
       const CommandResult* result) {  // (irq only)
     // parse ReceiveData header
-    u32 sentBytes[LINK_WIRELESS_MAX_PLAYERS] = {0, 0, 0, 0, 0};
+    u32 sentBytes[LINK_RAW_WIRELESS_MAX_PLAYERS] = {0, 0, 0, 0, 0};
     u32 receiveDataHeader = result->data[0];
     sentBytes[0] = Link::_min(receiveDataHeader & 0b1111111,
                               LinkRawWireless::MAX_TRANSFER_BYTES_SERVER);
@@ -1424,7 +1584,7 @@ class LinkWireless {
     bool isServer = linkRawWireless.getState() == State::SERVING;
     u32 cursor = 1;
     u32 startPlayerId = isServer ? 1 : 0;
-    u32 endPlayerId = isServer ? linkRawWireless.sessionState.playerCount : 1;
+    u32 endPlayerId = isServer ? getPlayerCountForLoops() : 1;
 
     // server reads from indexes 1~4, clients read from index 0
     for (u32 i = startPlayerId; i < endPlayerId; i++) {
@@ -1443,15 +1603,20 @@ class LinkWireless {
 
       // if retransmission is enabled, we update the confirmations based on the
       // ACKs found in the header
-      if (config.retransmission) {
-        if (isServer) {
-          sessionState.lastAckFromClients[i] = header.ack1;
-        } else {
-          u32 currentPlayerId = linkRawWireless.sessionState.currentPlayerId;
-          sessionState.lastAckFromServer = currentPlayerId == 1   ? header.ack1
-                                           : currentPlayerId == 2 ? header.ack2
-                                           : currentPlayerId == 3 ? header.ack3
-                                                                  : header.ack4;
+      if constexpr (Retransmission) {
+        if (config.retransmission) {
+          if (isServer) {
+            sessionState.lastAckFromClients[i] = header.ack1;
+            LINK_TRACE(WIRELESS, ACK, header.ack1, i);
+          } else {
+            u32 currentPlayerId = linkRawWireless.sessionState.currentPlayerId;
+            sessionState.lastAckFromServer =
+                currentPlayerId == 1   ? header.ack1
+                : currentPlayerId == 2 ? header.ack2
+                : currentPlayerId == 3 ? header.ack3
+                                       : header.ack4;
+            LINK_TRACE(WIRELESS, ACK, sessionState.lastAckFromServer, 0);
+          }
         }
       }
 
@@ -1522,11 +1687,13 @@ class LinkWireless {
     }
 
     // remove confirmed messages based on the updated ACKs
-    if (config.retransmission) {
-      if (isServer)
-        removeConfirmedMessagesFromClients();
-      else
-        removeConfirmedMessagesFromServer();
+    if constexpr (Retransmission) {
+      if (config.retransmission) {
+        if (isServer)
+          removeConfirmedMessagesFromClients();
+        else
+          removeConfirmedMessagesFromServer();
+      }
     }
 
     // copy data from the interrupt world to the main world
@@ -1572,21 +1739,24 @@ class LinkWireless {
           sessionState.didReceiveFirstPacketFromServer = true;
         } else {
           // if retransmission is enabled, the packet ID needs to be expected
-          if (config.retransmission) {
-            u32 expectedPacketId =
-                playerId > 0
-                    ? (sessionState.lastPacketIdFromClients[playerId] + 1) %
-                          MAX_PACKET_IDS_CLIENT
-                    : (sessionState.lastPacketIdFromServer + 1) %
-                          MAX_PACKET_IDS_SERVER;
-
-            if (packetId != expectedPacketId)
-              return;
-
-            if (playerId > 0)
-              sessionState.lastPacketIdFromClients[playerId] = expectedPacketId;
-            else
-              sessionState.lastPacketIdFromServer = expectedPacketId;
+          if constexpr (Retransmission) {
+            if (config.retransmission) {
+              u32 expectedPacketId =
+                  playerId > 0
+                      ? (sessionState.lastPacketIdFromClients[playerId] + 1) %
+                            MAX_PACKET_IDS_CLIENT
+                      : (sessionState.lastPacketIdFromServer + 1) %
+                            MAX_PACKET_IDS_SERVER;
+
+              if (packetId != expectedPacketId)
+                return;
+
+              if (playerId > 0)
+                sessionState.lastPacketIdFromClients[playerId] =
+                    expectedPacketId;
+              else
+                sessionState.lastPacketIdFromServer = expectedPacketId;
+            }
           }
         }
 
@@ -1599,12 +1769,41 @@ class LinkWireless {
         message.playerId = msgPlayerId;
         message.data = data;
         message.packetId = packetId;
-        sessionState.newIncomingMessages.push(message);
+        LINK_TRACE(WIRELESS, WORD_RECEIVED, data, msgPlayerId);
+
+        // `CHANNEL_ESCAPE, data` is an urgent message, and
+        // `CHANNEL_ESCAPE, CHANNEL_ESCAPE` is a regular `CHANNEL_ESCAPE`
+        // (the prefix isn't delivered, but it's still forwarded)
+        bool isPrefix = false;
+        if (msgPlayerId < MaxPlayers) {
+          bool& isEscaped = sessionState.isChannelEscaped[msgPlayerId];
+          isPrefix = !isEscaped && data == CHANNEL_ESCAPE;
+          message.isUrgent = isEscaped && data != CHANNEL_ESCAPE;
+          isEscaped = isPrefix;
+        }
+
+        if (isPrefix) {
+          // (nothing to deliver yet)
+        } else if (config.onReceive) {
+          // (no queues: the message is delivered right away)
+          if (msgPlayerId < MaxPlayers)
+            config.onReceive(msgPlayerId, data);
+        } else {
+#if LINK_ENABLE_STATS != 0 || LINK_ENABLE_TRACE != 0
+          if (sessionState.newIncomingMessages.isFull()) {
+            LINK_STATS_COUNT(overflows);
+            LINK_TRACE(WIRELESS, QUEUE_OVERFLOW, data, msgPlayerId);
+          }
+#endif
+          sessionState.newIncomingMessages.forcePush(message);
+        }
 
         // forward to other clients if needed
-        if (playerId > 0 && config.forwarding &&
-            linkRawWireless.sessionState.playerCount > 2)
-          forwardMessage(message);
+        if constexpr (Forwarding) {
+          if (playerId > 0 && config.forwarding &&
+              linkRawWireless.sessionState.playerCount > 2)
+            forwardMessage(message);
+        }
       })
 
   LINK_WIRELESS_SERIAL_ISR void forwardMessage(
@@ -1615,8 +1814,11 @@ class LinkWireless {
     if (!sessionState.outgoingMessages.isFull()) {
       sessionState.outgoingMessages.push(forwardedMessage);
       sessionState.forwardedCount++;
-    } else
+      LINK_STATS_COUNT(forwardedMessages);
+    } else {
       sessionState.outgoingMessages.overflow = true;
+      LINK_STATS_COUNT(overflows);
+    }
   }
 
   LINK_WIRELESS_SERIAL_ISR void
@@ -1628,7 +1830,7 @@ class LinkWireless {
   LINK_WIRELESS_SERIAL_ISR void
   removeConfirmedMessagesFromClients() {  // (irq only)
     u32 ringMinAck = 0xFFFFFFFF;
-    for (u32 i = 1; i < linkRawWireless.sessionState.playerCount; i++) {
+    for (u32 i = 1; i < getPlayerCountForLoops(); i++) {
       u32 ack = sessionState.lastAckFromClients[i];
 
       // ignore clients that didn't confirm anything yet
@@ -1683,37 +1885,70 @@ class LinkWireless {
   }
 
   LINK_WIRELESS_TIMER_ISR u32 getDeviceTransferLength() {  // (irq only)
-    return linkRawWireless.getState() == State::SERVING
-               ? LINK_WIRELESS_MAX_SERVER_TRANSFER_LENGTH
-               : LINK_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH;
+    return linkRawWireless.getState() == State::SERVING ? ServerTransferLength
+                                                        : ClientTransferLength;
   }
 
   LINK_WIRELESS_TIMER_ISR void copyOutgoingState() {  // (irq only)
-    if (sessionState.newOutgoingMessages.isWriting())
-      return;
-
-    while (!sessionState.newOutgoingMessages.isEmpty() &&
-           !sessionState.outgoingMessages.isFull()) {
-      auto message = sessionState.newOutgoingMessages.pop();
-      sessionState.outgoingMessages.push(message);
+    // only the messages that fit in the next transfer leave the user queues
+    // (any other message would wait anyway), so that urgent messages can still
+    // overtake the rest of the backlog
+    auto& outgoing = sessionState.outgoingMessages;
+    auto& bulk = sessionState.newOutgoingMessages;
+    auto& urgent = sessionState.newUrgentMessages;
+    u32 window = getDeviceTransferLength() * 2;
+
+    while (outgoing.size() < window) {
+      bool hasBulk = !bulk.isEmpty();
+      if (!urgent.isEmpty() &&
+          (!hasBulk || config.urgentWeight == 0 ||
+           sessionState.urgentStreak < config.urgentWeight)) {
+        if (!pushOutgoing(urgent.peek(), true))
+          break;
+        urgent.pop();
+        sessionState.urgentStreak++;
+      } else if (hasBulk) {
+        if (!pushOutgoing(bulk.peek(), false))
+          break;
+        bulk.pop();
+        sessionState.urgentStreak = 0;
+      } else {
+        break;
+      }
     }
+
+    LINK_STATS_MARK(outgoingHighWaterMark, _getPendingCount());
   }
 
-  LINK_WIRELESS_SERIAL_ISR void copyIncomingState() {  // (irq only)
-    if (sessionState.incomingMessages.isReading())
-      return;
+  LINK_WIRELESS_TIMER_ISR bool pushOutgoing(Message message,
+                                             bool isUrgent) {  // (irq only)
+    // urgent messages are prefixed with `CHANNEL_ESCAPE`, and bulk messages
+    // that happen to be `CHANNEL_ESCAPE` are sent twice, so receivers can tell
+    // both channels apart
+    auto& outgoing = sessionState.outgoingMessages;
+    bool isEscaped = isUrgent || message.data == CHANNEL_ESCAPE;
+    if (outgoing.available() < (isEscaped ? 2u : 1u))
+      return false;
 
-    while (!sessionState.newIncomingMessages.isEmpty() &&
-           !sessionState.incomingMessages.isFull()) {
-      auto message = sessionState.newIncomingMessages.pop();
-      sessionState.incomingMessages.push(message);
+    if (isEscaped) {
+      Message prefix = message;
+      prefix.data = CHANNEL_ESCAPE;
+      outgoing.push(prefix);
     }
+    outgoing.push(message);
+    return true;
+  }
+
+  LINK_WIRELESS_SERIAL_ISR void copyIncomingState() {  // (irq only)
+    sessionState.newIncomingMessages.moveTo(sessionState.incomingMessages);
+    LINK_STATS_MARK(incomingHighWaterMark,
+                    sessionState.incomingMessages.size());
   }
 
   bool checkRemoteTimeouts() {  // (irq only)
     bool isServer = linkRawWireless.getState() == State::SERVING;
     u32 startPlayerId = isServer ? 1 : 0;
-    u32 endPlayerId = isServer ? linkRawWireless.sessionState.playerCount : 1;
+    u32 endPlayerId = isServer ? getPlayerCountForLoops() : 1;
 
     for (u32 i = startPlayerId; i < endPlayerId; i++) {
       if (!sessionState.msgFlags[i]) {
@@ -1761,6 +1996,13 @@ class LinkWireless {
                                             false, true);
   }
 
+  bool queueCommand(u8 type) {  // (irq only)
+    if (isSendingSyncCommand)
+      return false;
+
+    return linkRawWireless.queueCommand(type, {}, 0, nullptr, true);
+  }
+
   bool isAsyncCommandActive() {
     return linkRawWireless.getAsyncState() ==
            LinkRawWireless::AsyncState::WORKING;
@@ -1773,6 +2015,14 @@ class LinkWireless {
   }
 
   bool abort(Error error) {
+#if LINK_ENABLE_STATS != 0
+    if (error == Error::TIMEOUT || error == Error::REMOTE_TIMEOUT)
+      LINK_STATS_COUNT(timeouts);
+    else
+      LINK_STATS_COUNT(commandFailures);
+    LINK_STATS_COUNT(resets);
+#endif
+    LINK_TRACE(WIRELESS, RESET, error, 0);
     reset();
     lastError = error;
     return false;
@@ -1813,12 +2063,13 @@ class LinkWireless {
     sessionState.lastAckFromServer = 0;
     sessionState.localHeartbeat = -1;
     sessionState.isResetTimeoutPending = false;
-    for (u32 i = 0; i < LINK_WIRELESS_MAX_PLAYERS; i++) {
+    for (u32 i = 0; i < MaxPlayers; i++) {
       sessionState.msgTimeouts[i] = 0;
       sessionState.msgFlags[i] = false;
       sessionState.lastPacketIdFromClients[i] = 0;
       sessionState.lastAckFromClients[i] = NO_ACK_RECEIVED_YET;
       sessionState.lastHeartbeatFromClients[i] = -1;
+      sessionState.isChannelEscaped[i] = false;
     }
     nextAsyncCommandDataSize = 0;
 
@@ -1826,10 +2077,14 @@ class LinkWireless {
     sessionState.outgoingMessages.clear();
 
     sessionState.newIncomingMessages.clear();
-    sessionState.newOutgoingMessages.syncClear();
+    sessionState.newOutgoingMessages.clear();
+    sessionState.newUrgentMessages.clear();
+    sessionState.urgentStreak = 0;
 
     sessionState.newIncomingMessages.overflow = false;
     sessionState.signalLevel = SignalLevel{};
+    sessionState.isSignalLevelReady = false;
+    sessionState.isSignalLevelPending = false;
 
     isSendingSyncCommand = false;
     LINK_BARRIER;
@@ -1857,16 +2112,41 @@ class LinkWireless {
         Link::_REG_TM[config.sendTimerId].cnt & (~Link::_TM_ENABLE);
   }
 
+  void updateInterval() {
+    // (2+ frames without receiving anything count as errors)
+    u32 pending = _getPendingCount();
+    bool hadErrors = sessionState.recvTimeout >= 2;
+
+    if (intervalController.update(pending, QueueSize + UrgentQueueSize,
+                                  hadErrors)) {
+      // (the new reload value is used after the next overflow)
+      Link::_REG_TM[config.sendTimerId].start = -intervalController.interval();
+    }
+  }
+
   void startTimer() {
-    Link::_REG_TM[config.sendTimerId].start = -config.interval;
+    Link::_REG_TM[config.sendTimerId].start = -getInterval();
     Link::_REG_TM[config.sendTimerId].cnt =
         Link::_TM_ENABLE | Link::_TM_IRQ | BASE_FREQUENCY;
   }
 
-  bool setup(u8 maxPlayers = LINK_WIRELESS_MAX_PLAYERS) {
+  void setIRQs() {
+    LINK_IRQ_SET(Link::_IRQ_VBLANK, LinkWirelessT, _onVBlank);
+    LINK_IRQ_SET(Link::_IRQ_SERIAL, LinkWirelessT, _onSerial);
+    LINK_IRQ_SET(Link::_TIMER_IRQ_IDS[config.sendTimerId], LinkWirelessT,
+                 _onTimer);
+  }
+
+  bool setup(u8 maxPlayers = MaxPlayers) {
     return linkRawWireless.setup(maxPlayers);
   }
 
+  u8 getMaxPlayers() { return Link::_min(config.maxPlayers, MaxPlayers); }
+
+  u32 getPlayerCountForLoops() {  // (bounded by `MaxPlayers` at compile time)
+    return Link::_min(linkRawWireless.sessionState.playerCount, MaxPlayers);
+  }
+
   template <typename F>
   void waitVBlanks(u32 vBlanks, F onVBlank) {
     u32 count = 0;
@@ -1881,30 +2161,13 @@ class LinkWireless {
           count++;
         }
       }
+      LINK_BUSY_WAIT;
     };
   }
-
-#ifdef LINK_WIRELESS_PROFILING_ENABLED
-  void profileStart() {
-    Link::_REG_TM1CNT_L = 0;
-    Link::_REG_TM2CNT_L = 0;
-
-    Link::_REG_TM1CNT_H = 0;
-    Link::_REG_TM2CNT_H = 0;
-
-    Link::_REG_TM2CNT_H = Link::_TM_ENABLE | Link::_TM_CASCADE;
-    Link::_REG_TM1CNT_H = Link::_TM_ENABLE | Link::_TM_FREQ_1;
-  }
-
-  u32 profileStop() {
-    Link::_REG_TM1CNT_H = 0;
-    Link::_REG_TM2CNT_H = 0;
-
-    return (Link::_REG_TM1CNT_L | (Link::_REG_TM2CNT_L << 16));
-  }
-#endif
 };
 
+using LinkWireless = LinkWirelessT<>;
+
 extern LinkWireless* linkWireless;
 
 /**
@@ -1941,8 +2204,29 @@ inline void LINK_WIRELESS_ISR_TIMER() {
  *        nested interrupts are disabled (`REG_IME = 0`) and SERIAL cannot
  *        interrupt anymore.
  *   - TIMER interrupts are skipped if SERIAL ISR is running.
+ *   - SERIAL ISR can also start an async task: the next queued command
+ *     (SignalLevel), right after processing a result. It disables nested
+ *     interrupts in the same way.
  *   - VBLANK interrupts are postponed if SERIAL or TIMER ISRs are running.
  *   - Nobody can interrupt VBLANK ISR.
+ * When using `config.onReceive`:
+ *   - The callback runs inside `processMessage(...)`, after the packet ID
+ *     checks (so, with retransmission, messages are still in order and never
+ *     duplicated), and before forwarding them to other clients.
+ *   - With nested interrupts, other user ISRs can interrupt the callback.
+ * When using `sendUrgent(...)`:
+ *   - Messages get their packet IDs when they leave the user queues (on each
+ *     TIMER IRQ, in `copyOutgoingState()`), so that's where the priority is
+ *     applied: only the messages that fit in the next transfer are moved to
+ *     `outgoingMessages`, picking urgent ones first (and, with
+ *     `config.urgentWeight` = N > 0, one bulk message after every N urgent
+ *     ones).
+ *   - Urgent messages are sent as `CHANNEL_ESCAPE` (0xFFFC) + the message,
+ *     and bulk messages that happen to be 0xFFFC are sent twice (so each
+ *     escaped message takes 2 packet IDs). Receivers undo this per original
+ *     player (in `processMessage(...)`), and mark urgent messages with
+ *     `isUrgent`. The server forwards both words as they are.
+ *   - `config.onReceive` gets both kinds of messages.
  */
 
 #endif  // LINK_WIRELESS_H
@@ -58,7 +58,7 @@
 /**
  * @brief Enable logging.
  * \warning Set `linkWirelessMultiboot->logger` and uncomment to enable!
- * \warning This option #includes std::string!
+ * \warning Entries are recorded in a `Link::BinaryLog` (no heap allocations).
  */
 // #define LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
 #endif
@@ -82,6 +82,8 @@ LINK_VERSION_TAG LINK_WIRELESS_MULTIBOOT_VERSION =
 #define LINK_WIRELESS_MULTIBOOT_MAX_PLAYERS 5
 #define LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_INTERVAL 50
 #define LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_TIMER_ID 3
+#define LINK_WIRELESS_MULTIBOOT_DEFAULT_COMMAND_TIMER_ID \
+  LINK_RAW_WIRELESS_DEFAULT_TIMER_ID
 #define LINK_WIRELESS_MULTIBOOT_TRY(CALL)       \
   LINK_BARRIER;                                 \
   if ((lastResult = CALL) != Result::SUCCESS) { \
@@ -94,10 +96,9 @@ LINK_VERSION_TAG LINK_WIRELESS_MULTIBOOT_VERSION =
   }
 
 #ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
-#include <string>
-#define _LWMLOG_(str) logger(str)
+#define _LWMLOG_(...) _log(__VA_ARGS__)
 #else
-#define _LWMLOG_(str)
+#define _LWMLOG_(...)
 #endif
 
 /**
@@ -137,8 +138,7 @@ class LinkWirelessMultiboot {
 
  public:
 #ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
-  typedef void (*Logger)(std::string);
-  Logger logger = [](std::string str) {};
+  Link::BinaryLog* logger = nullptr;
 #endif
 
   enum class State {
@@ -168,6 +168,15 @@ class LinkWirelessMultiboot {
     volatile bool* ready = nullptr;
   };
 
+  /**
+   * @brief Constructs a new LinkWirelessMultiboot object.
+   * @param commandTimerId `(0~3)` GBA Timer used by `LinkRawWireless` to run
+   * the adapter commands.
+   */
+  explicit LinkWirelessMultiboot(
+      u8 commandTimerId = LINK_WIRELESS_MULTIBOOT_DEFAULT_COMMAND_TIMER_ID)
+      : linkRawWireless(commandTimerId) {}
+
   /**
    * @brief Sends the `rom`. Once completed, the return value should be
    * `LinkWirelessMultiboot::Result::SUCCESS`.
@@ -251,10 +260,10 @@ class LinkWirelessMultiboot {
 
 #ifdef LINK_RAW_WIRELESS_ENABLE_LOGGING
   /**
-   * @brief Sets a logger function.
+   * @brief Sets the `Link::BinaryLog` of the internal `LinkRawWireless`.
    * \warning This is internal API!
    */
-  void _setLogger(LinkRawWireless::Logger logger) {
+  void _setLogger(Link::BinaryLog* logger) {
     linkRawWireless.logger = logger;
   }
 #endif
@@ -341,7 +350,7 @@ class LinkWirelessMultiboot {
     ClientPacket handshakePackets[2] = {ClientPacket{}, ClientPacket{}};
     bool hasReceivedName = false;
 
-    _LWMLOG_("new client: " + std::to_string(clientNumber));
+    _LWMLOG_("new client: %d", clientNumber);
     LINK_WIRELESS_MULTIBOOT_TRY_SUB(exchangeAndValidate(
         clientNumber,
         [this](LinkRawWireless::ReceiveDataResponse& response) {
@@ -409,7 +418,7 @@ class LinkWirelessMultiboot {
     }
     // (no more client packets)
 
-    _LWMLOG_("client " + std::to_string(clientNumber) + " accepted");
+    _LWMLOG_("client %d accepted", clientNumber);
 
     return Result::SUCCESS;
   }
@@ -553,7 +562,7 @@ class LinkWirelessMultiboot {
 
     if (remoteCommand.commandId != LinkRawWireless::EVENT_DATA_AVAILABLE) {
       _LWMLOG_("! expected EVENT 0x28");
-      _LWMLOG_("! but got " + toHex(remoteCommand.commandId));
+      _LWMLOG_("! but got %2x", remoteCommand.commandId);
       return Result::FAILURE;
     }
 
@@ -604,13 +613,9 @@ class LinkWirelessMultiboot {
   }
 
 #ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
-  template <typename I>
-  std::string toHex(I w, size_t hex_len = sizeof(I) << 1) {
-    static const char* digits = "0123456789ABCDEF";
-    std::string rc(hex_len, '0');
-    for (size_t i = 0, j = (hex_len - 1) * 4; i < hex_len; ++i, j -= 4)
-      rc[i] = digits[(w >> j) & 0x0F];
-    return rc;
+  void _log(const char* format, u32 arg0 = 0) {
+    if (logger)
+      logger->record(format, arg0);
   }
 #endif
 
@@ -681,7 +686,7 @@ class LinkWirelessMultiboot {
 
    public:
 #ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
-    Logger logger = [](std::string str){};
+    Link::BinaryLog* logger = nullptr;
 #endif
 
     using GeneralResult = Link::AsyncMultiboot::Result;
@@ -735,6 +740,8 @@ class LinkWirelessMultiboot {
      * will transfer faster but also consume more CPU. Some audio players
      * require precise interrupt timing to avoid crashes! Use a minimum of 30.
      * @param timerId `(0~3)` GBA Timer to use for waiting.
+     * @param commandTimerId `(0~3)` GBA Timer used by `LinkRawWireless` to run
+     * the adapter commands.
      */
     explicit Async(
         const char* gameName = "",
@@ -744,8 +751,10 @@ class LinkWirelessMultiboot {
         bool waitForReadySignal = false,
         bool keepConnectionAlive = false,
         u16 interval = LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_INTERVAL,
-        u8 timerId = LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_TIMER_ID)
-        : multiTransfer(&linkWirelessOpenSDK) {
+        u8 timerId = LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_TIMER_ID,
+        u8 commandTimerId = LINK_WIRELESS_MULTIBOOT_DEFAULT_COMMAND_TIMER_ID)
+        : linkRawWireless(commandTimerId),
+          multiTransfer(&linkWirelessOpenSDK) {
       config.gameName = gameName;
       config.userName = userName;
       config.gameId = gameId;
@@ -927,7 +936,7 @@ class LinkWirelessMultiboot {
 #ifndef LINK_WIRELESS_MULTIBOOT_ASYNC_DISABLE_NESTED_IRQ
       interrupt = true;
 #endif
-      if (linkRawWireless._onSerial() > 0) {
+      if (linkRawWireless._onSerial(true, true) > 0) {
         auto response = linkRawWireless._getAsyncCommandResultRef();
 #ifndef LINK_WIRELESS_MULTIBOOT_ASYNC_DISABLE_NESTED_IRQ
         Link::_REG_IME = 1;
@@ -970,6 +979,13 @@ class LinkWirelessMultiboot {
     Config config;
 
    private:
+#ifdef LINK_WIRELESS_MULTIBOOT_ENABLE_LOGGING
+    void _log(const char* format, u32 arg0 = 0) {
+      if (logger)
+        logger->record(format, arg0);
+    }
+#endif
+
     enum class SendState { NOT_SENDING, SEND_AND_WAIT, RECEIVE };
 
     struct MultibootFixedData {
@@ -1081,7 +1097,7 @@ class LinkWirelessMultiboot {
             dynamicData.connectedClients = newConnectedClients;
             u8 lastClientNumber =
                 (u8)Link::msB32(response->data[response->dataSize - 1]);
-            _LWMLOG_("new client: " + std::to_string(lastClientNumber));
+            _LWMLOG_("new client: %d", lastClientNumber);
 
             state = State::HANDSHAKING_CLIENT_STEP1;
             startHandshakeWith(lastClientNumber);
@@ -1198,7 +1214,7 @@ class LinkWirelessMultiboot {
           if (!hasFinished)
             return (void)exchangeAsync({}, 0, 1);
 
-          _LWMLOG_("client " + std::to_string(currentClient) + " accepted");
+          _LWMLOG_("client %d accepted", currentClient);
 
           startOrKeepListening();
           break;
@@ -12,14 +12,73 @@
 #define LINK_ENABLE_DEBUG_LOGS 0
 #endif
 
+/**
+ * @brief Enable the `Link::Stats` instrumentation in all libraries.
+ * Each library will expose its counters via `getStats(...)`.
+ */
+#ifndef LINK_ENABLE_STATS
+#define LINK_ENABLE_STATS 0
+#endif
+
+/**
+ * @brief Enable the `Link::Trace` event ring in all libraries.
+ * Recording an event only takes a few cycles, so it can be left enabled in
+ * release builds.
+ */
+#ifndef LINK_ENABLE_TRACE
+#define LINK_ENABLE_TRACE 0
+#endif
+
+/**
+ * @brief Number of events that the `Link::Trace` ring can store.
+ * It must be a power of two. Each event takes 12 bytes.
+ */
+#ifndef LINK_TRACE_SIZE
+#define LINK_TRACE_SIZE 256
+#endif
+
+/**
+ * @brief Number of entries that a `Link::BinaryLog` can store.
+ * Each entry takes 12 bytes.
+ */
+#ifndef LINK_LOG_SIZE
+#define LINK_LOG_SIZE 64
+#endif
+
+/**
+ * @brief Timer used as a free-running cycle counter by `Link::Stats` and
+ * `Link::Trace`.
+ * \warning It's started by the libraries on `activate()` when
+ * `LINK_ENABLE_STATS` or `LINK_ENABLE_TRACE` are `1`, so don't use it for
+ * anything else!
+ */
+#ifndef LINK_STATS_TIMER_ID
+#define LINK_STATS_TIMER_ID 0
+#endif
+
+/**
+ * @brief Build for the host (e.g. x86 Linux) instead of the GBA.
+ * Define this to replace the hardware registers and BIOS calls with a
+ * simulated backend. See `_link_host.hpp`.
+ */
+// #define LINK_HOST
+
 #if LINK_ENABLE_DEBUG_LOGS != 0
 #include <stdarg.h>
 #include <stdio.h>
 #endif
 
+#include <stdint.h>
+
 #define LINK_BARRIER asm volatile("" ::: "memory")
+#ifndef LINK_HOST
 #define LINK_CODE_IWRAM \
   __attribute__((section(".iwram"), target("arm"), noinline))
+#define LINK_BUSY_WAIT
+#else
+#define LINK_CODE_IWRAM __attribute__((noinline))
+#define LINK_BUSY_WAIT Link::Host::_idle()
+#endif
 #define LINK_INLINE inline __attribute__((always_inline))
 #define LINK_NOINLINE __attribute__((noinline))
 #define LINK_PACKED __attribute__((packed))
@@ -89,7 +148,17 @@ typedef struct {
 
 // I/O Registers
 
+#ifndef LINK_HOST
 constexpr u32 _REG_BASE = 0x04000000;
+inline const vu8* const _MEM_EWRAM = reinterpret_cast<const vu8*>(0x02000000);
+#else
+constexpr u32 _HOST_IO_SIZE = 0x400;
+constexpr u32 _HOST_EWRAM_SIZE = 0x40000;
+alignas(4) inline u8 _HOST_IO[_HOST_IO_SIZE] = {};
+alignas(4) inline u8 _HOST_EWRAM[_HOST_EWRAM_SIZE] = {};
+inline const uintptr_t _REG_BASE = reinterpret_cast<uintptr_t>(_HOST_IO);
+inline const vu8* const _MEM_EWRAM = _HOST_EWRAM;
+#endif
 
 inline vu16& _REG_RCNT = *reinterpret_cast<vu16*>(_REG_BASE + 0x0134);
 inline vu16& _REG_SIOCNT = *reinterpret_cast<vu16*>(_REG_BASE + 0x0128);
@@ -109,7 +178,14 @@ inline vu16& _REG_TM1CNT_L = *reinterpret_cast<vu16*>(_REG_BASE + 0x0104);
 inline vu16& _REG_TM1CNT_H = *reinterpret_cast<vu16*>(_REG_BASE + 0x0106);
 inline vu16& _REG_TM2CNT_L = *reinterpret_cast<vu16*>(_REG_BASE + 0x0108);
 inline vu16& _REG_TM2CNT_H = *reinterpret_cast<vu16*>(_REG_BASE + 0x010A);
+inline vu16& _REG_IE = *reinterpret_cast<vu16*>(_REG_BASE + 0x0200);
+inline vu16& _REG_IF = *reinterpret_cast<vu16*>(_REG_BASE + 0x0202);
 inline vu16& _REG_IME = *reinterpret_cast<vu16*>(_REG_BASE + 0x0208);
+#ifndef LINK_HOST
+inline vu16& _REG_IFBIOS = *reinterpret_cast<vu16*>(0x03007FF8);
+inline void (*volatile& _REG_ISR_MAIN)() =
+    *reinterpret_cast<void (*volatile*)()>(0x03007FFC);
+#endif
 
 inline volatile _TMR_REC* const _REG_TM =
     reinterpret_cast<volatile _TMR_REC*>(_REG_BASE + 0x0100);
@@ -135,6 +211,7 @@ static constexpr u16 _TIMER_IRQ_IDS[] = {_IRQ_TIMER0, _IRQ_TIMER1, _IRQ_TIMER2,
 
 // SWI
 
+#ifndef LINK_HOST
 static LINK_INLINE void _IntrWait(bool clearCurrent, u32 flags) noexcept {
   register auto r0 asm("r0") = clearCurrent;
   register auto r1 asm("r1") = flags;
@@ -153,6 +230,23 @@ static LINK_INLINE auto _MultiBoot(const _MultiBootParam* param,
                       : "+r"(r0), "+r"(r1)::"r3");
   return r0.res;
 }
+#else
+namespace Host {
+inline void _idle();
+inline void _intrWait(bool clearCurrent, u32 flags);
+inline int _multiBoot(const _MultiBootParam* param, u32 mbmode);
+inline u32 _statsCycles();
+}  // namespace Host
+
+static LINK_INLINE void _IntrWait(bool clearCurrent, u32 flags) noexcept {
+  Host::_intrWait(clearCurrent, flags);
+}
+
+static LINK_INLINE auto _MultiBoot(const _MultiBootParam* param,
+                                   u32 mbmode) noexcept {
+  return Host::_multiBoot(param, mbmode);
+}
+#endif
 
 // Random
 
@@ -213,6 +307,7 @@ static inline void wait(u32 verticalLines) {
       count++;
       vCount = Link::_REG_VCOUNT;
     }
+    LINK_BUSY_WAIT;
   };
 }
 
@@ -278,6 +373,13 @@ class AsyncMultiboot {
   virtual ~AsyncMultiboot() = default;
 };
 
+/**
+ * @brief A function that receives each message as soon as it's parsed, from
+ * the interrupt handler that received it (see `config.onReceive`).
+ * \warning Keep it short: it runs inside the `SERIAL` IRQ.
+ */
+using ReceiveCallback = void (*)(u8 playerId, u16 data);
+
 // Queue
 
 template <typename T, u32 Size>
@@ -395,6 +497,914 @@ class Queue {
   volatile bool _needsClear = false;
 };
 
+// Ring buffer
+
+static constexpr u32 _nextPowerOfTwo(u32 value) {
+  u32 result = 1;
+  while (result < value)
+    result <<= 1;
+  return result;
+}
+
+/**
+ * @brief A single-producer/single-consumer ring buffer. The producer (e.g. an
+ * ISR) only writes `tail` and the consumer (e.g. the user) only writes `head`,
+ * so both sides can run concurrently without flags. Indices are free-running
+ * and masked, so there are no divisions.
+ * \warning `Size` is the maximum number of items. The storage is rounded up to
+ * a power of two, so power-of-two sizes don't waste memory.
+ */
+template <typename T, u32 Size>
+class RingBuffer {
+  static constexpr u32 CAPACITY = _nextPowerOfTwo(Size);
+  static constexpr u32 MASK = CAPACITY - 1;
+
+ public:
+  /**
+   * @brief A contiguous segment of the storage.
+   */
+  struct Span {
+    T* data = nullptr;
+    u32 size = 0;
+    u32 index = 0;  // (position of `data`, used by `commitRead(...)`)
+  };
+
+  /**
+   * @brief Adds `item` (producer side). If the buffer is full, `item` is
+   * discarded, the `overflow` flag is set, and `false` is returned.
+   */
+  bool push(T item) {
+    u32 currentTail = tail;
+    if (currentTail - currentHead() >= Size) {
+      overflow = true;
+      return false;
+    }
+
+    arr[currentTail & MASK] = item;
+    LINK_BARRIER;
+    tail = currentTail + 1;
+    return true;
+  }
+
+  /**
+   * @brief Adds `item`. If the buffer is full, the oldest item is discarded to
+   * make room for it, and the `overflow` flag is set.
+   * \warning Only use this when the same context is also the consumer!
+   */
+  void forcePush(T item) {
+    if (isFull()) {
+      overflow = true;
+      pop();
+    }
+    push(item);
+  }
+
+  /**
+   * @brief Removes and returns the oldest item (consumer side). If the buffer
+   * is empty, `T{}` is returned.
+   */
+  T pop() {
+    u32 currentHead = this->currentHead();
+    if (currentHead == tail)
+      return T{};
+
+    auto x = arr[currentHead & MASK];
+    LINK_BARRIER;
+    head = currentHead + 1;
+    return x;
+  }
+
+  /**
+   * @brief Returns the oldest item without removing it (consumer side).
+   */
+  T peek() {
+    u32 currentHead = this->currentHead();
+    if (currentHead == tail)
+      return T{};
+    return arr[currentHead & MASK];
+  }
+
+  /**
+   * @brief Returns a pointer to the oldest item, or `nullptr` (consumer side).
+   */
+  T* peekRef() {
+    u32 currentHead = this->currentHead();
+    if (currentHead == tail)
+      return nullptr;
+    return &arr[currentHead & MASK];
+  }
+
+  /**
+   * @brief Calls `action` with a pointer to each item, from oldest to newest,
+   * until it returns `false` (consumer side).
+   */
+  template <typename F>
+  LINK_INLINE void forEach(F action) {
+    u32 currentTail = tail;
+
+    for (u32 i = currentHead(); i != currentTail; i++) {
+      if (!action(&arr[i & MASK]))
+        return;
+    }
+  }
+
+  /**
+   * @brief Adds up to `count` items from `items` with (at most) two block
+   * copies (producer side). Returns the number of added items. If not all of
+   * them fit, the `overflow` flag is set.
+   */
+  u32 pushMany(const T* items, u32 count) {
+    Span first, second;
+    writeSpans(first, second);
+
+    u32 pushed = copySpans(items, count, first, second);
+    if (pushed < count)
+      overflow = true;
+    commitWrite(pushed);
+    return pushed;
+  }
+
+  /**
+   * @brief Removes up to `max` items and copies them into `items` with (at
+   * most) two block copies (consumer side). Returns the number of removed
+   * items.
+   */
+  u32 popMany(T* items, u32 max) {
+    Span first, second;
+    readSpans(first, second);
+
+    u32 firstCount = first.size < max ? first.size : max;
+    copy(items, first.data, firstCount);
+    u32 secondCount = second.size < max - firstCount ? second.size
+                                                     : max - firstCount;
+    copy(items + firstCount, second.data, secondCount);
+
+    u32 popped = firstCount + secondCount;
+    commitRead(first, popped);
+    return popped;
+  }
+
+  /**
+   * @brief Moves as many items as possible to `target`, without overflowing
+   * it. This is the consumer side of this buffer and the producer side of
+   * `target`. Returns the number of moved items.
+   */
+  template <u32 TargetSize>
+  u32 moveTo(RingBuffer<T, TargetSize>& target) {
+    Span first, second;
+    readSpans(first, second);
+
+    u32 count = first.size + second.size;
+    u32 available = target.available();
+    if (count > available)
+      count = available;
+    if (count == 0)
+      return 0;
+
+    u32 firstCount = first.size < count ? first.size : count;
+    target.pushMany(first.data, firstCount);
+    target.pushMany(second.data, count - firstCount);
+
+    commitRead(first, count);
+    return count;
+  }
+
+  /**
+   * @brief Returns the readable items as (at most) two contiguous spans, from
+   * oldest to newest (consumer side). After processing them, call
+   * `commitRead(first, ...)`.
+   */
+  void readSpans(Span& first, Span& second) {
+    u32 currentHead = this->currentHead();
+    u32 count = tail - currentHead;
+    splitSpans(currentHead & MASK, count, first, second);
+    first.index = currentHead;
+  }
+
+  /**
+   * @brief Returns the free slots as (at most) two contiguous spans (producer
+   * side). After filling them, call `commitWrite(...)`.
+   */
+  void writeSpans(Span& first, Span& second) {
+    u32 currentTail = tail;
+    u32 count = Size - (currentTail - currentHead());
+    splitSpans(currentTail & MASK, count, first, second);
+    first.index = currentTail;
+  }
+
+  /**
+   * @brief Removes the first `count` items of the spans returned by
+   * `readSpans(...)` (consumer side). If a `syncClear()` ran in the meantime,
+   * the cleared items stay cleared.
+   */
+  void commitRead(const Span& first, u32 count) {
+    LINK_BARRIER;
+    head = first.index + count;
+  }
+
+  /**
+   * @brief Adds the first `count` written slots as items (producer side).
+   */
+  void commitWrite(u32 count) {
+    LINK_BARRIER;
+    tail = tail + count;
+  }
+
+  /**
+   * @brief Removes all the items (consumer side).
+   */
+  void clear() { head = tail; }
+
+  /**
+   * @brief Removes all the items. It can be called from any side, and items
+   * pushed after this call are kept.
+   */
+  void syncClear() { clearIndex = tail; }
+
+  [[nodiscard]] u32 size() { return tail - currentHead(); }
+  [[nodiscard]] u32 available() { return Size - size(); }
+  [[nodiscard]] bool isEmpty() { return size() == 0; }
+  [[nodiscard]] bool isFull() { return size() >= Size; }
+
+  volatile bool overflow = false;
+
+ private:
+  T arr[CAPACITY];
+  vu32 head = 0;
+  vu32 tail = 0;
+  vu32 clearIndex = 0;
+
+  LINK_INLINE u32 currentHead() {
+    // (`clearIndex` only counts if it's within `head~tail`, so this keeps
+    // working after the indexes wrap around; `tail` is read last, since it
+    // never goes below a `clearIndex` that was taken from it)
+    u32 currentHead = head;
+    u32 currentClearIndex = clearIndex;
+    u32 currentTail = tail;
+    return currentClearIndex - currentHead <= currentTail - currentHead
+               ? currentClearIndex
+               : currentHead;
+  }
+
+  void splitSpans(u32 start, u32 count, Span& first, Span& second) {
+    u32 firstCount = CAPACITY - start < count ? CAPACITY - start : count;
+    first.data = arr + start;
+    first.size = firstCount;
+    second.data = arr;
+    second.size = count - firstCount;
+  }
+
+  u32 copySpans(const T* items, u32 count, Span& first, Span& second) {
+    u32 firstCount = first.size < count ? first.size : count;
+    copy(first.data, items, firstCount);
+    u32 secondCount = second.size < count - firstCount ? second.size
+                                                       : count - firstCount;
+    copy(second.data, items + firstCount, secondCount);
+    return firstCount + secondCount;
+  }
+
+  static LINK_INLINE void copy(T* target, const T* source, u32 count) {
+    for (u32 i = 0; i < count; i++)
+      target[i] = source[i];
+  }
+};
+
+// Stats
+
+/**
+ * @brief Instrumentation counters, filled by the libraries when
+ * `LINK_ENABLE_STATS` is `1`. Counters that don't apply to a library stay in
+ * `0`. Cycles are CPU cycles (host cycles on `LINK_HOST` builds).
+ */
+struct Stats {
+  struct ISR {
+    u32 calls = 0;        //!< Handled IRQs
+    u32 totalCycles = 0;  //!< Accumulated time spent in the handler
+    u32 maxCycles = 0;    //!< Longest run of the handler
+  };
+
+  ISR vblank;
+  ISR serial;
+  ISR timer;
+
+  u32 incomingHighWaterMark = 0;  //!< Peak size of the incoming queue(s)
+  u32 outgoingHighWaterMark = 0;  //!< Peak size of the outgoing queue(s)
+  u32 overflows = 0;              //!< Messages dropped due to full queues
+  u32 resets = 0;                 //!< Connection resets
+  u32 timeouts = 0;               //!< Timeouts (local or remote)
+
+  u32 retransmissions = 0;    //!< Re-sent packets
+  u32 forwardedMessages = 0;  //!< Messages forwarded to other nodes
+  u32 crcFailures = 0;        //!< Packets/checksums that failed validation
+  u32 commandFailures = 0;    //!< Failed adapter/device commands
+};
+
+#if LINK_ENABLE_STATS != 0 || LINK_ENABLE_TRACE != 0
+static inline void _startStatsTimer() {
+  if (_REG_TM[LINK_STATS_TIMER_ID].cnt & _TM_ENABLE)
+    return;
+
+  _REG_TM[LINK_STATS_TIMER_ID].start = 0;
+  _REG_TM[LINK_STATS_TIMER_ID].cnt = _TM_ENABLE | _TM_FREQ_1;
+}
+
+#define LINK_STATS_START Link::_startStatsTimer()
+#else
+#define LINK_STATS_START
+#endif
+
+#if LINK_ENABLE_STATS != 0
+#ifndef LINK_HOST
+static LINK_INLINE u32 _statsCycles() {
+  return _REG_TM[LINK_STATS_TIMER_ID].count;
+}
+
+static LINK_INLINE u32 _statsElapsed(u32 start) {
+  // (16-bit counter: handlers longer than 65535 cycles wrap around)
+  return (u16)(_statsCycles() - start);
+}
+#else
+static LINK_INLINE u32 _statsCycles() {
+  return Host::_statsCycles();
+}
+
+static LINK_INLINE u32 _statsElapsed(u32 start) {
+  return _statsCycles() - start;
+}
+#endif
+
+struct _ISRProfiler {
+  Stats::ISR& isr;
+  u32 start;
+
+  LINK_INLINE _ISRProfiler(Stats::ISR& isr) : isr(isr), start(_statsCycles()) {}
+
+  LINK_INLINE ~_ISRProfiler() {
+    u32 elapsed = _statsElapsed(start);
+    isr.calls++;
+    isr.totalCycles += elapsed;
+    if (elapsed > isr.maxCycles)
+      isr.maxCycles = elapsed;
+  }
+};
+
+static LINK_INLINE void _statsMark(u32& highWaterMark, u32 value) {
+  if (value > highWaterMark)
+    highWaterMark = value;
+}
+
+static inline Stats _readStats(Stats& stats, bool clear) {
+  u16 ime = _REG_IME;
+  _REG_IME = 0;
+  LINK_BARRIER;
+  Stats copy = stats;
+  if (clear)
+    stats = Stats{};
+  LINK_BARRIER;
+  _REG_IME = ime;
+
+  return copy;
+}
+
+// (these expect a `Link::Stats _stats` member)
+#define LINK_STATS_ISR(ISR) \
+  Link::_ISRProfiler _linkISRProfiler(_stats.ISR)
+#define LINK_STATS_COUNT(FIELD) _stats.FIELD++
+#define LINK_STATS_MARK(FIELD, VALUE) Link::_statsMark(_stats.FIELD, VALUE)
+#else
+#define LINK_STATS_ISR(ISR)
+#define LINK_STATS_COUNT(FIELD)
+#define LINK_STATS_MARK(FIELD, VALUE)
+#endif
+
+// Trace
+
+/**
+ * @brief A fixed-size ring of binary events, filled by the ISRs of all the
+ * libraries when `LINK_ENABLE_TRACE` is `1`. When a session desyncs, dump it
+ * (see `dump(...)`) and decode it on a PC with `tools/LinkTrace_decoder`.
+ * \warning The layout of this struct is part of the dump format. If you
+ * change it, update `VERSION` and the decoder!
+ */
+struct Trace {
+  static constexpr u32 MAGIC = 0x4352544C;  // "LTRC" (little-endian)
+  static constexpr u16 VERSION = 1;
+  static constexpr u16 SIZE = LINK_TRACE_SIZE;
+
+  /**
+   * @brief The library that recorded the event (high nibble of `Event::id`).
+   */
+  enum Source : u8 {
+    CABLE = 0x00,
+    RAW_CABLE = 0x10,
+    WIRELESS = 0x20,
+    RAW_WIRELESS = 0x30,
+    SPI = 0x40,
+    UART = 0x50,
+    CUBE = 0x60,
+    MOBILE = 0x70,
+    PS2_KEYBOARD = 0x80,
+    CABLE_2P = 0x90,
+    USER = 0xF0
+  };
+
+  /**
+   * @brief What happened (low nibble of `Event::id`).
+   */
+  enum Type : u8 {
+    TRANSFER_START = 0,    // data0: outgoing data
+    WORD_RECEIVED = 1,     // data0: incoming data, data1: player/client id
+    ACK = 2,               // data0: acknowledged id, data1: player/client id
+    RETRANSMIT = 3,        // data0: packet id
+    TIMEOUT = 4,           // data0: player/client id, data1: timeout count
+    STATE_CHANGE = 5,      // data0: new state, data1: old state
+    RESET = 6,             // data0: reason
+    QUEUE_OVERFLOW = 7,    // data0: dropped data
+    CRC_FAILURE = 8,       // data0: received data
+    COMMAND = 9,           // data0: command id, data1: parameter
+    COMMAND_FAILURE = 10,  // data0: command id, data1: error code
+    CUSTOM = 15            // (free for user events)
+  };
+
+  struct Event {
+    u16 timestamp;  //!< `LINK_STATS_TIMER_ID` count (in cycles, it wraps)
+    u8 vCount;      //!< `REG_VCOUNT` (used to unwrap the timestamps)
+    u8 id;          //!< `Source | Type`
+    u32 data0;
+    u32 data1;
+  };
+
+  u32 magic = MAGIC;
+  u16 version = VERSION;
+  u16 size = SIZE;
+  u32 count = 0;  //!< Total recorded events (the ring keeps the last `SIZE`)
+  Event events[SIZE];
+
+  /**
+   * @brief Records an event. Safe to call from ISRs.
+   * \warning If an IRQ that also records events interrupts this, one of the
+   * two events might be lost.
+   */
+  LINK_INLINE void record(u8 id, u32 data0, u32 data1) {
+    u32 i = count;
+    count = i + 1;
+    Event& event = events[i & (SIZE - 1)];
+    event.timestamp = _REG_TM[LINK_STATS_TIMER_ID].count;
+    event.vCount = (u8)_REG_VCOUNT;
+    event.id = id;
+    event.data0 = data0;
+    event.data1 = data1;
+  }
+
+  /**
+   * @brief Discards all the recorded events.
+   */
+  void clear() {
+    u16 ime = _REG_IME;
+    _REG_IME = 0;
+    count = 0;
+    _REG_IME = ime;
+  }
+
+  /**
+   * @brief Copies the raw ring (`sizeof(Trace)` bytes) to `target`, one byte
+   * at a time, so it can be used to save it to SRAM. Interrupts are disabled
+   * during the copy.
+   * @param target The destination.
+   */
+  void dump(volatile u8* target) {
+    u16 ime = _REG_IME;
+    _REG_IME = 0;
+    const u8* source = reinterpret_cast<const u8*>(this);
+    for (u32 i = 0; i < sizeof(Trace); i++)
+      target[i] = source[i];
+    _REG_IME = ime;
+  }
+
+  static_assert((SIZE & (SIZE - 1)) == 0 && SIZE > 0,
+                "LINK_TRACE_SIZE must be a power of 2");
+};
+
+static_assert(sizeof(Trace::Event) == 12);
+static_assert(sizeof(Trace) == 12 + Trace::SIZE * 12);
+
+#if LINK_ENABLE_TRACE != 0
+/**
+ * @brief The global event ring (shared by all libraries).
+ */
+inline Trace trace LINK_WORDALIGNED;
+
+#define LINK_TRACE(SOURCE, TYPE, DATA0, DATA1)                \
+  Link::trace.record(Link::Trace::SOURCE | Link::Trace::TYPE, \
+                     (Link::u32)(DATA0), (Link::u32)(DATA1))
+#else
+#define LINK_TRACE(SOURCE, TYPE, DATA0, DATA1) ((void)0)
+#endif
+
+// Binary log
+
+/**
+ * @brief A log entry: a format string plus up to two integer arguments.
+ * \warning `format` must be a string literal! Only the pointer is stored.
+ */
+struct LogEntry {
+  const char* format = nullptr;
+  u32 arg0 = 0;
+  u32 arg1 = 0;
+
+  /**
+   * @brief Formats the entry into `buffer` (always null-terminated) and returns
+   * the number of written characters. Supported specifiers are `%d`, `%x`,
+   * `%2x`/`%4x`/`%8x` (zero-padded) and `%%`.
+   * @param buffer The destination.
+   * @param size The size of `buffer` (in bytes).
+   */
+  u32 toString(char* buffer, u32 size) const {
+    if (size == 0)
+      return 0;
+
+    u32 length = 0;
+    u32 usedArgs = 0;
+    auto put = [&](char c) {
+      if (length < size - 1)
+        buffer[length++] = c;
+    };
+
+    for (const char* c = format; c && *c; c++) {
+      if (*c != '%' || !c[1]) {
+        put(*c);
+        continue;
+      }
+
+      c++;
+      u32 width = 0;
+      if (*c >= '1' && *c <= '8' && c[1] == 'x')
+        width = *c++ - '0';
+
+      if (*c != 'd' && *c != 'x') {
+        put(*c);
+        continue;
+      }
+
+      u32 value = usedArgs++ == 0 ? arg0 : arg1;
+      u32 base = *c == 'x' ? 16 : 10;
+      char digits[10];
+      u32 count = 0;
+      do {
+        digits[count++] = "0123456789ABCDEF"[value % base];
+        value /= base;
+      } while (value > 0);
+      while (count < width)
+        digits[count++] = '0';
+      while (count > 0)
+        put(digits[--count]);
+    }
+
+    buffer[length] = '\0';
+    return length;
+  }
+};
+
+/**
+ * @brief An allocation-free logger. Recording an entry only stores a pointer
+ * and two integers in a preallocated ring, so enabling logs doesn't change the
+ * timing of the libraries. Formatting is deferred to the consumer, which
+ * should drain the entries with `read(...)` (e.g. once per frame) and format
+ * them with `LogEntry::toString(...)`.
+ * \warning If the ring is full, new entries are discarded and `overflow` is
+ * set.
+ */
+class BinaryLog {
+ public:
+  /**
+   * @brief Records an entry. Safe to call from ISRs.
+   * @param format A string literal (see `LogEntry::toString(...)`).
+   * @param arg0 The first argument.
+   * @param arg1 The second argument.
+   */
+  void record(const char* format, u32 arg0 = 0, u32 arg1 = 0) {
+    u16 ime = _REG_IME;
+    _REG_IME = 0;
+    entries.push({format, arg0, arg1});
+    _REG_IME = ime;
+  }
+
+  /**
+   * @brief Removes the oldest entry and copies it to `entry`. Returns `false`
+   * if there are no entries.
+   * @param entry The destination.
+   */
+  bool read(LogEntry& entry) {
+    if (entries.isEmpty())
+      return false;
+
+    entry = entries.pop();
+    return true;
+  }
+
+  /**
+   * @brief Returns `true` if entries were discarded because the ring was full,
+   * and clears the flag.
+   */
+  bool hasOverflowed() {
+    bool overflow = entries.overflow;
+    entries.overflow = false;
+    return overflow;
+  }
+
+  /**
+   * @brief Discards all the entries.
+   */
+  void clear() { entries.syncClear(); }
+
+ private:
+  RingBuffer<LogEntry, LINK_LOG_SIZE> entries;
+};
+
+// IRQ hub
+
+/**
+ * @brief A central interrupt dispatcher. Once installed, it's the master ISR:
+ * a single ARM handler in IWRAM that reads `REG_IF` and calls the handler of
+ * each pending interrupt from a small table. Like libtonc's `isr_master`, it
+ * switches to system mode first, so handlers run on the user stack instead of
+ * the small IRQ stack. Libraries register their handlers on `activate()` and
+ * unregister them on `deactivate()`, so there's no need to add the
+ * `LINK_*_ISR_*` functions to an interrupt library (and wrappers like
+ * `LinkUniversal` are skipped, since the active driver is called directly).
+ * \warning The handler is defined in `lib/iwram_code/LinkIRQ.cpp`, so make
+ * sure it gets compiled if you call `install(...)`!
+ * \warning Nested interrupts are not supported. Don't use it with the async
+ * multiboot libraries or `LINK_WIRELESS_ENABLE_NESTED_IRQ`.
+ */
+class IRQ {
+ public:
+  using Handler = void (*)(void* driver);
+  using UserHandler = void (*)(u16 irqs);
+
+  static constexpr u32 LINES = 8;  // (VBLANK, HBLANK, VCOUNT, TIMER0-3, SERIAL)
+
+  struct Entry {
+    Handler handler = nullptr;
+    void* driver = nullptr;
+  };
+
+  struct State {
+    Entry entries[LINES];
+    UserHandler userHandler = nullptr;
+    bool isInstalled = false;
+  };
+
+  /**
+   * @brief Installs the hub as the master ISR and enables the interrupts of the
+   * registered handlers.
+   * @param userHandler An optional function that will be called after the
+   * library handlers, with the pending interrupt flags (e.g. to handle your
+   * own VBLANK). Enabling other interrupts in `REG_IE` is up to you.
+   */
+  static void install(UserHandler userHandler = nullptr);
+
+  /**
+   * @brief Uninstalls the hub and disables interrupts (`REG_IME = 0`). The
+   * table is kept, so libraries remain registered.
+   */
+  static void uninstall();
+
+  /**
+   * @brief Returns whether the hub is the master ISR or not.
+   */
+  [[nodiscard]] static bool isInstalled();
+
+  /**
+   * @brief Registers `handler` for the `irq` flag (e.g. `Link::_IRQ_SERIAL`).
+   * If another driver owns that line, nothing happens and `false` is returned
+   * (so drivers wrapped by other drivers don't steal their interrupts).
+   * @param irq A single interrupt flag (`VBLANK` to `SERIAL`).
+   * @param driver The instance that will be passed to `handler`.
+   * @param handler The function to call.
+   */
+  static bool set(u16 irq, void* driver, Handler handler);
+
+  /**
+   * @brief Unregisters the handler of the `irq` flag, if `driver` owns it.
+   * @param irq A single interrupt flag (`VBLANK` to `SERIAL`).
+   * @param driver The instance that registered it.
+   */
+  static void unset(u16 irq, void* driver);
+
+  /**
+   * @brief Unregisters all the handlers owned by `driver`.
+   * @param driver The instance that registered them.
+   */
+  static void unsetAll(void* driver);
+
+  /**
+   * @brief Returns the dispatcher state (the table).
+   * \warning This is internal API!
+   */
+  [[nodiscard]] static State& _state();
+
+  /**
+   * @brief Calls the handlers of the `pending` interrupts.
+   * \warning This is internal API!
+   */
+  static LINK_INLINE void _dispatch(u16 pending) {
+    State& state = _state();
+    for (u32 irqs = pending & ((1 << LINES) - 1); irqs != 0;
+         irqs &= irqs - 1) {
+      Entry& entry = state.entries[lowestLine(irqs)];
+      if (entry.handler)
+        entry.handler(entry.driver);
+    }
+    if (state.userHandler)
+      state.userHandler(pending);
+  }
+
+#ifndef LINK_HOST
+  /**
+   * @brief The master ISR (it dispatches in system mode).
+   * \warning This is internal API!
+   */
+  static void _onIRQ();  // defined in `LinkIRQ.cpp`
+#else
+  static void _onIRQ() { _dispatch(_REG_IE & _REG_IF); }
+#endif
+
+ private:
+  // (the ARM7TDMI has no CLZ, so the lowest bit is found with a multiply)
+  static constexpr u8 DE_BRUIJN_LINES[32] = {
+      0,  1,  28, 2,  29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4,  8,
+      31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6,  11, 5,  10, 9};
+
+  static LINK_INLINE u32 lowestLine(u32 irqs) {
+    return DE_BRUIJN_LINES[((irqs & -irqs) * 0x077CB531) >> 27];
+  }
+
+  static u32 lineOf(u16 irq) {
+    u32 line = 0;
+    while (line < LINES - 1 && !((irq >> line) & 1))
+      line++;
+    return line;
+  }
+};
+
+#ifndef LINK_HOST
+inline IRQ::State _irqState;
+
+inline IRQ::State& IRQ::_state() {
+  return _irqState;
+}
+
+inline void IRQ::install(UserHandler userHandler) {
+  _REG_IME = 0;
+  State& state = _state();
+  state.userHandler = userHandler;
+  state.isInstalled = true;
+  for (u32 i = 0; i < LINES; i++) {
+    if (state.entries[i].handler)
+      _REG_IE |= 1 << i;
+  }
+  _REG_ISR_MAIN = &_onIRQ;
+  _REG_IME = 1;
+}
+
+inline void IRQ::uninstall() {
+  _REG_IME = 0;
+  _state().isInstalled = false;
+  _REG_ISR_MAIN = nullptr;
+}
+#else
+namespace Host {
+inline IRQ::State& _irqState();
+inline void _setMasterISR(void (*isr)());
+}  // namespace Host
+
+inline IRQ::State& IRQ::_state() {
+  return Host::_irqState();
+}
+
+inline void IRQ::install(UserHandler userHandler) {
+  State& state = _state();
+  state.userHandler = userHandler;
+  state.isInstalled = true;
+  for (u32 i = 0; i < LINES; i++) {
+    if (state.entries[i].handler)
+      _REG_IE |= 1 << i;
+  }
+  Host::_setMasterISR(&_onIRQ);
+}
+
+inline void IRQ::uninstall() {
+  _state().isInstalled = false;
+  Host::_setMasterISR(nullptr);
+}
+#endif
+
+inline bool IRQ::isInstalled() {
+  return _state().isInstalled;
+}
+
+inline bool IRQ::set(u16 irq, void* driver, Handler handler) {
+  Entry& entry = _state().entries[lineOf(irq)];
+  if (entry.handler && entry.driver != driver)
+    return false;
+
+  u16 ime = _REG_IME;
+  _REG_IME = 0;
+  entry.handler = handler;
+  entry.driver = driver;
+  if (isInstalled())
+    _REG_IE |= irq;
+  _REG_IME = ime;
+  return true;
+}
+
+inline void IRQ::unset(u16 irq, void* driver) {
+  Entry& entry = _state().entries[lineOf(irq)];
+  if (entry.driver != driver)
+    return;
+
+  u16 ime = _REG_IME;
+  _REG_IME = 0;
+  entry.handler = nullptr;
+  entry.driver = nullptr;
+  _REG_IME = ime;
+}
+
+inline void IRQ::unsetAll(void* driver) {
+  for (u32 i = 0; i < LINES; i++)
+    unset(1 << i, driver);
+}
+
+#define LINK_IRQ_SET(IRQ_FLAG, TYPE, METHOD) \
+  Link::IRQ::set(IRQ_FLAG, this,              \
+                 [](void* driver) { static_cast<TYPE*>(driver)->METHOD(); })
+
+// Adaptive interval
+
+/**
+ * @brief A closed-loop controller for send timer intervals, updated once per
+ * frame (from the VBLANK handler). It lowers the interval (faster transfers)
+ * when the outgoing queue backs up, and raises it (less CPU) when the queue
+ * stays idle or when errors appear.
+ */
+class IntervalController {
+ public:
+  static constexpr u32 IDLE_FRAMES = 30;
+
+  /**
+   * @brief Starts from `interval`, bounded by `[minInterval;maxInterval]`.
+   */
+  void reset(u16 interval, u16 minInterval, u16 maxInterval) {
+    min = minInterval;
+    max = maxInterval > minInterval ? maxInterval : minInterval;
+    current = clamp(interval);
+    idleFrames = 0;
+  }
+
+  /**
+   * @brief Feeds one frame of data: the number of `pending` outgoing messages
+   * (out of `capacity`) and whether errors or timeouts happened. Returns
+   * `true` if the interval changed.
+   */
+  bool update(u32 pending, u32 capacity, bool hadErrors) {
+    u16 previous = current;
+
+    if (hadErrors) {
+      // multiplicative back-off
+      idleFrames = 0;
+      current = clamp(current * 2);
+    } else if (pending * 2 >= capacity) {
+      // backed up: transfer faster
+      idleFrames = 0;
+      current = clamp(current - current / 4 - 1);
+    } else if (pending == 0) {
+      // idle: slowly give the CPU back
+      if (++idleFrames >= IDLE_FRAMES) {
+        idleFrames = 0;
+        current = clamp(current + current / 8 + 1);
+      }
+    } else {
+      idleFrames = 0;
+    }
+
+    return current != previous;
+  }
+
+  /**
+   * @brief Returns the current interval.
+   */
+  [[nodiscard]] u16 interval() { return current; }
+
+ private:
+  u16 current = 0;
+  u16 min = 0;
+  u16 max = 0;
+  u32 idleFrames = 0;
+
+  u16 clamp(int interval) { return (u16)_max(min, _min(interval, max)); }
+};
+
 // Reset communication registers
 static inline void reset() {
   _REG_RCNT = 1 << 15;
@@ -409,6 +1419,7 @@ static inline u16 perFrame(u16 packets) {
 // mGBA Logging
 
 #if LINK_ENABLE_DEBUG_LOGS != 0
+#ifndef LINK_HOST
 inline vu16& _REG_LOG_ENABLE = *reinterpret_cast<vu16*>(0x4FFF780);
 inline vu16& _REG_LOG_LEVEL = *reinterpret_cast<vu16*>(0x4FFF700);
 
@@ -424,8 +1435,21 @@ static inline void log(const char* fmt, ...) {
 
   va_end(args);
 }
+#else
+static inline void log(const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vfprintf(stderr, fmt, args);
+  fputc('\n', stderr);
+  va_end(args);
+}
+#endif
 #endif
 
 }  // namespace Link
 
+#ifdef LINK_HOST
+#include "_link_host.hpp"
+#endif
+
 #endif  // LINK_COMMON_H
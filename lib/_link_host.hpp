@@ -0,0 +1,920 @@
+#ifndef LINK_HOST_H
+#define LINK_HOST_H
+
+// --------------------------------------------------------------------------
+// A simulated I/O backend to compile and run the libraries on a host PC.
+// --------------------------------------------------------------------------
+// Usage:
+// - 1) Compile your program for the host (e.g. x86 Linux) with:
+//       -std=c++17 -DLINK_HOST
+//      (every `Link::_REG_*` register will live in a simulated address space)
+// - 2) Register the interrupt service routines:
+//       Link::Host::setISR(Link::_IRQ_VBLANK, LINK_CABLE_ISR_VBLANK);
+//       Link::Host::setISR(Link::_IRQ_SERIAL, LINK_CABLE_ISR_SERIAL);
+//       Link::Host::setISR(Link::_IRQ_TIMER3, LINK_CABLE_ISR_TIMER);
+//      (or call `Link::IRQ::install()` after `activate()`, on each machine)
+// - 3) Use the library as usual, and advance the simulated clock:
+//       Link::Host::step(Link::Host::CYCLES_PER_FRAME);
+//       // (VCOUNT and timers are updated, and ISRs run synchronously)
+// - 4) Read the ISR profiling data:
+//       auto stats = Link::Host::machine()->isrStats(Link::_IRQ_SERIAL);
+//       // stats.calls, stats.totalCycles, stats.maxCycles
+// --------------------------------------------------------------------------
+// considerations:
+// - this header is included by `_link_common.hpp` when `LINK_HOST` is defined!
+// - ISRs take no simulated time; their cost is measured in *host* cycles.
+// - peripherals (link partners, adapters) are simulated by `Peripheral`s,
+//   which can inspect and mutate the registers on every step.
+// - busy-wait loops inside the libraries advance the clock (`LINK_BUSY_WAIT`).
+// - to simulate multiple GBAs, create one `Machine` per GBA and plug them
+//   into a `MultiPlayBus` (or a `NormalBus`, for 2 GBAs in Normal mode). Then,
+//   `install()` it and `step(...)` it instead.
+// - there's no BIOS: `_MultiBoot(...)` always fails.
+// --------------------------------------------------------------------------
+
+#ifndef LINK_DEVELOPMENT
+#pragma GCC system_header
+#endif
+
+#include <string.h>
+
+#if !defined(__x86_64__) && !defined(__i386__)
+#include <chrono>
+#endif
+
+namespace Link {
+
+/**
+ * @brief This namespace contains the host-side I/O backend.
+ */
+namespace Host {
+
+using u64 = unsigned long long;
+using ISR = void (*)();
+
+constexpr u32 CPU_FREQUENCY = 16777216;
+constexpr u32 CYCLES_PER_SCANLINE = 1232;
+constexpr u32 TOTAL_SCANLINES = 228;
+constexpr u32 VBLANK_SCANLINE = 160;
+constexpr u32 CYCLES_PER_FRAME = CYCLES_PER_SCANLINE * TOTAL_SCANLINES;
+constexpr u32 IDLE_CYCLES = 16;
+constexpr u32 IRQ_COUNT = 14;
+constexpr u32 TIMER_COUNT = 4;
+
+static constexpr u32 REG_VCOUNT = 0x0006;
+static constexpr u32 REG_TM = 0x0100;
+static constexpr u32 REG_KEYS = 0x0130;
+static constexpr u32 REG_IE = 0x0200;
+static constexpr u32 REG_IF = 0x0202;
+static constexpr u32 REG_IME = 0x0208;
+
+static constexpr u32 TIMER_PRESCALERS[] = {1, 64, 256, 1024};
+
+/**
+ * @brief Returns a monotonic host cycle counter (TSC on x86, nanoseconds
+ * elsewhere).
+ */
+static inline u64 hostCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __builtin_ia32_rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+class Machine;
+
+/**
+ * @brief A simulated device attached to one or more machines.
+ */
+class Peripheral {
+ public:
+  /**
+   * @brief Called after `machine` advanced `cycles` cycles, before dispatching
+   * its interrupts.
+   */
+  virtual void step(Machine& machine, u32 cycles) = 0;
+
+  virtual ~Peripheral() = default;
+};
+
+/**
+ * @brief A simulated GBA: an I/O register block, a clock and the IRQ lines.
+ */
+class Machine {
+ public:
+  struct ISRStats {
+    u32 calls = 0;
+    u64 totalCycles = 0;
+    u64 maxCycles = 0;
+  };
+
+  Machine() { reset(); }
+
+  /**
+   * @brief Clears the registers, the clock, the ISRs and the stats.
+   */
+  void reset() {
+    memset(io(), 0, _HOST_IO_SIZE);
+    reg16(REG_KEYS) = _KEY_ANY;
+    reg16(REG_IME) = 1;
+    clock = 0;
+    lineCycles = 0;
+    dispatchedIRQs = 0;
+    peripheral = nullptr;
+    masterISR = nullptr;
+    irqState = IRQ::State{};
+    for (u32 i = 0; i < IRQ_COUNT; i++) {
+      isrs[i] = nullptr;
+      stats[i] = ISRStats{};
+    }
+    for (u32 i = 0; i < TIMER_COUNT; i++)
+      timers[i] = TimerState{};
+  }
+
+  /**
+   * @brief Maps this machine's registers to the `Link::_REG_*` addresses.
+   * \warning Only one machine can be active at the same time.
+   */
+  void activate();
+
+  /**
+   * @brief Returns whether this machine's registers are currently mapped.
+   */
+  [[nodiscard]] bool isActive();
+
+  /**
+   * @brief Sets the `isr` for the `irq` flag (e.g. `Link::_IRQ_SERIAL`), and
+   * enables that interrupt in `REG_IE`. Pass `nullptr` to disable it.
+   */
+  void setISR(u16 irq, ISR isr) {
+    u32 index = irqIndex(irq);
+    isrs[index] = isr;
+    if (isr)
+      reg16(REG_IE) |= irq;
+    else
+      reg16(REG_IE) &= ~irq;
+  }
+
+  /**
+   * @brief Sets a master ISR (like the GBA's `0x03007FFC`). When set, it's
+   * called instead of the per-irq ISRs, with the pending flags in `REG_IF`.
+   * Pass `nullptr` to go back to per-irq ISRs.
+   */
+  void setMasterISR(ISR isr) { masterISR = isr; }
+
+  /**
+   * @brief Attaches a `peripheral` (only one per machine).
+   */
+  void setPeripheral(Peripheral* peripheral) { this->peripheral = peripheral; }
+
+  /**
+   * @brief Flags the `irq` in `REG_IF`. It'll be dispatched on the next step if
+   * `REG_IE` and `REG_IME` allow it.
+   */
+  void raiseIRQ(u16 irq) { reg16(REG_IF) |= irq; }
+
+  /**
+   * @brief Advances the clock by `cycles` cycles, updating VCOUNT and the
+   * timers, stepping the peripheral, and dispatching the pending interrupts.
+   */
+  void step(u32 cycles) {
+    activate();
+
+    while (cycles > 0) {
+      u32 chunk = minCycles(cycles, CYCLES_PER_SCANLINE - lineCycles);
+      for (u32 i = 0; i < TIMER_COUNT; i++)
+        chunk = minCycles(chunk, cyclesUntilOverflow(i));
+
+      stepTimers(chunk);
+      stepVCount(chunk);
+      clock += chunk;
+      cycles -= chunk;
+
+      if (peripheral)
+        peripheral->step(*this, chunk);
+      dispatch();
+    }
+  }
+
+  /**
+   * @brief Runs the pending interrupts (if `REG_IME` allows it).
+   */
+  void dispatch() {
+    if (!reg16(REG_IME))
+      return;
+
+    u16 pending = reg16(REG_IE) & reg16(REG_IF);
+    if (masterISR) {
+      if (pending)
+        dispatchMaster(pending);
+      return;
+    }
+
+    for (u32 i = 0; i < IRQ_COUNT && pending; i++) {
+      u16 irq = 1 << i;
+      if (!(pending & irq))
+        continue;
+      pending &= ~irq;
+      reg16(REG_IF) &= ~irq;
+      if (!isrs[i])
+        continue;
+
+      reg16(REG_IME) = 0;
+      u64 start = hostCycles();
+      isrs[i]();
+      u64 elapsed = hostCycles() - start;
+      reg16(REG_IME) = 1;
+
+      stats[i].calls++;
+      stats[i].totalCycles += elapsed;
+      if (elapsed > stats[i].maxCycles)
+        stats[i].maxCycles = elapsed;
+      dispatchedIRQs |= irq;
+    }
+  }
+
+  /**
+   * @brief Returns the ISR profiling data for the `irq` flag.
+   */
+  [[nodiscard]] ISRStats isrStats(u16 irq) { return stats[irqIndex(irq)]; }
+
+  /**
+   * @brief Resets the ISR profiling data.
+   */
+  void resetStats() {
+    for (u32 i = 0; i < IRQ_COUNT; i++)
+      stats[i] = ISRStats{};
+  }
+
+  /**
+   * @brief Returns the number of elapsed cycles since the last `reset()`.
+   */
+  [[nodiscard]] u64 cycles() { return clock; }
+
+  /**
+   * @brief Returns the number of elapsed frames since the last `reset()`.
+   */
+  [[nodiscard]] u64 frames() { return clock / CYCLES_PER_FRAME; }
+
+  /**
+   * @brief Returns a 16-bit register of this machine, even if it's not active.
+   * @param offset The offset from `0x04000000`.
+   */
+  [[nodiscard]] vu16& reg16(u32 offset) {
+    return *reinterpret_cast<vu16*>(io() + offset);
+  }
+
+  /**
+   * @brief Returns a 32-bit register of this machine, even if it's not active.
+   * @param offset The offset from `0x04000000`.
+   */
+  [[nodiscard]] vu32& reg32(u32 offset) {
+    return *reinterpret_cast<vu32*>(io() + offset);
+  }
+
+  /**
+   * @brief Returns the flags of the interrupts dispatched since the last call.
+   * \warning This is internal API!
+   */
+  [[nodiscard]] u16 _takeDispatchedIRQs() {
+    u16 irqs = dispatchedIRQs;
+    dispatchedIRQs = 0;
+    return irqs;
+  }
+
+  /**
+   * @brief The `Link::IRQ` table of this machine.
+   * \warning This is internal API!
+   */
+  IRQ::State irqState;
+
+ private:
+  struct TimerState {
+    u32 counter = 0;
+    u32 reload = 0;
+    u32 prescalerCycles = 0;
+    u16 lastWritten = 0;
+    bool wasEnabled = false;
+  };
+
+  alignas(4) u8 ioBackup[_HOST_IO_SIZE];
+  ISR isrs[IRQ_COUNT];
+  ISR masterISR = nullptr;
+  ISRStats stats[IRQ_COUNT];
+  TimerState timers[TIMER_COUNT];
+  Peripheral* peripheral = nullptr;
+  u64 clock = 0;
+  u32 lineCycles = 0;
+  u16 dispatchedIRQs = 0;
+
+  u8* io();
+
+  u32 minCycles(u32 a, u32 b) { return a < b ? a : b; }
+
+  void dispatchMaster(u16 pending) {
+    reg16(REG_IME) = 0;
+    u64 start = hostCycles();
+    masterISR();
+    u64 elapsed = hostCycles() - start;
+    reg16(REG_IF) &= ~pending;
+    reg16(REG_IME) = 1;
+
+    for (u32 i = 0; i < IRQ_COUNT; i++) {
+      if (!(pending & (1 << i)))
+        continue;
+      stats[i].calls++;
+      stats[i].totalCycles += elapsed;
+      if (elapsed > stats[i].maxCycles)
+        stats[i].maxCycles = elapsed;
+    }
+    dispatchedIRQs |= pending;
+  }
+
+  u32 irqIndex(u16 irq) {
+    u32 index = 0;
+    while (index < IRQ_COUNT - 1 && !((irq >> index) & 1))
+      index++;
+    return index;
+  }
+
+  vu16& timerCount(u32 i) { return reg16(REG_TM + i * 4); }
+  vu16& timerControl(u32 i) { return reg16(REG_TM + i * 4 + 2); }
+
+  bool isTimerRunning(u32 i) { return timerControl(i) & _TM_ENABLE; }
+  bool isTimerCascade(u32 i) { return i > 0 && (timerControl(i) & _TM_CASCADE); }
+
+  void syncTimer(u32 i) {
+    auto& timer = timers[i];
+    bool isEnabled = isTimerRunning(i);
+
+    // (the reload value and the counter share the same address, so user
+    // writes are detected by comparing against the last simulated value)
+    if (isEnabled && (!timer.wasEnabled || timerCount(i) != timer.lastWritten)) {
+      timer.reload = timerCount(i);
+      timer.counter = timer.reload;
+      timer.prescalerCycles = 0;
+      timer.lastWritten = timer.counter;
+    }
+    timer.wasEnabled = isEnabled;
+  }
+
+  u32 cyclesUntilOverflow(u32 i) {
+    syncTimer(i);
+    if (!isTimerRunning(i) || isTimerCascade(i))
+      return 0xFFFFFFFF;
+
+    auto& timer = timers[i];
+    u32 prescaler = TIMER_PRESCALERS[timerControl(i) & 0b11];
+    return (0x10000 - timer.counter) * prescaler - timer.prescalerCycles;
+  }
+
+  void stepTimers(u32 cycles) {
+    for (u32 i = 0; i < TIMER_COUNT; i++) {
+      if (!isTimerRunning(i) || isTimerCascade(i))
+        continue;
+
+      auto& timer = timers[i];
+      u32 prescaler = TIMER_PRESCALERS[timerControl(i) & 0b11];
+      timer.prescalerCycles += cycles;
+      u32 ticks = timer.prescalerCycles / prescaler;
+      timer.prescalerCycles %= prescaler;
+      tickTimer(i, ticks);
+    }
+  }
+
+  void tickTimer(u32 i, u32 ticks) {
+    auto& timer = timers[i];
+    u32 overflows = 0;
+    timer.counter += ticks;
+    while (timer.counter > 0xFFFF) {
+      timer.counter = timer.counter - 0x10000 + timer.reload;
+      overflows++;
+    }
+    timerCount(i) = timer.lastWritten = timer.counter;
+
+    if (overflows == 0)
+      return;
+    if (timerControl(i) & _TM_IRQ)
+      raiseIRQ(_TIMER_IRQ_IDS[i]);
+    if (i + 1 < TIMER_COUNT && isTimerRunning(i + 1) && isTimerCascade(i + 1)) {
+      syncTimer(i + 1);
+      tickTimer(i + 1, overflows);
+    }
+  }
+
+  void stepVCount(u32 cycles) {
+    lineCycles += cycles;
+    if (lineCycles < CYCLES_PER_SCANLINE)
+      return;
+
+    lineCycles -= CYCLES_PER_SCANLINE;
+    u16 vCount = (reg16(REG_VCOUNT) + 1) % TOTAL_SCANLINES;
+    reg16(REG_VCOUNT) = vCount;
+    if (vCount == VBLANK_SCANLINE)
+      raiseIRQ(_IRQ_VBLANK);
+  }
+};
+
+inline Machine _defaultMachine;
+inline Machine* _activeMachine = &_defaultMachine;
+inline void (*_clockDriver)(u32 cycles) = nullptr;
+
+inline void Machine::activate() {
+  if (_activeMachine == this)
+    return;
+
+  memcpy(_activeMachine->ioBackup, _HOST_IO, _HOST_IO_SIZE);
+  memcpy(_HOST_IO, ioBackup, _HOST_IO_SIZE);
+  _activeMachine = this;
+}
+
+inline bool Machine::isActive() {
+  return _activeMachine == this;
+}
+
+inline u8* Machine::io() {
+  return isActive() ? _HOST_IO : ioBackup;
+}
+
+/**
+ * @brief Returns the active machine.
+ */
+static inline Machine* machine() {
+  return _activeMachine;
+}
+
+/**
+ * @brief Sets a function that advances the whole simulation (e.g. a bus with
+ * multiple machines). When set, `advance(...)` calls it instead of stepping
+ * only the active machine. It must leave the same machine active.
+ */
+static inline void setClockDriver(void (*driver)(u32 cycles)) {
+  _clockDriver = driver;
+}
+
+/**
+ * @brief Advances the simulation by `cycles` cycles.
+ */
+static inline void advance(u32 cycles) {
+  if (_clockDriver) {
+    Machine* current = _activeMachine;
+    _clockDriver(cycles);
+    current->activate();
+  } else {
+    _activeMachine->step(cycles);
+  }
+}
+
+/**
+ * @brief Advances the active machine by `cycles` cycles.
+ */
+static inline void step(u32 cycles) {
+  _activeMachine->step(cycles);
+}
+
+/**
+ * @brief Sets an ISR on the active machine.
+ */
+static inline void setISR(u16 irq, ISR isr) {
+  _activeMachine->setISR(irq, isr);
+}
+
+/**
+ * @brief Resets the active machine.
+ */
+static inline void reset() {
+  _activeMachine->reset();
+}
+
+inline void _idle() {
+  advance(IDLE_CYCLES);
+}
+
+inline IRQ::State& _irqState() {
+  return _activeMachine->irqState;
+}
+
+inline void _setMasterISR(void (*isr)()) {
+  _activeMachine->setMasterISR(isr);
+}
+
+inline void _intrWait(bool clearCurrent, u32 flags) {
+  Machine* current = _activeMachine;
+  if (clearCurrent)
+    (void)current->_takeDispatchedIRQs();
+
+  while (!(current->_takeDispatchedIRQs() & flags))
+    advance(IDLE_CYCLES);
+}
+
+inline int _multiBoot(const _MultiBootParam* param, u32 mbmode) {
+  (void)param;
+  (void)mbmode;
+  return 1;
+}
+
+inline u32 _statsCycles() {
+  return (u32)hostCycles();
+}
+
+/**
+ * @brief A Link Cable connecting 2-4 machines in Multi-Play mode. It steps all
+ * the machines in lockstep, and performs the transfers started by the master
+ * (slot `0`).
+ */
+class MultiPlayBus {
+ public:
+  static constexpr u32 MAX_NODES = 4;
+  static constexpr u32 BITS_PER_NODE = 18;  // (start + 16 data bits + stop)
+  static constexpr u32 DEFAULT_QUANTUM = 128;
+  static constexpr u32 BAUD_RATES[] = {9600, 38400, 57600, 115200};
+  static constexpr u16 DISCONNECTED = 0xFFFF;
+
+  /**
+   * @brief Number of cycles that every machine runs before the bus checks for
+   * new transfers. Lower values are more accurate but slower.
+   */
+  u32 quantum = DEFAULT_QUANTUM;
+
+  /**
+   * @brief If not `0`, every `faultInterval` transfers, one of the machines
+   * (round-robin) sees the transfer with its error bit set, like with a noisy
+   * cable. The other machines receive the data normally.
+   */
+  u32 faultInterval = 0;
+
+  /**
+   * @brief Plugs `machine` into slot `slot` (`0` = master).
+   */
+  void connect(u32 slot, Machine* machine) { nodes[slot] = machine; }
+
+  /**
+   * @brief Unplugs the machine at slot `slot`.
+   */
+  void disconnect(u32 slot) { nodes[slot] = nullptr; }
+
+  /**
+   * @brief Returns the machine at slot `slot`, or `nullptr`.
+   */
+  [[nodiscard]] Machine* node(u32 slot) { return nodes[slot]; }
+
+  /**
+   * @brief Makes `Link::Host::advance(...)` step the whole bus.
+   */
+  void install() {
+    _activeBus = this;
+    setClockDriver([](u32 cycles) { _activeBus->step(cycles); });
+  }
+
+  /**
+   * @brief Steps all the machines by `cycles` cycles.
+   */
+  void step(u32 cycles) {
+    while (cycles > 0) {
+      u32 chunk = cycles < quantum ? cycles : quantum;
+      if (isTransferring && remainingCycles < chunk)
+        chunk = remainingCycles;
+
+      for (u32 i = 0; i < MAX_NODES; i++) {
+        if (nodes[i])
+          nodes[i]->step(chunk);
+      }
+      clock += chunk;
+      cycles -= chunk;
+
+      update(chunk);
+    }
+  }
+
+  /**
+   * @brief Returns the number of elapsed cycles.
+   */
+  [[nodiscard]] u64 cycles() { return clock; }
+
+  /**
+   * @brief Returns the number of completed transfers.
+   */
+  [[nodiscard]] u32 transfers() { return completedTransfers; }
+
+  /**
+   * @brief Returns how many cycles a transfer takes at `baudRate` (`0~3`)
+   * with `nodeCount` connected machines.
+   */
+  [[nodiscard]] static u32 transferCycles(u32 baudRate, u32 nodeCount) {
+    return (u32)((u64)nodeCount * BITS_PER_NODE * CPU_FREQUENCY /
+                 BAUD_RATES[baudRate & 0b11]);
+  }
+
+ private:
+  static constexpr u32 REG_SIOMULTI = 0x0120;
+  static constexpr u32 REG_SIOCNT = 0x0128;
+  static constexpr u32 REG_SIOMLT_SEND = 0x012A;
+  static constexpr u32 REG_RCNT = 0x0134;
+  static constexpr u16 BIT_SLAVE = 1 << 2;
+  static constexpr u16 BIT_READY = 1 << 3;
+  static constexpr u16 BITS_PLAYER_ID = 0b11 << 4;
+  static constexpr u16 BIT_ERROR = 1 << 6;
+  static constexpr u16 BIT_START = 1 << 7;
+  static constexpr u16 BIT_IRQ = 1 << 14;
+
+  inline static MultiPlayBus* _activeBus = nullptr;
+
+  Machine* nodes[MAX_NODES] = {};
+  u16 outgoingData[MAX_NODES] = {};
+  u64 clock = 0;
+  u32 remainingCycles = 0;
+  u32 completedTransfers = 0;
+  u32 faults = 0;
+  bool isTransferring = false;
+
+  bool isMultiPlayMode(Machine* machine) {
+    return !(machine->reg16(REG_RCNT) & (1 << 15)) &&
+           (machine->reg16(REG_SIOCNT) & 0x3000) == 0x2000;
+  }
+
+  bool allReady() {
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      if (nodes[i] && !isMultiPlayMode(nodes[i]))
+        return false;
+    }
+    return true;
+  }
+
+  u32 nodeCount() {
+    u32 count = 0;
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      if (nodes[i])
+        count++;
+    }
+    return count;
+  }
+
+  void update(u32 elapsed) {
+    bool ready = allReady();
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      if (!nodes[i] || !isMultiPlayMode(nodes[i]))
+        continue;
+      vu16& siocnt = nodes[i]->reg16(REG_SIOCNT);
+      siocnt = (siocnt & ~(BIT_SLAVE | BIT_READY)) | (i > 0 ? BIT_SLAVE : 0) |
+               (ready ? BIT_READY : 0);
+    }
+
+    if (isTransferring) {
+      remainingCycles -= elapsed;
+      if (remainingCycles == 0)
+        finishTransfer();
+      return;
+    }
+
+    Machine* master = nodes[0];
+    if (!master || !isMultiPlayMode(master) ||
+        !(master->reg16(REG_SIOCNT) & BIT_START))
+      return;
+
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      if (nodes[i] && isMultiPlayMode(nodes[i]))
+        nodes[i]->reg16(REG_SIOCNT) |= BIT_START;
+    }
+    outgoingData[0] = master->reg16(REG_SIOMLT_SEND);
+    remainingCycles =
+        transferCycles(master->reg16(REG_SIOCNT) & 0b11, nodeCount());
+    isTransferring = true;
+  }
+
+  void finishTransfer() {
+    isTransferring = false;
+    completedTransfers++;
+
+    bool ready = allReady();
+    for (u32 i = 1; i < MAX_NODES; i++) {
+      outgoingData[i] = nodes[i] && isMultiPlayMode(nodes[i])
+                            ? nodes[i]->reg16(REG_SIOMLT_SEND)
+                            : DISCONNECTED;
+    }
+
+    int faultySlot = -1;
+    if (faultInterval > 0 && completedTransfers % faultInterval == 0)
+      faultySlot = faults++ % nodeCount();
+
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      Machine* machine = nodes[i];
+      if (!machine || !isMultiPlayMode(machine))
+        continue;
+
+      for (u32 j = 0; j < MAX_NODES; j++)
+        machine->reg16(REG_SIOMULTI + j * 2) = outgoingData[j];
+      vu16& siocnt = machine->reg16(REG_SIOCNT);
+      siocnt = (siocnt & ~(BIT_START | BIT_ERROR | BITS_PLAYER_ID)) | (i << 4) |
+               (ready && (int)i != faultySlot ? 0 : BIT_ERROR);
+      if (siocnt & BIT_IRQ)
+        machine->raiseIRQ(_IRQ_SERIAL);
+    }
+  }
+};
+
+/**
+ * @brief A GBC Link Cable connecting 2 machines in Normal mode (SPI). The
+ * cable crosses the lines, so each machine's `SI` is the other one's `SO`. The
+ * machine with the internal clock (the master) starts the transfers, and the
+ * other one (the slave) takes part only if its start bit is set.
+ */
+class NormalBus {
+ public:
+  static constexpr u32 MAX_NODES = 2;
+  static constexpr u32 DEFAULT_QUANTUM = 64;
+  static constexpr u32 CYCLES_PER_BIT_256KBPS = 64;
+  static constexpr u32 CYCLES_PER_BIT_2MBPS = 8;
+
+  /**
+   * @brief Number of cycles that every machine runs before the bus checks for
+   * new transfers. Lower values are more accurate but slower.
+   */
+  u32 quantum = DEFAULT_QUANTUM;
+
+  /**
+   * @brief Plugs `machine` into slot `slot` (`0~1`).
+   */
+  void connect(u32 slot, Machine* machine) { nodes[slot] = machine; }
+
+  /**
+   * @brief Unplugs the machine at slot `slot`.
+   */
+  void disconnect(u32 slot) { nodes[slot] = nullptr; }
+
+  /**
+   * @brief Returns the machine at slot `slot`, or `nullptr`.
+   */
+  [[nodiscard]] Machine* node(u32 slot) { return nodes[slot]; }
+
+  /**
+   * @brief Makes `Link::Host::advance(...)` step the whole bus.
+   */
+  void install() {
+    _activeBus = this;
+    setClockDriver([](u32 cycles) { _activeBus->step(cycles); });
+  }
+
+  /**
+   * @brief Steps both machines by `cycles` cycles.
+   */
+  void step(u32 cycles) {
+    while (cycles > 0) {
+      u32 chunk = cycles < quantum ? cycles : quantum;
+      if (isTransferring && remainingCycles < chunk)
+        chunk = remainingCycles;
+
+      for (u32 i = 0; i < MAX_NODES; i++) {
+        if (nodes[i])
+          nodes[i]->step(chunk);
+      }
+      clock += chunk;
+      cycles -= chunk;
+
+      update(chunk);
+    }
+  }
+
+  /**
+   * @brief Returns the number of elapsed cycles.
+   */
+  [[nodiscard]] u64 cycles() { return clock; }
+
+  /**
+   * @brief Returns the number of completed transfers.
+   */
+  [[nodiscard]] u32 transfers() { return completedTransfers; }
+
+  /**
+   * @brief Returns how many cycles a transfer takes.
+   */
+  [[nodiscard]] static u32 transferCycles(bool is2Mbps, bool is32Bit) {
+    return (is32Bit ? 32 : 8) *
+           (is2Mbps ? CYCLES_PER_BIT_2MBPS : CYCLES_PER_BIT_256KBPS);
+  }
+
+ private:
+  static constexpr u32 REG_SIODATA32 = 0x0120;
+  static constexpr u32 REG_SIOCNT = 0x0128;
+  static constexpr u32 REG_SIODATA8 = 0x012A;
+  static constexpr u32 REG_RCNT = 0x0134;
+  static constexpr u16 BIT_CLOCK = 1 << 0;
+  static constexpr u16 BIT_CLOCK_SPEED = 1 << 1;
+  static constexpr u16 BIT_SI = 1 << 2;
+  static constexpr u16 BIT_SO = 1 << 3;
+  static constexpr u16 BIT_START = 1 << 7;
+  static constexpr u16 BIT_LENGTH = 1 << 12;
+  static constexpr u16 BIT_IRQ = 1 << 14;
+
+  inline static NormalBus* _activeBus = nullptr;
+
+  Machine* nodes[MAX_NODES] = {};
+  u32 outgoingData[MAX_NODES] = {};
+  bool isParticipating[MAX_NODES] = {};
+  u64 clock = 0;
+  u32 remainingCycles = 0;
+  u32 completedTransfers = 0;
+  bool is32Bit = true;
+  bool isTransferring = false;
+
+  bool isNormalMode(Machine* machine) {
+    return machine && !(machine->reg16(REG_RCNT) & (1 << 15)) &&
+           !(machine->reg16(REG_SIOCNT) & (1 << 13));
+  }
+
+  bool isMaster(Machine* machine) {
+    return machine->reg16(REG_SIOCNT) & BIT_CLOCK;
+  }
+
+  bool isStarted(Machine* machine) {
+    return machine->reg16(REG_SIOCNT) & BIT_START;
+  }
+
+  u32 readData(Machine* machine) {
+    return is32Bit ? machine->reg32(REG_SIODATA32)
+                   : machine->reg16(REG_SIODATA8) & 0xFF;
+  }
+
+  void writeData(Machine* machine, u32 data) {
+    if (is32Bit)
+      machine->reg32(REG_SIODATA32) = data;
+    else
+      machine->reg16(REG_SIODATA8) = data & 0xFF;
+  }
+
+  void update(u32 elapsed) {
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      if (!isNormalMode(nodes[i]))
+        continue;
+      // (the other end's SO, or HIGH if nothing drives the line)
+      Machine* other = nodes[!i];
+      bool isSIHigh = !isNormalMode(other) ||
+                      (other->reg16(REG_SIOCNT) & BIT_SO);
+      vu16& siocnt = nodes[i]->reg16(REG_SIOCNT);
+      siocnt = (siocnt & ~BIT_SI) | (isSIHigh ? BIT_SI : 0);
+    }
+
+    if (isTransferring) {
+      remainingCycles -= elapsed;
+      if (remainingCycles == 0)
+        finishTransfer();
+      return;
+    }
+
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      Machine* master = nodes[i];
+      if (isNormalMode(master) && isMaster(master) && isStarted(master)) {
+        startTransfer(i);
+        return;
+      }
+    }
+  }
+
+  void startTransfer(u32 slot) {
+    Machine* master = nodes[slot];
+    Machine* slave = nodes[!slot];
+    u16 siocnt = master->reg16(REG_SIOCNT);
+
+    is32Bit = siocnt & BIT_LENGTH;
+    isParticipating[slot] = true;
+    isParticipating[!slot] =
+        isNormalMode(slave) && !isMaster(slave) && isStarted(slave);
+
+    outgoingData[slot] = readData(master);
+    if (isParticipating[!slot])
+      outgoingData[!slot] = readData(slave);
+    else
+      outgoingData[!slot] = isNormalMode(slave) && !isMaster(slave) &&
+                                    !(slave->reg16(REG_SIOCNT) & BIT_SO)
+                                ? 0
+                                : 0xFFFFFFFF;
+
+    remainingCycles = transferCycles(siocnt & BIT_CLOCK_SPEED, is32Bit);
+    isTransferring = true;
+  }
+
+  void finishTransfer() {
+    isTransferring = false;
+    completedTransfers++;
+
+    for (u32 i = 0; i < MAX_NODES; i++) {
+      Machine* machine = nodes[i];
+      if (!isParticipating[i] || !isNormalMode(machine))
+        continue;
+
+      writeData(machine, outgoingData[!i]);
+      vu16& siocnt = machine->reg16(REG_SIOCNT);
+      siocnt &= ~BIT_START;
+      if (siocnt & BIT_IRQ)
+        machine->raiseIRQ(_IRQ_SERIAL);
+    }
+  }
+};
+
+}  // namespace Host
+
+}  // namespace Link
+
+#endif  // LINK_HOST_H
@@ -68,6 +68,14 @@ u16 C_LinkCable_peek(C_LinkCableHandle handle, u8 playerId) {
   return static_cast<LinkCable*>(handle)->peek(playerId);
 }
 
+bool C_LinkCable_canReadUrgent(C_LinkCableHandle handle, u8 playerId) {
+  return static_cast<LinkCable*>(handle)->canReadUrgent(playerId);
+}
+
+u16 C_LinkCable_readUrgent(C_LinkCableHandle handle, u8 playerId) {
+  return static_cast<LinkCable*>(handle)->readUrgent(playerId);
+}
+
 bool C_LinkCable_canSend(C_LinkCableHandle handle) {
   return static_cast<LinkCable*>(handle)->canSend();
 }
@@ -76,6 +84,27 @@ bool C_LinkCable_send(C_LinkCableHandle handle, u16 data) {
   return static_cast<LinkCable*>(handle)->send(data);
 }
 
+bool C_LinkCable_canSendUrgent(C_LinkCableHandle handle) {
+  return static_cast<LinkCable*>(handle)->canSendUrgent();
+}
+
+bool C_LinkCable_sendUrgent(C_LinkCableHandle handle, u16 data) {
+  return static_cast<LinkCable*>(handle)->sendUrgent(data);
+}
+
+bool C_LinkCable_sendPacket(C_LinkCableHandle handle,
+                            const u8* data,
+                            u32 length) {
+  return static_cast<LinkCable*>(handle)->sendPacket(data, length);
+}
+
+u32 C_LinkCable_receivePacket(C_LinkCableHandle handle,
+                              u8 playerId,
+                              u8* buffer,
+                              u32 size) {
+  return static_cast<LinkCable*>(handle)->receivePacket(playerId, buffer, size);
+}
+
 bool C_LinkCable_didQueueOverflow(C_LinkCableHandle handle, bool clear) {
   return static_cast<LinkCable*>(handle)->didQueueOverflow(clear);
 }
@@ -88,6 +117,10 @@ void C_LinkCable_resetTimer(C_LinkCableHandle handle) {
   static_cast<LinkCable*>(handle)->resetTimer();
 }
 
+u16 C_LinkCable_getInterval(C_LinkCableHandle handle) {
+  return static_cast<LinkCable*>(handle)->getInterval();
+}
+
 C_LinkCable_Config C_LinkCable_getConfig(C_LinkCableHandle handle) {
   C_LinkCable_Config config;
   auto instance = static_cast<LinkCable*>(handle);
@@ -96,6 +129,13 @@ C_LinkCable_Config C_LinkCable_getConfig(C_LinkCableHandle handle) {
   config.timeout = instance->config.timeout;
   config.interval = instance->config.interval;
   config.sendTimerId = instance->config.sendTimerId;
+  config.reliable = instance->config.reliable;
+  config.adaptiveInterval = instance->config.adaptiveInterval;
+  config.minInterval = instance->config.minInterval;
+  config.maxInterval = instance->config.maxInterval;
+  config.burstSize = instance->config.burstSize;
+  config.onReceive = instance->config.onReceive;
+  config.urgentWeight = instance->config.urgentWeight;
   return config;
 }
 
@@ -106,6 +146,17 @@ void C_LinkCable_setConfig(C_LinkCableHandle handle,
   instance->config.timeout = config.timeout;
   instance->config.interval = config.interval;
   instance->config.sendTimerId = config.sendTimerId;
+  instance->config.reliable = config.reliable;
+  instance->config.adaptiveInterval = config.adaptiveInterval;
+  instance->config.minInterval = config.minInterval;
+  instance->config.maxInterval = config.maxInterval;
+  instance->config.burstSize = config.burstSize;
+  instance->config.onReceive = config.onReceive;
+  instance->config.urgentWeight = config.urgentWeight;
+}
+
+C_Link_Stats C_LinkCable_getStats(C_LinkCableHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkCable*>(handle)->getStats(clear));
 }
 
 void C_LinkCable_onVBlank(C_LinkCableHandle handle) {
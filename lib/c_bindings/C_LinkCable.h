@@ -6,8 +6,10 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkCableHandle;
+typedef void (*C_LinkCable_ReceiveCallback)(u8 playerId, u16 data);
 
 #define C_LINK_CABLE_MAX_PLAYERS 4
 #define C_LINK_CABLE_DEFAULT_TIMEOUT 3
@@ -28,6 +30,13 @@ typedef struct {
   u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
   u16 interval;  // can be changed in realtime, but call `resetTimer()`
   u8 sendTimerId;
+  bool reliable;
+  bool adaptiveInterval;
+  u16 minInterval;
+  u16 maxInterval;
+  u8 burstSize;
+  C_LinkCable_ReceiveCallback onReceive;  // (if set, messages skip the queues)
+  u8 urgentWeight;  // urgent msgs per bulk msg when both wait (0 = strict)
 } C_LinkCable_Config;
 
 C_LinkCableHandle C_LinkCable_createDefault();
@@ -54,18 +63,32 @@ bool C_LinkCable_waitForWithCancel(C_LinkCableHandle handle,
 bool C_LinkCable_canRead(C_LinkCableHandle handle, u8 playerId);
 u16 C_LinkCable_read(C_LinkCableHandle handle, u8 playerId);
 u16 C_LinkCable_peek(C_LinkCableHandle handle, u8 playerId);
+bool C_LinkCable_canReadUrgent(C_LinkCableHandle handle, u8 playerId);
+u16 C_LinkCable_readUrgent(C_LinkCableHandle handle, u8 playerId);
 
 bool C_LinkCable_canSend(C_LinkCableHandle handle);
 bool C_LinkCable_send(C_LinkCableHandle handle, u16 data);
+bool C_LinkCable_canSendUrgent(C_LinkCableHandle handle);
+bool C_LinkCable_sendUrgent(C_LinkCableHandle handle, u16 data);
+bool C_LinkCable_sendPacket(C_LinkCableHandle handle,
+                            const u8* data,
+                            u32 length);
+u32 C_LinkCable_receivePacket(C_LinkCableHandle handle,
+                              u8 playerId,
+                              u8* buffer,
+                              u32 size);
 
 bool C_LinkCable_didQueueOverflow(C_LinkCableHandle handle, bool clear);
 
 void C_LinkCable_resetTimeout(C_LinkCableHandle handle);
 void C_LinkCable_resetTimer(C_LinkCableHandle handle);
+u16 C_LinkCable_getInterval(C_LinkCableHandle handle);
 
 C_LinkCable_Config C_LinkCable_getConfig(C_LinkCableHandle handle);
 void C_LinkCable_setConfig(C_LinkCableHandle handle, C_LinkCable_Config config);
 
+C_Link_Stats C_LinkCable_getStats(C_LinkCableHandle handle, bool clear);
+
 void C_LinkCable_onVBlank(C_LinkCableHandle handle);
 void C_LinkCable_onSerial(C_LinkCableHandle handle);
 void C_LinkCable_onTimer(C_LinkCableHandle handle);
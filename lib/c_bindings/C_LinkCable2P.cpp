@@ -0,0 +1,127 @@
+#include "C_LinkCable2P.h"
+#include "../LinkCable2P.hpp"
+
+extern "C" {
+C_LinkCable2PHandle C_LinkCable2P_createDefault() {
+  return new LinkCable2P();
+}
+
+C_LinkCable2PHandle C_LinkCable2P_create(C_LinkCable2P_Speed speed,
+                                         u32 timeout,
+                                         u16 interval,
+                                         u8 sendTimerId) {
+  return new LinkCable2P(static_cast<LinkCable2P::Speed>(speed), timeout,
+                         interval, sendTimerId);
+}
+
+void C_LinkCable2P_destroy(C_LinkCable2PHandle handle) {
+  delete static_cast<LinkCable2P*>(handle);
+}
+
+bool C_LinkCable2P_isActive(C_LinkCable2PHandle handle) {
+  return static_cast<LinkCable2P*>(handle)->isActive();
+}
+
+void C_LinkCable2P_activate(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->activate();
+}
+
+void C_LinkCable2P_deactivate(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->deactivate();
+}
+
+bool C_LinkCable2P_isConnected(C_LinkCable2PHandle handle) {
+  return static_cast<LinkCable2P*>(handle)->isConnected();
+}
+
+u8 C_LinkCable2P_playerCount(C_LinkCable2PHandle handle) {
+  return static_cast<LinkCable2P*>(handle)->playerCount();
+}
+
+u8 C_LinkCable2P_currentPlayerId(C_LinkCable2PHandle handle) {
+  return static_cast<LinkCable2P*>(handle)->currentPlayerId();
+}
+
+void C_LinkCable2P_sync(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->sync();
+}
+
+bool C_LinkCable2P_waitFor(C_LinkCable2PHandle handle, u8 playerId) {
+  return static_cast<LinkCable2P*>(handle)->waitFor(playerId);
+}
+
+bool C_LinkCable2P_waitForWithCancel(C_LinkCable2PHandle handle,
+                                     u8 playerId,
+                                     bool (*cancel)()) {
+  return static_cast<LinkCable2P*>(handle)->waitFor(playerId, cancel);
+}
+
+bool C_LinkCable2P_canRead(C_LinkCable2PHandle handle, u8 playerId) {
+  return static_cast<LinkCable2P*>(handle)->canRead(playerId);
+}
+
+u16 C_LinkCable2P_read(C_LinkCable2PHandle handle, u8 playerId) {
+  return static_cast<LinkCable2P*>(handle)->read(playerId);
+}
+
+u16 C_LinkCable2P_peek(C_LinkCable2PHandle handle, u8 playerId) {
+  return static_cast<LinkCable2P*>(handle)->peek(playerId);
+}
+
+bool C_LinkCable2P_canSend(C_LinkCable2PHandle handle) {
+  return static_cast<LinkCable2P*>(handle)->canSend();
+}
+
+bool C_LinkCable2P_send(C_LinkCable2PHandle handle, u16 data) {
+  return static_cast<LinkCable2P*>(handle)->send(data);
+}
+
+bool C_LinkCable2P_didQueueOverflow(C_LinkCable2PHandle handle, bool clear) {
+  return static_cast<LinkCable2P*>(handle)->didQueueOverflow(clear);
+}
+
+void C_LinkCable2P_resetTimeout(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->resetTimeout();
+}
+
+void C_LinkCable2P_resetTimer(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->resetTimer();
+}
+
+C_LinkCable2P_Config C_LinkCable2P_getConfig(C_LinkCable2PHandle handle) {
+  C_LinkCable2P_Config config;
+  auto instance = static_cast<LinkCable2P*>(handle);
+  config.speed = static_cast<C_LinkCable2P_Speed>(instance->config.speed);
+  config.timeout = instance->config.timeout;
+  config.interval = instance->config.interval;
+  config.sendTimerId = instance->config.sendTimerId;
+  config.onReceive = instance->config.onReceive;
+  return config;
+}
+
+void C_LinkCable2P_setConfig(C_LinkCable2PHandle handle,
+                             C_LinkCable2P_Config config) {
+  auto instance = static_cast<LinkCable2P*>(handle);
+  instance->config.speed = static_cast<LinkCable2P::Speed>(config.speed);
+  instance->config.timeout = config.timeout;
+  instance->config.interval = config.interval;
+  instance->config.sendTimerId = config.sendTimerId;
+  instance->config.onReceive = config.onReceive;
+}
+
+C_Link_Stats C_LinkCable2P_getStats(C_LinkCable2PHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkCable2P*>(handle)->getStats(clear));
+}
+
+void C_LinkCable2P_onVBlank(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->_onVBlank();
+}
+
+void C_LinkCable2P_onSerial(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->_onSerial();
+}
+
+void C_LinkCable2P_onTimer(C_LinkCable2PHandle handle) {
+  static_cast<LinkCable2P*>(handle)->_onTimer();
+}
+}
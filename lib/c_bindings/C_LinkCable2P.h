@@ -0,0 +1,95 @@
+#ifndef C_BINDINGS_LINK_CABLE_2P_H
+#define C_BINDINGS_LINK_CABLE_2P_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tonc_core.h>
+#include "C_LinkStats.h"
+
+typedef void* C_LinkCable2PHandle;
+typedef void (*C_LinkCable2P_ReceiveCallback)(u8 playerId, u16 data);
+
+#define C_LINK_CABLE_2P_PLAYERS 2
+#define C_LINK_CABLE_2P_DEFAULT_TIMEOUT 3
+#define C_LINK_CABLE_2P_DEFAULT_INTERVAL 10
+#define C_LINK_CABLE_2P_DEFAULT_SEND_TIMER_ID 3
+#define C_LINK_CABLE_2P_DISCONNECTED 0xFFFF
+#define C_LINK_CABLE_2P_NO_DATA 0x0
+
+typedef enum {
+  C_LINK_CABLE_2P_SPEED_256KBPS,
+  C_LINK_CABLE_2P_SPEED_2MBPS
+} C_LinkCable2P_Speed;
+
+typedef struct {
+  C_LinkCable2P_Speed speed;
+  u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
+  u16 interval;  // can be changed in realtime, but call `resetTimer()`
+  u8 sendTimerId;
+  C_LinkCable2P_ReceiveCallback onReceive;  // (if set, messages skip the queue)
+} C_LinkCable2P_Config;
+
+C_LinkCable2PHandle C_LinkCable2P_createDefault();
+C_LinkCable2PHandle C_LinkCable2P_create(C_LinkCable2P_Speed speed,
+                                         u32 timeout,
+                                         u16 interval,
+                                         u8 sendTimerId);
+void C_LinkCable2P_destroy(C_LinkCable2PHandle handle);
+
+bool C_LinkCable2P_isActive(C_LinkCable2PHandle handle);
+void C_LinkCable2P_activate(C_LinkCable2PHandle handle);
+void C_LinkCable2P_deactivate(C_LinkCable2PHandle handle);
+
+bool C_LinkCable2P_isConnected(C_LinkCable2PHandle handle);
+u8 C_LinkCable2P_playerCount(C_LinkCable2PHandle handle);
+u8 C_LinkCable2P_currentPlayerId(C_LinkCable2PHandle handle);
+
+void C_LinkCable2P_sync(C_LinkCable2PHandle handle);
+bool C_LinkCable2P_waitFor(C_LinkCable2PHandle handle, u8 playerId);
+bool C_LinkCable2P_waitForWithCancel(C_LinkCable2PHandle handle,
+                                     u8 playerId,
+                                     bool (*cancel)());
+
+bool C_LinkCable2P_canRead(C_LinkCable2PHandle handle, u8 playerId);
+u16 C_LinkCable2P_read(C_LinkCable2PHandle handle, u8 playerId);
+u16 C_LinkCable2P_peek(C_LinkCable2PHandle handle, u8 playerId);
+
+bool C_LinkCable2P_canSend(C_LinkCable2PHandle handle);
+bool C_LinkCable2P_send(C_LinkCable2PHandle handle, u16 data);
+
+bool C_LinkCable2P_didQueueOverflow(C_LinkCable2PHandle handle, bool clear);
+
+void C_LinkCable2P_resetTimeout(C_LinkCable2PHandle handle);
+void C_LinkCable2P_resetTimer(C_LinkCable2PHandle handle);
+
+C_LinkCable2P_Config C_LinkCable2P_getConfig(C_LinkCable2PHandle handle);
+void C_LinkCable2P_setConfig(C_LinkCable2PHandle handle,
+                             C_LinkCable2P_Config config);
+
+C_Link_Stats C_LinkCable2P_getStats(C_LinkCable2PHandle handle, bool clear);
+
+void C_LinkCable2P_onVBlank(C_LinkCable2PHandle handle);
+void C_LinkCable2P_onSerial(C_LinkCable2PHandle handle);
+void C_LinkCable2P_onTimer(C_LinkCable2PHandle handle);
+
+extern C_LinkCable2PHandle cLinkCable2P;
+
+inline void C_LINK_CABLE_2P_ISR_VBLANK() {
+  C_LinkCable2P_onVBlank(cLinkCable2P);
+}
+
+inline void C_LINK_CABLE_2P_ISR_SERIAL() {
+  C_LinkCable2P_onSerial(cLinkCable2P);
+}
+
+inline void C_LINK_CABLE_2P_ISR_TIMER() {
+  C_LinkCable2P_onTimer(cLinkCable2P);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // C_BINDINGS_LINK_CABLE_2P_H
@@ -0,0 +1,95 @@
+#include "C_LinkCodec.h"
+#include "../LinkCable.hpp"
+#include "../LinkCodec.hpp"
+#include "../LinkUniversal.hpp"
+#include "../LinkWireless.hpp"
+
+using Encoder = LinkCodec::Encoder<>;
+using Decoder = LinkCodec::Decoder<>;
+
+extern "C" {
+u32 C_LinkCodec_maxEncodedSize(u32 count) {
+  return LinkCodec::maxEncodedSize(count);
+}
+
+u32 C_LinkCodec_encode(const u16* messages, u32 count, u16* out) {
+  return LinkCodec::encode(messages, count, out);
+}
+
+C_LinkCodec_EncoderHandle C_LinkCodec_createEncoder() {
+  return new Encoder();
+}
+
+void C_LinkCodec_destroyEncoder(C_LinkCodec_EncoderHandle handle) {
+  delete static_cast<Encoder*>(handle);
+}
+
+bool C_LinkCodec_Encoder_send(C_LinkCodec_EncoderHandle handle,
+                              const u16* messages,
+                              u32 count) {
+  return static_cast<Encoder*>(handle)->send(messages, count);
+}
+
+u32 C_LinkCodec_Encoder_flushCable(C_LinkCodec_EncoderHandle handle,
+                                   C_LinkCableHandle linkCable) {
+  return static_cast<Encoder*>(handle)->flush(
+      static_cast<LinkCable*>(linkCable));
+}
+
+u32 C_LinkCodec_Encoder_flushWireless(C_LinkCodec_EncoderHandle handle,
+                                      C_LinkWirelessHandle linkWireless) {
+  return static_cast<Encoder*>(handle)->flush(
+      static_cast<LinkWireless*>(linkWireless));
+}
+
+u32 C_LinkCodec_Encoder_flushUniversal(C_LinkCodec_EncoderHandle handle,
+                                       C_LinkUniversalHandle linkUniversal) {
+  return static_cast<Encoder*>(handle)->flush(
+      static_cast<LinkUniversal*>(linkUniversal));
+}
+
+bool C_LinkCodec_Encoder_isEmpty(C_LinkCodec_EncoderHandle handle) {
+  return static_cast<Encoder*>(handle)->isEmpty();
+}
+
+void C_LinkCodec_Encoder_clear(C_LinkCodec_EncoderHandle handle) {
+  static_cast<Encoder*>(handle)->clear();
+}
+
+u32 C_LinkCodec_Encoder_getSentMessages(C_LinkCodec_EncoderHandle handle) {
+  return static_cast<Encoder*>(handle)->getSentMessages();
+}
+
+u32 C_LinkCodec_Encoder_getSentWords(C_LinkCodec_EncoderHandle handle) {
+  return static_cast<Encoder*>(handle)->getSentWords();
+}
+
+C_LinkCodec_DecoderHandle C_LinkCodec_createDecoder() {
+  return new Decoder();
+}
+
+void C_LinkCodec_destroyDecoder(C_LinkCodec_DecoderHandle handle) {
+  delete static_cast<Decoder*>(handle);
+}
+
+bool C_LinkCodec_Decoder_push(C_LinkCodec_DecoderHandle handle, u16 word) {
+  return static_cast<Decoder*>(handle)->push(word);
+}
+
+const u16* C_LinkCodec_Decoder_data(C_LinkCodec_DecoderHandle handle) {
+  return static_cast<Decoder*>(handle)->data();
+}
+
+u32 C_LinkCodec_Decoder_size(C_LinkCodec_DecoderHandle handle) {
+  return static_cast<Decoder*>(handle)->size();
+}
+
+bool C_LinkCodec_Decoder_didFail(C_LinkCodec_DecoderHandle handle,
+                                 bool clear) {
+  return static_cast<Decoder*>(handle)->didFail(clear);
+}
+
+void C_LinkCodec_Decoder_reset(C_LinkCodec_DecoderHandle handle) {
+  static_cast<Decoder*>(handle)->reset();
+}
+}
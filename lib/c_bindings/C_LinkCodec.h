@@ -0,0 +1,51 @@
+#ifndef C_BINDINGS_LINK_CODEC_H
+#define C_BINDINGS_LINK_CODEC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tonc_core.h>
+#include "C_LinkCable.h"
+#include "C_LinkUniversal.h"
+#include "C_LinkWireless.h"
+
+typedef void* C_LinkCodec_EncoderHandle;
+typedef void* C_LinkCodec_DecoderHandle;
+
+#define C_LINK_CODEC_MAX_BATCH 128
+
+u32 C_LinkCodec_maxEncodedSize(u32 count);
+u32 C_LinkCodec_encode(const u16* messages, u32 count, u16* out);
+
+C_LinkCodec_EncoderHandle C_LinkCodec_createEncoder();
+void C_LinkCodec_destroyEncoder(C_LinkCodec_EncoderHandle handle);
+
+bool C_LinkCodec_Encoder_send(C_LinkCodec_EncoderHandle handle,
+                              const u16* messages,
+                              u32 count);
+u32 C_LinkCodec_Encoder_flushCable(C_LinkCodec_EncoderHandle handle,
+                                   C_LinkCableHandle linkCable);
+u32 C_LinkCodec_Encoder_flushWireless(C_LinkCodec_EncoderHandle handle,
+                                      C_LinkWirelessHandle linkWireless);
+u32 C_LinkCodec_Encoder_flushUniversal(C_LinkCodec_EncoderHandle handle,
+                                       C_LinkUniversalHandle linkUniversal);
+bool C_LinkCodec_Encoder_isEmpty(C_LinkCodec_EncoderHandle handle);
+void C_LinkCodec_Encoder_clear(C_LinkCodec_EncoderHandle handle);
+u32 C_LinkCodec_Encoder_getSentMessages(C_LinkCodec_EncoderHandle handle);
+u32 C_LinkCodec_Encoder_getSentWords(C_LinkCodec_EncoderHandle handle);
+
+C_LinkCodec_DecoderHandle C_LinkCodec_createDecoder();
+void C_LinkCodec_destroyDecoder(C_LinkCodec_DecoderHandle handle);
+
+bool C_LinkCodec_Decoder_push(C_LinkCodec_DecoderHandle handle, u16 word);
+const u16* C_LinkCodec_Decoder_data(C_LinkCodec_DecoderHandle handle);
+u32 C_LinkCodec_Decoder_size(C_LinkCodec_DecoderHandle handle);
+bool C_LinkCodec_Decoder_didFail(C_LinkCodec_DecoderHandle handle, bool clear);
+void C_LinkCodec_Decoder_reset(C_LinkCodec_DecoderHandle handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // C_BINDINGS_LINK_CODEC_H
@@ -58,6 +58,10 @@ bool C_LinkCube_didReset(C_LinkCubeHandle handle, bool clear) {
   return static_cast<LinkCube*>(handle)->didReset(clear);
 }
 
+C_Link_Stats C_LinkCube_getStats(C_LinkCubeHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkCube*>(handle)->getStats(clear));
+}
+
 void C_LinkCube_onSerial(C_LinkCubeHandle handle) {
   static_cast<LinkCube*>(handle)->_onSerial();
 }
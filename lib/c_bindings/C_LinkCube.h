@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkCubeHandle;
 
@@ -29,6 +30,8 @@ u32 C_LinkCube_pendingCount(C_LinkCubeHandle handle);
 bool C_LinkCube_didQueueOverflow(C_LinkCubeHandle handle, bool clear);
 bool C_LinkCube_didReset(C_LinkCubeHandle handle, bool clear);
 
+C_Link_Stats C_LinkCube_getStats(C_LinkCubeHandle handle, bool clear);
+
 void C_LinkCube_onSerial(C_LinkCubeHandle handle);
 
 extern C_LinkCubeHandle cLinkCube;
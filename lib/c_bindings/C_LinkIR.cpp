@@ -88,6 +88,10 @@ void C_LinkIR_setConfig(C_LinkIRHandle handle, C_LinkIR_Config config) {
   instance->config.secondaryTimerId = config.secondaryTimerId;
 }
 
+C_Link_Stats C_LinkIR_getStats(C_LinkIRHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkIR*>(handle)->getStats(clear));
+}
+
 void C_LinkIR_onSerial(C_LinkIRHandle handle) {
   static_cast<LinkIR*>(handle)->_onSerial();
 }
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkIRHandle;
 
@@ -48,6 +49,8 @@ bool C_LinkIR_isDetectingLight(C_LinkIRHandle handle);
 C_LinkIR_Config C_LinkIR_getConfig(C_LinkIRHandle handle);
 void C_LinkIR_setConfig(C_LinkIRHandle handle, C_LinkIR_Config config);
 
+C_Link_Stats C_LinkIR_getStats(C_LinkIRHandle handle, bool clear);
+
 void C_LinkIR_onSerial(C_LinkIRHandle handle);
 
 extern C_LinkIRHandle cLinkIR;
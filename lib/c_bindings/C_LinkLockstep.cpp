@@ -0,0 +1,76 @@
+#include "C_LinkLockstep.h"
+#include "../LinkLockstep.hpp"
+
+extern "C" {
+C_LinkLockstepHandle C_LinkLockstep_createDefault(
+    C_LinkUniversalHandle linkUniversal) {
+  return new LinkLockstep(static_cast<LinkUniversal*>(linkUniversal));
+}
+
+C_LinkLockstepHandle C_LinkLockstep_create(C_LinkUniversalHandle linkUniversal,
+                                           u8 inputDelay) {
+  return new LinkLockstep(static_cast<LinkUniversal*>(linkUniversal),
+                          inputDelay);
+}
+
+void C_LinkLockstep_destroy(C_LinkLockstepHandle handle) {
+  delete static_cast<LinkLockstep*>(handle);
+}
+
+bool C_LinkLockstep_isActive(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->isActive();
+}
+
+bool C_LinkLockstep_activate(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->activate();
+}
+
+void C_LinkLockstep_deactivate(C_LinkLockstepHandle handle) {
+  static_cast<LinkLockstep*>(handle)->deactivate();
+}
+
+bool C_LinkLockstep_update(C_LinkLockstepHandle handle, u16 input) {
+  return static_cast<LinkLockstep*>(handle)->update(input);
+}
+
+u16 C_LinkLockstep_getInput(C_LinkLockstepHandle handle, u8 playerId) {
+  return static_cast<LinkLockstep*>(handle)->getInput(playerId);
+}
+
+u32 C_LinkLockstep_currentFrame(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->currentFrame();
+}
+
+u8 C_LinkLockstep_playerCount(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->playerCount();
+}
+
+u8 C_LinkLockstep_currentPlayerId(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->currentPlayerId();
+}
+
+u32 C_LinkLockstep_getStallCount(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->getStallCount();
+}
+
+u32 C_LinkLockstep_getLongestStall(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->getLongestStall();
+}
+
+bool C_LinkLockstep_didDesync(C_LinkLockstepHandle handle) {
+  return static_cast<LinkLockstep*>(handle)->didDesync();
+}
+
+C_LinkLockstep_Config C_LinkLockstep_getConfig(C_LinkLockstepHandle handle) {
+  C_LinkLockstep_Config config;
+  auto instance = static_cast<LinkLockstep*>(handle);
+  config.inputDelay = instance->config.inputDelay;
+  return config;
+}
+
+void C_LinkLockstep_setConfig(C_LinkLockstepHandle handle,
+                              C_LinkLockstep_Config config) {
+  auto instance = static_cast<LinkLockstep*>(handle);
+  instance->config.inputDelay = config.inputDelay;
+}
+}
@@ -0,0 +1,51 @@
+#ifndef C_BINDINGS_LINK_LOCKSTEP_H
+#define C_BINDINGS_LINK_LOCKSTEP_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tonc_core.h>
+#include "C_LinkUniversal.h"
+
+typedef void* C_LinkLockstepHandle;
+
+#define C_LINK_LOCKSTEP_DEFAULT_INPUT_DELAY 2
+#define C_LINK_LOCKSTEP_INPUT_MASK 0x3FF
+
+typedef struct {
+  u8 inputDelay;  // (call `activate()` again after changing it)
+} C_LinkLockstep_Config;
+
+C_LinkLockstepHandle C_LinkLockstep_createDefault(
+    C_LinkUniversalHandle linkUniversal);
+C_LinkLockstepHandle C_LinkLockstep_create(C_LinkUniversalHandle linkUniversal,
+                                           u8 inputDelay);
+void C_LinkLockstep_destroy(C_LinkLockstepHandle handle);
+
+bool C_LinkLockstep_isActive(C_LinkLockstepHandle handle);
+bool C_LinkLockstep_activate(C_LinkLockstepHandle handle);
+void C_LinkLockstep_deactivate(C_LinkLockstepHandle handle);
+
+bool C_LinkLockstep_update(C_LinkLockstepHandle handle, u16 input);
+u16 C_LinkLockstep_getInput(C_LinkLockstepHandle handle, u8 playerId);
+
+u32 C_LinkLockstep_currentFrame(C_LinkLockstepHandle handle);
+u8 C_LinkLockstep_playerCount(C_LinkLockstepHandle handle);
+u8 C_LinkLockstep_currentPlayerId(C_LinkLockstepHandle handle);
+
+u32 C_LinkLockstep_getStallCount(C_LinkLockstepHandle handle);
+u32 C_LinkLockstep_getLongestStall(C_LinkLockstepHandle handle);
+bool C_LinkLockstep_didDesync(C_LinkLockstepHandle handle);
+
+C_LinkLockstep_Config C_LinkLockstep_getConfig(C_LinkLockstepHandle handle);
+void C_LinkLockstep_setConfig(C_LinkLockstepHandle handle,
+                              C_LinkLockstep_Config config);
+
+extern C_LinkLockstepHandle cLinkLockstep;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // C_BINDINGS_LINK_LOCKSTEP_H
@@ -137,6 +137,10 @@ C_LinkMobile_Error C_LinkMobile_getError(C_LinkMobileHandle handle) {
           error.reqType};
 }
 
+C_Link_Stats C_LinkMobile_getStats(C_LinkMobileHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkMobile*>(handle)->getStats(clear));
+}
+
 void C_LinkMobile_onVBlank(C_LinkMobileHandle handle) {
   static_cast<LinkMobile*>(handle)->_onVBlank();
 }
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkMobileHandle;
 
@@ -187,6 +188,8 @@ bool C_LinkMobile_canShutdown(C_LinkMobileHandle handle);
 C_LinkMobile_DataSize C_LinkMobile_getDataSize(C_LinkMobileHandle handle);
 C_LinkMobile_Error C_LinkMobile_getError(C_LinkMobileHandle handle);
 
+C_Link_Stats C_LinkMobile_getStats(C_LinkMobileHandle handle, bool clear);
+
 void C_LinkMobile_onVBlank(C_LinkMobileHandle handle);
 void C_LinkMobile_onSerial(C_LinkMobileHandle handle);
 void C_LinkMobile_onTimer(C_LinkMobileHandle handle);
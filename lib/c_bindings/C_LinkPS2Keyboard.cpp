@@ -23,6 +23,10 @@ void C_LinkPS2Keyboard_deactivate(C_LinkPS2KeyboardHandle handle) {
   static_cast<LinkPS2Keyboard*>(handle)->deactivate();
 }
 
+C_Link_Stats C_LinkPS2Keyboard_getStats(C_LinkPS2KeyboardHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkPS2Keyboard*>(handle)->getStats(clear));
+}
+
 void C_LinkPS2Keyboard_onVBlank(C_LinkPS2KeyboardHandle handle) {
   static_cast<LinkPS2Keyboard*>(handle)->_onVBlank();
 }
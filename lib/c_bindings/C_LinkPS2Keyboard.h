@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkPS2KeyboardHandle;
 
@@ -19,6 +20,8 @@ bool C_LinkPS2Keyboard_isActive(C_LinkPS2KeyboardHandle handle);
 void C_LinkPS2Keyboard_activate(C_LinkPS2KeyboardHandle handle);
 void C_LinkPS2Keyboard_deactivate(C_LinkPS2KeyboardHandle handle);
 
+C_Link_Stats C_LinkPS2Keyboard_getStats(C_LinkPS2KeyboardHandle handle, bool clear);
+
 void C_LinkPS2Keyboard_onVBlank(C_LinkPS2KeyboardHandle handle);
 void C_LinkPS2Keyboard_onSerial(C_LinkPS2KeyboardHandle handle);
 
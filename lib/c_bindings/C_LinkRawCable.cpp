@@ -66,6 +66,34 @@ C_LinkRawCable_Response C_LinkRawCable_getAsyncData(
   return cResponse;
 }
 
+bool C_LinkRawCable_transferBlockAsync(
+    C_LinkRawCableHandle handle,
+    const u16* data,
+    C_LinkRawCable_Response* responses,
+    u32 count,
+    C_LinkRawCable_BlockCallback onComplete) {
+  // (both structs have the same layout)
+  static_assert(sizeof(C_LinkRawCable_Response) ==
+                sizeof(LinkRawCable::Response));
+  return static_cast<LinkRawCable*>(handle)->transferBlockAsync(
+      data, reinterpret_cast<LinkRawCable::Response*>(responses), count,
+      onComplete);
+}
+
+C_LinkRawCable_BlockState C_LinkRawCable_getBlockState(
+    C_LinkRawCableHandle handle) {
+  return static_cast<C_LinkRawCable_BlockState>(
+      static_cast<LinkRawCable*>(handle)->getBlockState());
+}
+
+u32 C_LinkRawCable_getBlockProgress(C_LinkRawCableHandle handle) {
+  return static_cast<LinkRawCable*>(handle)->getBlockProgress();
+}
+
+void C_LinkRawCable_cancelBlock(C_LinkRawCableHandle handle) {
+  static_cast<LinkRawCable*>(handle)->cancelBlock();
+}
+
 C_LinkRawCable_BaudRate C_LinkRawCable_getBaudRate(
     C_LinkRawCableHandle handle) {
   return static_cast<C_LinkRawCable_BaudRate>(
@@ -80,6 +108,10 @@ bool C_LinkRawCable_isReady(C_LinkRawCableHandle handle) {
   return static_cast<LinkRawCable*>(handle)->isReady();
 }
 
+C_Link_Stats C_LinkRawCable_getStats(C_LinkRawCableHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkRawCable*>(handle)->getStats(clear));
+}
+
 void C_LinkRawCable_onSerial(C_LinkRawCableHandle handle) {
   static_cast<LinkRawCable*>(handle)->_onSerial();
 }
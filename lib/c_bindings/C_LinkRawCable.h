@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkRawCableHandle;
 
@@ -25,6 +26,15 @@ typedef enum {
   C_LINK_RAW_CABLE_ASYNC_STATE_READY
 } C_LinkRawCable_AsyncState;
 
+typedef enum {
+  C_LINK_RAW_CABLE_BLOCK_STATE_IDLE,
+  C_LINK_RAW_CABLE_BLOCK_STATE_WAITING,
+  C_LINK_RAW_CABLE_BLOCK_STATE_DONE,
+  C_LINK_RAW_CABLE_BLOCK_STATE_FAILED
+} C_LinkRawCable_BlockState;
+
+typedef void (*C_LinkRawCable_BlockCallback)(bool success);
+
 typedef struct {
   u16 data[C_LINK_RAW_CABLE_MAX_PLAYERS];
   int playerId;
@@ -50,10 +60,23 @@ C_LinkRawCable_AsyncState C_LinkRawCable_getAsyncState(
     C_LinkRawCableHandle handle);
 C_LinkRawCable_Response C_LinkRawCable_getAsyncData(
     C_LinkRawCableHandle handle);
+
+bool C_LinkRawCable_transferBlockAsync(C_LinkRawCableHandle handle,
+                                       const u16* data,
+                                       C_LinkRawCable_Response* responses,
+                                       u32 count,
+                                       C_LinkRawCable_BlockCallback onComplete);
+C_LinkRawCable_BlockState C_LinkRawCable_getBlockState(
+    C_LinkRawCableHandle handle);
+u32 C_LinkRawCable_getBlockProgress(C_LinkRawCableHandle handle);
+void C_LinkRawCable_cancelBlock(C_LinkRawCableHandle handle);
+
 C_LinkRawCable_BaudRate C_LinkRawCable_getBaudRate(C_LinkRawCableHandle handle);
 bool C_LinkRawCable_isMaster(C_LinkRawCableHandle handle);
 bool C_LinkRawCable_isReady(C_LinkRawCableHandle handle);
 
+C_Link_Stats C_LinkRawCable_getStats(C_LinkRawCableHandle handle, bool clear);
+
 void C_LinkRawCable_onSerial(C_LinkRawCableHandle handle);
 
 extern C_LinkRawCableHandle cLinkRawCable;
@@ -7,6 +7,26 @@ C_LinkRawWireless_CommandResult fromCppResult(
 LinkRawWireless::CommandResult toCppResult(
     const C_LinkRawWireless_CommandResult* result);
 
+// (queued commands finish in order, so their C callbacks wait in a ring)
+static C_LinkRawWireless_CommandCallback
+    queuedCallbacks[LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE + 1];
+static u32 queuedCallbacksStart = 0;
+static u32 queuedCallbacksCount = 0;
+
+static void onQueuedCommandComplete(
+    const LinkRawWireless::CommandResult& cppResult) {
+  if (queuedCallbacksCount == 0)
+    return;
+
+  auto callback = queuedCallbacks[queuedCallbacksStart];
+  queuedCallbacksStart =
+      (queuedCallbacksStart + 1) % (LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE + 1);
+  queuedCallbacksCount--;
+
+  auto result = fromCppResult(cppResult);
+  callback(&result);
+}
+
 C_LinkRawWirelessHandle C_LinkRawWireless_create() {
   return new LinkRawWireless();
 }
@@ -23,6 +43,10 @@ bool C_LinkRawWireless_activate(C_LinkRawWirelessHandle handle) {
   return static_cast<LinkRawWireless*>(handle)->activate();
 }
 
+void C_LinkRawWireless_activateAsync(C_LinkRawWirelessHandle handle) {
+  static_cast<LinkRawWireless*>(handle)->activateAsync();
+}
+
 bool C_LinkRawWireless_restoreExistingConnection(
     C_LinkRawWirelessHandle handle) {
   return static_cast<LinkRawWireless*>(handle)->restoreExistingConnection();
@@ -292,6 +316,34 @@ bool C_LinkRawWireless_sendCommandAsync(C_LinkRawWirelessHandle handle,
       type, params, length, invertsClock);
 }
 
+bool C_LinkRawWireless_queueCommand(
+    C_LinkRawWirelessHandle handle,
+    u8 type,
+    const u32* params,
+    u32 length,
+    C_LinkRawWireless_CommandCallback onComplete) {
+  auto linkRawWireless = static_cast<LinkRawWireless*>(handle);
+  if (linkRawWireless->getQueuedCommands() == 0)
+    queuedCallbacksCount = 0;  // (resets drop the queue)
+  if (!onComplete)
+    return linkRawWireless->queueCommand(type, params, length);
+
+  u32 index = (queuedCallbacksStart + queuedCallbacksCount) %
+              (LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE + 1);
+  queuedCallbacks[index] = onComplete;
+  queuedCallbacksCount++;
+  if (!linkRawWireless->queueCommand(type, params, length,
+                                     onQueuedCommandComplete)) {
+    queuedCallbacksCount--;
+    return false;
+  }
+  return true;
+}
+
+u32 C_LinkRawWireless_getQueuedCommands(C_LinkRawWirelessHandle handle) {
+  return static_cast<LinkRawWireless*>(handle)->getQueuedCommands();
+}
+
 C_LinkRawWireless_AsyncState C_LinkRawWireless_getAsyncState(
     C_LinkRawWirelessHandle handle) {
   return static_cast<C_LinkRawWireless_AsyncState>(
@@ -334,10 +386,18 @@ u8 C_LinkRawWireless_currentPlayerId(C_LinkRawWirelessHandle handle) {
   return static_cast<LinkRawWireless*>(handle)->currentPlayerId();
 }
 
+C_Link_Stats C_LinkRawWireless_getStats(C_LinkRawWirelessHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkRawWireless*>(handle)->getStats(clear));
+}
+
 void C_LinkRawWireless_onSerial(C_LinkRawWirelessHandle handle) {
   static_cast<LinkRawWireless*>(handle)->_onSerial();
 }
 
+void C_LinkRawWireless_onTimer(C_LinkRawWirelessHandle handle) {
+  static_cast<LinkRawWireless*>(handle)->_onTimer();
+}
+
 C_LinkRawWireless_CommandResult fromCppResult(
     LinkRawWireless::CommandResult cppResult) {
   C_LinkRawWireless_CommandResult result;
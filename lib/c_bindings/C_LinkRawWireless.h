@@ -6,10 +6,12 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkRawWirelessHandle;
 
 #define C_LINK_RAW_WIRELESS_MAX_PLAYERS 5
+#define C_LINK_RAW_WIRELESS_DEFAULT_TIMER_ID 2
 #define C_LINK_RAW_WIRELESS_MAX_COMMAND_RESPONSE_LENGTH 30
 #define C_LINK_RAW_WIRELESS_MAX_CLIENT_TRANSFER_LENGTH 4
 #define C_LINK_RAW_WIRELESS_MAX_GAME_ID 0x7FFF
@@ -17,6 +19,7 @@ typedef void* C_LinkRawWirelessHandle;
 #define C_LINK_RAW_WIRELESS_MAX_USER_NAME_LENGTH 8
 #define C_LINK_RAW_WIRELESS_MAX_COMMAND_TRANSFER_LENGTH 23
 #define C_LINK_RAW_WIRELESS_MAX_SERVERS 4
+#define C_LINK_RAW_WIRELESS_COMMAND_QUEUE_SIZE 4
 
 typedef enum {
   C_LINK_RAW_WIRELESS_STATE_NEEDS_RESET,
@@ -99,11 +102,15 @@ typedef struct {
   u32 dataSize;
 } C_LinkRawWireless_ReceiveDataResponse;
 
+typedef void (*C_LinkRawWireless_CommandCallback)(
+    const C_LinkRawWireless_CommandResult* result);
+
 C_LinkRawWirelessHandle C_LinkRawWireless_create();
 void C_LinkRawWireless_destroy(C_LinkRawWirelessHandle handle);
 
 bool C_LinkRawWireless_isActive(C_LinkRawWirelessHandle handle);
 bool C_LinkRawWireless_activate(C_LinkRawWirelessHandle handle);
+void C_LinkRawWireless_activateAsync(C_LinkRawWirelessHandle handle);
 bool C_LinkRawWireless_restoreExistingConnection(
     C_LinkRawWirelessHandle handle);
 void C_LinkRawWireless_deactivate(C_LinkRawWirelessHandle handle);
@@ -188,6 +195,13 @@ bool C_LinkRawWireless_sendCommandAsync(C_LinkRawWirelessHandle handle,
                                         const u32* params,
                                         u32 length,
                                         bool invertsClock);
+bool C_LinkRawWireless_queueCommand(
+    C_LinkRawWirelessHandle handle,
+    u8 type,
+    const u32* params,
+    u32 length,
+    C_LinkRawWireless_CommandCallback onComplete);
+u32 C_LinkRawWireless_getQueuedCommands(C_LinkRawWirelessHandle handle);
 
 C_LinkRawWireless_AsyncState C_LinkRawWireless_getAsyncState(
     C_LinkRawWirelessHandle handle);
@@ -203,7 +217,10 @@ bool C_LinkRawWireless_isServerClosed(C_LinkRawWirelessHandle handle);
 u8 C_LinkRawWireless_playerCount(C_LinkRawWirelessHandle handle);
 u8 C_LinkRawWireless_currentPlayerId(C_LinkRawWirelessHandle handle);
 
+C_Link_Stats C_LinkRawWireless_getStats(C_LinkRawWirelessHandle handle, bool clear);
+
 void C_LinkRawWireless_onSerial(C_LinkRawWirelessHandle handle);
+void C_LinkRawWireless_onTimer(C_LinkRawWirelessHandle handle);
 
 extern C_LinkRawWirelessHandle cLinkRawWireless;
 
@@ -211,6 +228,10 @@ inline void C_LINK_LINK_RAW_WIRELESS_ISR_SERIAL() {
   C_LinkRawWireless_onSerial(cLinkRawWireless);
 }
 
+inline void C_LINK_LINK_RAW_WIRELESS_ISR_TIMER() {
+  C_LinkRawWireless_onTimer(cLinkRawWireless);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,114 @@
+#include "C_LinkRollback.h"
+#include "../LinkRollback.hpp"
+
+extern "C" {
+C_LinkRollbackHandle C_LinkRollback_createDefault(
+    C_LinkUniversalHandle linkUniversal) {
+  return new LinkRollback(static_cast<LinkUniversal*>(linkUniversal));
+}
+
+C_LinkRollbackHandle C_LinkRollback_create(C_LinkUniversalHandle linkUniversal,
+                                           u8 inputDelay,
+                                           u8 maxRollback) {
+  return new LinkRollback(static_cast<LinkUniversal*>(linkUniversal),
+                          inputDelay, maxRollback);
+}
+
+void C_LinkRollback_destroy(C_LinkRollbackHandle handle) {
+  delete static_cast<LinkRollback*>(handle);
+}
+
+bool C_LinkRollback_isActive(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->isActive();
+}
+
+bool C_LinkRollback_activate(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->activate();
+}
+
+void C_LinkRollback_deactivate(C_LinkRollbackHandle handle) {
+  static_cast<LinkRollback*>(handle)->deactivate();
+}
+
+bool C_LinkRollback_update(C_LinkRollbackHandle handle, u16 input) {
+  return static_cast<LinkRollback*>(handle)->update(input);
+}
+
+bool C_LinkRollback_needsRollback(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->needsRollback();
+}
+
+u32 C_LinkRollback_getRollbackFrame(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->getRollbackFrame();
+}
+
+u16 C_LinkRollback_getInput(C_LinkRollbackHandle handle, u8 playerId) {
+  return static_cast<LinkRollback*>(handle)->getInput(playerId);
+}
+
+u16 C_LinkRollback_getInputAt(C_LinkRollbackHandle handle,
+                              u8 playerId,
+                              u32 frame) {
+  return static_cast<LinkRollback*>(handle)->getInput(playerId, frame);
+}
+
+bool C_LinkRollback_isConfirmed(C_LinkRollbackHandle handle,
+                                u8 playerId,
+                                u32 frame) {
+  return static_cast<LinkRollback*>(handle)->isConfirmed(playerId, frame);
+}
+
+u32 C_LinkRollback_getPlayerConfirmedFrame(C_LinkRollbackHandle handle,
+                                           u8 playerId) {
+  return static_cast<LinkRollback*>(handle)->getConfirmedFrame(playerId);
+}
+
+u32 C_LinkRollback_getConfirmedFrame(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->getConfirmedFrame();
+}
+
+u32 C_LinkRollback_currentFrame(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->currentFrame();
+}
+
+u8 C_LinkRollback_playerCount(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->playerCount();
+}
+
+u8 C_LinkRollback_currentPlayerId(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->currentPlayerId();
+}
+
+u32 C_LinkRollback_getStallCount(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->getStallCount();
+}
+
+u32 C_LinkRollback_getRollbackCount(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->getRollbackCount();
+}
+
+u32 C_LinkRollback_getLongestRollback(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->getLongestRollback();
+}
+
+bool C_LinkRollback_didDesync(C_LinkRollbackHandle handle) {
+  return static_cast<LinkRollback*>(handle)->didDesync();
+}
+
+C_LinkRollback_Config C_LinkRollback_getConfig(C_LinkRollbackHandle handle) {
+  C_LinkRollback_Config config;
+  auto instance = static_cast<LinkRollback*>(handle);
+  config.inputDelay = instance->config.inputDelay;
+  config.maxRollback = instance->config.maxRollback;
+  config.predict = instance->config.predict;
+  return config;
+}
+
+void C_LinkRollback_setConfig(C_LinkRollbackHandle handle,
+                              C_LinkRollback_Config config) {
+  auto instance = static_cast<LinkRollback*>(handle);
+  instance->config.inputDelay = config.inputDelay;
+  instance->config.maxRollback = config.maxRollback;
+  instance->config.predict = config.predict;
+}
+}
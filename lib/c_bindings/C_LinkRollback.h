@@ -0,0 +1,72 @@
+#ifndef C_BINDINGS_LINK_ROLLBACK_H
+#define C_BINDINGS_LINK_ROLLBACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tonc_core.h>
+#include "C_LinkUniversal.h"
+
+typedef void* C_LinkRollbackHandle;
+
+#define C_LINK_ROLLBACK_DEFAULT_INPUT_DELAY 1
+#define C_LINK_ROLLBACK_DEFAULT_MAX_ROLLBACK 7
+#define C_LINK_ROLLBACK_INPUT_MASK 0x3FF
+
+typedef u16 (*C_LinkRollback_PredictionCallback)(u8 playerId,
+                                                  u32 frame,
+                                                  u16 lastInput);
+
+typedef struct {
+  u8 inputDelay;   // (call `activate()` again after changing it)
+  u8 maxRollback;  // (call `activate()` again after changing it)
+  C_LinkRollback_PredictionCallback predict;  // (NULL = repeat the last input)
+} C_LinkRollback_Config;
+
+C_LinkRollbackHandle C_LinkRollback_createDefault(
+    C_LinkUniversalHandle linkUniversal);
+C_LinkRollbackHandle C_LinkRollback_create(C_LinkUniversalHandle linkUniversal,
+                                           u8 inputDelay,
+                                           u8 maxRollback);
+void C_LinkRollback_destroy(C_LinkRollbackHandle handle);
+
+bool C_LinkRollback_isActive(C_LinkRollbackHandle handle);
+bool C_LinkRollback_activate(C_LinkRollbackHandle handle);
+void C_LinkRollback_deactivate(C_LinkRollbackHandle handle);
+
+bool C_LinkRollback_update(C_LinkRollbackHandle handle, u16 input);
+bool C_LinkRollback_needsRollback(C_LinkRollbackHandle handle);
+u32 C_LinkRollback_getRollbackFrame(C_LinkRollbackHandle handle);
+
+u16 C_LinkRollback_getInput(C_LinkRollbackHandle handle, u8 playerId);
+u16 C_LinkRollback_getInputAt(C_LinkRollbackHandle handle,
+                              u8 playerId,
+                              u32 frame);
+bool C_LinkRollback_isConfirmed(C_LinkRollbackHandle handle,
+                                u8 playerId,
+                                u32 frame);
+u32 C_LinkRollback_getPlayerConfirmedFrame(C_LinkRollbackHandle handle,
+                                           u8 playerId);
+u32 C_LinkRollback_getConfirmedFrame(C_LinkRollbackHandle handle);
+
+u32 C_LinkRollback_currentFrame(C_LinkRollbackHandle handle);
+u8 C_LinkRollback_playerCount(C_LinkRollbackHandle handle);
+u8 C_LinkRollback_currentPlayerId(C_LinkRollbackHandle handle);
+
+u32 C_LinkRollback_getStallCount(C_LinkRollbackHandle handle);
+u32 C_LinkRollback_getRollbackCount(C_LinkRollbackHandle handle);
+u32 C_LinkRollback_getLongestRollback(C_LinkRollbackHandle handle);
+bool C_LinkRollback_didDesync(C_LinkRollbackHandle handle);
+
+C_LinkRollback_Config C_LinkRollback_getConfig(C_LinkRollbackHandle handle);
+void C_LinkRollback_setConfig(C_LinkRollbackHandle handle,
+                              C_LinkRollback_Config config);
+
+extern C_LinkRollbackHandle cLinkRollback;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // C_BINDINGS_LINK_ROLLBACK_H
@@ -3,76 +3,128 @@
 
 extern "C" {
 C_LinkSPIHandle C_LinkSPI_create() {
-  return new LinkSPI();
+  return new LinkSPIStream();
 }
 
 void C_LinkSPI_destroy(C_LinkSPIHandle handle) {
-  delete static_cast<LinkSPI*>(handle);
+  delete static_cast<LinkSPIStream*>(handle);
 }
 
 bool C_LinkSPI_isActive(C_LinkSPIHandle handle) {
-  return static_cast<LinkSPI*>(handle)->isActive();
+  return static_cast<LinkSPIStream*>(handle)->isActive();
 }
 
 void C_LinkSPI_activate(C_LinkSPIHandle handle,
                         C_LinkSPI_Mode mode,
                         C_LinkSPI_DataSize dataSize) {
-  static_cast<LinkSPI*>(handle)->activate(
-      static_cast<LinkSPI::Mode>(mode),
-      static_cast<LinkSPI::DataSize>(dataSize));
+  static_cast<LinkSPIStream*>(handle)->activate(
+      static_cast<LinkSPIStream::Mode>(mode),
+      static_cast<LinkSPIStream::DataSize>(dataSize));
 }
 
 void C_LinkSPI_deactivate(C_LinkSPIHandle handle) {
-  static_cast<LinkSPI*>(handle)->deactivate();
+  static_cast<LinkSPIStream*>(handle)->deactivate();
 }
 
 u32 C_LinkSPI_transfer(C_LinkSPIHandle handle, u32 data) {
-  return static_cast<LinkSPI*>(handle)->transfer(data);
+  return static_cast<LinkSPIStream*>(handle)->transfer(data);
 }
 
 u32 C_LinkSPI_transferWithCancel(C_LinkSPIHandle handle,
                                  u32 data,
                                  bool (*cancel)()) {
-  return static_cast<LinkSPI*>(handle)->transfer(data, cancel);
+  return static_cast<LinkSPIStream*>(handle)->transfer(data, cancel);
 }
 
 void C_LinkSPI_transferAsync(C_LinkSPIHandle handle, u32 data) {
-  static_cast<LinkSPI*>(handle)->transferAsync(data);
+  static_cast<LinkSPIStream*>(handle)->transferAsync(data);
 }
 
 void C_LinkSPI_transferAsyncWithCancel(C_LinkSPIHandle handle,
                                        u32 data,
                                        bool (*cancel)()) {
-  static_cast<LinkSPI*>(handle)->transferAsync(data, cancel);
+  static_cast<LinkSPIStream*>(handle)->transferAsync(data, cancel);
 }
 
 C_LinkSPI_AsyncState C_LinkSPI_getAsyncState(C_LinkSPIHandle handle) {
   return static_cast<C_LinkSPI_AsyncState>(
-      static_cast<LinkSPI*>(handle)->getAsyncState());
+      static_cast<LinkSPIStream*>(handle)->getAsyncState());
 }
 
 u32 C_LinkSPI_getAsyncData(C_LinkSPIHandle handle) {
-  return static_cast<LinkSPI*>(handle)->getAsyncData();
+  return static_cast<LinkSPIStream*>(handle)->getAsyncData();
 }
 
 C_LinkSPI_Mode C_LinkSPI_getMode(C_LinkSPIHandle handle) {
-  return static_cast<C_LinkSPI_Mode>(static_cast<LinkSPI*>(handle)->getMode());
+  return static_cast<C_LinkSPI_Mode>(
+      static_cast<LinkSPIStream*>(handle)->getMode());
 }
 
 C_LinkSPI_DataSize C_LinkSPI_getDataSize(C_LinkSPIHandle handle) {
   return static_cast<C_LinkSPI_DataSize>(
-      static_cast<LinkSPI*>(handle)->getDataSize());
+      static_cast<LinkSPIStream*>(handle)->getDataSize());
 }
 
 void C_LinkSPI_setWaitModeActive(C_LinkSPIHandle handle, bool isActive) {
-  static_cast<LinkSPI*>(handle)->setWaitModeActive(isActive);
+  static_cast<LinkSPIStream*>(handle)->setWaitModeActive(isActive);
 }
 
 bool C_LinkSPI_isWaitModeActive(C_LinkSPIHandle handle) {
-  return static_cast<LinkSPI*>(handle)->isWaitModeActive();
+  return static_cast<LinkSPIStream*>(handle)->isWaitModeActive();
+}
+
+bool C_LinkSPI_startStream(C_LinkSPIHandle handle, u8 timerId) {
+  return static_cast<LinkSPIStream*>(handle)->startStream(timerId);
+}
+
+void C_LinkSPI_stopStream(C_LinkSPIHandle handle) {
+  static_cast<LinkSPIStream*>(handle)->stopStream();
+}
+
+bool C_LinkSPI_isStreaming(C_LinkSPIHandle handle) {
+  return static_cast<LinkSPIStream*>(handle)->isStreaming();
+}
+
+bool C_LinkSPI_canSend(C_LinkSPIHandle handle) {
+  return static_cast<LinkSPIStream*>(handle)->canSend();
+}
+
+bool C_LinkSPI_send(C_LinkSPIHandle handle, u32 data) {
+  return static_cast<LinkSPIStream*>(handle)->send(data);
+}
+
+bool C_LinkSPI_canRead(C_LinkSPIHandle handle) {
+  return static_cast<LinkSPIStream*>(handle)->canRead();
+}
+
+u32 C_LinkSPI_read(C_LinkSPIHandle handle) {
+  return static_cast<LinkSPIStream*>(handle)->read();
+}
+
+u32 C_LinkSPI_getPendingCount(C_LinkSPIHandle handle) {
+  return static_cast<LinkSPIStream*>(handle)->getPendingCount();
+}
+
+C_LinkSPI_StreamStats C_LinkSPI_getStreamStats(C_LinkSPIHandle handle,
+                                               bool clear) {
+  auto stats = static_cast<LinkSPIStream*>(handle)->getStreamStats(clear);
+  C_LinkSPI_StreamStats cStats;
+  cStats.words = stats.words;
+  cStats.bytes = stats.bytes;
+  cStats.stalls = stats.stalls;
+  cStats.overflows = stats.overflows;
+  return cStats;
+}
+
+C_Link_Stats C_LinkSPI_getStats(C_LinkSPIHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkSPIStream*>(handle)->getStats(clear));
 }
 
 void C_LinkSPI_onSerial(C_LinkSPIHandle handle, bool customAck) {
-  static_cast<LinkSPI*>(handle)->_onSerial(customAck);
+  static_cast<LinkSPIStream*>(handle)->_onSerial(customAck);
+}
+
+void C_LinkSPI_onTimer(C_LinkSPIHandle handle) {
+  static_cast<LinkSPIStream*>(handle)->_onTimer();
 }
 }
@@ -6,12 +6,14 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkSPIHandle;
 
 #define C_LINK_SPI_NO_DATA_32 0xFFFFFFFF
 #define C_LINK_SPI_NO_DATA_8 0xFF
 #define C_LINK_SPI_NO_DATA LINK_SPI_NO_DATA_32
+#define C_LINK_SPI_DEFAULT_STREAM_TIMER_ID 3
 
 typedef enum {
   C_LINK_SPI_MODE_SLAVE,
@@ -27,6 +29,13 @@ typedef enum {
   C_LINK_SPI_ASYNC_STATE_READY
 } C_LinkSPI_AsyncState;
 
+typedef struct {
+  u32 words;
+  u32 bytes;
+  u32 stalls;
+  u32 overflows;
+} C_LinkSPI_StreamStats;
+
 C_LinkSPIHandle C_LinkSPI_create();
 void C_LinkSPI_destroy(C_LinkSPIHandle handle);
 
@@ -55,7 +64,21 @@ C_LinkSPI_DataSize C_LinkSPI_getDataSize(C_LinkSPIHandle handle);
 void C_LinkSPI_setWaitModeActive(C_LinkSPIHandle handle, bool isActive);
 bool C_LinkSPI_isWaitModeActive(C_LinkSPIHandle handle);
 
+bool C_LinkSPI_startStream(C_LinkSPIHandle handle, u8 timerId);
+void C_LinkSPI_stopStream(C_LinkSPIHandle handle);
+bool C_LinkSPI_isStreaming(C_LinkSPIHandle handle);
+bool C_LinkSPI_canSend(C_LinkSPIHandle handle);
+bool C_LinkSPI_send(C_LinkSPIHandle handle, u32 data);
+bool C_LinkSPI_canRead(C_LinkSPIHandle handle);
+u32 C_LinkSPI_read(C_LinkSPIHandle handle);
+u32 C_LinkSPI_getPendingCount(C_LinkSPIHandle handle);
+C_LinkSPI_StreamStats C_LinkSPI_getStreamStats(C_LinkSPIHandle handle,
+                                               bool clear);
+
+C_Link_Stats C_LinkSPI_getStats(C_LinkSPIHandle handle, bool clear);
+
 void C_LinkSPI_onSerial(C_LinkSPIHandle handle, bool customAck);
+void C_LinkSPI_onTimer(C_LinkSPIHandle handle);
 
 extern C_LinkSPIHandle cLinkSPI;
 
@@ -63,6 +86,10 @@ inline void C_LINK_SPI_ISR_SERIAL() {
   C_LinkSPI_onSerial(cLinkSPI, false);
 }
 
+inline void C_LINK_SPI_ISR_TIMER() {
+  C_LinkSPI_onTimer(cLinkSPI);
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,67 @@
+#ifndef C_BINDINGS_LINK_STATS_H
+#define C_BINDINGS_LINK_STATS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <tonc_core.h>
+
+typedef struct {
+  u32 calls;
+  u32 totalCycles;
+  u32 maxCycles;
+} C_Link_ISRStats;
+
+typedef struct {
+  C_Link_ISRStats vblank;
+  C_Link_ISRStats serial;
+  C_Link_ISRStats timer;
+
+  u32 incomingHighWaterMark;
+  u32 outgoingHighWaterMark;
+  u32 overflows;
+  u32 resets;
+  u32 timeouts;
+
+  u32 retransmissions;
+  u32 forwardedMessages;
+  u32 crcFailures;
+  u32 commandFailures;
+} C_Link_Stats;
+
+#ifdef __cplusplus
+}
+
+// (this header is also included from `extern "C"` blocks)
+extern "C++" {
+#include "../_link_common.hpp"
+
+inline C_Link_ISRStats C_Link_toISRStats(const Link::Stats::ISR& isr) {
+  C_Link_ISRStats cIsr;
+  cIsr.calls = isr.calls;
+  cIsr.totalCycles = isr.totalCycles;
+  cIsr.maxCycles = isr.maxCycles;
+  return cIsr;
+}
+
+inline C_Link_Stats C_Link_toStats(const Link::Stats& stats) {
+  C_Link_Stats cStats;
+  cStats.vblank = C_Link_toISRStats(stats.vblank);
+  cStats.serial = C_Link_toISRStats(stats.serial);
+  cStats.timer = C_Link_toISRStats(stats.timer);
+  cStats.incomingHighWaterMark = stats.incomingHighWaterMark;
+  cStats.outgoingHighWaterMark = stats.outgoingHighWaterMark;
+  cStats.overflows = stats.overflows;
+  cStats.resets = stats.resets;
+  cStats.timeouts = stats.timeouts;
+  cStats.retransmissions = stats.retransmissions;
+  cStats.forwardedMessages = stats.forwardedMessages;
+  cStats.crcFailures = stats.crcFailures;
+  cStats.commandFailures = stats.commandFailures;
+  return cStats;
+}
+}
+#endif
+
+#endif  // C_BINDINGS_LINK_STATS_H
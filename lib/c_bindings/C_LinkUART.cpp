@@ -85,6 +85,10 @@ void C_LinkUART_sendByte(C_LinkUARTHandle handle, u8 data) {
   static_cast<LinkUART*>(handle)->send(data);
 }
 
+C_Link_Stats C_LinkUART_getStats(C_LinkUARTHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkUART*>(handle)->getStats(clear));
+}
+
 void C_LinkUART_onSerial(C_LinkUARTHandle handle) {
   static_cast<LinkUART*>(handle)->_onSerial();
 }
@@ -6,6 +6,7 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkUARTHandle;
 
@@ -63,6 +64,8 @@ u32 C_LinkUART_availableForSend(C_LinkUARTHandle handle);
 u8 C_LinkUART_readByte(C_LinkUARTHandle handle);
 void C_LinkUART_sendByte(C_LinkUARTHandle handle, u8 data);
 
+C_Link_Stats C_LinkUART_getStats(C_LinkUARTHandle handle, bool clear);
+
 void C_LinkUART_onSerial(C_LinkUARTHandle handle);
 
 extern C_LinkUARTHandle cLinkUART;
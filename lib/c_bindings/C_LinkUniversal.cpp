@@ -20,7 +20,8 @@ C_LinkUniversalHandle C_LinkUniversal_create(
       LinkUniversal::WirelessOptions{
           wirelessOptions.forwarding, wirelessOptions.retransmission,
           wirelessOptions.maxPlayers, wirelessOptions.timeout,
-          wirelessOptions.interval, wirelessOptions.sendTimerId});
+          wirelessOptions.interval, wirelessOptions.sendTimerId,
+          wirelessOptions.commandTimerId});
 }
 
 void C_LinkUniversal_destroy(C_LinkUniversalHandle handle) {
@@ -81,6 +82,14 @@ u16 C_LinkUniversal_peek(C_LinkUniversalHandle handle, u8 playerId) {
   return static_cast<LinkUniversal*>(handle)->peek(playerId);
 }
 
+bool C_LinkUniversal_canReadUrgent(C_LinkUniversalHandle handle, u8 playerId) {
+  return static_cast<LinkUniversal*>(handle)->canReadUrgent(playerId);
+}
+
+u16 C_LinkUniversal_readUrgent(C_LinkUniversalHandle handle, u8 playerId) {
+  return static_cast<LinkUniversal*>(handle)->readUrgent(playerId);
+}
+
 bool C_LinkUniversal_canSend(C_LinkUniversalHandle handle) {
   return static_cast<LinkUniversal*>(handle)->canSend();
 }
@@ -89,6 +98,14 @@ bool C_LinkUniversal_send(C_LinkUniversalHandle handle, u16 data) {
   return static_cast<LinkUniversal*>(handle)->send(data);
 }
 
+bool C_LinkUniversal_canSendUrgent(C_LinkUniversalHandle handle) {
+  return static_cast<LinkUniversal*>(handle)->canSendUrgent();
+}
+
+bool C_LinkUniversal_sendUrgent(C_LinkUniversalHandle handle, u16 data) {
+  return static_cast<LinkUniversal*>(handle)->sendUrgent(data);
+}
+
 bool C_LinkUniversal_didQueueOverflow(C_LinkUniversalHandle handle,
                                       bool clear) {
   return static_cast<LinkUniversal*>(handle)->didQueueOverflow(clear);
@@ -124,6 +141,16 @@ void C_LinkUniversal_setProtocol(C_LinkUniversalHandle handle,
       static_cast<LinkUniversal::Protocol>(protocol));
 }
 
+void C_LinkUniversal_setReceiveCallback(
+    C_LinkUniversalHandle handle,
+    C_LinkUniversal_ReceiveCallback callback) {
+  static_cast<LinkUniversal*>(handle)->setReceiveCallback(callback);
+}
+
+void C_LinkUniversal_setUrgentWeight(C_LinkUniversalHandle handle, u8 weight) {
+  static_cast<LinkUniversal*>(handle)->setUrgentWeight(weight);
+}
+
 bool C_LinkUniversal_isConnectedNow(C_LinkUniversalHandle handle) {
   return static_cast<LinkUniversal*>(handle)->isConnectedNow();
 }
@@ -151,6 +178,10 @@ u32 C_LinkUniversal_getSubWaitCount(C_LinkUniversalHandle handle) {
   return static_cast<LinkUniversal*>(handle)->_getSubWaitCount();
 }
 
+C_Link_Stats C_LinkUniversal_getStats(C_LinkUniversalHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkUniversal*>(handle)->getStats(clear));
+}
+
 void C_LinkUniversal_onVBlank(C_LinkUniversalHandle handle) {
   static_cast<LinkUniversal*>(handle)->_onVBlank();
 }
@@ -6,10 +6,12 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 #include "C_LinkCable.h"
 #include "C_LinkWireless.h"
 
 typedef void* C_LinkUniversalHandle;
+typedef void (*C_LinkUniversal_ReceiveCallback)(u8 playerId, u16 data);
 
 #define C_LINK_UNIVERSAL_DISCONNECTED 0xFFFF
 #define C_LINK_UNIVERSAL_NO_DATA 0x0
@@ -48,6 +50,7 @@ typedef struct {
   u32 timeout;
   u16 interval;
   u8 sendTimerId;
+  u8 commandTimerId;
 } C_LinkUniversal_WirelessOptions;
 
 C_LinkUniversalHandle C_LinkUniversal_createDefault();
@@ -76,9 +79,13 @@ bool C_LinkUniversal_waitForWithCancel(C_LinkUniversalHandle handle,
 bool C_LinkUniversal_canRead(C_LinkUniversalHandle handle, u8 playerId);
 u16 C_LinkUniversal_read(C_LinkUniversalHandle handle, u8 playerId);
 u16 C_LinkUniversal_peek(C_LinkUniversalHandle handle, u8 playerId);
+bool C_LinkUniversal_canReadUrgent(C_LinkUniversalHandle handle, u8 playerId);
+u16 C_LinkUniversal_readUrgent(C_LinkUniversalHandle handle, u8 playerId);
 
 bool C_LinkUniversal_canSend(C_LinkUniversalHandle handle);
 bool C_LinkUniversal_send(C_LinkUniversalHandle handle, u16 data);
+bool C_LinkUniversal_canSendUrgent(C_LinkUniversalHandle handle);
+bool C_LinkUniversal_sendUrgent(C_LinkUniversalHandle handle, u16 data);
 
 bool C_LinkUniversal_didQueueOverflow(C_LinkUniversalHandle handle, bool clear);
 
@@ -92,6 +99,10 @@ C_LinkUniversal_Protocol C_LinkUniversal_getProtocol(
     C_LinkUniversalHandle handle);
 void C_LinkUniversal_setProtocol(C_LinkUniversalHandle handle,
                                  C_LinkUniversal_Protocol protocol);
+void C_LinkUniversal_setReceiveCallback(
+    C_LinkUniversalHandle handle,
+    C_LinkUniversal_ReceiveCallback callback);
+void C_LinkUniversal_setUrgentWeight(C_LinkUniversalHandle handle, u8 weight);
 
 bool C_LinkUniversal_isConnectedNow(C_LinkUniversalHandle handle);
 C_LinkWireless_State C_LinkUniversal_getWirelessState(
@@ -104,6 +115,8 @@ C_LinkWirelessHandle C_LinkUniversal_getLinkWireless(
 u32 C_LinkUniversal_getWaitCount(C_LinkUniversalHandle handle);
 u32 C_LinkUniversal_getSubWaitCount(C_LinkUniversalHandle handle);
 
+C_Link_Stats C_LinkUniversal_getStats(C_LinkUniversalHandle handle, bool clear);
+
 void C_LinkUniversal_onVBlank(C_LinkUniversalHandle handle);
 void C_LinkUniversal_onSerial(C_LinkUniversalHandle handle);
 void C_LinkUniversal_onTimer(C_LinkUniversalHandle handle);
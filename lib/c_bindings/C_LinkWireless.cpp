@@ -11,9 +11,10 @@ C_LinkWirelessHandle C_LinkWireless_create(bool forwarding,
                                            u8 maxPlayers,
                                            u32 timeout,
                                            u16 interval,
-                                           u8 sendTimerId) {
+                                           u8 sendTimerId,
+                                           u8 commandTimerId) {
   return new LinkWireless(forwarding, retransmission, maxPlayers, timeout,
-                          interval, sendTimerId);
+                          interval, sendTimerId, commandTimerId);
 }
 
 void C_LinkWireless_destroy(C_LinkWirelessHandle handle) {
@@ -122,6 +123,14 @@ bool C_LinkWireless_send(C_LinkWirelessHandle handle, u16 data) {
   return static_cast<LinkWireless*>(handle)->send(data);
 }
 
+bool C_LinkWireless_canSendUrgent(C_LinkWirelessHandle handle) {
+  return static_cast<LinkWireless*>(handle)->canSendUrgent();
+}
+
+bool C_LinkWireless_sendUrgent(C_LinkWirelessHandle handle, u16 data) {
+  return static_cast<LinkWireless*>(handle)->sendUrgent(data);
+}
+
 bool C_LinkWireless_receive(C_LinkWirelessHandle handle,
                             C_LinkWireless_Message messages[],
                             u32* receivedCount) {
@@ -134,6 +143,7 @@ bool C_LinkWireless_receive(C_LinkWirelessHandle handle,
     messages[i].packetId = cppMessages[i].packetId;
     messages[i].data = cppMessages[i].data;
     messages[i].playerId = cppMessages[i].playerId;
+    messages[i].isUrgent = cppMessages[i].isUrgent;
   }
 
   return result;
@@ -176,6 +186,10 @@ void C_LinkWireless_resetTimer(C_LinkWirelessHandle handle) {
   return static_cast<LinkWireless*>(handle)->resetTimer();
 }
 
+u16 C_LinkWireless_getInterval(C_LinkWirelessHandle handle) {
+  return static_cast<LinkWireless*>(handle)->getInterval();
+}
+
 C_LinkWireless_Error C_LinkWireless_getLastError(C_LinkWirelessHandle handle,
                                                  bool clear) {
   return static_cast<C_LinkWireless_Error>(
@@ -191,6 +205,11 @@ C_LinkWireless_Config C_LinkWireless_getConfig(C_LinkWirelessHandle handle) {
   config.timeout = instance->config.timeout;
   config.interval = instance->config.interval;
   config.sendTimerId = instance->config.sendTimerId;
+  config.adaptiveInterval = instance->config.adaptiveInterval;
+  config.minInterval = instance->config.minInterval;
+  config.maxInterval = instance->config.maxInterval;
+  config.onReceive = instance->config.onReceive;
+  config.urgentWeight = instance->config.urgentWeight;
   return config;
 }
 
@@ -203,6 +222,15 @@ void C_LinkWireless_setConfig(C_LinkWirelessHandle handle,
   instance->config.timeout = config.timeout;
   instance->config.interval = config.interval;
   instance->config.sendTimerId = config.sendTimerId;
+  instance->config.adaptiveInterval = config.adaptiveInterval;
+  instance->config.minInterval = config.minInterval;
+  instance->config.maxInterval = config.maxInterval;
+  instance->config.onReceive = config.onReceive;
+  instance->config.urgentWeight = config.urgentWeight;
+}
+
+C_Link_Stats C_LinkWireless_getStats(C_LinkWirelessHandle handle, bool clear) {
+  return C_Link_toStats(static_cast<LinkWireless*>(handle)->getStats(clear));
 }
 
 void C_LinkWireless_onVBlank(C_LinkWirelessHandle handle) {
@@ -6,8 +6,10 @@ extern "C" {
 #endif
 
 #include <tonc_core.h>
+#include "C_LinkStats.h"
 
 typedef void* C_LinkWirelessHandle;
+typedef void (*C_LinkWireless_ReceiveCallback)(u8 playerId, u16 data);
 
 #define C_LINK_WIRELESS_MAX_PLAYERS 5
 #define C_LINK_WIRELESS_MIN_PLAYERS 2
@@ -18,6 +20,7 @@ typedef void* C_LinkWirelessHandle;
 #define C_LINK_WIRELESS_DEFAULT_TIMEOUT 10
 #define C_LINK_WIRELESS_DEFAULT_INTERVAL 75
 #define C_LINK_WIRELESS_DEFAULT_SEND_TIMER_ID 3
+#define C_LINK_WIRELESS_DEFAULT_COMMAND_TIMER_ID 2
 
 typedef enum {
   C_LINK_WIRELESS_STATE_NEEDS_RESET,
@@ -48,6 +51,7 @@ typedef struct {
   u16 packetId;
   u16 data;
   u8 playerId;
+  bool isUrgent;
 } C_LinkWireless_Message;
 
 typedef struct {
@@ -65,6 +69,11 @@ typedef struct {
   u32 timeout;   // can be changed in realtime, but call `resetTimeout()`
   u16 interval;  // can be changed in realtime, but call `resetTimer()`
   u8 sendTimerId;
+  bool adaptiveInterval;
+  u16 minInterval;
+  u16 maxInterval;
+  C_LinkWireless_ReceiveCallback onReceive;  // (if set, skips the queues)
+  u8 urgentWeight;  // urgent msgs per bulk msg when both wait (0 = strict)
 } C_LinkWireless_Config;
 
 typedef struct {
@@ -77,7 +86,8 @@ C_LinkWirelessHandle C_LinkWireless_create(bool forwarding,
                                            u8 maxPlayers,
                                            u32 timeout,
                                            u16 interval,
-                                           u8 sendTimerId);
+                                           u8 sendTimerId,
+                                           u8 commandTimerId);
 void C_LinkWireless_destroy(C_LinkWirelessHandle handle);
 
 bool C_LinkWireless_activate(C_LinkWirelessHandle handle);
@@ -108,6 +118,8 @@ bool C_LinkWireless_keepConnecting(C_LinkWirelessHandle handle);
 
 bool C_LinkWireless_send(C_LinkWirelessHandle handle, u16 data);
 bool C_LinkWireless_canSend(C_LinkWirelessHandle handle);
+bool C_LinkWireless_sendUrgent(C_LinkWirelessHandle handle, u16 data);
+bool C_LinkWireless_canSendUrgent(C_LinkWirelessHandle handle);
 bool C_LinkWireless_receive(C_LinkWirelessHandle handle,
                             C_LinkWireless_Message messages[],
                             u32* receivedCount);
@@ -123,6 +135,7 @@ bool C_LinkWireless_didQueueOverflow(C_LinkWirelessHandle handle, bool clear);
 
 void C_LinkWireless_resetTimeout(C_LinkWirelessHandle handle);
 void C_LinkWireless_resetTimer(C_LinkWirelessHandle handle);
+u16 C_LinkWireless_getInterval(C_LinkWirelessHandle handle);
 
 C_LinkWireless_Error C_LinkWireless_getLastError(C_LinkWirelessHandle handle,
                                                  bool clear);
@@ -131,6 +144,8 @@ C_LinkWireless_Config C_LinkWireless_getConfig(C_LinkWirelessHandle handle);
 void C_LinkWireless_setConfig(C_LinkWirelessHandle handle,
                               C_LinkWireless_Config config);
 
+C_Link_Stats C_LinkWireless_getStats(C_LinkWirelessHandle handle, bool clear);
+
 void C_LinkWireless_onVBlank(C_LinkWirelessHandle handle);
 void C_LinkWireless_onSerial(C_LinkWirelessHandle handle);
 void C_LinkWireless_onTimer(C_LinkWirelessHandle handle);
@@ -53,10 +53,11 @@ C_LinkWirelessMultiboot_AsyncHandle C_LinkWirelessMultiboot_Async_create(
     bool waitForReadySignal,
     bool keepConnectionAlive,
     u16 interval,
-    u8 timerId) {
+    u8 timerId,
+    u8 commandTimerId) {
   return new LinkWirelessMultiboot::Async(
       gameName, userName, gameId, players, waitForReadySignal,
-      keepConnectionAlive, interval, timerId);
+      keepConnectionAlive, interval, timerId, commandTimerId);
 }
 
 void C_LinkWirelessMultiboot_Async_destroy(
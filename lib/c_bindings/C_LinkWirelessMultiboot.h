@@ -16,6 +16,7 @@ typedef void* C_LinkWirelessMultiboot_AsyncHandle;
 #define C_LINK_WIRELESS_MULTIBOOT_MAX_PLAYERS 5
 #define C_LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_INTERVAL 50
 #define C_LINK_WIRELESS_MULTIBOOT_ASYNC_DEFAULT_TIMER_ID 3
+#define C_LINK_WIRELESS_MULTIBOOT_DEFAULT_COMMAND_TIMER_ID 2
 
 typedef enum {
   C_LINK_WIRELESS_MULTIBOOT_STATE_STOPPED,
@@ -123,7 +124,8 @@ C_LinkWirelessMultiboot_AsyncHandle C_LinkWirelessMultiboot_Async_create(
     bool waitForReadySignal,
     bool keepConnectionAlive,
     u16 interval,
-    u8 timerId);
+    u8 timerId,
+    u8 commandTimerId);
 void C_LinkWirelessMultiboot_Async_destroy(
     C_LinkWirelessMultiboot_AsyncHandle handle);
 
@@ -113,6 +113,7 @@ LINK_CODE_IWRAM bool LinkIR::receive(u16 pulses[],
 }
 
 LINK_CODE_IWRAM void LinkIR::_onSerial() {
+  LINK_STATS_ISR(serial);
   if (!isEnabled)
     return;
 
@@ -139,6 +140,11 @@ LINK_CODE_IWRAM void LinkIR::generate38kHzSignal(u32 microseconds) {
 
   // the GBA is 16.776MHz => 13.15 µs ~= 220 cycles per half-period
 
+#ifdef LINK_HOST
+  Link::_REG_RCNT = 0x80BA;
+  Link::Host::advance(halfPeriods * 220);
+  Link::_REG_RCNT = 0x80B2;
+#else
   asm volatile(
       "mov    r0, %0          \n"  // r0 = address of REG_RCNT
       "ldr    r1, =0x80BA     \n"  // r1 = initial value 0x80BA (LED ON)
@@ -163,12 +169,16 @@ LINK_CODE_IWRAM void LinkIR::generate38kHzSignal(u32 microseconds) {
       :
       : "r"(&Link::_REG_RCNT), "r"(halfPeriods)
       : "r0", "r1", "r2", "r3");
+#endif
 }
 
 LINK_CODE_IWRAM void LinkIR::waitMicroseconds(u32 microseconds) {
   if (!microseconds)
     return;
 
+#ifdef LINK_HOST
+  Link::Host::advance(microseconds * 17);
+#else
   asm volatile(
       "mov    r1, %0          \n"  // r1 = main loop count (microseconds)
       "1:                     \n"  // --- main loop ---
@@ -183,4 +193,5 @@ LINK_CODE_IWRAM void LinkIR::waitMicroseconds(u32 microseconds) {
       :
       : "r"(microseconds)
       : "r1", "r2");
+#endif
 }
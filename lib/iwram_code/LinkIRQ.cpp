@@ -0,0 +1,35 @@
+#include "../_link_common.hpp"
+
+#ifndef LINK_HOST
+// (called by the master ISR in system mode, so it can use the user stack)
+extern "C" LINK_CODE_IWRAM void _LINK_IRQ_dispatch() {
+  Link::u16 pending = Link::_REG_IE & Link::_REG_IF;
+  Link::_REG_IF = pending;
+  Link::_REG_IFBIOS |= pending;
+  Link::IRQ::_dispatch(pending);
+}
+
+/**
+ * The BIOS calls the master ISR in IRQ mode, whose stack is only ~160 bytes
+ * (and the BIOS already uses some of it). Like libtonc's `isr_master`, this
+ * switches to system mode (keeping IRQs disabled in `CPSR`) so the handlers
+ * run on the user stack, and switches back before returning to the BIOS.
+ */
+LINK_CODE_IWRAM __attribute__((naked)) void Link::IRQ::_onIRQ() {
+  asm volatile(
+      "mrs    r0, cpsr        \n"  // r0 = CPSR (IRQ mode: 0x92)
+      "orr    r0, r0, #0x1F   \n"  // IRQ mode (0x12) => system mode (0x1F)
+      "msr    cpsr_c, r0      \n"  // switch to system mode (IRQs disabled)
+      "stmfd  sp!, {r0, lr}   \n"  // save r0 and lr_sys on the user stack
+                                   // (two words keep it 8-byte aligned)
+      "ldr    r0, 1f          \n"  // r0 = address of _LINK_IRQ_dispatch
+      "mov    lr, pc          \n"  // lr = return address (the ldmfd below)
+      "bx     r0              \n"  // call _LINK_IRQ_dispatch()
+      "ldmfd  sp!, {r0, lr}   \n"  // restore r0 (CPSR) and lr_sys
+      "bic    r0, r0, #0x0D   \n"  // system mode (0x1F) => IRQ mode (0x12)
+      "msr    cpsr_c, r0      \n"  // switch back to IRQ mode
+      "bx     lr              \n"  // return to the BIOS (lr_irq)
+      "1:                     \n"  //
+      ".word  _LINK_IRQ_dispatch\n");
+}
+#endif
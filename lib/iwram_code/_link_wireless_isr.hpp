@@ -0,0 +1,68 @@
+#ifndef LINK_WIRELESS_ISR_H
+#define LINK_WIRELESS_ISR_H
+
+// --------------------------------------------------------------------------
+// Definitions of the LinkWireless functions that go in IWRAM.
+// --------------------------------------------------------------------------
+// Include this file in a source file that gets compiled (like
+// `lib/iwram_code/LinkWireless.cpp`), and instantiate each `LinkWirelessT<...>`
+// there with `LINK_WIRELESS_INSTANTIATE(...)`.
+// --------------------------------------------------------------------------
+
+#include "../LinkWireless.hpp"
+
+#ifdef LINK_WIRELESS_PUT_ISR_IN_IWRAM
+
+#if LINK_WIRELESS_PUT_ISR_IN_IWRAM_SERIAL == 1
+#define _LINK_SERIAL_ISR \
+  LINK_CODE_IWRAM        \
+  __attribute__((optimize(LINK_WIRELESS_PUT_ISR_IN_IWRAM_SERIAL_LEVEL)))
+#else
+#define _LINK_SERIAL_ISR
+#endif
+
+#if LINK_WIRELESS_PUT_ISR_IN_IWRAM_TIMER == 1
+#define _LINK_TIMER_ISR \
+  LINK_CODE_IWRAM       \
+  __attribute__((optimize(LINK_WIRELESS_PUT_ISR_IN_IWRAM_TIMER_LEVEL)))
+#else
+#define _LINK_TIMER_ISR
+#endif
+
+#define _LINK_TEMPLATE                                                \
+  template <Link::u32 QueueSize, Link::u32 MaxPlayers,                \
+            Link::u32 ServerTransferLength, bool Forwarding,          \
+            bool Retransmission, Link::u32 ClientTransferLength,      \
+            Link::u32 UrgentQueueSize>
+#define _LINK_CLASS                                                      \
+  LinkWirelessT<QueueSize, MaxPlayers, ServerTransferLength, Forwarding, \
+                Retransmission, ClientTransferLength, UrgentQueueSize>
+
+_LINK_TEMPLATE
+_LINK_SERIAL_ISR void _LINK_CLASS::_onSerial() {
+  this->__onSerial();
+}
+
+_LINK_TEMPLATE
+_LINK_TIMER_ISR void _LINK_CLASS::_onTimer() {
+  this->__onTimer();
+}
+
+_LINK_TEMPLATE
+_LINK_SERIAL_ISR void _LINK_CLASS::processMessage(u32 playerId,
+                                                  u32 data,
+                                                  u32& currentPacketId,
+                                                  u32& playerBitMap,
+                                                  int& playerBitMapCount) {
+  this->_processMessage(playerId, data, currentPacketId, playerBitMap,
+                        playerBitMapCount);
+}
+
+#undef _LINK_SERIAL_ISR
+#undef _LINK_TIMER_ISR
+#undef _LINK_TEMPLATE
+#undef _LINK_CLASS
+
+#endif
+
+#endif  // LINK_WIRELESS_ISR_H
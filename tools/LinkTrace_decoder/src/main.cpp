@@ -0,0 +1,225 @@
+// TOOL:
+// This program decodes a `Link::Trace` dump into a timeline.
+// - The input can be a raw dump (e.g. an SRAM file written with
+//   `Link::trace.dump(...)`) or any memory dump that contains the ring (e.g. a
+//   WRAM dump from an emulator). The ring is found by its magic number.
+// - Timestamps are unwrapped using both the 16-bit timer and `VCOUNT`, so the
+//   times are exact as long as consecutive events are less than one frame
+//   apart (longer gaps are reported modulo one frame).
+// Output:
+// - One line per event, with its time (in cycles since the first event), the
+//   delta from the previous event, the scanline, the library, the event type
+//   and its payload.
+// Usage:
+//   ./LinkTrace_decoder file.bin [-o offset] [-s source]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "../../../lib/_link_common.hpp"
+
+using u64 = Link::Host::u64;
+using u32 = Link::u32;
+using u16 = Link::u16;
+using u8 = Link::u8;
+using Trace = Link::Trace;
+
+static constexpr u32 HEADER_SIZE = 12;
+static constexpr u32 EVENT_SIZE = sizeof(Trace::Event);
+static constexpr u32 CYCLES_PER_FRAME =
+    Link::Host::CYCLES_PER_SCANLINE * Link::Host::TOTAL_SCANLINES;
+
+struct Ring {
+  u32 offset;
+  u16 size;
+  u32 count;
+  std::vector<Trace::Event> events;  // (oldest first)
+};
+
+static u16 read16(const std::vector<u8>& bytes, u32 offset) {
+  return bytes[offset] | (bytes[offset + 1] << 8);
+}
+
+static u32 read32(const std::vector<u8>& bytes, u32 offset) {
+  return read16(bytes, offset) | (read16(bytes, offset + 2) << 16);
+}
+
+static bool readFile(const char* path, std::vector<u8>& bytes) {
+  FILE* file = fopen(path, "rb");
+  if (!file)
+    return false;
+
+  u8 buffer[4096];
+  size_t read;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+    bytes.insert(bytes.end(), buffer, buffer + read);
+
+  fclose(file);
+  return true;
+}
+
+static bool findRing(const std::vector<u8>& bytes, u32 start, Ring& ring) {
+  for (u32 offset = start; offset + HEADER_SIZE <= bytes.size(); offset += 4) {
+    if (read32(bytes, offset) != Trace::MAGIC ||
+        read16(bytes, offset + 4) != Trace::VERSION)
+      continue;
+
+    u16 size = read16(bytes, offset + 6);
+    if (size == 0 || (size & (size - 1)) != 0 ||
+        offset + HEADER_SIZE + size * EVENT_SIZE > bytes.size())
+      continue;
+
+    ring.offset = offset;
+    ring.size = size;
+    ring.count = read32(bytes, offset + 8);
+
+    u32 available = ring.count < size ? ring.count : size;
+    for (u32 i = ring.count - available; i != ring.count; i++) {
+      u32 eventOffset = offset + HEADER_SIZE + (i & (size - 1)) * EVENT_SIZE;
+      Trace::Event event;
+      event.timestamp = read16(bytes, eventOffset);
+      event.vCount = bytes[eventOffset + 2];
+      event.id = bytes[eventOffset + 3];
+      event.data0 = read32(bytes, eventOffset + 4);
+      event.data1 = read32(bytes, eventOffset + 8);
+      ring.events.push_back(event);
+    }
+
+    return true;
+  }
+
+  return false;
+}
+
+static const char* sourceName(u8 source) {
+  switch (source) {
+    case Trace::CABLE:
+      return "CABLE";
+    case Trace::RAW_CABLE:
+      return "RAW_CABLE";
+    case Trace::WIRELESS:
+      return "WIRELESS";
+    case Trace::RAW_WIRELESS:
+      return "RAW_WIRELESS";
+    case Trace::SPI:
+      return "SPI";
+    case Trace::UART:
+      return "UART";
+    case Trace::CUBE:
+      return "CUBE";
+    case Trace::MOBILE:
+      return "MOBILE";
+    case Trace::PS2_KEYBOARD:
+      return "PS2_KEYBOARD";
+    case Trace::CABLE_2P:
+      return "CABLE_2P";
+    case Trace::USER:
+      return "USER";
+    default:
+      return "?";
+  }
+}
+
+static const char* typeName(u8 type) {
+  switch (type) {
+    case Trace::TRANSFER_START:
+      return "TRANSFER_START";
+    case Trace::WORD_RECEIVED:
+      return "WORD_RECEIVED";
+    case Trace::ACK:
+      return "ACK";
+    case Trace::RETRANSMIT:
+      return "RETRANSMIT";
+    case Trace::TIMEOUT:
+      return "TIMEOUT";
+    case Trace::STATE_CHANGE:
+      return "STATE_CHANGE";
+    case Trace::RESET:
+      return "RESET";
+    case Trace::QUEUE_OVERFLOW:
+      return "QUEUE_OVERFLOW";
+    case Trace::CRC_FAILURE:
+      return "CRC_FAILURE";
+    case Trace::COMMAND:
+      return "COMMAND";
+    case Trace::COMMAND_FAILURE:
+      return "COMMAND_FAILURE";
+    case Trace::CUSTOM:
+      return "CUSTOM";
+    default:
+      return "?";
+  }
+}
+
+/**
+ * @brief Returns the cycles between two events. `VCOUNT` gives an estimate
+ * (1 scanline of precision, modulo 1 frame) and the 16-bit timer gives the
+ * exact value (modulo 65536 cycles), so they're combined.
+ */
+static u32 elapsedCycles(const Trace::Event& from, const Trace::Event& to) {
+  u32 lines = (to.vCount + Link::Host::TOTAL_SCANLINES - from.vCount) %
+              Link::Host::TOTAL_SCANLINES;
+  int estimate = lines * Link::Host::CYCLES_PER_SCANLINE;
+  int correction = (short)(u16)(to.timestamp - from.timestamp - estimate);
+  int elapsed = estimate + correction;
+  return elapsed < 0 ? elapsed + CYCLES_PER_FRAME : elapsed;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2 || argv[1][0] == '-') {
+    fprintf(stderr, "Usage: %s file.bin [-o offset] [-s source]\n", argv[0]);
+    return 1;
+  }
+
+  const char* path = argv[1];
+  u32 start = 0;
+  int filter = -1;
+  for (int i = 2; i < argc - 1; i++) {
+    if (std::string(argv[i]) == "-o")
+      start = (u32)strtoul(argv[i + 1], nullptr, 0) & ~3;
+    if (std::string(argv[i]) == "-s")
+      filter = (int)strtoul(argv[i + 1], nullptr, 0) & 0xF0;
+  }
+
+  std::vector<u8> bytes;
+  if (!readFile(path, bytes)) {
+    fprintf(stderr, "Cannot read %s\n", path);
+    return 1;
+  }
+
+  Ring ring;
+  if (!findRing(bytes, start, ring)) {
+    fprintf(stderr, "No trace found in %s (magic: 0x%08X, version: %d)\n",
+            path, Trace::MAGIC, Trace::VERSION);
+    return 1;
+  }
+
+  u32 lost = ring.count - ring.events.size();
+  printf("Trace at 0x%X: %zu events (%u recorded, %u lost), ring size: %d\n\n",
+         ring.offset, ring.events.size(), ring.count, lost, ring.size);
+  printf("%8s  %12s  %10s  %4s  %-12s  %-15s  %-10s  %-10s\n", "#", "cycles",
+         "delta", "line", "source", "event", "data0", "data1");
+
+  u64 time = 0;
+  for (u32 i = 0; i < ring.events.size(); i++) {
+    const Trace::Event& event = ring.events[i];
+    u32 delta = i > 0 ? elapsedCycles(ring.events[i - 1], event) : 0;
+    time += delta;
+
+    u8 source = event.id & 0xF0;
+    if (filter >= 0 && source != filter)
+      continue;
+
+    printf("%8u  %12llu  %10u  %4d  %-12s  %-15s  0x%08X  0x%08X\n",
+           lost + i, (unsigned long long)time, delta, event.vCount,
+           sourceName(source), typeName(event.id & 0x0F), event.data0,
+           event.data1);
+  }
+
+  double ms = (double)time * 1000 / Link::Host::CPU_FREQUENCY;
+  printf("\nTotal: %llu cycles (%.3f ms)\n", (unsigned long long)time, ms);
+
+  return 0;
+}